@@ -2,24 +2,33 @@
 // Measures PrototypeMemory<Dim,Capacity>::Classify() throughput vs number of entries.
 // Reports (CSV default): name,dim_bits,capacity,size,iters,secs,queries_per_sec,eff_gb_per_sec
 // NDJSON mode (--json): one line per sample with fields incl. sample_index,warmup_ms,measure_ms
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+// Allocator sweep (--allocators): TLB-sensitive scans over a ~44 MB memory (Dim=10000, 32768 entries)
+// under each LargeAllocator; names are AM/alloc_<allocator>.
+// Large sweep (--large): memories of ~11 MB to ~350 MB (beyond the LLC) scanned without prefetch,
+// with the default and calibrated prefetch distance (AM/scan_*), and by ClassifyBatch over entry
+// tiles (AM/batch, queries_per_sec counts every query of the batch).
+// Cascade sweep (--cascade): AM/cascade rows with mode=full|exact|approx, prefix_words,
+// margin_bits and flip_prob, reporting queries_per_sec against recall and refined_frac.
+// Transposed sweep (--transposed): AM/rowmajor_core, AM/rowmajor_selected and AM/transposed
+// (TransposedPrototypeMemory) for small Dim / large N, with query=near|random.
 
 #include <algorithm>
-#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <cstdio>
 #include <utility>
 #include <vector>
 #include <cstdlib>
 #include <exception>
-#include <cstring>
-#include <numeric>
-#include <cmath>
 #if defined(_MSC_VER)
 #include <intrin.h>
 #endif
 
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/allocator.hpp"
 #include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/transposed.hpp"
 #include "hyperstream/config.hpp"
 #include "hyperstream/backend/policy.hpp"
 #if HS_X86_ARCH
@@ -30,35 +39,16 @@
 #include "hyperstream/backend/cpu_backend_neon.hpp"
 #endif
 #include "hyperstream/backend/capability.hpp"
+#include "bench_harness.hpp"
 
 using hyperstream::core::HyperVector;
 using hyperstream::memory::PrototypeMemory;
 
 namespace {
 
-struct Settings {
-  int warmup_ms = 0;     // preserve legacy behavior when omitted
-  int measure_ms = 300;
-  int samples = 1;
-  bool json = false;
-};
-
-static Settings ParseArgs(int argc, char** argv) {
-  Settings s;
-  for (int i = 1; i < argc; ++i) {
-    const char* a = argv[i];
-    if (std::strncmp(a, "--warmup_ms=", 12) == 0) {
-      s.warmup_ms = std::atoi(a + 12);
-    } else if (std::strncmp(a, "--measure_ms=", 13) == 0) {
-      s.measure_ms = std::atoi(a + 13);
-    } else if (std::strncmp(a, "--samples=", 10) == 0) {
-      s.samples = std::max(1, std::atoi(a + 10));
-    } else if (std::strncmp(a, "--json", 6) == 0) {
-      s.json = true;
-    }
-  }
-  return s;
-}
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Summarize;
 
 // Simple splitmix generator for deterministic bit patterns
 static inline std::uint64_t splitmix64(std::uint64_t& x) {
@@ -84,30 +74,47 @@ static void fill_random(HyperVector<Dim, bool>* hv, std::uint64_t seed) {
   }
 }
 
-template <typename Fn>
-static std::pair<std::size_t, double> run_for_ms(Fn&& fn, int min_ms) {
-  using clock = std::chrono::steady_clock;
-  const auto t0 = clock::now();
-  std::size_t iters = 0;
-  volatile std::uint64_t sink = 0;
-  do {
-    fn(&sink);
-    ++iters;
-  } while (std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - t0).count() < min_ms);
-  const double secs = std::chrono::duration<double>(clock::now() - t0).count();
-  return {iters, secs};
-}
+// Per-sample rows (+ aggregate when samples > 1). Each iteration classifies `queries_per_iter`
+// queries; add_fields appends bench-specific fields after the common ones.
+template <typename AddFields>
+static void report_am(const char* name, std::size_t dim, std::size_t capacity, std::size_t size,
+                      std::size_t bytes_per_iter, std::size_t queries_per_iter,
+                      const std::vector<hyperstream::bench::Sample>& samples, const Options& s,
+                      AddFields&& add_fields) {
+  std::vector<double> qps_v, gbps_v;
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double qps = static_cast<double>(smp.iters * queries_per_iter) / smp.secs;
+    const double eff_gbps = (static_cast<double>(bytes_per_iter) * smp.iters / smp.secs) / 1e9;
+    qps_v.push_back(qps); gbps_v.push_back(eff_gbps);
+    Record r(name);
+    r.Add("dim_bits", dim).Add("capacity", capacity).Add("size", size);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6)
+     .Add("queries_per_sec", qps, 1).Add("eff_gb_per_sec", eff_gbps, 3);
+    add_fields(r);
+    if (s.json) {
+      r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    }
+    r.Add(smp.counters, smp.iters);
+    r.Print(s.json);
+  }
 
-static void print_json_sample(const char* name, std::size_t dim_bits, std::size_t capacity, std::size_t size,
-                              std::size_t iters, double secs, double qps, double gbps,
-                              int sample_index, const Settings& s) {
-  std::printf("{\"name\":\"%s\",\"dim_bits\":%zu,\"capacity\":%zu,\"size\":%zu,\"iters\":%zu,\"secs\":%.6f,\"queries_per_sec\":%.1f,\"eff_gb_per_sec\":%.3f,\"sample_index\":%d,\"warmup_ms\":%d,\"measure_ms\":%d}\n",
-              name, dim_bits, capacity, size, iters, secs, qps, gbps, sample_index, s.warmup_ms, s.measure_ms);
+  if (s.samples > 1) {
+    Record agg(name);
+    agg.Add("dim_bits", dim).Add("capacity", capacity).Add("size", size);
+    add_fields(agg);
+    agg.AddBool("aggregate", true).Add("samples", s.samples)
+       .Add("queries_per_sec", Summarize(qps_v), 1).Add("eff_gb_per_sec", Summarize(gbps_v), 3)
+       .Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    agg.Print(s.json);
+  }
 }
 
 template <std::size_t Dim, std::size_t Capacity, typename ClassifyFn>
-static void bench_am(const char* name, std::size_t size, ClassifyFn&& classify, const Settings& s) {
-  PrototypeMemory<Dim, Capacity> am;
+static void bench_am(const char* name, std::size_t size, ClassifyFn&& classify, const Options& s,
+                     hyperstream::memory::LargeAllocator* alloc = nullptr) {
+  PrototypeMemory<Dim, Capacity> am(alloc);
   // Fill entries deterministically up to 'size'
   std::uint64_t seed = 12345;
   for (std::size_t i = 0; i < size && i < Capacity; ++i) {
@@ -118,62 +125,15 @@ static void bench_am(const char* name, std::size_t size, ClassifyFn&& classify,
   const std::size_t words = HyperVector<Dim, bool>::WordCount();
   const std::size_t bytes_per_iter = (size * words + words) * sizeof(std::uint64_t); // approx
 
-  // Warmup (optional)
-  if (s.warmup_ms > 0) {
-    (void)run_for_ms([&](volatile std::uint64_t* sink){
-      const auto lbl = classify(am, query);
-      *sink ^= lbl;
-    }, s.warmup_ms);
-  }
-
-  // Samples
-  std::vector<double> qps_v; qps_v.reserve(static_cast<std::size_t>(s.samples));
-  std::vector<double> gbps_v; gbps_v.reserve(static_cast<std::size_t>(s.samples));
-  for (int si = 0; si < s.samples; ++si) {
-    auto [iters, secs] = run_for_ms([&](volatile std::uint64_t* sink){
-      const auto lbl = classify(am, query);
-      *sink ^= lbl;
-    }, s.measure_ms);
-    const double qps = static_cast<double>(iters) / secs;
-    const double eff_gbps = (static_cast<double>(bytes_per_iter) * iters / secs) / 1e9;
-    qps_v.push_back(qps); gbps_v.push_back(eff_gbps);
-    if (s.json) {
-      print_json_sample(name, Dim, Capacity, size, iters, secs, qps, eff_gbps, si, s);
-    } else {
-      // Preserve legacy line when samples==1 and no JSON
-      if (s.samples == 1) {
-        std::printf("%s,dim_bits=%zu,capacity=%zu,size=%zu,iters=%zu,secs=%.6f,queries_per_sec=%.1f,eff_gb_per_sec=%.3f\n",
-                    name, Dim, Capacity, size, iters, secs, qps, eff_gbps);
-      } else {
-        std::printf("%s,dim_bits=%zu,capacity=%zu,size=%zu,sample=%d,iters=%zu,secs=%.6f,queries_per_sec=%.1f,eff_gb_per_sec=%.3f\n",
-                    name, Dim, Capacity, size, si, iters, secs, qps, eff_gbps);
-      }
-    }
-  }
-
-  if (s.samples > 1) {
-    auto agg = [](std::vector<double> v){
-      std::sort(v.begin(), v.end());
-      const double mean = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
-      const double median = (v.size()%2? v[v.size()/2] : 0.5*(v[v.size()/2-1]+v[v.size()/2]));
-      double ss = 0.0; for (double x: v) { double d=x-mean; ss += d*d; }
-      const double stdev = std::sqrt(ss / v.size());
-      return std::tuple<double,double,double>(mean, median, stdev);
-    };
-    auto [q_mean,q_med,q_std] = agg(qps_v);
-    auto [g_mean,g_med,g_std] = agg(gbps_v);
-    if (s.json) {
-      std::printf("{\"name\":\"%s\",\"dim_bits\":%zu,\"capacity\":%zu,\"size\":%zu,\"aggregate\":true,\"samples\":%d,\"queries_per_sec\":{\"mean\":%.1f,\"median\":%.1f,\"stdev\":%.1f},\"eff_gb_per_sec\":{\"mean\":%.3f,\"median\":%.3f,\"stdev\":%.3f},\"warmup_ms\":%d,\"measure_ms\":%d}\n",
-                  name, Dim, Capacity, size, s.samples, q_mean, q_med, q_std, g_mean, g_med, g_std, s.warmup_ms, s.measure_ms);
-    } else {
-      std::printf("%s,dim_bits=%zu,capacity=%zu,size=%zu,aggregate=samples:%d,qps_mean=%.1f,qps_median=%.1f,qps_stdev=%.1f,gbps_mean=%.3f,gbps_median=%.3f,gbps_stdev=%.3f\n",
-                  name, Dim, Capacity, size, s.samples, q_mean, q_med, q_std, g_mean, g_med, g_std);
-    }
-  }
+  const auto samples = hyperstream::bench::Measure(s, [&](volatile std::uint64_t* sink){
+    const auto lbl = classify(am, query);
+    *sink ^= lbl;
+  });
+  report_am(name, Dim, Capacity, size, bytes_per_iter, 1, samples, s, [](Record&) {});
 }
 
 template <std::size_t Dim>
-static void run_one_dim(const Settings& s) {
+static void run_one_dim(const Options& s) {
   // Choose representative capacities/sizes
   bench_am<Dim, 256>("AM/core", 256, [](auto& am, const auto& q){ return am.Classify(q, 0); }, s);
   bench_am<Dim, 1024>("AM/core", 1024, [](auto& am, const auto& q){ return am.Classify(q, 0); }, s);
@@ -205,6 +165,223 @@ static void run_one_dim(const Settings& s) {
 #endif
 }
 
+// Scan throughput of a memory far larger than the L2 TLB reach of 4 KiB pages, per allocator.
+template <std::size_t Dim>
+static void run_allocators(const Options& s) {
+  using namespace hyperstream::memory;
+  constexpr std::size_t kCap = 32768;
+  auto classify = [](const auto& am, const auto& q){ return am.Classify(q, 0); };
+  const std::size_t bytes = kCap * sizeof(typename PrototypeMemory<Dim, kCap>::Entry);
+
+  HeapAllocator heap;
+  bench_am<Dim, kCap>("AM/alloc_heap", kCap, classify, s, &heap);
+  {
+    ArenaAllocator arena(bytes);
+    bench_am<Dim, kCap>("AM/alloc_arena", kCap, classify, s, &arena);
+  }
+  HugePageAllocator huge2m(HugePageAllocator::PageSize::k2M, /*prefault=*/true);
+  bench_am<Dim, kCap>("AM/alloc_hugepage_2m", kCap, classify, s, &huge2m);
+  HugePageAllocator huge1g(HugePageAllocator::PageSize::k1G, /*prefault=*/true);
+  bench_am<Dim, kCap>("AM/alloc_hugepage_1g", kCap, classify, s, &huge1g);
+  NumaAllocator numa(0, /*prefault=*/true, /*huge_pages=*/true);
+  bench_am<Dim, kCap>("AM/alloc_numa", kCap, classify, s, &numa);
+  if (!s.json) {
+    std::printf("AM/alloc_notes,hugepage_1g_fallbacks=%zu,numa_binding_failures=%zu\n",
+                huge1g.huge_tlb_fallbacks(), numa.binding_failures());
+  }
+}
+
+// Scans of memories from about the LLC size up to several times it (Dim=10000: 8192 entries is
+// ~11 MB, 262144 is ~350 MB): single queries with prefetching off, at the default distance and at
+// the calibrated distance, then ClassifyBatch with cache-sized entry tiles. All use the
+// policy-selected Hamming kernel.
+template <std::size_t Dim>
+static void run_large(const Options& s) {
+  using namespace hyperstream::memory;
+  constexpr std::size_t kCap = 262144;
+  constexpr std::size_t kBatch = PrototypeMemory<Dim, kCap>::kBatchQueryBlock;
+  using Entry = typename PrototypeMemory<Dim, kCap>::Entry;
+  PrototypeMemory<Dim, kCap> am;
+  std::vector<HyperVector<Dim, bool>> queries(kBatch);
+  for (std::size_t q = 0; q < kBatch; ++q) fill_random(&queries[q], 777 + q);
+  std::vector<std::uint64_t> labels(kBatch);
+  const ScanTuning defaults = am.scan_tuning();
+  // Policy-selected SIMD distance: fast enough that the scan is bound by memory, not popcount.
+  const auto dist = hyperstream::backend::SelectHammingBackend<Dim>();
+
+  std::uint64_t seed = 12345;
+  for (std::size_t size : {std::size_t{8192}, std::size_t{65536}, std::size_t{262144}}) {
+    while (am.size() < size) {
+      HyperVector<Dim, bool> hv; fill_random(&hv, seed++); (void)am.Learn(am.size() + 1, hv);
+    }
+    const std::size_t bytes = size * sizeof(Entry);
+    std::size_t k = 0;
+    auto single = [&](volatile std::uint64_t* sink) { *sink ^= am.Classify(queries[k++ % kBatch], dist, 0); };
+    auto report_single = [&](const char* name) {
+      const ScanTuning t = am.scan_tuning();
+      report_am(name, Dim, kCap, size, bytes, 1, hyperstream::bench::Measure(s, single), s,
+                [&](Record& r) { r.Add("prefetch_distance", t.prefetch_distance); });
+    };
+
+    am.set_scan_tuning({0, defaults.tile_bytes});
+    report_single("AM/scan_noprefetch");
+    am.set_scan_tuning(defaults);
+    report_single("AM/scan_prefetch");
+    (void)am.CalibratePrefetchDistance(dist);
+    report_single("AM/scan_calibrated");
+
+    const ScanTuning tuned = am.scan_tuning();
+    for (std::size_t tile_bytes : {std::size_t{64} * 1024, defaults.tile_bytes, std::size_t{1} << 20}) {
+      am.set_scan_tuning({tuned.prefetch_distance, tile_bytes});
+      report_am("AM/batch", Dim, kCap, size, bytes, kBatch,
+                hyperstream::bench::Measure(s, [&](volatile std::uint64_t* sink) {
+                  am.ClassifyBatch(queries.data(), kBatch, labels.data(), dist, 0);
+                  *sink ^= labels[0];
+                }), s, [&](Record& r) {
+                  r.Add("prefetch_distance", tuned.prefetch_distance).Add("tile_bytes", tile_bytes)
+                   .Add("batch_queries", kBatch);
+                });
+    }
+    am.set_scan_tuning(defaults);
+  }
+}
+
+// Words-level Hamming kernel matching the policy's choice for Dim (cascade refinement scores word
+// ranges, not whole vectors). Null selects the portable core distance.
+template <std::size_t Dim>
+static std::size_t (*selected_words_distance())(const std::uint64_t*, const std::uint64_t*, std::size_t) {
+  const auto fn = hyperstream::backend::SelectHammingBackend<Dim>();
+  (void)fn;
+#if HS_X86_ARCH
+  if (fn == &hyperstream::backend::avx2::HammingDistanceAVX2<Dim>) return &hyperstream::backend::avx2::HammingWords;
+  if (fn == &hyperstream::backend::sse2::HammingDistanceSSE2<Dim>) return &hyperstream::backend::sse2::HammingWords;
+#endif
+#if HS_ARM64_ARCH
+  if (fn == &hyperstream::backend::neon::HammingDistanceNEON<Dim>) return &hyperstream::backend::neon::HammingWords;
+#endif
+  return nullptr;
+}
+
+// Speed/recall of cascade classification (Dim=10000, 16384 entries, ~22 MB): queries are stored
+// prototypes with each bit flipped with probability flip_prob. mode=full is the plain scan with
+// the selected kernel; recall is agreement with it, refined_frac the share of entries scored on
+// the full vector.
+template <std::size_t Dim>
+static void run_cascade(const Options& s) {
+  using namespace hyperstream::memory;
+  constexpr std::size_t kCap = 16384;
+  constexpr std::size_t kQueries = 64;
+  using Entry = typename PrototypeMemory<Dim, kCap>::Entry;
+  PrototypeMemory<Dim, kCap> am;
+  std::uint64_t seed = 4242;
+  for (std::size_t i = 0; i < kCap; ++i) {
+    HyperVector<Dim, bool> hv; fill_random(&hv, seed++); (void)am.Learn(i + 1, hv);
+  }
+  const auto hv_dist = hyperstream::backend::SelectHammingBackend<Dim>();
+  const auto raw_words = selected_words_distance<Dim>();
+  auto words_dist = [raw_words](const std::uint64_t* a, const std::uint64_t* b, std::size_t n) {
+    return raw_words ? raw_words(a, b, n) : detail_cascade::CoreWordsDistance{}(a, b, n);
+  };
+  const std::size_t bytes = kCap * sizeof(Entry);
+
+  for (double flip_prob : {0.05, 0.30, 0.45}) {
+    std::vector<HyperVector<Dim, bool>> queries(kQueries);
+    std::uint64_t rng = 99 + static_cast<std::uint64_t>(flip_prob * 1000);
+    const auto threshold = static_cast<std::uint64_t>(flip_prob * 18446744073709551615.0);
+    for (std::size_t q = 0; q < kQueries; ++q) {
+      queries[q] = am.data()[(q * 257) % kCap].hv;
+      for (std::size_t bit = 0; bit < Dim; ++bit) {
+        if (splitmix64(rng) < threshold) queries[q].SetBit(bit, !queries[q].GetBit(bit));
+      }
+    }
+    std::vector<std::uint64_t> reference(kQueries);
+    for (std::size_t q = 0; q < kQueries; ++q) reference[q] = am.Classify(queries[q], hv_dist, 0);
+
+    std::size_t k = 0;
+    report_am("AM/cascade", Dim, kCap, kCap, bytes, 1,
+              hyperstream::bench::Measure(s, [&](volatile std::uint64_t* sink) {
+                *sink ^= am.Classify(queries[k++ % kQueries], hv_dist, 0);
+              }), s, [&](Record& r) {
+                r.Add("mode", "full").Add("prefix_words", HyperVector<Dim, bool>::WordCount())
+                 .Add("margin_bits", std::size_t{0}).Add("flip_prob", flip_prob, 2)
+                 .Add("recall", 1.0, 4).Add("refined_frac", 1.0, 4);
+              });
+
+    auto run = [&](const char* mode_name, const CascadeOptions& opts) {
+      std::size_t hits = 0;
+      std::size_t refined = 0;
+      for (std::size_t q = 0; q < kQueries; ++q) {
+        CascadeStats st;
+        hits += am.ClassifyCascade(queries[q], opts, words_dist, 0, &st) == reference[q] ? 1u : 0u;
+        refined += st.refined;
+      }
+      const double recall = static_cast<double>(hits) / kQueries;
+      const double refined_frac = static_cast<double>(refined) / (static_cast<double>(kQueries) * kCap);
+      report_am("AM/cascade", Dim, kCap, kCap, bytes, 1,
+                hyperstream::bench::Measure(s, [&](volatile std::uint64_t* sink) {
+                  *sink ^= am.ClassifyCascade(queries[k++ % kQueries], opts, words_dist, 0);
+                }), s, [&](Record& r) {
+                  r.Add("mode", mode_name).Add("prefix_words", opts.prefix_words)
+                   .Add("margin_bits", opts.margin_bits).Add("flip_prob", flip_prob, 2)
+                   .Add("recall", recall, 4).Add("refined_frac", refined_frac, 6);
+                });
+    };
+    for (std::size_t prefix : {std::size_t{16}, std::size_t{32}}) {
+      CascadeOptions opts;
+      opts.prefix_words = prefix;
+      opts.margin_bits = 0;
+      run("exact", opts);
+      opts.mode = CascadeMode::kApproximate;
+      for (std::size_t margin : {std::size_t{0}, std::size_t{32}, std::size_t{128}}) {
+        opts.margin_bits = margin;
+        run("approx", opts);
+      }
+    }
+  }
+}
+
+// Row-major scan vs the bit-transposed engine for small Dim / many prototypes. Queries are stored
+// prototypes with 10% of bits flipped (query=near: pruning cuts most groups short) or random
+// vectors (query=random: distances cluster near Dim/2, little pruning).
+template <std::size_t Dim, std::size_t Cap>
+static void bench_transposed(const Options& s) {
+  using namespace hyperstream::memory;
+  auto rows = std::make_unique<PrototypeMemory<Dim, Cap>>();
+  std::uint64_t seed = 31337;
+  for (std::size_t i = 0; i < Cap; ++i) {
+    HyperVector<Dim, bool> hv; fill_random(&hv, seed++); (void)rows->Learn(i + 1, hv);
+  }
+  auto cols = std::make_unique<TransposedPrototypeMemory<Dim, Cap>>(*rows);
+  const auto hv_dist = hyperstream::backend::SelectHammingBackend<Dim>();
+  constexpr std::size_t kQueries = 16;
+  const std::size_t bytes = Cap * HyperVector<Dim, bool>::WordCount() * sizeof(std::uint64_t);
+  for (const char* kind : {"near", "random"}) {
+    std::vector<HyperVector<Dim, bool>> queries(kQueries);
+    std::uint64_t rng = 5150;
+    for (std::size_t q = 0; q < kQueries; ++q) {
+      if (kind[0] == 'n') {
+        queries[q] = rows->data()[(q * 7919) % Cap].hv;
+        for (std::size_t bit = 0; bit < Dim; ++bit) {
+          if (splitmix64(rng) % 10 == 0) queries[q].SetBit(bit, !queries[q].GetBit(bit));
+        }
+      } else {
+        fill_random(&queries[q], 777 + q);
+      }
+    }
+    std::size_t k = 0;
+    auto add = [&](Record& r) { r.Add("query", kind); };
+    report_am("AM/rowmajor_core", Dim, Cap, Cap, bytes, 1, hyperstream::bench::Measure(s, [&](volatile std::uint64_t* sink) {
+      *sink ^= rows->Classify(queries[k++ % kQueries], 0);
+    }), s, add);
+    report_am("AM/rowmajor_selected", Dim, Cap, Cap, bytes, 1, hyperstream::bench::Measure(s, [&](volatile std::uint64_t* sink) {
+      *sink ^= rows->Classify(queries[k++ % kQueries], hv_dist, 0);
+    }), s, add);
+    report_am("AM/transposed", Dim, Cap, Cap, bytes, 1, hyperstream::bench::Measure(s, [&](volatile std::uint64_t* sink) {
+      *sink ^= cols->Classify(queries[k++ % kQueries], 0);
+    }), s, add);
+  }
+}
+
 } // namespace
 
 int main(int argc, char** argv) try {
@@ -212,7 +389,7 @@ int main(int argc, char** argv) try {
   setvbuf(stdout, nullptr, _IONBF, 0);
   setvbuf(stderr, nullptr, _IONBF, 0);
 
-  const Settings s = ParseArgs(argc, argv);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
 
   // Print active configuration
   std::printf("Config/profile=%s,default_dim_bits=%zu,default_capacity=%zu\n",
@@ -220,6 +397,27 @@ int main(int argc, char** argv) try {
               hyperstream::config::kDefaultDimBits,
               hyperstream::config::kDefaultCapacity);
 
+  if (s.HasFlag("--allocators")) {
+    run_allocators<10000>(s);
+    return EXIT_SUCCESS;
+  }
+  if (s.HasFlag("--large")) {
+    run_large<10000>(s);
+    return EXIT_SUCCESS;
+  }
+  if (s.HasFlag("--cascade")) {
+    run_cascade<10000>(s);
+    return EXIT_SUCCESS;
+  }
+  if (s.HasFlag("--transposed")) {
+    bench_transposed<64, 65536>(s);
+    bench_transposed<256, 4096>(s);
+    bench_transposed<256, 65536>(s);
+    bench_transposed<1024, 65536>(s);
+    bench_transposed<10000, 4096>(s);
+    return EXIT_SUCCESS;
+  }
+
   // Use a typical binary dimension for HDC
   run_one_dim<10000>(s);
   run_one_dim<16384>(s);
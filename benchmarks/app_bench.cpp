@@ -0,0 +1,376 @@
+// HyperStream end-to-end application benchmark
+// Three deterministic synthetic workloads exercising full encode -> memory -> decide pipelines:
+//   App/langid   character trigrams (SequentialNGramEncoder) + PrototypeMemory classify;
+//                8 synthetic "languages" with distinct bigram transition tables. event = character
+//   App/anomaly  periodic signal windows (ThermometerEncoder + position rotation + bundling),
+//                per-phase prototypes trained through ClusterMemory, distance threshold;
+//                10% of test windows carry injected spikes/level shifts. event = sample
+//   App/records  categorical records bound role-by-value (SymbolEncoder + Bind) and bundled,
+//                PrototypeMemory classify over 6 noisy classes. event = record
+// Data comes from a splitmix64 stream (no <random> distributions) so accuracy is identical across
+// standard libraries. Training and accuracy are computed once; the timed loop replays the test set.
+// Reports: name,dim_bits,classes,events_per_iter,iters,secs,events_per_sec,accuracy,model_bytes
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hyperstream/config.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+#include "hyperstream/encoding/symbol.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::HyperVector;
+using hyperstream::memory::ClusterMemory;
+using hyperstream::memory::PrototypeMemory;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::Summarize;
+
+struct Rng {
+  std::uint64_t state;
+  std::uint64_t Next() {
+    state += 0x9e3779b97f4a7c15ULL;
+    std::uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+  std::size_t Below(std::size_t n) { return static_cast<std::size_t>(Next() % n); }
+  double Unit() { return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+struct AppResult {
+  std::size_t classes = 0;
+  std::size_t events_per_iter = 0;
+  double accuracy = 0.0;
+  std::size_t model_bytes = 0;
+  std::vector<Sample> samples;
+};
+
+static void report(const Options& s, const char* name, std::size_t dim_bits, const AppResult& r) {
+  std::vector<double> eps_v;
+  for (std::size_t si = 0; si < r.samples.size(); ++si) {
+    const Sample& smp = r.samples[si];
+    const double eps = static_cast<double>(smp.iters * r.events_per_iter) / smp.secs;
+    eps_v.push_back(eps);
+    Record rec(name);
+    rec.Add("dim_bits", dim_bits).Add("classes", r.classes).Add("events_per_iter", r.events_per_iter);
+    if (!s.json && s.samples > 1) rec.Add("sample", static_cast<int>(si));
+    rec.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("events_per_sec", eps, 1)
+       .Add("accuracy", r.accuracy, 4).Add("model_bytes", r.model_bytes);
+    if (s.json) rec.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    rec.Add(smp.counters, smp.iters * r.events_per_iter);
+    rec.Print(s.json);
+  }
+  if (s.samples > 1) {
+    Record agg(name);
+    agg.Add("dim_bits", dim_bits).AddBool("aggregate", true).Add("samples", s.samples)
+       .Add("events_per_sec", Summarize(eps_v), 1).Add("accuracy", r.accuracy, 4)
+       .Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    agg.Print(s.json);
+  }
+}
+
+// -----------------------------
+// Language identification
+// -----------------------------
+
+constexpr std::size_t kAlphabet = 27;  // a-z + space
+constexpr std::size_t kLanguages = 8;
+constexpr std::size_t kSentenceLen = 48;
+
+// Each language prefers 3 successors per character (55%), otherwise uniform.
+struct Language {
+  std::size_t preferred[kAlphabet][3];
+};
+
+static std::vector<Language> make_languages() {
+  Rng rng{0x1a2b3c4dULL};
+  std::vector<Language> langs(kLanguages);
+  for (auto& l : langs) {
+    for (std::size_t c = 0; c < kAlphabet; ++c) {
+      for (auto& p : l.preferred[c]) p = rng.Below(kAlphabet);
+    }
+  }
+  return langs;
+}
+
+static std::vector<std::uint8_t> make_sentence(const Language& l, Rng* rng) {
+  std::vector<std::uint8_t> out(kSentenceLen);
+  std::size_t c = rng->Below(kAlphabet);
+  for (auto& ch : out) {
+    c = (rng->Unit() < 0.55) ? l.preferred[c][rng->Below(3)] : rng->Below(kAlphabet);
+    ch = static_cast<std::uint8_t>(c);
+  }
+  return out;
+}
+
+template <std::size_t Dim>
+static AppResult run_langid(const Options& s) {
+  using Encoder = hyperstream::encoding::SequentialNGramEncoder<Dim, 3>;
+  const auto langs = make_languages();
+  Rng rng{0xfeedULL};
+  auto encode = [](Encoder* enc, const std::vector<std::uint8_t>& text, HyperVector<Dim, bool>* out) {
+    enc->Reset();
+    for (std::uint8_t ch : text) enc->Update(ch);
+    enc->Finalize(out);
+  };
+
+  Encoder enc;
+  auto train = std::make_unique<ClusterMemory<Dim, kLanguages>>();
+  HyperVector<Dim, bool> hv;
+  for (std::size_t n = 0; n < 24; ++n) {
+    for (std::size_t l = 0; l < kLanguages; ++l) {
+      encode(&enc, make_sentence(langs[l], &rng), &hv);
+      (void)train->Update(l, hv);
+    }
+  }
+  PrototypeMemory<Dim, kLanguages> model;
+  for (std::size_t l = 0; l < kLanguages; ++l) {
+    train->Finalize(l, &hv);
+    (void)model.Learn(l, hv);
+  }
+
+  std::vector<std::vector<std::uint8_t>> test;
+  std::vector<std::uint64_t> truth;
+  for (std::size_t n = 0; n < 32; ++n) {
+    for (std::size_t l = 0; l < kLanguages; ++l) {
+      test.push_back(make_sentence(langs[l], &rng));
+      truth.push_back(l);
+    }
+  }
+  std::size_t correct = 0;
+  for (std::size_t i = 0; i < test.size(); ++i) {
+    encode(&enc, test[i], &hv);
+    correct += model.Classify(hv) == truth[i];
+  }
+
+  AppResult r;
+  r.classes = kLanguages;
+  r.events_per_iter = kSentenceLen;
+  r.accuracy = static_cast<double>(correct) / static_cast<double>(test.size());
+  r.model_bytes = hyperstream::config::PrototypeMemoryStorageBytes(Dim, kLanguages) + sizeof(Encoder);
+  std::size_t k = 0;
+  r.samples = Measure(s, [&](volatile std::uint64_t* sink) {
+    encode(&enc, test[k++ % test.size()], &hv);
+    *sink ^= model.Classify(hv);
+  });
+  return r;
+}
+
+// -----------------------------
+// Time-series anomaly detection
+// -----------------------------
+
+constexpr std::size_t kPeriod = 64;
+constexpr std::size_t kWindow = 16;
+constexpr std::size_t kPhases = kPeriod / kWindow;
+
+struct Window {
+  double x[kWindow];
+  std::size_t phase;
+  bool anomalous;
+};
+
+static std::vector<Window> make_windows(std::size_t count, double anomaly_rate, Rng* rng) {
+  const double kTwoPi = 6.283185307179586;
+  std::vector<Window> out(count);
+  for (std::size_t w = 0; w < count; ++w) {
+    Window& win = out[w];
+    win.phase = w % kPhases;
+    win.anomalous = rng->Unit() < anomaly_rate;
+    const std::size_t t0 = win.phase * kWindow;
+    for (std::size_t i = 0; i < kWindow; ++i) {
+      const double t = static_cast<double>(t0 + i);
+      win.x[i] = std::sin(kTwoPi * t / static_cast<double>(kPeriod)) + 0.1 * (rng->Unit() - 0.5);
+    }
+    if (win.anomalous) {
+      if (rng->Next() & 1) {
+        for (int n = 0; n < 3; ++n) win.x[rng->Below(kWindow)] += 1.2;  // spikes
+      } else {
+        for (double& x : win.x) x += 0.5;  // level shift
+      }
+    }
+  }
+  return out;
+}
+
+template <std::size_t Dim>
+static AppResult run_anomaly(const Options& s) {
+  using Thermo = hyperstream::encoding::ThermometerEncoder<Dim>;
+  auto thermo = std::make_unique<Thermo>(-2.0, 2.0);
+  auto encode = [&](const Window& w, HyperVector<Dim, bool>* out) {
+    BinaryBundler<Dim> bundler;
+    HyperVector<Dim, bool> level, rotated;
+    for (std::size_t i = 0; i < kWindow; ++i) {
+      thermo->Encode(w.x[i], &level);
+      hyperstream::core::PermuteRotate(level, i, &rotated);
+      bundler.Accumulate(rotated);
+    }
+    bundler.Finalize(out);
+  };
+
+  Rng rng{0xa11ce5ULL};
+  HyperVector<Dim, bool> hv;
+  auto train = std::make_unique<ClusterMemory<Dim, kPhases>>();
+  for (const Window& w : make_windows(512, 0.0, &rng)) {
+    encode(w, &hv);
+    (void)train->Update(w.phase, hv);
+  }
+  PrototypeMemory<Dim, kPhases> model;
+  for (std::size_t p = 0; p < kPhases; ++p) {
+    train->Finalize(p, &hv);
+    (void)model.Learn(p, hv);
+  }
+  auto score = [&](const Window& w) {
+    encode(w, &hv);
+    return hyperstream::core::HammingDistance(hv, model.data()[w.phase].hv);
+  };
+  // Threshold: worst normal distance on a held-out calibration stream, plus 10%.
+  std::size_t threshold = 0;
+  for (const Window& w : make_windows(256, 0.0, &rng)) threshold = std::max(threshold, score(w));
+  threshold += threshold / 10;
+
+  const auto test = make_windows(1024, 0.1, &rng);
+  std::size_t correct = 0;
+  for (const Window& w : test) correct += (score(w) > threshold) == w.anomalous;
+
+  AppResult r;
+  r.classes = 2;
+  r.events_per_iter = kWindow;
+  r.accuracy = static_cast<double>(correct) / static_cast<double>(test.size());
+  r.model_bytes = hyperstream::config::PrototypeMemoryStorageBytes(Dim, kPhases) + sizeof(Thermo);
+  std::size_t k = 0;
+  r.samples = Measure(s, [&](volatile std::uint64_t* sink) {
+    *sink ^= score(test[k++ % test.size()]) > threshold;
+  });
+  return r;
+}
+
+// -----------------------------
+// Record classification (role binding)
+// -----------------------------
+
+constexpr std::size_t kFields = 8;
+constexpr std::size_t kVocab = 16;
+constexpr std::size_t kClasses = 6;
+
+struct RecordRow {
+  std::size_t values[kFields];
+  std::uint64_t label;
+};
+
+static std::vector<RecordRow> make_records(std::size_t count, Rng* rng) {
+  static const auto protos = [] {
+    Rng prng{0xc1a55ULL};
+    std::vector<std::vector<std::size_t>> p(kClasses, std::vector<std::size_t>(kFields));
+    for (auto& c : p) {
+      for (auto& v : c) v = prng.Below(kVocab);
+    }
+    return p;
+  }();
+  std::vector<RecordRow> out(count);
+  for (auto& row : out) {
+    row.label = rng->Below(kClasses);
+    for (std::size_t f = 0; f < kFields; ++f) {
+      row.values[f] = (rng->Unit() < 0.6) ? protos[row.label][f] : rng->Below(kVocab);
+    }
+  }
+  return out;
+}
+
+template <std::size_t Dim>
+static AppResult run_records(const Options& s) {
+  hyperstream::encoding::SymbolEncoder<Dim> sym(0x5eed5eedULL);
+  std::vector<HyperVector<Dim, bool>> roles(kFields);
+  std::vector<std::string> value_names(kVocab);
+  for (std::size_t f = 0; f < kFields; ++f) sym.EncodeToken("field" + std::to_string(f), &roles[f]);
+  for (std::size_t v = 0; v < kVocab; ++v) value_names[v] = "value" + std::to_string(v);
+
+  auto encode = [&](const RecordRow& row, HyperVector<Dim, bool>* out) {
+    BinaryBundler<Dim> bundler;
+    HyperVector<Dim, bool> value, bound;
+    for (std::size_t f = 0; f < kFields; ++f) {
+      sym.EncodeToken(value_names[row.values[f]], &value);
+      hyperstream::core::Bind(roles[f], value, &bound);
+      bundler.Accumulate(bound);
+    }
+    bundler.Finalize(out);
+  };
+
+  Rng rng{0x4ec04dULL};
+  HyperVector<Dim, bool> hv;
+  auto train = std::make_unique<ClusterMemory<Dim, kClasses>>();
+  for (const RecordRow& row : make_records(600, &rng)) {
+    encode(row, &hv);
+    (void)train->Update(row.label, hv);
+  }
+  PrototypeMemory<Dim, kClasses> model;
+  for (std::size_t c = 0; c < kClasses; ++c) {
+    train->Finalize(c, &hv);
+    (void)model.Learn(c, hv);
+  }
+
+  const auto test = make_records(1024, &rng);
+  std::size_t correct = 0;
+  for (const RecordRow& row : test) {
+    encode(row, &hv);
+    correct += model.Classify(hv) == row.label;
+  }
+
+  AppResult r;
+  r.classes = kClasses;
+  r.events_per_iter = 1;
+  r.accuracy = static_cast<double>(correct) / static_cast<double>(test.size());
+  r.model_bytes = hyperstream::config::PrototypeMemoryStorageBytes(Dim, kClasses) +
+                  kFields * hyperstream::config::BinaryHyperVectorStorageBytes(Dim);
+  std::size_t k = 0;
+  r.samples = Measure(s, [&](volatile std::uint64_t* sink) {
+    encode(test[k++ % test.size()], &hv);
+    *sink ^= model.Classify(hv);
+  });
+  return r;
+}
+
+template <std::size_t Dim>
+static void run_one_dim(const Options& s) {
+  report(s, "App/langid", Dim, run_langid<Dim>(s));
+  report(s, "App/anomaly", Dim, run_anomaly<Dim>(s));
+  report(s, "App/records", Dim, run_records<Dim>(s));
+}
+
+} // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  setvbuf(stderr, nullptr, _IONBF, 0);
+
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  run_one_dim<2048>(s);
+  run_one_dim<10000>(s);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+} catch (...) {
+  std::fprintf(stderr, "ERROR: unknown\n");
+  return EXIT_FAILURE;
+}
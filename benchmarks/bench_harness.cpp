@@ -0,0 +1,344 @@
+// Shared benchmark harness implementation (see bench_harness.hpp).
+
+#include "bench_harness.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace hyperstream {
+namespace bench {
+
+// -----------------------------
+// CLI
+// -----------------------------
+
+bool Options::HasFlag(const char* flag) const {
+  for (const auto& a : extra) {
+    if (a == flag) return true;
+  }
+  return false;
+}
+
+const char* Options::FlagValue(const char* key, const char* fallback) const {
+  const std::size_t n = std::strlen(key);
+  for (const auto& a : extra) {
+    if (a.size() > n && a.compare(0, n, key) == 0 && a[n] == '=') return a.c_str() + n + 1;
+  }
+  return fallback;
+}
+
+Options ParseArgs(int argc, char** argv, Options defaults) {
+  Options s = std::move(defaults);
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    if (std::strncmp(a, "--warmup_ms=", 12) == 0) {
+      s.warmup_ms = std::max(0, std::atoi(a + 12));
+    } else if (std::strncmp(a, "--measure_ms=", 13) == 0) {
+      s.measure_ms = std::max(1, std::atoi(a + 13));
+    } else if (std::strncmp(a, "--samples=", 10) == 0) {
+      s.samples = std::max(1, std::atoi(a + 10));
+    } else if (std::strcmp(a, "--json") == 0) {
+      s.json = true;
+    } else if (std::strncmp(a, "--pin_cpu=", 10) == 0) {
+      s.pin_cpu = std::atoi(a + 10);
+    } else if (std::strcmp(a, "--perf_counters") == 0) {
+      s.perf_counters = true;
+    } else {
+      s.extra.emplace_back(a);
+    }
+  }
+  if (s.pin_cpu >= 0 && !PinToCpu(s.pin_cpu)) {
+    std::fprintf(stderr, "#pin_cpu=%d unsupported or refused; running unpinned\n", s.pin_cpu);
+  }
+  if (s.perf_counters && !PerfCounters::Instance().available()) {
+    std::fprintf(stderr, "#perf_counters unavailable (non-Linux or perf_event_paranoid); omitting\n");
+    s.perf_counters = false;
+  }
+  return s;
+}
+
+bool PinToCpu(int cpu) {
+  if (cpu < 0) return false;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+  if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) return false;
+  return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#else
+  return false;  // macOS exposes only affinity hints; treat as unsupported
+#endif
+}
+
+// -----------------------------
+// perf_event_open counters
+// -----------------------------
+
+PerfCounters& PerfCounters::Instance() {
+  static PerfCounters inst;
+  return inst;
+}
+
+#if defined(__linux__)
+namespace {
+int OpenCounter(std::uint32_t type, std::uint64_t config) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  fds_[0] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[1] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[2] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  fds_[3] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  // Cycles and instructions are the minimum useful set; LLC/branch misses may be absent in VMs.
+  available_ = fds_[0] >= 0 && fds_[1] >= 0;
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0) close(fd);
+  }
+}
+
+void PerfCounters::Start() {
+  for (int fd : fds_) {
+    if (fd < 0) continue;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+PerfCounts PerfCounters::Stop() {
+  std::uint64_t v[4] = {0, 0, 0, 0};
+  for (int i = 0; i < 4; ++i) {
+    if (fds_[i] < 0) continue;
+    ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fds_[i], &v[i], sizeof(v[i])) != static_cast<ssize_t>(sizeof(v[i]))) v[i] = 0;
+  }
+  PerfCounts c;
+  c.valid = available_;
+  c.cycles = v[0];
+  c.instructions = v[1];
+  c.llc_misses = v[2];
+  c.branch_misses = v[3];
+  return c;
+}
+#else
+PerfCounters::PerfCounters() = default;
+PerfCounters::~PerfCounters() = default;
+void PerfCounters::Start() {}
+PerfCounts PerfCounters::Stop() { return PerfCounts{}; }
+#endif
+
+// -----------------------------
+// Statistics
+// -----------------------------
+
+namespace {
+double MedianOfSorted(const std::vector<double>& v) {
+  const std::size_t n = v.size();
+  if (n == 0) return 0.0;
+  return (n % 2) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+}  // namespace
+
+Summary Summarize(std::vector<double> v) {
+  Summary s;
+  s.n = v.size();
+  if (v.empty()) return s;
+  std::sort(v.begin(), v.end());
+  const double n = static_cast<double>(v.size());
+  s.mean = std::accumulate(v.begin(), v.end(), 0.0) / n;
+  s.median = MedianOfSorted(v);
+  double ss = 0.0;
+  for (double x : v) ss += (x - s.mean) * (x - s.mean);
+  s.stdev = std::sqrt(ss / n);
+  std::vector<double> dev(v.size());
+  for (std::size_t i = 0; i < v.size(); ++i) dev[i] = std::fabs(v[i] - s.median);
+  std::sort(dev.begin(), dev.end());
+  s.mad = MedianOfSorted(dev);
+  // Ranks n/2 -/+ 1.96*sqrt(n)/2 (normal approximation to Binomial(n, 0.5)), 1-based.
+  const double half = 0.98 * std::sqrt(n);
+  const long lo = std::max(1L, static_cast<long>(std::floor(n / 2.0 - half)));
+  const long hi = std::min(static_cast<long>(v.size()), static_cast<long>(std::ceil(n / 2.0 + 1.0 + half)));
+  s.ci_low = v[static_cast<std::size_t>(lo - 1)];
+  s.ci_high = v[static_cast<std::size_t>(hi - 1)];
+  return s;
+}
+
+// -----------------------------
+// Record
+// -----------------------------
+
+namespace {
+std::string FixedString(double v, int precision) {
+  if (!std::isfinite(v)) return "0";
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%.*f", precision, v);
+  return buf;
+}
+
+std::string JsonEscape(const std::string& s) {
+  std::string out;
+  out.reserve(s.size());
+  for (char c : s) {
+    if (c == '"' || c == '\\') out.push_back('\\');
+    out.push_back(c);
+  }
+  return out;
+}
+}  // namespace
+
+Record::Record(std::string name) : name_(std::move(name)) {}
+
+Record& Record::Add(const char* key, std::size_t v) {
+  fields_.push_back(Field{key, std::to_string(v), false, false, {}});
+  return *this;
+}
+
+Record& Record::Add(const char* key, int v) {
+  fields_.push_back(Field{key, std::to_string(v), false, false, {}});
+  return *this;
+}
+
+Record& Record::Add(const char* key, double v, int precision) {
+  fields_.push_back(Field{key, FixedString(v, precision), false, false, {}});
+  return *this;
+}
+
+Record& Record::Add(const char* key, const char* v) {
+  fields_.push_back(Field{key, v, true, false, {}});
+  return *this;
+}
+
+Record& Record::AddBool(const char* key, bool v) {
+  fields_.push_back(Field{key, v ? "true" : "false", false, false, {}});
+  return *this;
+}
+
+Record& Record::Add(const char* key, const Summary& s, int precision) {
+  Field f{key, std::string(), false, true, {}};
+  f.children = {{"mean", FixedString(s.mean, precision)},
+                {"median", FixedString(s.median, precision)},
+                {"stdev", FixedString(s.stdev, precision)},
+                {"mad", FixedString(s.mad, precision)},
+                {"ci_low", FixedString(s.ci_low, precision)},
+                {"ci_high", FixedString(s.ci_high, precision)}};
+  fields_.push_back(std::move(f));
+  return *this;
+}
+
+Record& Record::Add(const PerfCounts& c, std::size_t iters) {
+  if (!c.valid) return *this;
+  Add("cycles", static_cast<std::size_t>(c.cycles));
+  Add("instructions", static_cast<std::size_t>(c.instructions));
+  Add("llc_misses", static_cast<std::size_t>(c.llc_misses));
+  Add("branch_misses", static_cast<std::size_t>(c.branch_misses));
+  const double it = static_cast<double>(iters ? iters : 1);
+  Add("cycles_per_iter", static_cast<double>(c.cycles) / it, 1);
+  Add("ipc", c.cycles ? static_cast<double>(c.instructions) / static_cast<double>(c.cycles) : 0.0, 3);
+  return *this;
+}
+
+std::string Record::Csv() const {
+  std::string out = name_;
+  for (const auto& f : fields_) {
+    if (f.nested) {
+      for (const auto& ch : f.children) out += "," + f.key + "_" + ch.first + "=" + ch.second;
+    } else {
+      out += "," + f.key + "=" + f.value;
+    }
+  }
+  return out;
+}
+
+std::string Record::Json() const {
+  std::string out = "{\"name\":\"" + JsonEscape(name_) + "\"";
+  for (const auto& f : fields_) {
+    out += ",\"" + f.key + "\":";
+    if (f.nested) {
+      out += "{";
+      for (std::size_t i = 0; i < f.children.size(); ++i) {
+        if (i) out += ",";
+        out += "\"" + f.children[i].first + "\":" + f.children[i].second;
+      }
+      out += "}";
+    } else if (f.quoted) {
+      out += "\"" + JsonEscape(f.value) + "\"";
+    } else {
+      out += f.value;
+    }
+  }
+  out += "}";
+  return out;
+}
+
+void Record::Print(bool json) const {
+  const std::string line = json ? Json() : Csv();
+  std::printf("%s\n", line.c_str());
+  std::fflush(stdout);
+}
+
+// -----------------------------
+// Shared reporters
+// -----------------------------
+
+void ReportThroughput(const Options& opts, const char* name, std::size_t dim_bits,
+                      std::size_t bytes_per_iter, const std::vector<Sample>& samples) {
+  std::vector<double> gbps_v;
+  gbps_v.reserve(samples.size());
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const Sample& smp = samples[si];
+    const double total_bytes = static_cast<double>(bytes_per_iter) * static_cast<double>(smp.iters);
+    const double gbps = (total_bytes / smp.secs) / 1e9;
+    gbps_v.push_back(gbps);
+    Record r(name);
+    r.Add("dim_bits", dim_bits).Add("bytes_per_iter", bytes_per_iter);
+    if (!opts.json && opts.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("gb_per_sec", gbps, 3);
+    if (opts.json) {
+      r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", opts.warmup_ms).Add("measure_ms", opts.measure_ms);
+    }
+    r.Add(smp.counters, smp.iters);
+    r.Print(opts.json);
+  }
+  if (opts.samples > 1) {
+    Record agg(name);
+    agg.Add("dim_bits", dim_bits).Add("bytes_per_iter", bytes_per_iter)
+       .AddBool("aggregate", true).Add("samples", opts.samples)
+       .Add("gb_per_sec", Summarize(gbps_v), 3)
+       .Add("warmup_ms", opts.warmup_ms).Add("measure_ms", opts.measure_ms);
+    agg.Print(opts.json);
+  }
+}
+
+}  // namespace bench
+}  // namespace hyperstream
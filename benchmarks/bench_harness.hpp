@@ -0,0 +1,201 @@
+#pragma once
+
+// Shared benchmark harness for the HyperStream microbenchmarks.
+// - Common CLI: --warmup_ms=, --measure_ms=, --samples=, --json, --pin_cpu=, --perf_counters
+//   (bench-specific flags are left in Options::extra and queried with HasFlag/FlagValue).
+// - Timed loops with batched clock reads, optional warmup, repeated samples.
+// - Robust summaries: mean/stdev plus median, MAD and a distribution-free 95% CI of the median.
+// - Optional per-sample hardware counters via Linux perf_event_open (cycles, instructions,
+//   LLC misses, branch misses); silently unavailable elsewhere or when the kernel refuses.
+// - One Record type renders both the legacy CSV lines (name,key=value,...) and NDJSON rows, so
+//   field names stay identical between the two and match ci/ndjson_schema.
+// - ThreadExecutor: std::thread adapter for the library's task executors (memory/executor.hpp).
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace hyperstream {
+namespace bench {
+
+// Escapes `p` and clobbers memory so the optimizer cannot hoist loop-invariant work (e.g. a
+// distance over constant inputs) out of the timed batch loop.
+inline void Escape(const void* p) {
+#if defined(_MSC_VER)
+  static const void* volatile escape_sink = nullptr;
+  escape_sink = p;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r"(p) : "memory");
+#endif
+}
+
+struct Options {
+  int warmup_ms = 0;
+  int measure_ms = 300;
+  int samples = 1;
+  bool json = false;
+  int pin_cpu = -1;            // <0: do not pin
+  bool perf_counters = false;  // Linux only; ignored when unavailable
+  std::vector<std::string> extra;  // arguments not consumed by the harness
+
+  bool HasFlag(const char* flag) const;
+  // Value of "--key=value" from extra, or `fallback` when absent.
+  const char* FlagValue(const char* key, const char* fallback) const;
+};
+
+// Parses the common flags over `defaults` and applies --pin_cpu. Unknown arguments go to extra.
+Options ParseArgs(int argc, char** argv, Options defaults = Options{});
+
+// Pins the calling thread to `cpu`. Returns false where unsupported or refused.
+bool PinToCpu(int cpu);
+
+struct PerfCounts {
+  bool valid = false;
+  std::uint64_t cycles = 0;
+  std::uint64_t instructions = 0;
+  std::uint64_t llc_misses = 0;
+  std::uint64_t branch_misses = 0;
+};
+
+// Process-wide counter set, opened on first use. Counters are enabled only around measured runs.
+class PerfCounters {
+ public:
+  static PerfCounters& Instance();
+  bool available() const noexcept { return available_; }
+  void Start();
+  PerfCounts Stop();
+
+ private:
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  int fds_[4] = {-1, -1, -1, -1};
+  bool available_ = false;
+};
+
+struct Sample {
+  std::size_t iters = 0;
+  double secs = 0.0;
+  PerfCounts counters;
+};
+
+struct Summary {
+  std::size_t n = 0;
+  double mean = 0.0;
+  double median = 0.0;
+  double stdev = 0.0;  // population stdev (matches the historical aggregate rows)
+  double mad = 0.0;    // median absolute deviation (unscaled)
+  double ci_low = 0.0;   // 95% CI of the median from binomial order statistics;
+  double ci_high = 0.0;  // collapses to [min, max] for small n
+};
+
+Summary Summarize(std::vector<double> values);
+
+// Runs fn(&sink) until at least min_ms elapsed. The clock is read once per batch; batches grow
+// geometrically until one takes ~100 us so cheap kernels are not dominated by clock overhead.
+template <typename Fn>
+Sample RunForMs(Fn&& fn, int min_ms, bool with_counters = false) {
+  using clock = std::chrono::steady_clock;
+  static volatile std::uint64_t sink = 0;
+  const auto budget = std::chrono::milliseconds(min_ms);
+  const auto batch_target = std::chrono::microseconds(100);
+  PerfCounters* perf = with_counters ? &PerfCounters::Instance() : nullptr;
+  if (perf) perf->Start();
+  const auto t0 = clock::now();
+  auto now = t0;
+  std::size_t iters = 0;
+  std::size_t batch = 1;
+  do {
+    const auto b0 = now;
+    for (std::size_t i = 0; i < batch; ++i) {
+      fn(&sink);
+      Escape(&fn);
+    }
+    iters += batch;
+    now = clock::now();
+    if (now - b0 < batch_target) batch *= 2;
+  } while (now - t0 < budget);
+  Sample s;
+  s.iters = iters;
+  s.secs = std::chrono::duration<double>(now - t0).count();
+  if (perf) s.counters = perf->Stop();
+  return s;
+}
+
+// Optional warmup followed by opts.samples timed runs of opts.measure_ms each.
+template <typename Fn>
+std::vector<Sample> Measure(const Options& opts, Fn&& fn) {
+  if (opts.warmup_ms > 0) (void)RunForMs(fn, opts.warmup_ms);
+  std::vector<Sample> out;
+  out.reserve(static_cast<std::size_t>(opts.samples));
+  for (int i = 0; i < opts.samples; ++i) out.push_back(RunForMs(fn, opts.measure_ms, opts.perf_counters));
+  return out;
+}
+
+// Ordered key/value record rendered as CSV ("name,k=v,...") or a single-line JSON object.
+class Record {
+ public:
+  explicit Record(std::string name);
+
+  Record& Add(const char* key, std::size_t v);
+  Record& Add(const char* key, int v);
+  Record& Add(const char* key, double v, int precision);
+  Record& Add(const char* key, const char* v);
+  Record& AddBool(const char* key, bool v);
+  // Nested {"mean","median","stdev","mad","ci_low","ci_high"}; flattened to key_mean=... in CSV.
+  Record& Add(const char* key, const Summary& s, int precision);
+  // cycles/instructions/llc_misses/branch_misses (+ per-iteration cycles and IPC) when valid.
+  Record& Add(const PerfCounts& c, std::size_t iters);
+
+  std::string Csv() const;
+  std::string Json() const;
+  void Print(bool json) const;
+
+ private:
+  struct Field {
+    std::string key;
+    std::string value;  // already formatted
+    bool quoted = false;  // string value: quoted in JSON, bare in CSV
+    bool nested = false;
+    std::vector<std::pair<std::string, std::string>> children;
+  };
+  std::string name_;
+  std::vector<Field> fields_;
+};
+
+// Emits one row per sample for a streaming kernel (name,dim_bits,bytes_per_iter,iters,secs,
+// gb_per_sec[,sample_index,warmup_ms,measure_ms][,counters]) plus an aggregate row when
+// opts.samples > 1. This is the shared row shape of bind/hamming/permute benches.
+void ReportThroughput(const Options& opts, const char* name, std::size_t dim_bits,
+                      std::size_t bytes_per_iter, const std::vector<Sample>& samples);
+
+// Executor running tasks pulled from a shared counter on `threads` workers (the calling thread
+// included); `threads` <= 1 runs everything on the calling thread.
+struct ThreadExecutor {
+  std::size_t threads = 1;
+  template <typename Fn>
+  void operator()(std::size_t count, Fn&& fn) const {
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+      for (std::size_t t = next++; t < count; t = next++) fn(t);
+    };
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+  }
+};
+
+}  // namespace bench
+}  // namespace hyperstream
@@ -1,9 +1,11 @@
 // HyperStream Bind microbenchmark (no external deps)
 // Measures throughput of core::Bind (scalar) vs available SIMD backends (SSE2/AVX2)
 // across a set of fixed hypervector dimensions.
+// For dimensions with compile-time-specialized kernels (backend::IsFixedDim), <backend>_generic rows
+// run the runtime word_count loop on the same data so the specialization speedup is visible.
 // Output: CSV-like lines per benchmark: name,dimension_bits,bytes_per_iter,iterations,seconds,gb_per_sec
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
 
-#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -19,6 +21,7 @@
 #endif
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/core/ops.hpp"
+#include "bench_harness.hpp"
 
 using hyperstream::core::HyperVector;
 using hyperstream::core::Bind;
@@ -29,6 +32,8 @@ using hyperstream::backend::avx2::BindAVX2;
 
 namespace {
 
+using hyperstream::bench::Options;
+
 template <std::size_t Dim>
 static inline std::size_t bytes_per_iteration() {
   constexpr std::size_t words = HyperVector<Dim, bool>::WordCount();
@@ -58,34 +63,12 @@ static inline void BindAVX2_Ref(const HyperVector<Dim, bool>& a,
 }
 #endif
 
-// Basic steady-state loop running for at least min_ms milliseconds.
-// Returns pair {iterations, seconds}.
-template <typename Fn>
-static std::pair<std::size_t, double> run_for_ms(Fn&& fn, int min_ms) {
-  using clock = std::chrono::steady_clock;
-  const auto t0 = clock::now();
-  std::size_t iters = 0;
-  volatile std::uint64_t sink = 0; // prevent over-optimization
-  do {
-    fn(&sink);
-    ++iters;
-  } while (std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - t0).count() < min_ms);
-  const double secs = std::chrono::duration<double>(clock::now() - t0).count();
-  // Print sink occasionally to avoid optimizing everything away (still minimal overhead)
-  if ((iters & 0xff) == 0) std::fprintf(stderr, "#sink=%llu\n", (unsigned long long)sink);
-  return {iters, secs};
-}
-
 // Benchmark a single implementation identified by name for a fixed dimension.
 // The callable do_bind(out_sink*) must perform one Bind over initialized a,b,out.
 template <std::size_t Dim, typename DoBind>
-static void bench_impl(const char* name, DoBind&& do_bind) {
-  const std::size_t kBytesPerIter = bytes_per_iteration<Dim>();
-  auto [iters, secs] = run_for_ms(do_bind, 300); // ~300ms per case
-  const double total_bytes = static_cast<double>(kBytesPerIter) * static_cast<double>(iters);
-  const double gbps = (total_bytes / secs) / 1e9; // GB/s
-  std::printf("%s,dim_bits=%zu,bytes_per_iter=%zu,iters=%zu,secs=%.6f,gb_per_sec=%.3f\n",
-              name, Dim, kBytesPerIter, iters, secs, gbps);
+static void bench_impl(const Options& opts, const char* name, DoBind&& do_bind) {
+  hyperstream::bench::ReportThroughput(opts, name, Dim, bytes_per_iteration<Dim>(),
+                                       hyperstream::bench::Measure(opts, do_bind));
 }
 
 // Helper to initialize test vectors deterministically.
@@ -99,54 +82,77 @@ static void init_vectors(HyperVector<Dim, bool>* a, HyperVector<Dim, bool>* b) {
 
 // Bench a single dimension for scalar and available SIMD backends.
 template <std::size_t D>
-static void run_one() {
+static void run_one(const Options& opts) {
   HyperVector<D, bool> a, b, out;
   init_vectors(&a, &b);
+  constexpr bool kFixed = hyperstream::backend::IsFixedDim(D);
+  constexpr std::size_t kWords = HyperVector<D, bool>::WordCount();
+  (void)kFixed;
+  (void)kWords;
 
   // A/B-1 ordering: AVX2 first, then core, then SSE2. Also add AVX2_Ref for A/B-2.
   #if defined(__AVX2__)
-  bench_impl<D>("Bind/avx2", [&](volatile std::uint64_t* sink) {
+  bench_impl<D>(opts, "Bind/avx2", [&](volatile std::uint64_t* sink) {
     BindAVX2(a, b, &out);
     *sink ^= a.Words()[0];
   });
-  bench_impl<D>("Bind/avx2_ref", [&](volatile std::uint64_t* sink) {
+  bench_impl<D>(opts, "Bind/avx2_ref", [&](volatile std::uint64_t* sink) {
     BindAVX2_Ref(a, b, &out);
     *sink ^= a.Words()[0];
   });
+  if constexpr (kFixed) {
+    bench_impl<D>(opts, "Bind/avx2_generic", [&](volatile std::uint64_t* sink) {
+      hyperstream::backend::avx2::BindWords(a.Words().data(), b.Words().data(), out.Words().data(), kWords);
+      *sink ^= a.Words()[0];
+    });
+  }
   #endif
 
-  bench_impl<D>("Bind/core", [&](volatile std::uint64_t* sink) {
+  bench_impl<D>(opts, "Bind/core", [&](volatile std::uint64_t* sink) {
     Bind(a, b, &out);
     *sink ^= a.Words()[0];
   });
 
 #if HS_X86_ARCH
-  bench_impl<D>("Bind/sse2", [&](volatile std::uint64_t* sink) {
+  bench_impl<D>(opts, "Bind/sse2", [&](volatile std::uint64_t* sink) {
     BindSSE2(a, b, &out);
     *sink ^= a.Words()[0];
   });
+  if constexpr (kFixed) {
+    bench_impl<D>(opts, "Bind/sse2_generic", [&](volatile std::uint64_t* sink) {
+      hyperstream::backend::sse2::BindWords(a.Words().data(), b.Words().data(), out.Words().data(), kWords);
+      *sink ^= a.Words()[0];
+    });
+  }
 #endif
 #if HS_ARM64_ARCH
-  bench_impl<D>("Bind/neon", [&](volatile std::uint64_t* sink) {
+  bench_impl<D>(opts, "Bind/neon", [&](volatile std::uint64_t* sink) {
     hyperstream::backend::neon::BindNEON(a, b, &out);
     *sink ^= a.Words()[0];
   });
+  if constexpr (kFixed) {
+    bench_impl<D>(opts, "Bind/neon_generic", [&](volatile std::uint64_t* sink) {
+      hyperstream::backend::neon::BindWords(a.Words().data(), b.Words().data(), out.Words().data(), kWords);
+      *sink ^= a.Words()[0];
+    });
+  }
 #endif
 
 }
 
 } // namespace
 
-int main() {
+int main(int argc, char** argv) {
+  const Options opts = hyperstream::bench::ParseArgs(argc, argv);
   // Representative sizes (bits)
-  run_one<1024>();
-  run_one<2048>();
-  run_one<4096>();
-  run_one<8192>();
-  run_one<10000>();
-  run_one<16384>();
-  run_one<65536>();
-  run_one<262144>();
-  run_one<1048576>();
+  run_one<1024>(opts);
+  run_one<2048>(opts);
+  run_one<4096>(opts);
+  run_one<8192>(opts);
+  run_one<10000>(opts);
+  run_one<16384>(opts);
+  run_one<65536>(opts);
+  run_one<262144>(opts);
+  run_one<1048576>(opts);
   return 0;
 }
@@ -0,0 +1,138 @@
+// HyperStream BinaryBundler microbenchmark
+// Measures Accumulate throughput, Finalize cost with and without per-window telemetry
+// (saturation count and near-tie margin histogram), and reports telemetry for a sweep of
+// window sizes over a noisy stream so window length / counter width can be chosen from data.
+// Output lines:
+//   Bundler/accumulate,dim_bits,iters,secs,ns_per_op,gb_per_sec
+//   Bundler/finalize|finalize_stats,dim_bits,iters,secs,ns_per_op
+//   Bundler/window,dim_bits,window,flip_prob,saturated_frac,tie_frac,margin_lt4_frac,margin_lt64_frac
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::HyperVector;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+
+// Per-sample ns/op rows (+ aggregate when samples > 1) for latency-style cases.
+static void report_ns_per_op(const Options& opts, const char* name, std::size_t dim_bits,
+                             const std::vector<hyperstream::bench::Sample>& samples,
+                             std::size_t bytes_per_op = 0) {
+  std::vector<double> ns_v;
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double ns = smp.secs * 1e9 / static_cast<double>(smp.iters);
+    ns_v.push_back(ns);
+    Record r(name);
+    r.Add("dim_bits", dim_bits);
+    if (!opts.json && opts.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("ns_per_op", ns, 1);
+    if (bytes_per_op) {
+      r.Add("gb_per_sec", (static_cast<double>(bytes_per_op) * smp.iters / smp.secs) / 1e9, 3);
+    }
+    if (opts.json) {
+      r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", opts.warmup_ms).Add("measure_ms", opts.measure_ms);
+    }
+    r.Add(smp.counters, smp.iters);
+    r.Print(opts.json);
+  }
+  if (opts.samples > 1) {
+    Record agg(name);
+    agg.Add("dim_bits", dim_bits).AddBool("aggregate", true).Add("samples", opts.samples)
+       .Add("ns_per_op", hyperstream::bench::Summarize(ns_v), 1);
+    agg.Print(opts.json);
+  }
+}
+
+template <std::size_t Dim>
+static void random_vector(std::mt19937_64* rng, HyperVector<Dim, bool>* hv) {
+  auto& w = hv->Words();
+  for (auto& x : w) x = (*rng)();
+  constexpr std::size_t extra_bits = HyperVector<Dim, bool>::WordCount() * 64ULL - Dim;
+  if constexpr (extra_bits > 0) w.back() &= ~0ULL >> extra_bits;
+}
+
+template <std::size_t Dim>
+static void bench_throughput(const Options& opts) {
+  std::mt19937_64 rng(0xB0DE1ULL);
+  constexpr std::size_t kPool = 64;
+  std::vector<HyperVector<Dim, bool>> pool(kPool);
+  for (auto& hv : pool) random_vector(&rng, &hv);
+
+  BinaryBundler<Dim> bundler;
+  HyperVector<Dim, bool> out;
+  std::size_t k = 0;
+  // Input bytes only; the counter array traffic is what saturating adds pay for.
+  report_ns_per_op(opts, "Bundler/accumulate", Dim, Measure(opts, [&](volatile std::uint64_t* sink) {
+    bundler.Accumulate(pool[k++ & (kPool - 1)]);
+    *sink ^= k;
+  }), Dim / 8);
+  report_ns_per_op(opts, "Bundler/finalize", Dim, Measure(opts, [&](volatile std::uint64_t* sink) {
+    bundler.Finalize(&out);
+    *sink ^= out.Words()[0];
+  }));
+  typename BinaryBundler<Dim>::Stats stats;
+  report_ns_per_op(opts, "Bundler/finalize_stats", Dim, Measure(opts, [&](volatile std::uint64_t* sink) {
+    bundler.Finalize(&out, &stats);
+    *sink ^= out.Words()[0] ^ stats.ties();
+  }));
+}
+
+// Stream of noisy copies of one base vector (each bit flipped with probability p); reports how the
+// counter population evolves with window length.
+template <std::size_t Dim>
+static void bench_window_sweep(const Options& opts, double flip_prob) {
+  std::mt19937_64 rng(0x5EEDULL);
+  HyperVector<Dim, bool> base;
+  random_vector(&rng, &base);
+  std::bernoulli_distribution flip(flip_prob);
+  constexpr std::size_t kPool = 4093;  // prime, so long windows do not replay an exact period
+  std::vector<HyperVector<Dim, bool>> pool(kPool);
+  for (auto& hv : pool) {
+    hv = base;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      if (flip(rng)) hv.SetBit(i, !hv.GetBit(i));
+    }
+  }
+
+  BinaryBundler<Dim> bundler;
+  HyperVector<Dim, bool> out;
+  typename BinaryBundler<Dim>::Stats stats;
+  std::size_t done = 0;
+  for (std::size_t window : {16u, 256u, 4096u, 32768u, 65536u, 262144u}) {
+    for (; done < window; ++done) bundler.Accumulate(pool[done % kPool]);
+    bundler.Finalize(&out, &stats);
+    const double d = static_cast<double>(Dim);
+    Record r("Bundler/window");
+    r.Add("dim_bits", Dim).Add("window", window).Add("flip_prob", flip_prob, 2)
+     .Add("saturated_frac", stats.SaturatedFraction(), 4)
+     .Add("tie_frac", static_cast<double>(stats.ties()) / d, 4)
+     .Add("margin_lt4_frac", static_cast<double>(stats.MarginBelowPow2(2)) / d, 4)
+     .Add("margin_lt64_frac", static_cast<double>(stats.MarginBelowPow2(6)) / d, 4);
+    r.Print(opts.json);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const Options opts = hyperstream::bench::ParseArgs(argc, argv);
+  bench_throughput<1024>(opts);
+  bench_throughput<10000>(opts);
+  bench_throughput<65536>(opts);
+  bench_window_sweep<10000>(opts, 0.45);
+  bench_window_sweep<10000>(opts, 0.30);
+  return 0;
+}
@@ -2,6 +2,20 @@
 // Measures ClusterMemory<Dim,Capacity>::Update() and Finalize() throughput.
 // Reports (CSV default): name,dim_bits,capacity,updates,update_iters,update_secs,updates_per_sec,finalize_iters,finalize_secs,finalizes_per_sec
 // NDJSON mode (--json): one line per sample with fields incl. sample_index,warmup_ms,measure_ms
+// --classify: Cluster/classify rows (dim_bits,capacity,path,iters,queries_per_sec) comparing
+//   path=finalize_then_classify (Finalize every cluster into a PrototypeMemory per query),
+//   path=prototype_only (classify against clusters finalized once), path=counter_dot[_selected]
+//   (ClusterMemory::Classify on the counters) and path=binarized[_after_update] (cached prototypes;
+//   the _after_update variants Update one cluster before each query).
+// --retrain [--threads=N]: Cluster/retrain rows (dim_bits,classes,samples,batch,threads,epoch,
+//   mistakes,secs,samples_per_sec), one per epoch of memory::Retrain over a synthetic multi-modal
+//   training set after a one-shot Update pass; epoch=0 is the one-shot model's classification pass.
+// --stream [--threads=N]: Cluster/stream rows (dim_bits,capacity,vectors,mode,threads,iters,
+//   clusters,vectors_per_sec,storage_bytes) for memory::StreamingClusterer over a stream drawn from
+//   32 noisy centers; mode=assign_portable|assign_selected (per-vector Assign, portable or
+//   policy-selected Hamming), assign_refresh1 (centroids re-binarized after every update),
+//   batch (AssignBatch of 256 on N threads), shards (N shards clustered on N threads, then merged).
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
 
 #include <algorithm>
 #include <chrono>
@@ -9,45 +23,32 @@
 #include <cstdio>
 #include <cstdlib>
 #include <exception>
-#include <numeric>
+#include <memory>
+#include <string>
 #include <vector>
-#include <cstring>
-#include <cmath>
 
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
 #include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/clusterer.hpp"
+#include "hyperstream/memory/retrain.hpp"
 #include "hyperstream/config.hpp"
 #include "hyperstream/backend/capability.hpp"
 #include "hyperstream/backend/policy.hpp"
+#include "bench_harness.hpp"
 
 using hyperstream::core::HyperVector;
 using hyperstream::memory::ClusterMemory;
+using hyperstream::memory::PrototypeMemory;
 
 namespace {
 
-struct Settings {
-  int warmup_ms = 0;   // preserve legacy behavior when omitted
-  int measure_ms = 150;
-  int samples = 1;
-  bool json = false;
-};
-
-static Settings ParseArgs(int argc, char** argv) {
-  Settings s;
-  for (int i = 1; i < argc; ++i) {
-    const char* a = argv[i];
-    if (std::strncmp(a, "--warmup_ms=", 12) == 0) {
-      s.warmup_ms = std::atoi(a + 12);
-    } else if (std::strncmp(a, "--measure_ms=", 13) == 0) {
-      s.measure_ms = std::atoi(a + 13);
-    } else if (std::strncmp(a, "--samples=", 10) == 0) {
-      s.samples = std::max(1, std::atoi(a + 10));
-    } else if (std::strncmp(a, "--json", 6) == 0) {
-      s.json = true;
-    }
-  }
-  return s;
-}
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::RunForMs;
+using hyperstream::bench::Summarize;
+using hyperstream::bench::ThreadExecutor;
 
 static inline std::uint64_t splitmix64(std::uint64_t& x) {
   x += 0x9e3779b97f4a7c15ULL;
@@ -71,30 +72,8 @@ static void fill_random(HyperVector<Dim, bool>* hv, std::uint64_t seed) {
   }
 }
 
-template <typename Fn>
-static std::pair<std::size_t, double> run_for_ms(Fn&& fn, int min_ms) {
-  using clock = std::chrono::steady_clock;
-  const auto t0 = clock::now();
-  std::size_t iters = 0;
-  volatile std::uint64_t sink = 0;
-  do {
-    fn(&sink);
-    ++iters;
-  } while (std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - t0).count() < min_ms);
-  const double secs = std::chrono::duration<double>(clock::now() - t0).count();
-  return {iters, secs};
-}
-
-static void print_json_sample(const char* name, std::size_t dim_bits, std::size_t capacity, std::size_t updates,
-                              std::size_t iters_u, double secs_u, double updates_ps,
-                              std::size_t iters_f, double secs_f, double finalizes_ps,
-                              int sample_index, const Settings& s) {
-  std::printf("{\"name\":\"%s\",\"dim_bits\":%zu,\"capacity\":%zu,\"updates\":%zu,\"update_iters\":%zu,\"update_secs\":%.6f,\"updates_per_sec\":%.1f,\"finalize_iters\":%zu,\"finalize_secs\":%.6f,\"finalizes_per_sec\":%.1f,\"sample_index\":%d,\"warmup_ms\":%d,\"measure_ms\":%d}\n",
-              name, dim_bits, capacity, updates, iters_u, secs_u, updates_ps, iters_f, secs_f, finalizes_ps, sample_index, s.warmup_ms, s.measure_ms);
-}
-
 template <std::size_t Dim, std::size_t Capacity>
-static void bench_cluster(const char* name, std::size_t updates, const Settings& s) {
+static void bench_cluster(const char* name, std::size_t updates, const Options& s) {
   ClusterMemory<Dim, Capacity> cmem;
   std::uint64_t seed = 1;
 
@@ -113,65 +92,248 @@ static void bench_cluster(const char* name, std::size_t updates, const Settings&
 
   // Warmup (optional)
   if (s.warmup_ms > 0) {
-    (void)run_for_ms(do_update_loop, s.warmup_ms);
-    (void)run_for_ms(do_finalize_loop, s.warmup_ms);
+    (void)RunForMs(do_update_loop, s.warmup_ms);
+    (void)RunForMs(do_finalize_loop, s.warmup_ms);
   }
 
   std::vector<double> upd_ps_v; upd_ps_v.reserve(static_cast<std::size_t>(s.samples));
   std::vector<double> fin_ps_v; fin_ps_v.reserve(static_cast<std::size_t>(s.samples));
 
   for (int si = 0; si < s.samples; ++si) {
-    auto [iters_u, secs_u] = run_for_ms(do_update_loop, s.measure_ms);
-    auto [iters_f, secs_f] = run_for_ms(do_finalize_loop, s.measure_ms);
+    const auto u = RunForMs(do_update_loop, s.measure_ms, s.perf_counters);
+    const auto f = RunForMs(do_finalize_loop, s.measure_ms);
 
-    const double updates_ps = static_cast<double>(iters_u) * updates / secs_u;
-    const double finalizes_ps = static_cast<double>(iters_f) / secs_f;
+    const double updates_ps = static_cast<double>(u.iters) * updates / u.secs;
+    const double finalizes_ps = static_cast<double>(f.iters) / f.secs;
     upd_ps_v.push_back(updates_ps); fin_ps_v.push_back(finalizes_ps);
 
-    if (s.json) {
-      print_json_sample(name, Dim, Capacity, updates, iters_u, secs_u, updates_ps, iters_f, secs_f, finalizes_ps, si, s);
-    } else {
-      // Emit per-phase early line only for first sample to preserve legacy behavior
-      if (si == 0) {
-        std::printf("%s-update,dim_bits=%zu,capacity=%zu,updates=%zu,update_iters=%zu,update_secs=%.6f,updates_per_sec=%.1f\n",
-                    name, Dim, Capacity, updates, iters_u, secs_u, updates_ps);
-        std::fflush(stdout);
-      }
-      // Combined line
-      if (s.samples == 1) {
-        std::printf("%s,dim_bits=%zu,capacity=%zu,updates=%zu,update_iters=%zu,update_secs=%.6f,updates_per_sec=%.1f,finalize_iters=%zu,finalize_secs=%.6f,finalizes_per_sec=%.1f\n",
-                    name, Dim, Capacity, updates, iters_u, secs_u, updates_ps, iters_f, secs_f, finalizes_ps);
-      } else {
-        std::printf("%s,dim_bits=%zu,capacity=%zu,updates=%zu,sample=%d,update_iters=%zu,update_secs=%.6f,updates_per_sec=%.1f,finalize_iters=%zu,finalize_secs=%.6f,finalizes_per_sec=%.1f\n",
-                    name, Dim, Capacity, updates, si, iters_u, secs_u, updates_ps, iters_f, secs_f, finalizes_ps);
-      }
-      std::fflush(stdout);
+    // Emit per-phase early line only for first sample to preserve legacy behavior
+    if (!s.json && si == 0) {
+      Record early(std::string(name) + "-update");
+      early.Add("dim_bits", Dim).Add("capacity", Capacity).Add("updates", updates)
+           .Add("update_iters", u.iters).Add("update_secs", u.secs, 6).Add("updates_per_sec", updates_ps, 1);
+      early.Print(false);
     }
+    Record r(name);
+    r.Add("dim_bits", Dim).Add("capacity", Capacity).Add("updates", updates);
+    if (!s.json && s.samples > 1) r.Add("sample", si);
+    r.Add("update_iters", u.iters).Add("update_secs", u.secs, 6).Add("updates_per_sec", updates_ps, 1)
+     .Add("finalize_iters", f.iters).Add("finalize_secs", f.secs, 6).Add("finalizes_per_sec", finalizes_ps, 1);
+    if (s.json) r.Add("sample_index", si).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(u.counters, u.iters * updates);  // counters cover the update phase, normalized per update
+    r.Print(s.json);
+  }
+
+  if (s.samples > 1) {
+    Record agg(name);
+    agg.Add("dim_bits", Dim).Add("capacity", Capacity).Add("updates", updates)
+       .AddBool("aggregate", true).Add("samples", s.samples)
+       .Add("updates_per_sec", Summarize(upd_ps_v), 1).Add("finalizes_per_sec", Summarize(fin_ps_v), 1)
+       .Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    agg.Print(s.json);
   }
+}
 
+// One row per sample (+ aggregate when samples > 1) of queries/sec for a classify path.
+static void report_classify(const Options& s, std::size_t dim, std::size_t cap, const char* path,
+                            const std::vector<hyperstream::bench::Sample>& samples) {
+  std::vector<double> qps_v;
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double qps = static_cast<double>(smp.iters) / smp.secs;
+    qps_v.push_back(qps);
+    Record r("Cluster/classify");
+    r.Add("dim_bits", dim).Add("capacity", cap).Add("path", path);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("queries_per_sec", qps, 1);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters);
+    r.Print(s.json);
+  }
   if (s.samples > 1) {
-    auto agg = [](std::vector<double> v){
-      std::sort(v.begin(), v.end());
-      const double mean = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
-      const double median = (v.size()%2? v[v.size()/2] : 0.5*(v[v.size()/2-1]+v[v.size()/2]));
-      double ss = 0.0; for (double x: v) { double d=x-mean; ss += d*d; }
-      const double stdev = std::sqrt(ss / v.size());
-      return std::tuple<double,double,double>(mean, median, stdev);
-    };
-    auto [u_mean,u_med,u_std] = agg(upd_ps_v);
-    auto [f_mean,f_med,f_std] = agg(fin_ps_v);
-    if (s.json) {
-      std::printf("{\"name\":\"%s\",\"dim_bits\":%zu,\"capacity\":%zu,\"updates\":%zu,\"aggregate\":true,\"samples\":%d,\"updates_per_sec\":{\"mean\":%.1f,\"median\":%.1f,\"stdev\":%.1f},\"finalizes_per_sec\":{\"mean\":%.1f,\"median\":%.1f,\"stdev\":%.1f},\"warmup_ms\":%d,\"measure_ms\":%d}\n",
-                  name, Dim, Capacity, updates, s.samples, u_mean, u_med, u_std, f_mean, f_med, f_std, s.warmup_ms, s.measure_ms);
+    Record agg("Cluster/classify");
+    agg.Add("dim_bits", dim).Add("capacity", cap).Add("path", path)
+       .AddBool("aggregate", true).Add("samples", s.samples)
+       .Add("queries_per_sec", Summarize(qps_v), 1);
+    agg.Print(s.json);
+  }
+}
+
+// Classification against trained clusters: finalize-then-classify vs counter scoring vs the
+// cached binarized prototypes. Distances use the policy-selected Hamming kernel throughout.
+template <std::size_t Dim, std::size_t Capacity>
+static void bench_classify(const Options& s) {
+  auto cmem = std::make_unique<ClusterMemory<Dim, Capacity>>();
+  std::uint64_t seed = 7;
+  std::vector<HyperVector<Dim, bool>> samples(64);
+  for (auto& hv : samples) fill_random(&hv, splitmix64(seed));
+  for (std::size_t i = 0; i < 8 * Capacity; ++i) (void)cmem->Update(i % Capacity, samples[i % samples.size()]);
+  const auto hamming = hyperstream::backend::SelectHammingBackend<Dim>();
+  const auto dot = hyperstream::backend::SelectSignedDotBackend();
+  std::size_t k = 0;
+  auto next_query = [&]() -> const HyperVector<Dim, bool>& { return samples[k++ % samples.size()]; };
+
+  auto protos = std::make_unique<PrototypeMemory<Dim, Capacity>>();
+  HyperVector<Dim, bool> out;
+  auto finalize_all = [&]() {
+    protos = std::make_unique<PrototypeMemory<Dim, Capacity>>();
+    for (std::size_t c = 0; c < Capacity; ++c) {
+      cmem->Finalize(c, &out);
+      (void)protos->Learn(c, out);
+    }
+  };
+  report_classify(s, Dim, Capacity, "finalize_then_classify", Measure(s, [&](volatile std::uint64_t* sink) {
+    finalize_all();
+    *sink ^= protos->Classify(next_query(), hamming, 0);
+  }));
+  finalize_all();
+  report_classify(s, Dim, Capacity, "prototype_only", Measure(s, [&](volatile std::uint64_t* sink) {
+    *sink ^= protos->Classify(next_query(), hamming, 0);
+  }));
+  report_classify(s, Dim, Capacity, "counter_dot", Measure(s, [&](volatile std::uint64_t* sink) {
+    *sink ^= cmem->Classify(next_query(), &hyperstream::core::SignedDotWords);
+  }));
+  report_classify(s, Dim, Capacity, "counter_dot_selected", Measure(s, [&](volatile std::uint64_t* sink) {
+    *sink ^= cmem->Classify(next_query(), dot);
+  }));
+  report_classify(s, Dim, Capacity, "binarized", Measure(s, [&](volatile std::uint64_t* sink) {
+    *sink ^= cmem->ClassifyBinarized(next_query(), hamming);
+  }));
+  // Online use: one Update between queries. The finalize path rebuilds every prototype, the
+  // binarized cache only the updated one.
+  report_classify(s, Dim, Capacity, "finalize_then_classify_after_update", Measure(s, [&](volatile std::uint64_t* sink) {
+    (void)cmem->Update(k % Capacity, samples[k % samples.size()]);
+    finalize_all();
+    *sink ^= protos->Classify(next_query(), hamming, 0);
+  }));
+  report_classify(s, Dim, Capacity, "binarized_after_update", Measure(s, [&](volatile std::uint64_t* sink) {
+    (void)cmem->Update(k % Capacity, samples[k % samples.size()]);
+    *sink ^= cmem->ClassifyBinarized(next_query(), hamming);
+  }));
+}
+
+// Retraining throughput: every class mixes its own mode with a perturbed copy of the next class's,
+// so the one-shot prototypes misclassify and each epoch has real mistakes to correct.
+template <std::size_t Dim, std::size_t Classes>
+static void bench_retrain(const Options& s, std::size_t n, std::size_t batch, std::size_t threads) {
+  std::uint64_t seed = 11;
+  std::vector<HyperVector<Dim, bool>> modes(Classes);
+  for (auto& hv : modes) fill_random(&hv, splitmix64(seed));
+  auto perturb = [&](HyperVector<Dim, bool>* hv, std::size_t flips) {
+    for (std::size_t f = 0; f < flips; ++f) {
+      const std::size_t bit = static_cast<std::size_t>(splitmix64(seed) % Dim);
+      hv->SetBit(bit, !hv->GetBit(bit));
+    }
+  };
+  std::vector<HyperVector<Dim, bool>> samples(n);
+  std::vector<std::uint64_t> labels(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t c = i % Classes;
+    samples[i] = modes[c];
+    if ((i / Classes) % 4 == 3) {
+      samples[i] = modes[(c + 1) % Classes];
+      perturb(&samples[i], Dim / 6);
+    }
+    perturb(&samples[i], Dim / 5);
+    labels[i] = c;
+  }
+  auto cmem = std::make_unique<ClusterMemory<Dim, Classes>>();
+  for (std::size_t i = 0; i < n; ++i) (void)cmem->Update(labels[i], samples[i]);
+  const auto hamming = hyperstream::backend::SelectHammingBackend<Dim>();
+  hyperstream::memory::RetrainOptions options;
+  options.epochs = 1;
+  options.batch_size = batch;
+  options.stop_when_separated = false;
+  constexpr std::size_t kEpochs = 8;
+  for (std::size_t epoch = 0; epoch <= kEpochs; ++epoch) {
+    std::size_t mistakes = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    if (epoch == 0) {
+      for (std::size_t i = 0; i < n; ++i) mistakes += cmem->ClassifyBinarized(samples[i], hamming) != labels[i] ? 1 : 0;
     } else {
-      std::printf("%s,dim_bits=%zu,capacity=%zu,updates=%zu,aggregate=samples:%d,updates_ps_mean=%.1f,updates_ps_median=%.1f,updates_ps_stdev=%.1f,finalizes_ps_mean=%.1f,finalizes_ps_median=%.1f,finalizes_ps_stdev=%.1f\n",
-                  name, Dim, Capacity, updates, s.samples, u_mean, u_med, u_std, f_mean, f_med, f_std);
+      mistakes = hyperstream::memory::Retrain(*cmem, samples.data(), labels.data(), n, options, hamming,
+                                              ThreadExecutor{threads}).mistakes_per_epoch[0];
     }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    Record r("Cluster/retrain");
+    r.Add("dim_bits", Dim).Add("classes", Classes).Add("samples", n).Add("batch", batch).Add("threads", threads)
+     .Add("epoch", epoch).Add("mistakes", mistakes).Add("secs", secs, 6)
+     .Add("samples_per_sec", static_cast<double>(n) / secs, 1);
+    r.Print(s.json);
   }
 }
 
+// Streaming clustering throughput; every iteration clusters the whole stream from scratch.
+template <std::size_t Dim, std::size_t Capacity>
+static void bench_stream(const Options& s, std::size_t n, std::size_t threads) {
+  using Clusterer = hyperstream::memory::StreamingClusterer<Dim, Capacity>;
+  constexpr std::size_t kCenters = 32;
+  std::uint64_t seed = 21;
+  std::vector<HyperVector<Dim, bool>> centers(kCenters);
+  for (auto& hv : centers) fill_random(&hv, splitmix64(seed));
+  std::vector<HyperVector<Dim, bool>> stream(n);
+  for (auto& hv : stream) {
+    hv = centers[splitmix64(seed) % kCenters];
+    for (std::size_t f = 0; f < Dim / 10; ++f) {
+      const std::size_t bit = static_cast<std::size_t>(splitmix64(seed) % Dim);
+      hv.SetBit(bit, !hv.GetBit(bit));
+    }
+  }
+  const auto hamming = hyperstream::backend::SelectHammingBackend<Dim>();
+  auto portable = [](const HyperVector<Dim, bool>& a, const HyperVector<Dim, bool>& b) {
+    return hyperstream::core::HammingDistance(a, b);
+  };
+  std::size_t clusters = 0;
+  auto report = [&](const char* mode, std::size_t mode_threads, const std::vector<hyperstream::bench::Sample>& samples) {
+    for (std::size_t si = 0; si < samples.size(); ++si) {
+      const auto& smp = samples[si];
+      Record r("Cluster/stream");
+      r.Add("dim_bits", Dim).Add("capacity", Capacity).Add("vectors", n).Add("mode", mode).Add("threads", mode_threads);
+      if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+      r.Add("iters", smp.iters).Add("clusters", clusters)
+       .Add("vectors_per_sec", static_cast<double>(n) * static_cast<double>(smp.iters) / smp.secs, 1)
+       .Add("storage_bytes", Clusterer::StorageBytes());
+      if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+      r.Add(smp.counters, smp.iters * n);
+      r.Print(s.json);
+    }
+  };
+  auto run_assign = [&](const char* mode, std::size_t refresh_every, auto dist) {
+    hyperstream::memory::StreamingClustererOptions options;
+    options.refresh_every = refresh_every;
+    report(mode, 1, Measure(s, [&](volatile std::uint64_t* sink) {
+      auto c = std::make_unique<Clusterer>(options);
+      for (const auto& hv : stream) *sink ^= c->Assign(hv, dist);
+      clusters = c->size();
+    }));
+  };
+  run_assign("assign_portable", 64, portable);
+  run_assign("assign_selected", 64, hamming);
+  run_assign("assign_refresh1", 1, hamming);
+  constexpr std::size_t kBatch = 256;
+  std::vector<std::uint64_t> ids(n);
+  report("batch", threads, Measure(s, [&](volatile std::uint64_t* sink) {
+    auto c = std::make_unique<Clusterer>();
+    for (std::size_t b0 = 0; b0 < n; b0 += kBatch) {
+      c->AssignBatch(&stream[b0], std::min(kBatch, n - b0), &ids[b0], hamming, ThreadExecutor{threads});
+    }
+    clusters = c->size();
+    *sink ^= ids[n - 1];
+  }));
+  report("shards", threads, Measure(s, [&](volatile std::uint64_t* sink) {
+    std::vector<std::unique_ptr<Clusterer>> shards(threads);
+    ThreadExecutor{threads}(threads, [&](std::size_t t) {
+      shards[t] = std::make_unique<Clusterer>();
+      for (std::size_t i = t; i < n; i += threads) (void)shards[t]->Assign(stream[i], hamming);
+    });
+    for (std::size_t t = 1; t < threads; ++t) shards[0]->Merge(*shards[t], hamming);
+    clusters = shards[0]->size();
+    *sink ^= clusters;
+  }));
+}
+
 template <std::size_t Dim>
-static void run_one_dim(const Settings& s) {
+static void run_one_dim(const Options& s) {
   bench_cluster<Dim, 16>("Cluster/update_finalize", 100, s);
 }
 
@@ -182,7 +344,31 @@ int main(int argc, char** argv) try {
   setvbuf(stdout, nullptr, _IONBF, 0);
   setvbuf(stderr, nullptr, _IONBF, 0);
 
-  const Settings s = ParseArgs(argc, argv);
+  Options defaults;
+  defaults.measure_ms = 150;
+  const Options s = hyperstream::bench::ParseArgs(argc, argv, defaults);
+
+  if (s.HasFlag("--stream")) {
+    const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+    bench_stream<1024, 64>(s, 16384, threads);
+    bench_stream<10000, 64>(s, 8192, threads);
+    return EXIT_SUCCESS;
+  }
+
+  if (s.HasFlag("--retrain")) {
+    const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+    bench_retrain<1024, 16>(s, 8192, 256, threads);
+    bench_retrain<10000, 16>(s, 4096, 256, threads);
+    bench_retrain<10000, 16>(s, 4096, 1, threads);
+    return EXIT_SUCCESS;
+  }
+
+  if (s.HasFlag("--classify")) {
+    bench_classify<1024, 16>(s);
+    bench_classify<10000, 16>(s);
+    bench_classify<10000, 64>(s);
+    return EXIT_SUCCESS;
+  }
 
   if (argc == 1) {
     // Print active configuration
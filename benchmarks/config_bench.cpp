@@ -1,5 +1,6 @@
 // HyperStream Configuration Report Benchmark
 // Prints active profile, defaults, CPU features, and selected backends.
+// Flags: --auto-tune (Hamming SSE2 vs AVX2 sweep), --json (one NDJSON record per report section)
 
 #include <cstdio>
 #include <cstdlib>
@@ -9,26 +10,47 @@
 #include "hyperstream/backend/capability.hpp"
 #include "hyperstream/backend/policy.hpp"
 #include "hyperstream/core/hypervector.hpp"
+#include "bench_harness.hpp"
 
+using hyperstream::bench::Record;
 using hyperstream::core::HyperVector;
 
 namespace {
 
 template <std::size_t Dim>
-void ReportSelectedBackends() {
+void ReportSelectedBackends(bool json) {
   const auto rep = hyperstream::backend::Report<Dim>();
+  if (json) {
+    Record("SelectedBackends")
+        .Add("dim_bits", Dim)
+        .Add("bind", hyperstream::backend::GetBackendName(rep.bind_kind))
+        .Add("bind_reason", rep.bind_reason)
+        .Add("hamming", hyperstream::backend::GetBackendName(rep.hamming_kind))
+        .Add("hamming_reason", rep.hamming_reason)
+        .Print(true);
+    return;
+  }
   std::printf("SelectedBackends/bind=%s,reason=\"%s\",hamming=%s,reason=\"%s\"\n",
               hyperstream::backend::GetBackendName(rep.bind_kind), rep.bind_reason,
               hyperstream::backend::GetBackendName(rep.hamming_kind), rep.hamming_reason);
 }
 
-void ReportFootprints() {
+void ReportFootprints(bool json) {
   using namespace hyperstream::config;
   const std::size_t d = kDefaultDimBits;
   // Representative configs
   const std::size_t hv_b = BinaryHyperVectorStorageBytes(d);
   const std::size_t cl_b = ClusterMemoryStorageBytes(d, 16);
   const std::size_t pm_b = PrototypeMemoryStorageBytes(d, 256);
+  if (json) {
+    Record("Footprints")
+        .Add("dim_bits", d)
+        .Add("binary_hv_bytes", hv_b)
+        .Add("cluster_memory_cap16_bytes", cl_b)
+        .Add("prototype_memory_cap256_bytes", pm_b)
+        .Print(true);
+    return;
+  }
   std::printf("Footprints/BinaryHV(dim=%zu)=%zub,ClusterMemory(dim=%zu,cap=16)=%zub,PrototypeMemory(dim=%zu,cap=256)=%zub\n",
               d, hv_b, d, cl_b, d, pm_b);
 }
@@ -37,7 +59,6 @@ void ReportFootprints() {
 
 // Simple auto-tune microbench (disabled by default; enable with --auto-tune)
 #include <chrono>
-#include <cstring>
 
 #if HS_X86_ARCH
 template <std::size_t Dim>
@@ -69,35 +90,55 @@ int main(int argc, char** argv) try {
   setvbuf(stdout, nullptr, _IONBF, 0);
   setvbuf(stderr, nullptr, _IONBF, 0);
 
-  const bool auto_tune = (argc >= 2) && (std::strcmp(argv[1], "--auto-tune") == 0);
+  const hyperstream::bench::Options opts = hyperstream::bench::ParseArgs(argc, argv);
+  const bool auto_tune = opts.HasFlag("--auto-tune");
+  const bool json = opts.json;
 
   // Profile and defaults
-  std::printf("Config/profile=%s,default_dim_bits=%zu,default_capacity=%zu,heap_threshold_bytes=%zu\n",
-              hyperstream::config::kActiveProfile,
-              hyperstream::config::kDefaultDimBits,
-              hyperstream::config::kDefaultCapacity,
-              hyperstream::config::kHeapAllocThresholdBytes);
+  if (json) {
+    Record("Config")
+        .Add("profile", hyperstream::config::kActiveProfile)
+        .Add("default_dim_bits", hyperstream::config::kDefaultDimBits)
+        .Add("default_capacity", hyperstream::config::kDefaultCapacity)
+        .Add("heap_threshold_bytes", hyperstream::config::kHeapAllocThresholdBytes)
+        .Print(true);
+  } else {
+    std::printf("Config/profile=%s,default_dim_bits=%zu,default_capacity=%zu,heap_threshold_bytes=%zu\n",
+                hyperstream::config::kActiveProfile,
+                hyperstream::config::kDefaultDimBits,
+                hyperstream::config::kDefaultCapacity,
+                hyperstream::config::kHeapAllocThresholdBytes);
+  }
 
   // CPU features
   const std::uint32_t mask = hyperstream::backend::GetCpuFeatureMask();
-  std::printf("CPUFeatures/mask=0x%08x,SSE2=%d,AVX2=%d\n", mask,
-              hyperstream::backend::HasFeature(mask, hyperstream::backend::CpuFeature::SSE2) ? 1 : 0,
-              hyperstream::backend::HasFeature(mask, hyperstream::backend::CpuFeature::AVX2) ? 1 : 0);
+  const int has_sse2 = hyperstream::backend::HasFeature(mask, hyperstream::backend::CpuFeature::SSE2) ? 1 : 0;
+  const int has_avx2 = hyperstream::backend::HasFeature(mask, hyperstream::backend::CpuFeature::AVX2) ? 1 : 0;
+  if (json) {
+    Record("CPUFeatures").Add("mask", static_cast<std::size_t>(mask)).Add("sse2", has_sse2).Add("avx2", has_avx2).Print(true);
+  } else {
+    std::printf("CPUFeatures/mask=0x%08x,SSE2=%d,AVX2=%d\n", mask, has_sse2, has_avx2);
+  }
 
   // Threshold (env override aware)
   const std::size_t thr = hyperstream::backend::GetHammingThreshold();
-  std::printf("Policy/HammingThreshold=%zu,overridden=%d\n", thr, hyperstream::backend::HammingThresholdOverridden() ? 1 : 0);
+  const int overridden = hyperstream::backend::HammingThresholdOverridden() ? 1 : 0;
+  if (json) {
+    Record("Policy").Add("hamming_threshold", thr).Add("overridden", overridden).Print(true);
+  } else {
+    std::printf("Policy/HammingThreshold=%zu,overridden=%d\n", thr, overridden);
+  }
 
   // Selected backends and reasons for default dimension
-  ReportSelectedBackends<hyperstream::config::kDefaultDimBits>();
+  ReportSelectedBackends<hyperstream::config::kDefaultDimBits>(json);
 
   // Footprint estimates
-  ReportFootprints();
+  ReportFootprints(json);
 
 #if HS_X86_ARCH
   if (auto_tune) {
     // Keep total runtime under ~2 seconds by limiting iterations per dimension.
-    std::printf("AutoTune/Hamming begin\n");
+    if (!json) std::printf("AutoTune/Hamming begin\n");
     struct Case { std::size_t dim; std::size_t iters; } cases[] = {
       {8192,  8000}, {16384, 4000}, {32768, 2000}, {65536, 1000}
     };
@@ -112,15 +153,23 @@ int main(int argc, char** argv) try {
         case 65536: { auto p = MicrobenchHammingSSE2vsAVX2<65536>(c.iters); sse2_ms=p.first; avx2_ms=p.second; break; }
       }
       const char* faster = (sse2_ms < avx2_ms) ? "sse2" : "avx2";
-      std::printf("AutoTune/Hamming dim=%zu,sse2_ms=%.3f,avx2_ms=%.3f,faster=%s\n", c.dim, sse2_ms, avx2_ms, faster);
+      if (json) {
+        Record("AutoTune/Hamming").Add("dim_bits", c.dim).Add("iters", c.iters)
+            .Add("sse2_ms", sse2_ms, 3).Add("avx2_ms", avx2_ms, 3).Add("faster", faster).Print(true);
+      } else {
+        std::printf("AutoTune/Hamming dim=%zu,sse2_ms=%.3f,avx2_ms=%.3f,faster=%s\n", c.dim, sse2_ms, avx2_ms, faster);
+      }
       if (!recommended && sse2_ms < avx2_ms) recommended = c.dim;
     }
-    if (recommended) {
+    if (json) {
+      Record("AutoTune/HammingSummary").Add("recommended_threshold", recommended)
+          .Add("configured_threshold", thr).Print(true);
+    } else if (recommended) {
       std::printf("AutoTune/Hamming recommended_threshold=%zu (first dim where sse2 faster)\n", recommended);
     } else {
       std::printf("AutoTune/Hamming recommended_threshold=(none within tested range)\n");
     }
-    std::printf("AutoTune/Hamming configured_threshold=%zu\n", thr);
+    if (!json) std::printf("AutoTune/Hamming configured_threshold=%zu\n", thr);
   }
 #else
   if (auto_tune) {
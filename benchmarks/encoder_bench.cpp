@@ -0,0 +1,391 @@
+// HyperStream encoder / bit-access microbenchmark
+// Compares per-bit loops over the checked GetBit/SetBit accessors with the word-level paths the
+// library uses internally (FromBools/ToBools, BinaryBundler Accumulate/Finalize), then reports
+// the per-call cost of the encoders built on them.
+// Output lines:
+//   Bits/<op>,dim_bits,path=per_bit|word|bit_sliced,iters,secs,ns_per_op[,gb_per_sec]
+//   Encode/<encoder>,dim_bits,iters,secs,ns_per_op
+//   Encode/<token encoder>,dim_bits,path=fnv1a|wyhash,iters,secs,ns_per_op (64-byte tokens)
+//   Token/hash,bytes,hash=fnv1a|wyhash,iters,secs,ns_per_op,gb_per_sec (token lengths 4..512)
+//   Text/char_trigram,dim_bits,path=hash_encoder|sequential_ngram|char_ngram,bytes,iters,secs,mb_per_sec
+//     hash_encoder: HashEncoder::Update per 3-byte substring; sequential_ngram: SequentialNGramEncoder
+//     Update per byte; char_ngram: CharNGramEncoder (rolling n-gram + bit-sliced bundler)
+//   TimeSeries/window,dim_bits,channels,window,stride,path=hand_loop|fused,windows,iters,secs,samples_per_sec
+//     hand_loop: ThermometerEncoder -> PermuteRotate -> Bind -> BinaryBundler per sample;
+//     fused: MultiChannelTimeSeriesEncoder::EncodeWindows (64 levels). samples = windows * window * channels
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/char_ngram.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+#include "hyperstream/encoding/symbol.hpp"
+#include "hyperstream/encoding/timeseries.hpp"
+#include "hyperstream/encoding/token_hash.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::HyperVector;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+
+// Per-sample ns/op rows (+ aggregate when samples > 1); `path` is omitted when null.
+static void report_ns_per_op(const Options& opts, const char* name, std::size_t dim_bits, const char* path,
+                             const std::vector<hyperstream::bench::Sample>& samples,
+                             std::size_t bytes_per_op = 0) {
+  std::vector<double> ns_v;
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double ns = smp.secs * 1e9 / static_cast<double>(smp.iters);
+    ns_v.push_back(ns);
+    Record r(name);
+    r.Add("dim_bits", dim_bits);
+    if (path) r.Add("path", path);
+    if (!opts.json && opts.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("ns_per_op", ns, 1);
+    if (bytes_per_op) {
+      r.Add("gb_per_sec", (static_cast<double>(bytes_per_op) * smp.iters / smp.secs) / 1e9, 3);
+    }
+    if (opts.json) {
+      r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", opts.warmup_ms).Add("measure_ms", opts.measure_ms);
+    }
+    r.Add(smp.counters, smp.iters);
+    r.Print(opts.json);
+  }
+  if (opts.samples > 1) {
+    Record agg(name);
+    agg.Add("dim_bits", dim_bits);
+    if (path) agg.Add("path", path);
+    agg.AddBool("aggregate", true).Add("samples", opts.samples)
+       .Add("ns_per_op", hyperstream::bench::Summarize(ns_v), 1);
+    agg.Print(opts.json);
+  }
+}
+
+template <std::size_t Dim>
+static void random_vector(std::mt19937_64* rng, HyperVector<Dim, bool>* hv) {
+  auto& w = hv->Words();
+  for (auto& x : w) x = (*rng)();
+  constexpr std::size_t extra_bits = HyperVector<Dim, bool>::WordCount() * 64ULL - Dim;
+  if constexpr (extra_bits > 0) w.back() &= ~0ULL >> extra_bits;
+}
+
+// Bit packing/unpacking and the bundler loops: per-bit checked accessors vs the word-level paths.
+template <std::size_t Dim>
+static void bench_bits(const Options& opts) {
+  using counter_t = typename BinaryBundler<Dim>::counter_t;
+  std::mt19937_64 rng(0xB17ULL);
+  constexpr std::size_t kPool = 16;
+  std::vector<HyperVector<Dim, bool>> pool(kPool);
+  for (auto& hv : pool) random_vector(&rng, &hv);
+  auto bools = std::make_unique<std::array<bool, Dim>>();
+  pool[0].ToBools(bools->data());
+
+  HyperVector<Dim, bool> out;
+  std::size_t k = 0;
+  report_ns_per_op(opts, "Bits/pack", Dim, "per_bit", Measure(opts, [&](volatile std::uint64_t* sink) {
+    for (std::size_t i = 0; i < Dim; ++i) out.SetBit(i, (*bools)[i]);
+    *sink ^= out.Words()[0];
+  }));
+  report_ns_per_op(opts, "Bits/pack", Dim, "word", Measure(opts, [&](volatile std::uint64_t* sink) {
+    out.FromBools(bools->data());
+    *sink ^= out.Words()[0];
+  }));
+  report_ns_per_op(opts, "Bits/unpack", Dim, "per_bit", Measure(opts, [&](volatile std::uint64_t* sink) {
+    const auto& hv = pool[k++ & (kPool - 1)];
+    for (std::size_t i = 0; i < Dim; ++i) (*bools)[i] = hv.GetBit(i);
+    *sink ^= (*bools)[Dim - 1];
+  }));
+  report_ns_per_op(opts, "Bits/unpack", Dim, "word", Measure(opts, [&](volatile std::uint64_t* sink) {
+    pool[k++ & (kPool - 1)].ToBools(bools->data());
+    *sink ^= (*bools)[Dim - 1];
+  }));
+
+  // Reference: the pre-word-level saturating Accumulate and Finalize over a local counter array.
+  auto counters = std::make_unique<std::array<counter_t, Dim>>();
+  counters->fill(0);
+  report_ns_per_op(opts, "Bits/accumulate", Dim, "per_bit", Measure(opts, [&](volatile std::uint64_t* sink) {
+    const auto& hv = pool[k++ & (kPool - 1)];
+    auto& c = *counters;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      if (hv.GetBit(i)) {
+        if (c[i] != std::numeric_limits<counter_t>::max()) ++c[i];
+      } else {
+        if (c[i] != std::numeric_limits<counter_t>::min()) --c[i];
+      }
+    }
+    *sink ^= static_cast<std::uint64_t>(c[0]);
+  }), Dim / 8);
+  BinaryBundler<Dim> bundler;
+  report_ns_per_op(opts, "Bits/accumulate", Dim, "word", Measure(opts, [&](volatile std::uint64_t* sink) {
+    bundler.Accumulate(pool[k++ & (kPool - 1)]);
+    *sink ^= k;
+  }), Dim / 8);
+  hyperstream::core::BitSlicedBundler<Dim> sliced;
+  report_ns_per_op(opts, "Bits/accumulate", Dim, "bit_sliced", Measure(opts, [&](volatile std::uint64_t* sink) {
+    sliced.Accumulate(pool[k++ & (kPool - 1)]);
+    *sink ^= k;
+  }), Dim / 8);
+  report_ns_per_op(opts, "Bits/finalize", Dim, "per_bit", Measure(opts, [&](volatile std::uint64_t* sink) {
+    const auto& c = *counters;
+    for (std::size_t i = 0; i < Dim; ++i) out.SetBit(i, c[i] >= 0);
+    *sink ^= out.Words()[0];
+  }));
+  report_ns_per_op(opts, "Bits/finalize", Dim, "word", Measure(opts, [&](volatile std::uint64_t* sink) {
+    bundler.Finalize(&out);
+    *sink ^= out.Words()[0];
+  }));
+}
+
+// Per-call cost of the encoders whose inner loops use the unchecked/word-level accessors.
+template <std::size_t Dim>
+static void bench_encoders(const Options& opts) {
+  using namespace hyperstream::encoding;
+  HyperVector<Dim, bool> out;
+  std::size_t k = 0;
+
+  HashEncoder<Dim> hash;
+  const char* tokens[] = {"alpha", "beta", "gamma", "delta"};
+  report_ns_per_op(opts, "Encode/hash_token", Dim, nullptr, Measure(opts, [&](volatile std::uint64_t* sink) {
+    hash.EncodeToken(tokens[k++ & 3], 0, &out);
+    *sink ^= out.Words()[0];
+  }));
+
+  UnaryIntensityEncoder<Dim> intensity(Dim / 2);
+  report_ns_per_op(opts, "Encode/unary_intensity", Dim, nullptr, Measure(opts, [&](volatile std::uint64_t* sink) {
+    intensity.Update((k++ * 37) % (Dim / 2));
+    *sink ^= k;
+  }));
+
+  ThermometerEncoder<Dim> thermo(0.0, 1.0);
+  report_ns_per_op(opts, "Encode/thermometer", Dim, nullptr, Measure(opts, [&](volatile std::uint64_t* sink) {
+    thermo.Encode(static_cast<double>(k++ & 1023) / 1024.0, &out);
+    *sink ^= out.Words()[0];
+  }));
+
+  RandomProjectionEncoder<Dim> proj(0x9E0ULL);
+  std::array<float, 16> features{};
+  for (std::size_t i = 0; i < features.size(); ++i) features[i] = static_cast<float>(i) * 0.25f - 1.5f;
+  report_ns_per_op(opts, "Encode/random_projection16", Dim, nullptr, Measure(opts, [&](volatile std::uint64_t* sink) {
+    features[k++ & 15] += 0.001f;
+    proj.Encode(features.data(), features.size(), &out);
+    *sink ^= out.Words()[0];
+  }));
+}
+
+// Token hash throughput per family and token length; a pool of distinct tokens defeats caching of
+// the result while staying L1-resident.
+static void bench_token_hash(const Options& opts) {
+  using hyperstream::encoding::HashToken;
+  using hyperstream::encoding::TokenHash;
+  constexpr std::size_t kPool = 16;
+  std::mt19937_64 rng(0x70ULL);
+  const std::size_t lengths[] = {4, 8, 16, 32, 64, 128, 256, 512};
+  const struct {
+    const char* label;
+    TokenHash hash;
+  } families[] = {{"fnv1a", TokenHash::kFnv1a}, {"wyhash", TokenHash::kWyhash}};
+  for (std::size_t len : lengths) {
+    std::vector<std::string> pool(kPool, std::string(len, ' '));
+    for (auto& token : pool) {
+      for (auto& c : token) c = static_cast<char>('a' + rng() % 26);
+    }
+    for (const auto& family : families) {
+      std::size_t k = 0;
+      const auto samples = Measure(opts, [&](volatile std::uint64_t* sink) {
+        *sink ^= HashToken(family.hash, pool[k++ & (kPool - 1)], 0x51ed2701f3a5c7b9ULL);
+      });
+      for (std::size_t si = 0; si < samples.size(); ++si) {
+        const auto& smp = samples[si];
+        const double ns = smp.secs * 1e9 / static_cast<double>(smp.iters);
+        Record r("Token/hash");
+        r.Add("bytes", len).Add("hash", family.label);
+        if (!opts.json && opts.samples > 1) r.Add("sample", static_cast<int>(si));
+        r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("ns_per_op", ns, 1)
+         .Add("gb_per_sec", static_cast<double>(len) / ns, 3);
+        if (opts.json) {
+          r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", opts.warmup_ms).Add("measure_ms", opts.measure_ms);
+        }
+        r.Add(smp.counters, smp.iters);
+        r.Print(opts.json);
+      }
+    }
+  }
+}
+
+// Token encoders on 64-byte tokens (URL-sized) under each hash family.
+template <std::size_t Dim>
+static void bench_token_encoders(const Options& opts) {
+  using namespace hyperstream::encoding;
+  HyperVector<Dim, bool> out;
+  std::vector<std::string> tokens;
+  for (int i = 0; i < 4; ++i) {
+    tokens.push_back("https://example.com/hyperstream/token/" + std::to_string(i) + std::string(26, 'x'));
+    tokens.back().resize(64);
+  }
+  const struct {
+    const char* label;
+    TokenHash hash;
+  } families[] = {{"fnv1a", TokenHash::kFnv1a}, {"wyhash", TokenHash::kWyhash}};
+  for (const auto& family : families) {
+    std::size_t k = 0;
+    HashEncoder<Dim> hash(4, 0x51ed2701f3a5c7b9ULL, family.hash);
+    report_ns_per_op(opts, "Encode/hash_token64", Dim, family.label, Measure(opts, [&](volatile std::uint64_t* sink) {
+      hash.EncodeToken(tokens[k++ & 3], 0, &out);
+      *sink ^= out.Words()[0];
+    }));
+    SymbolEncoder<Dim> symbol(0x9E0ULL, family.hash);
+    report_ns_per_op(opts, "Encode/symbol_token64", Dim, family.label, Measure(opts, [&](volatile std::uint64_t* sink) {
+      symbol.EncodeToken(tokens[k++ & 3], &out);
+      *sink ^= out.Words()[0];
+    }));
+  }
+}
+
+// Text throughput of character trigram encoding: tokenizing into n-gram strings for HashEncoder,
+// the per-symbol SequentialNGramEncoder, and CharNGramEncoder over the raw bytes.
+template <std::size_t Dim>
+static void bench_text(const Options& opts) {
+  using namespace hyperstream::encoding;
+  constexpr std::size_t kBytes = 16 * 1024;
+  const char* words[] = {"the", "stream", "of", "hyper", "vectors", "encodes", "text", "lorem", "ipsum", "log:"};
+  std::mt19937_64 rng(0x72ULL);
+  std::string text;
+  while (text.size() < kBytes) {
+    text += words[rng() % 10];
+    text += ' ';
+  }
+  text.resize(kBytes);
+  HyperVector<Dim, bool> out;
+  auto report = [&](const char* path, const std::vector<hyperstream::bench::Sample>& samples) {
+    for (std::size_t si = 0; si < samples.size(); ++si) {
+      const auto& smp = samples[si];
+      Record r("Text/char_trigram");
+      r.Add("dim_bits", Dim).Add("path", path).Add("bytes", kBytes);
+      if (!opts.json && opts.samples > 1) r.Add("sample", static_cast<int>(si));
+      r.Add("iters", smp.iters).Add("secs", smp.secs, 6)
+       .Add("mb_per_sec", static_cast<double>(kBytes) * static_cast<double>(smp.iters) / smp.secs / 1e6, 2);
+      if (opts.json) {
+        r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", opts.warmup_ms).Add("measure_ms", opts.measure_ms);
+      }
+      r.Add(smp.counters, smp.iters * kBytes);
+      r.Print(opts.json);
+    }
+  };
+  const std::string_view view(text);
+  HashEncoder<Dim> hash;
+  report("hash_encoder", Measure(opts, [&](volatile std::uint64_t* sink) {
+    hash.Reset();
+    for (std::size_t i = 0; i + 3 <= view.size(); ++i) hash.Update(view.substr(i, 3));
+    hash.Finalize(&out);
+    *sink ^= out.Words()[0];
+  }));
+  SequentialNGramEncoder<Dim, 3> sequential;
+  report("sequential_ngram", Measure(opts, [&](volatile std::uint64_t* sink) {
+    sequential.Reset();
+    for (char ch : view) sequential.Update(static_cast<unsigned char>(ch));
+    sequential.Finalize(&out);
+    *sink ^= out.Words()[0];
+  }));
+  auto rolling = std::make_unique<CharNGramEncoder<Dim, 3>>();
+  report("char_ngram", Measure(opts, [&](volatile std::uint64_t* sink) {
+    rolling->Encode(view, &out);
+    *sink ^= out.Words()[0];
+  }));
+}
+
+// Sliding-window sensor encoding: the per-sample loop applications write by hand vs the fused
+// multi-channel encoder, over the same windows of a synthetic 8-channel stream.
+template <std::size_t Dim>
+static void bench_timeseries(const Options& opts) {
+  using namespace hyperstream::encoding;
+  constexpr std::size_t kChannels = 8;
+  constexpr std::size_t kWindow = 32;
+  constexpr std::size_t kSteps = 1024;
+  constexpr std::size_t kStride = 4;
+  using Encoder = MultiChannelTimeSeriesEncoder<Dim, kChannels, kWindow>;
+  std::mt19937_64 rng(0x74ULL);
+  std::vector<float> x(kSteps * kChannels);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<float>(std::sin(0.05 * static_cast<double>(i / kChannels) * (1 + i % kChannels))) +
+           0.1f * static_cast<float>(rng() % 1000) / 1000.0f;
+  }
+  const std::size_t windows = Encoder::WindowCount(kSteps, kStride);
+  const std::size_t samples_per_iter = windows * kWindow * kChannels;
+  std::vector<HyperVector<Dim, bool>> out(windows);
+  auto report = [&](const char* path, const std::vector<hyperstream::bench::Sample>& samples) {
+    for (std::size_t si = 0; si < samples.size(); ++si) {
+      const auto& smp = samples[si];
+      Record r("TimeSeries/window");
+      r.Add("dim_bits", Dim).Add("channels", kChannels).Add("window", kWindow).Add("stride", kStride)
+       .Add("path", path).Add("windows", windows);
+      if (!opts.json && opts.samples > 1) r.Add("sample", static_cast<int>(si));
+      r.Add("iters", smp.iters).Add("secs", smp.secs, 6)
+       .Add("samples_per_sec", static_cast<double>(samples_per_iter) * static_cast<double>(smp.iters) / smp.secs, 0);
+      if (opts.json) {
+        r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", opts.warmup_ms).Add("measure_ms", opts.measure_ms);
+      }
+      r.Add(smp.counters, smp.iters * samples_per_iter);
+      r.Print(opts.json);
+    }
+  };
+  auto thermo = std::make_unique<ThermometerEncoder<Dim>>(-1.5, 1.5);
+  std::vector<HyperVector<Dim, bool>> channels(kChannels);
+  for (std::size_t c = 0; c < kChannels; ++c) detail::GenerateRandomHypervector(0x54534531ULL, c, &channels[c]);
+  report("hand_loop", Measure(opts, [&](volatile std::uint64_t* sink) {
+    HyperVector<Dim, bool> level, rotated, bound;
+    for (std::size_t w = 0; w < windows; ++w) {
+      BinaryBundler<Dim> bundler;
+      const float* win = x.data() + w * kStride * kChannels;
+      for (std::size_t t = 0; t < kWindow; ++t) {
+        for (std::size_t c = 0; c < kChannels; ++c) {
+          thermo->Encode(win[t * kChannels + c], &level);
+          hyperstream::core::PermuteRotate(level, t, &rotated);
+          hyperstream::core::Bind(rotated, channels[c], &bound);
+          bundler.Accumulate(bound);
+        }
+      }
+      bundler.Finalize(&out[w]);
+    }
+    *sink ^= out[windows - 1].Words()[0];
+  }));
+  const Encoder fused(-1.5, 1.5);
+  report("fused", Measure(opts, [&](volatile std::uint64_t* sink) {
+    fused.EncodeWindows(x.data(), kSteps, kStride, out.data());
+    *sink ^= out[windows - 1].Words()[0];
+  }));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const Options opts = hyperstream::bench::ParseArgs(argc, argv);
+  bench_bits<1024>(opts);
+  bench_bits<10000>(opts);
+  bench_bits<65536>(opts);
+  bench_encoders<1024>(opts);
+  bench_encoders<10000>(opts);
+  bench_token_hash(opts);
+  bench_token_encoders<1024>(opts);
+  bench_token_encoders<10000>(opts);
+  bench_text<1024>(opts);
+  bench_text<10000>(opts);
+  bench_timeseries<1024>(opts);
+  bench_timeseries<10000>(opts);
+  return 0;
+}
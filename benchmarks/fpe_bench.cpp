@@ -0,0 +1,174 @@
+// HyperStream fractional power encoding microbenchmark
+// Compares FractionalPowerEncoder (complex phasors and their binarized export) with
+// ThermometerEncoder on scalar inputs: encode throughput and how well each representation's
+// similarity reproduces a Gaussian (RBF) kernel of length scale l = 1.
+// Output lines:
+//   FPE/encode,dim_bits,encoder,mode,threads,iters,secs,values_per_sec,ns_per_value
+//   encoder=thermometer | fpe_binary | fpe_complex; mode=loop (Encode per value) or batch
+//   (EncodeBatch over kValues values, fpe only).
+//   FPE/kernel,dim_bits,encoder,rmse_vs_rbf,max_err_vs_rbf,sim_0.5l,sim_1l,sim_2l,sim_4l
+//   Similarities (cosine for complex, normalized Hamming for binary) averaged over anchors in
+//   [-2l, 2l] at offsets d in [0, 4l]; rbf(d) = exp(-d^2 / 2). The thermometer spans [-4l, 4l].
+// Flags: --threads=N (EncodeBatch threads; default 1)
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::FractionalPowerEncoder;
+using hyperstream::encoding::FractionalPowerKernel;
+using hyperstream::encoding::ThermometerEncoder;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::ThreadExecutor;
+
+constexpr std::size_t kValues = 1024;  // values per measured iteration
+constexpr std::uint64_t kSeed = 0x73ULL;
+constexpr double kRange = 4.0;  // thermometer range [-kRange, kRange] in length scales
+
+void report(const Options& s, std::size_t dim, const char* encoder, const char* mode, std::size_t threads,
+            const std::vector<Sample>& samples) {
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double values = static_cast<double>(kValues) * static_cast<double>(smp.iters);
+    Record r("FPE/encode");
+    r.Add("dim_bits", dim).Add("encoder", encoder).Add("mode", mode).Add("threads", threads);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6)
+     .Add("values_per_sec", values / smp.secs, 1).Add("ns_per_value", smp.secs * 1e9 / values, 1);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters * kValues);
+    r.Print(s.json);
+  }
+}
+
+// Mean similarity sim(x, x + d) over anchors x, compared with rbf(d) on a grid of offsets d.
+template <typename Similarity>
+void report_kernel(const Options& s, std::size_t dim, const char* encoder, Similarity&& sim) {
+  constexpr int kAnchors = 17;
+  double sq = 0.0;
+  double max_err = 0.0;
+  int points = 0;
+  double at[4] = {0.0, 0.0, 0.0, 0.0};
+  for (int di = 0; di <= 40; ++di) {
+    const double d = 0.1 * di;
+    double mean = 0.0;
+    for (int a = 0; a < kAnchors; ++a) mean += sim(-2.0 + 4.0 * a / (kAnchors - 1), d);
+    mean /= kAnchors;
+    const double err = mean - std::exp(-0.5 * d * d);
+    sq += err * err;
+    max_err = std::max(max_err, std::fabs(err));
+    ++points;
+    if (di == 5) at[0] = mean;
+    if (di == 10) at[1] = mean;
+    if (di == 20) at[2] = mean;
+    if (di == 40) at[3] = mean;
+  }
+  Record r("FPE/kernel");
+  r.Add("dim_bits", dim).Add("encoder", encoder)
+   .Add("rmse_vs_rbf", std::sqrt(sq / points), 4).Add("max_err_vs_rbf", max_err, 4)
+   .Add("sim_0.5l", at[0], 4).Add("sim_1l", at[1], 4).Add("sim_2l", at[2], 4).Add("sim_4l", at[3], 4);
+  r.Print(s.json);
+}
+
+template <std::size_t Dim>
+void bench_dim(const Options& s, std::size_t threads) {
+  using Binary = HyperVector<Dim, bool>;
+  using Complex = HyperVector<Dim, std::complex<float>>;
+  const FractionalPowerEncoder<Dim> fpe(kSeed, 1.0, FractionalPowerKernel::kGaussian);
+  const ThermometerEncoder<Dim> thermo(-kRange, kRange);
+
+  std::vector<double> xs(kValues);
+  for (std::size_t i = 0; i < kValues; ++i) xs[i] = -kRange + 2.0 * kRange * static_cast<double>(i * 7919 % kValues) / kValues;
+
+  {
+    Binary hv;
+    report(s, Dim, "thermometer", "loop", 1, Measure(s, [&](volatile std::uint64_t* sink) {
+      std::uint64_t acc = 0;
+      for (double x : xs) {
+        thermo.Encode(x, &hv);
+        acc ^= hv.Words()[0];
+      }
+      *sink ^= acc;
+    }));
+    report(s, Dim, "fpe_binary", "loop", 1, Measure(s, [&](volatile std::uint64_t* sink) {
+      std::uint64_t acc = 0;
+      for (double x : xs) {
+        fpe.Encode(x, &hv);
+        acc ^= hv.Words()[0];
+      }
+      *sink ^= acc;
+    }));
+    std::vector<Binary> out(kValues);
+    report(s, Dim, "fpe_binary", "batch", threads, Measure(s, [&](volatile std::uint64_t* sink) {
+      fpe.EncodeBatch(xs.data(), kValues, out.data(), ThreadExecutor{threads});
+      *sink ^= out[kValues - 1].Words()[0];
+    }));
+  }
+  {
+    std::vector<Complex> out(kValues);
+    report(s, Dim, "fpe_complex", "loop", 1, Measure(s, [&](volatile std::uint64_t* sink) {
+      float acc = 0.0f;
+      for (std::size_t i = 0; i < kValues; ++i) {
+        fpe.Encode(xs[i], &out[i]);
+        acc += out[i][0].real();
+      }
+      *sink ^= static_cast<std::uint64_t>(acc * 1024.0f);
+    }));
+    report(s, Dim, "fpe_complex", "batch", threads, Measure(s, [&](volatile std::uint64_t* sink) {
+      fpe.EncodeBatch(xs.data(), kValues, out.data(), ThreadExecutor{threads});
+      *sink ^= static_cast<std::uint64_t>(out[kValues - 1][0].real() * 1024.0f);
+    }));
+  }
+
+  Complex ca;
+  Complex cb;
+  report_kernel(s, Dim, "fpe_complex", [&](double x, double d) {
+    fpe.Encode(x, &ca);
+    fpe.Encode(x + d, &cb);
+    return static_cast<double>(hyperstream::core::CosineSimilarity(ca, cb));
+  });
+  Binary ba;
+  Binary bb;
+  report_kernel(s, Dim, "fpe_binary", [&](double x, double d) {
+    fpe.Encode(x, &ba);
+    fpe.Encode(x + d, &bb);
+    return static_cast<double>(hyperstream::core::NormalizedHammingSimilarity(ba, bb));
+  });
+  report_kernel(s, Dim, "thermometer", [&](double x, double d) {
+    thermo.Encode(x, &ba);
+    thermo.Encode(x + d, &bb);
+    return static_cast<double>(hyperstream::core::NormalizedHammingSimilarity(ba, bb));
+  });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+  bench_dim<1024>(s, threads);
+  bench_dim<10000>(s, threads);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+}
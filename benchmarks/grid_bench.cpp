@@ -0,0 +1,120 @@
+// HyperStream 2D grid (image) encoder benchmark
+// Encodes synthetic 8-bit frames (gradient + moving blobs + noise) as the bundle of
+// column ^ row ^ intensity over all pixels, comparing the per-pixel loop applications write by
+// hand (Bind x2 + BinaryBundler) with GridEncoder (fused bind + bit-sliced add, row-band tiles).
+// Output lines:
+//   Grid/encode,dim_bits,width,height,path,threads,iters,secs,frames_per_sec,mpixels_per_sec
+//   path=hand_loop | fused; fused runs once with 1 thread and once with --threads when > 1.
+// Flags: --threads=N (GridEncoder executor threads; default 1)
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/grid.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::GridEncoder;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::ThreadExecutor;
+
+constexpr std::size_t kFrames = 4;  // distinct frames cycled through by the timed loop
+
+std::vector<std::vector<std::uint8_t>> make_frames(std::size_t width, std::size_t height) {
+  std::vector<std::vector<std::uint8_t>> frames(kFrames, std::vector<std::uint8_t>(width * height));
+  std::uint64_t state = 0x75ULL;
+  for (std::size_t f = 0; f < kFrames; ++f) {
+    const double cx = static_cast<double>(width) * (0.25 + 0.15 * static_cast<double>(f));
+    const double cy = static_cast<double>(height) * 0.5;
+    const double r2 = static_cast<double>(width * width) / 36.0;
+    for (std::size_t y = 0; y < height; ++y) {
+      for (std::size_t x = 0; x < width; ++x) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double dx = static_cast<double>(x) - cx;
+        const double dy = static_cast<double>(y) - cy;
+        double v = 96.0 * static_cast<double>(x + y) / static_cast<double>(width + height);
+        if (dx * dx + dy * dy < r2) v += 128.0;
+        v += static_cast<double>(state >> 60);  // 0..15 noise
+        frames[f][y * width + x] = static_cast<std::uint8_t>(std::min(255.0, v));
+      }
+    }
+  }
+  return frames;
+}
+
+void report(const Options& s, std::size_t dim, std::size_t width, std::size_t height, const char* path,
+            std::size_t threads, const std::vector<Sample>& samples) {
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double frames = static_cast<double>(smp.iters);
+    Record r("Grid/encode");
+    r.Add("dim_bits", dim).Add("width", width).Add("height", height).Add("path", path).Add("threads", threads);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("frames_per_sec", frames / smp.secs, 2)
+     .Add("mpixels_per_sec", frames * static_cast<double>(width * height) / smp.secs / 1e6, 2);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters * width * height);
+    r.Print(s.json);
+  }
+}
+
+template <std::size_t Dim>
+void bench_grid(const Options& s, std::size_t width, std::size_t height, std::size_t threads) {
+  const GridEncoder<Dim> enc(width, height);
+  const auto frames = make_frames(width, height);
+  HyperVector<Dim, bool> out;
+  std::size_t f = 0;
+
+  report(s, Dim, width, height, "hand_loop", 1, Measure(s, [&](volatile std::uint64_t* sink) {
+    const auto& img = frames[f++ % kFrames];
+    BinaryBundler<Dim> bundler;
+    HyperVector<Dim, bool> pos, bound;
+    for (std::size_t y = 0; y < height; ++y) {
+      for (std::size_t x = 0; x < width; ++x) {
+        hyperstream::core::Bind(enc.column(x), enc.row(y), &pos);
+        hyperstream::core::Bind(pos, enc.intensity(enc.IntensityLevel(img[y * width + x])), &bound);
+        bundler.Accumulate(bound);
+      }
+    }
+    bundler.Finalize(&out);
+    *sink ^= out.Words()[0];
+  }));
+  report(s, Dim, width, height, "fused", 1, Measure(s, [&](volatile std::uint64_t* sink) {
+    enc.Encode(frames[f++ % kFrames].data(), &out);
+    *sink ^= out.Words()[0];
+  }));
+  if (threads > 1) {
+    report(s, Dim, width, height, "fused", threads, Measure(s, [&](volatile std::uint64_t* sink) {
+      enc.Encode(frames[f++ % kFrames].data(), &out, ThreadExecutor{threads});
+      *sink ^= out.Words()[0];
+    }));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+  bench_grid<1024>(s, 1024, 1024, threads);  // 1M-pixel frames
+  bench_grid<10000>(s, 256, 256, threads);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+}
@@ -1,15 +1,18 @@
 // HyperStream Hamming distance microbenchmark (no external deps)
 // Measures throughput of Hamming distance for binary HyperVectors:
 //   core::HammingDistance (scalar), SSE2, and AVX2 (Harley–Seal)
+// For dimensions with compile-time-specialized kernels (backend::IsFixedDim), <backend>_generic rows
+// run the runtime word_count loop on the same data so the specialization speedup is visible.
 // Output: CSV-like: name,dimension_bits,bytes_per_iter,iterations,seconds,gb_per_sec
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
 
-#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <string>
 
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/core/ops.hpp"
+#include "bench_harness.hpp"
 #include "hyperstream/backend/policy.hpp"
 #if HS_X86_ARCH
 #include "hyperstream/backend/cpu_backend_sse2.hpp"
@@ -28,6 +31,8 @@ using hyperstream::backend::avx2::HammingDistanceAVX2;
 
 namespace {
 
+using hyperstream::bench::Options;
+
 template <std::size_t Dim>
 static inline std::size_t bytes_per_iteration() {
   constexpr std::size_t words = HyperVector<Dim, bool>::WordCount();
@@ -35,29 +40,10 @@ static inline std::size_t bytes_per_iteration() {
   return words * sizeof(std::uint64_t) * 2ULL;
 }
 
-template <typename Fn>
-static std::pair<std::size_t, double> run_for_ms(Fn&& fn, int min_ms) {
-  using clock = std::chrono::steady_clock;
-  const auto t0 = clock::now();
-  std::size_t iters = 0;
-  volatile std::size_t sink = 0;
-  do {
-    fn(&sink);
-    ++iters;
-  } while (std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - t0).count() < min_ms);
-  const double secs = std::chrono::duration<double>(clock::now() - t0).count();
-  if ((iters & 0xff) == 0) std::fprintf(stderr, "#sink=%zu\n", (size_t)sink);
-  return {iters, secs};
-}
-
 template <std::size_t Dim, typename DoDist>
-static void bench_impl(const char* name, DoDist&& do_dist) {
-  const std::size_t kBytesPerIter = bytes_per_iteration<Dim>();
-  auto [iters, secs] = run_for_ms(do_dist, 300);
-  const double total_bytes = static_cast<double>(kBytesPerIter) * static_cast<double>(iters);
-  const double gbps = (total_bytes / secs) / 1e9;
-  std::printf("%s,dim_bits=%zu,bytes_per_iter=%zu,iters=%zu,secs=%.6f,gb_per_sec=%.3f\n",
-              name, Dim, kBytesPerIter, iters, secs, gbps);
+static void bench_impl(const Options& opts, const char* name, DoDist&& do_dist) {
+  hyperstream::bench::ReportThroughput(opts, name, Dim, bytes_per_iteration<Dim>(),
+                                       hyperstream::bench::Measure(opts, do_dist));
 }
 
 template <std::size_t Dim>
@@ -69,44 +55,64 @@ static void init_vectors(HyperVector<Dim, bool>* a, HyperVector<Dim, bool>* b) {
 }
 
 template <std::size_t D>
-static void run_one() {
+static void run_one(const Options& opts) {
   HyperVector<D, bool> a, b;
   init_vectors(&a, &b);
 
-  bench_impl<D>("Hamming/core", [&](volatile std::size_t* sink) {
+  bench_impl<D>(opts, "Hamming/core", [&](volatile std::uint64_t* sink) {
     *sink ^= HammingDistance(a, b);
   });
 
+  constexpr bool kFixed = hyperstream::backend::IsFixedDim(D);
+  constexpr std::size_t kWords = HyperVector<D, bool>::WordCount();
+  (void)kWords;
+
 #if HS_X86_ARCH
-  bench_impl<D>("Hamming/sse2", [&](volatile std::size_t* sink) {
+  bench_impl<D>(opts, "Hamming/sse2", [&](volatile std::uint64_t* sink) {
     *sink ^= HammingDistanceSSE2(a, b);
   });
+  if constexpr (kFixed) {
+    bench_impl<D>(opts, "Hamming/sse2_generic", [&](volatile std::uint64_t* sink) {
+      *sink ^= hyperstream::backend::sse2::HammingWords(a.Words().data(), b.Words().data(), kWords);
+    });
+  }
 #endif
 
 #if defined(__AVX2__)
-  bench_impl<D>("Hamming/avx2", [&](volatile std::size_t* sink) {
+  bench_impl<D>(opts, "Hamming/avx2", [&](volatile std::uint64_t* sink) {
     *sink ^= HammingDistanceAVX2(a, b);
   });
+  if constexpr (kFixed) {
+    bench_impl<D>(opts, "Hamming/avx2_generic", [&](volatile std::uint64_t* sink) {
+      *sink ^= hyperstream::backend::avx2::HammingWords(a.Words().data(), b.Words().data(), kWords);
+    });
+  }
 #endif
 
 #if HS_ARM64_ARCH
-  bench_impl<D>("Hamming/neon", [&](volatile std::size_t* sink) {
+  bench_impl<D>(opts, "Hamming/neon", [&](volatile std::uint64_t* sink) {
     *sink ^= hyperstream::backend::neon::HammingDistanceNEON<D>(a, b);
   });
+  if constexpr (kFixed) {
+    bench_impl<D>(opts, "Hamming/neon_generic", [&](volatile std::uint64_t* sink) {
+      *sink ^= hyperstream::backend::neon::HammingWords(a.Words().data(), b.Words().data(), kWords);
+    });
+  }
 #endif
 }
 
 } // namespace
 
-int main() {
-  run_one<1024>();
-  run_one<2048>();
-  run_one<4096>();
-  run_one<8192>();
-  run_one<10000>();
-  run_one<16384>();
-  run_one<65536>();
-  run_one<262144>();
-  run_one<1048576>();
+int main(int argc, char** argv) {
+  const Options opts = hyperstream::bench::ParseArgs(argc, argv);
+  run_one<1024>(opts);
+  run_one<2048>(opts);
+  run_one<4096>(opts);
+  run_one<8192>(opts);
+  run_one<10000>(opts);
+  run_one<16384>(opts);
+  run_one<65536>(opts);
+  run_one<262144>(opts);
+  run_one<1048576>(opts);
   return 0;
 }
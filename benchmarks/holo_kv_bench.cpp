@@ -0,0 +1,186 @@
+// HyperStream holographic key-value store microbenchmark
+// Stores random (key, value) pairs over a codebook of random values and looks them up again.
+// Output lines:
+//   HoloKV/capacity,dim_bits,values,pairs,target,shards,pairs_per_shard,estimated_accuracy,accuracy,storage_bytes
+//     target=unsharded stores every pair in one memory vector (the hand-rolled bundle baseline)
+//   HoloKV/put,dim_bits,values,pairs,target,mode,threads,iters,secs,pairs_per_sec
+//     mode=put_loop (Put per pair) or put_batch (PutBatch, one executor task per shard)
+//   HoloKV/get,dim_bits,values,pairs,target,mode,threads,iters,secs,lookups_per_sec,accuracy
+//     mode=get_loop (Get per key: CleanupMemory scan, first 1000 keys), get_batch_portable /
+//     get_batch_selected (GetBatch with the portable or policy-selected tile kernel)
+// Flags: --threads=N (executor threads for put_batch / get_batch_selected; default 1)
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <vector>
+
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/holo_kv.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::HoloKVOptions;
+using hyperstream::memory::HoloKVStore;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::ThreadExecutor;
+
+constexpr std::size_t kPairs = 20000;
+constexpr std::size_t kLoopKeys = 1000;  // get_loop scans the codebook per key; time a prefix
+
+template <std::size_t Dim, std::size_t V>
+struct Workload {
+  std::vector<HyperVector<Dim, bool>> codebook = std::vector<HyperVector<Dim, bool>>(V);
+  std::vector<HyperVector<Dim, bool>> keys = std::vector<HyperVector<Dim, bool>>(kPairs);
+  std::vector<std::size_t> values = std::vector<std::size_t>(kPairs);
+
+  Workload() {
+    std::mt19937_64 rng(0x68ULL + Dim + V);
+    auto fill = [&rng](HyperVector<Dim, bool>* hv) {
+      for (auto& w : hv->Words()) w = rng();
+      if (Dim % 64 != 0) hv->Words().back() &= (1ULL << (Dim % 64)) - 1ULL;
+    };
+    for (auto& hv : codebook) fill(&hv);
+    for (std::size_t i = 0; i < kPairs; ++i) {
+      fill(&keys[i]);
+      values[i] = static_cast<std::size_t>(rng() % V);
+    }
+  }
+};
+
+template <std::size_t Dim, std::size_t V>
+double Accuracy(const Workload<Dim, V>& w, const std::vector<std::size_t>& got) {
+  std::size_t correct = 0;
+  for (std::size_t i = 0; i < kPairs; ++i) correct += got[i] == w.values[i] ? 1 : 0;
+  return static_cast<double>(correct) / static_cast<double>(kPairs);
+}
+
+void report(const Options& s, const char* name, std::size_t dim, std::size_t v, const char* target,
+            const char* mode, std::size_t threads, std::size_t items, const char* rate, double accuracy,
+            const std::vector<Sample>& samples) {
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    Record r(name);
+    r.Add("dim_bits", dim).Add("values", v).Add("pairs", kPairs).Add("target", target).Add("mode", mode)
+     .Add("threads", threads);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6)
+     .Add(rate, static_cast<double>(items) * static_cast<double>(smp.iters) / smp.secs, 1);
+    if (accuracy >= 0.0) r.Add("accuracy", accuracy, 4);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters * items);
+    r.Print(s.json);
+  }
+}
+
+template <std::size_t Dim, std::size_t V>
+HoloKVStore<Dim, V> MakeStore(const Workload<Dim, V>& w, const HoloKVOptions& options) {
+  HoloKVStore<Dim, V> store(options);
+  for (const auto& hv : w.codebook) (void)store.AddValue(hv);
+  return store;
+}
+
+// Capacity vs accuracy: one row per target, plus the single-bundle baseline.
+template <std::size_t Dim, std::size_t V>
+void bench_capacity(const Options& s, const Workload<Dim, V>& w) {
+  struct Target {
+    const char* label;
+    double accuracy;  // 0: unsharded
+  };
+  const Target targets[] = {{"unsharded", 0.0}, {"0.9", 0.9}, {"0.99", 0.99}, {"0.999", 0.999}};
+  for (const Target& target : targets) {
+    HoloKVOptions options;
+    options.expected_pairs = target.accuracy == 0.0 ? 1 : kPairs;  // one shard when unsharded
+    options.target_accuracy = target.accuracy == 0.0 ? 0.99 : target.accuracy;
+    HoloKVStore<Dim, V> store = MakeStore(w, options);
+    (void)store.PutBatch(w.keys.data(), w.values.data(), kPairs);
+    std::vector<std::size_t> got(kPairs);
+    store.GetBatch(w.keys.data(), kPairs, got.data(), hyperstream::backend::SelectHammingTileBackend());
+    Record r("HoloKV/capacity");
+    r.Add("dim_bits", Dim).Add("values", V).Add("pairs", kPairs)
+     .Add("target", target.label)
+     .Add("shards", store.shard_count()).Add("pairs_per_shard", store.pairs_per_shard())
+     .Add("estimated_accuracy", store.EstimatedAccuracy(), 4).Add("accuracy", Accuracy(w, got), 4)
+     .Add("storage_bytes", store.StorageBytes());
+    r.Print(s.json);
+  }
+}
+
+// Put/Get throughput at the default target accuracy.
+template <std::size_t Dim, std::size_t V>
+void bench_throughput(const Options& s, const Workload<Dim, V>& w, std::size_t threads) {
+  HoloKVOptions options;
+  options.expected_pairs = kPairs;
+  const char* target = "0.99";
+  {
+    HoloKVStore<Dim, V> store = MakeStore(w, options);
+    report(s, "HoloKV/put", Dim, V, target, "put_loop", 1, kPairs, "pairs_per_sec", -1.0,
+           Measure(s, [&](volatile std::uint64_t* sink) {
+             for (std::size_t i = 0; i < kPairs; ++i) *sink ^= store.Put(w.keys[i], w.values[i]) ? 1u : 0u;
+           }));
+  }
+  {
+    HoloKVStore<Dim, V> store = MakeStore(w, options);
+    report(s, "HoloKV/put", Dim, V, target, "put_batch", threads, kPairs, "pairs_per_sec", -1.0,
+           Measure(s, [&](volatile std::uint64_t* sink) {
+             *sink ^= store.PutBatch(w.keys.data(), w.values.data(), kPairs, ThreadExecutor{threads});
+           }));
+  }
+  HoloKVStore<Dim, V> store = MakeStore(w, options);
+  (void)store.PutBatch(w.keys.data(), w.values.data(), kPairs);
+  std::vector<std::size_t> got(kPairs);
+  auto get_loop = [&]() {
+    for (std::size_t i = 0; i < kLoopKeys; ++i) got[i] = store.Get(w.keys[i]);
+  };
+  get_loop();
+  std::size_t loop_correct = 0;
+  for (std::size_t i = 0; i < kLoopKeys; ++i) loop_correct += got[i] == w.values[i] ? 1 : 0;
+  report(s, "HoloKV/get", Dim, V, target, "get_loop", 1, kLoopKeys, "lookups_per_sec",
+         static_cast<double>(loop_correct) / static_cast<double>(kLoopKeys),
+         Measure(s, [&](volatile std::uint64_t* sink) {
+           get_loop();
+           *sink ^= got[0];
+         }));
+  auto run_batch = [&](const char* mode, hyperstream::backend::HammingTileFn tile, std::size_t mode_threads) {
+    store.GetBatch(w.keys.data(), kPairs, got.data(), tile, ThreadExecutor{mode_threads});
+    report(s, "HoloKV/get", Dim, V, target, mode, mode_threads, kPairs, "lookups_per_sec", Accuracy(w, got),
+           Measure(s, [&](volatile std::uint64_t* sink) {
+             store.GetBatch(w.keys.data(), kPairs, got.data(), tile, ThreadExecutor{mode_threads});
+             *sink ^= got[0];
+           }));
+  };
+  run_batch("get_batch_portable", &hyperstream::core::HammingTileWords, 1);
+  run_batch("get_batch_selected", hyperstream::backend::SelectHammingTileBackend(), threads);
+}
+
+template <std::size_t Dim, std::size_t V>
+void bench_all(const Options& s, std::size_t threads) {
+  const Workload<Dim, V> w;
+  bench_capacity(s, w);
+  bench_throughput(s, w, threads);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+  bench_all<2048, 256>(s, threads);
+  bench_all<10000, 1024>(s, threads);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+}
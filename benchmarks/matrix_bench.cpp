@@ -0,0 +1,174 @@
+// HyperStream all-pairs Hamming matrix microbenchmark
+// Compares a pairwise HammingDistance loop with the blocked, register-tiled HammingMatrix kernels
+// (portable / SSE2 / AVX2 / AVX-512 VPOPCNTDQ / NEON where available) and the top-k-per-row mode.
+// Output lines:
+//   Matrix/<mode>,dim_bits,n,m,kernel,threads[,k],iters,secs,pairs_per_sec,gbit_per_sec
+//   mode=pairwise|full|topk; gbit_per_sec counts the XOR-popcounted bits (pairs * Dim).
+// Flags: --large (top-k over N=M=100000 at Dim=256 and 1024, one timed pass each)
+//        --threads=N (row-block tasks run on N std::threads; default 1)
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hyperstream/backend/capability.hpp"
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/hamming_matrix.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::HammingMatrixOptions;
+using hyperstream::memory::HammingNeighbor;
+
+namespace {
+
+using hyperstream::backend::HammingTileFn;
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::Summarize;
+using hyperstream::bench::ThreadExecutor;
+
+struct Kernel {
+  const char* name;
+  HammingTileFn fn;
+};
+
+std::vector<Kernel> AvailableKernels() {
+  std::vector<Kernel> ks = {{"portable", &hyperstream::core::HammingTileWords}};
+#if HS_X86_ARCH && !defined(HYPERSTREAM_FORCE_SCALAR)
+  using hyperstream::backend::CpuFeature;
+  const std::uint32_t mask = hyperstream::backend::GetCpuFeatureMask();
+  if (hyperstream::backend::HasFeature(mask, CpuFeature::SSE2)) {
+    ks.push_back({"sse2", &hyperstream::backend::sse2::HammingTileWords});
+  }
+  if (hyperstream::backend::HasFeature(mask, CpuFeature::AVX2)) {
+    ks.push_back({"avx2", &hyperstream::backend::avx2::HammingTileWords});
+  }
+  if (hyperstream::backend::HasFeature(mask, CpuFeature::AVX512_VPOPCNTDQ)) {
+    ks.push_back({"avx512", &hyperstream::backend::avx512::HammingTileWords});
+  }
+#elif HS_ARM64_ARCH && !defined(HYPERSTREAM_FORCE_SCALAR)
+  ks.push_back({"neon", &hyperstream::backend::neon::HammingTileWords});
+#endif
+  return ks;
+}
+
+template <std::size_t Dim>
+std::vector<HyperVector<Dim, bool>> RandomSet(std::size_t n, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<HyperVector<Dim, bool>> v(n);
+  for (auto& hv : v) {
+    for (auto& w : hv.Words()) w = rng();
+    if (Dim % 64 != 0) hv.Words().back() &= (1ULL << (Dim % 64)) - 1ULL;
+  }
+  return v;
+}
+
+void report(const Options& s, const char* mode, std::size_t dim, std::size_t n, std::size_t m,
+            const char* kernel, std::size_t threads, std::size_t k, const std::vector<Sample>& samples) {
+  const double pairs = static_cast<double>(n) * static_cast<double>(m);
+  std::vector<double> pps_v;
+  auto head = [&](Record& r) {
+    r.Add("dim_bits", dim).Add("n", n).Add("m", m).Add("kernel", kernel).Add("threads", threads);
+    if (k) r.Add("k", k);
+  };
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double pps = pairs * static_cast<double>(smp.iters) / smp.secs;
+    pps_v.push_back(pps);
+    Record r(std::string("Matrix/") + mode);
+    head(r);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("pairs_per_sec", pps, 1)
+     .Add("gbit_per_sec", pps * static_cast<double>(dim) / 1e9, 1);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters);
+    r.Print(s.json);
+  }
+  if (s.samples > 1) {
+    Record agg(std::string("Matrix/") + mode);
+    head(agg);
+    agg.AddBool("aggregate", true).Add("samples", s.samples).Add("pairs_per_sec", Summarize(pps_v), 1);
+    agg.Print(s.json);
+  }
+}
+
+// N x N: pairwise selected-kernel loop vs every blocked kernel, then top-k with the selected one.
+template <std::size_t Dim>
+void bench_matrix(const Options& s, std::size_t n, std::size_t threads) {
+  const auto set = RandomSet<Dim>(n, 0x64ULL + n);
+  std::vector<std::uint32_t> out(n * n);
+  const auto hamming = hyperstream::backend::SelectHammingBackend<Dim>();
+  report(s, "pairwise", Dim, n, n, "selected", 1, 0, Measure(s, [&](volatile std::uint64_t* sink) {
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < n; ++j) out[i * n + j] = static_cast<std::uint32_t>(hamming(set[i], set[j]));
+    }
+    *sink ^= out[n + 1];
+  }));
+  const ThreadExecutor exec{threads};
+  for (const Kernel& kernel : AvailableKernels()) {
+    report(s, "full", Dim, n, n, kernel.name, threads, 0, Measure(s, [&](volatile std::uint64_t* sink) {
+      hyperstream::memory::HammingMatrix(set.data(), n, set.data(), n, out.data(), HammingMatrixOptions{},
+                                         kernel.fn, exec);
+      *sink ^= out[n + 1];
+    }));
+  }
+  constexpr std::size_t kK = 10;
+  std::vector<HammingNeighbor> nn(n * kK);
+  HammingMatrixOptions options;
+  options.skip_self = true;
+  report(s, "topk", Dim, n, n, "selected", threads, kK, Measure(s, [&](volatile std::uint64_t* sink) {
+    hyperstream::memory::HammingTopK(set.data(), n, set.data(), n, kK, nn.data(), options,
+                                     hyperstream::backend::SelectHammingTileBackend(), exec);
+    *sink ^= nn[0].index;
+  }));
+}
+
+// Top-k over N = M = 100000 (1e10 pairs): one timed pass with the selected kernel.
+template <std::size_t Dim>
+void bench_topk_large(const Options& s, std::size_t threads) {
+  constexpr std::size_t kN = 100000;
+  constexpr std::size_t kK = 10;
+  const auto set = RandomSet<Dim>(kN, 0x100000ULL);
+  std::vector<HammingNeighbor> nn(kN * kK);
+  HammingMatrixOptions options;
+  options.skip_self = true;
+  Options once = s;
+  once.warmup_ms = 0;
+  once.measure_ms = 0;
+  once.samples = 1;
+  report(once, "topk", Dim, kN, kN, "selected", threads, kK, Measure(once, [&](volatile std::uint64_t* sink) {
+    hyperstream::memory::HammingTopK(set.data(), kN, set.data(), kN, kK, nn.data(), options,
+                                     hyperstream::backend::SelectHammingTileBackend(), ThreadExecutor{threads});
+    *sink ^= nn[0].index;
+  }));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+  if (s.HasFlag("--large")) {
+    bench_topk_large<256>(s, threads);
+    bench_topk_large<1024>(s, threads);
+    return EXIT_SUCCESS;
+  }
+  bench_matrix<256>(s, 2048, threads);
+  bench_matrix<1024>(s, 2048, threads);
+  bench_matrix<10000>(s, 1024, threads);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+}
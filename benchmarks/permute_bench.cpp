@@ -2,19 +2,24 @@
 // Measures throughput of core::PermuteRotate (bitwise) and a bench-local
 // word-level rotate reference for binary HyperVectors.
 // Output lines: name,dim_bits,bytes_per_iter,iters,secs,gb_per_sec
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
 
-#include <chrono>
 #include <cstdint>
 #include <cstdio>
 
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/core/ops.hpp"
+#include "bench_harness.hpp"
 
 using hyperstream::core::HyperVector;
 using hyperstream::core::PermuteRotate;
 
 namespace {
 
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::ReportThroughput;
+
 template <std::size_t Dim>
 static inline std::size_t bytes_per_iteration() {
   constexpr std::size_t words = HyperVector<Dim, bool>::WordCount();
@@ -22,21 +27,6 @@ static inline std::size_t bytes_per_iteration() {
   return words * sizeof(std::uint64_t) * 2ULL;
 }
 
-template <typename Fn>
-static std::pair<std::size_t, double> run_for_ms(Fn&& fn, int min_ms) {
-  using clock = std::chrono::steady_clock;
-  const auto t0 = clock::now();
-  std::size_t iters = 0;
-  volatile std::uint64_t sink = 0;
-  do {
-    fn(&sink);
-    ++iters;
-  } while (std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - t0).count() < min_ms);
-  const double secs = std::chrono::duration<double>(clock::now() - t0).count();
-  if ((iters & 0xff) == 0) std::fprintf(stderr, "#sink=%llu\n", (unsigned long long)sink);
-  return {iters, secs};
-}
-
 template <std::size_t Dim>
 static void init_vectors(HyperVector<Dim, bool>* in) {
   in->Clear();
@@ -78,47 +68,38 @@ static inline void PermuteRotateWord_Ref(const HyperVector<Dim, bool>& in,
 }
 
 template <std::size_t Dim>
-static void bench_one_dim() {
+static void bench_one_dim(const Options& opts) {
   constexpr std::size_t kRotate = 13;
   HyperVector<Dim, bool> in, out;
   init_vectors(&in);
 
   // Core bitwise rotate
-  {
-    const std::size_t kBytesPerIter = bytes_per_iteration<Dim>();
-    auto [iters, secs] = run_for_ms([&](volatile std::uint64_t* sink) {
-      PermuteRotate(in, kRotate, &out);
-      *sink ^= in.Words()[0];
-    }, 300);
-    const double gbps = (static_cast<double>(kBytesPerIter) * iters / secs) / 1e9;
-    std::printf("Permute/core_bitrotate,dim_bits=%zu,bytes_per_iter=%zu,iters=%zu,secs=%.6f,gb_per_sec=%.3f\n",
-      Dim, kBytesPerIter, iters, secs, gbps);
-  }
+  ReportThroughput(opts, "Permute/core_bitrotate", Dim, bytes_per_iteration<Dim>(),
+                   Measure(opts, [&](volatile std::uint64_t* sink) {
+    PermuteRotate(in, kRotate, &out);
+    *sink ^= in.Words()[0];
+  }));
 
   // Word-level rotate reference
-  {
-    const std::size_t kBytesPerIter = bytes_per_iteration<Dim>();
-    auto [iters, secs] = run_for_ms([&](volatile std::uint64_t* sink) {
-      PermuteRotateWord_Ref(in, kRotate, &out);
-      *sink ^= in.Words()[0];
-    }, 300);
-    const double gbps = (static_cast<double>(kBytesPerIter) * iters / secs) / 1e9;
-    std::printf("Permute/word_rotate_ref,dim_bits=%zu,bytes_per_iter=%zu,iters=%zu,secs=%.6f,gb_per_sec=%.3f\n",
-      Dim, kBytesPerIter, iters, secs, gbps);
-  }
+  ReportThroughput(opts, "Permute/word_rotate_ref", Dim, bytes_per_iteration<Dim>(),
+                   Measure(opts, [&](volatile std::uint64_t* sink) {
+    PermuteRotateWord_Ref(in, kRotate, &out);
+    *sink ^= in.Words()[0];
+  }));
 }
 
 } // namespace
 
-int main() {
-  bench_one_dim<1024>();
-  bench_one_dim<2048>();
-  bench_one_dim<4096>();
-  bench_one_dim<8192>();
-  bench_one_dim<10000>();
-  bench_one_dim<16384>();
-  bench_one_dim<65536>();
-  bench_one_dim<262144>();
-  bench_one_dim<1048576>();
+int main(int argc, char** argv) {
+  const Options opts = hyperstream::bench::ParseArgs(argc, argv);
+  bench_one_dim<1024>(opts);
+  bench_one_dim<2048>(opts);
+  bench_one_dim<4096>(opts);
+  bench_one_dim<8192>(opts);
+  bench_one_dim<10000>(opts);
+  bench_one_dim<16384>(opts);
+  bench_one_dim<65536>(opts);
+  bench_one_dim<262144>(opts);
+  bench_one_dim<1048576>(opts);
   return 0;
 }
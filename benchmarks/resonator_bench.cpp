@@ -0,0 +1,182 @@
+// HyperStream resonator network microbenchmark
+// Factorizes synthetic products c_1[i_1] ^ c_2[i_2] ^ c_3[i_3] of random codewords.
+// Output lines:
+//   Resonator/factorize,dim_bits,factors,codebook,queries,mode,threads,iters,secs,queries_per_sec,
+//     iterations_per_sec,accuracy,converged_rate,mean_iterations
+//   mode=restore_loop (alternating CleanupMemory::Restore per factor, the hand-written baseline),
+//   batch_portable / batch_selected (memory::Resonator::FactorizeBatch with the portable or
+//   policy-selected tile kernel). accuracy = fraction of queries whose factors are all correct;
+//   iterations_per_sec counts resonator iterations (passes over all factors) summed over queries.
+// Flags: --threads=N (query blocks on N std::threads for batch_selected; default 1)
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/resonator.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::Resonator;
+using hyperstream::memory::ResonatorOutcome;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::ThreadExecutor;
+
+constexpr std::size_t kFactors = 3;
+constexpr std::size_t kQueries = 256;
+constexpr std::size_t kMaxIterations = 64;
+
+struct Quality {
+  double accuracy = 0.0;
+  double converged_rate = 0.0;
+  double mean_iterations = 0.0;
+};
+
+void report(const Options& s, std::size_t dim, std::size_t m, const char* mode, std::size_t threads,
+            const Quality& quality, const std::vector<Sample>& samples) {
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double qps = static_cast<double>(kQueries) * static_cast<double>(smp.iters) / smp.secs;
+    Record r("Resonator/factorize");
+    r.Add("dim_bits", dim).Add("factors", kFactors).Add("codebook", m).Add("queries", kQueries)
+     .Add("mode", mode).Add("threads", threads);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6).Add("queries_per_sec", qps, 1)
+     .Add("iterations_per_sec", qps * quality.mean_iterations, 1).Add("accuracy", quality.accuracy, 3)
+     .Add("converged_rate", quality.converged_rate, 3).Add("mean_iterations", quality.mean_iterations, 2);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters * kQueries);
+    r.Print(s.json);
+  }
+}
+
+template <std::size_t Dim, std::size_t M>
+void bench_resonator(const Options& s, std::size_t threads) {
+  std::mt19937_64 rng(0x67ULL + Dim + M);
+  std::vector<std::vector<HyperVector<Dim, bool>>> books(kFactors, std::vector<HyperVector<Dim, bool>>(M));
+  Resonator<Dim> resonator;
+  std::vector<std::unique_ptr<hyperstream::memory::CleanupMemory<Dim, M>>> cleanup;
+  for (auto& book : books) {
+    for (auto& hv : book) {
+      for (auto& w : hv.Words()) w = rng();
+      if (Dim % 64 != 0) hv.Words().back() &= (1ULL << (Dim % 64)) - 1ULL;
+    }
+    (void)resonator.AddCodebook(book.data(), M);
+    cleanup.push_back(std::make_unique<hyperstream::memory::CleanupMemory<Dim, M>>());
+    for (const auto& hv : book) (void)cleanup.back()->Insert(hv);
+  }
+  std::vector<std::uint32_t> truth(kQueries * kFactors);
+  std::vector<HyperVector<Dim, bool>> queries(kQueries);
+  for (std::size_t q = 0; q < kQueries; ++q) {
+    for (std::size_t f = 0; f < kFactors; ++f) truth[q * kFactors + f] = static_cast<std::uint32_t>(rng() % M);
+    resonator.Compose(&truth[q * kFactors], &queries[q]);
+  }
+
+  // Baseline: replace each estimate by the nearest codeword of the unbound query, factor by
+  // factor, until the estimates bind back to the query or stop changing.
+  std::vector<HyperVector<Dim, bool>> est(kFactors);
+  std::vector<std::uint32_t> loop_iterations(kQueries);
+  std::vector<bool> loop_exact(kQueries);
+  auto restore_loop = [&]() {
+    for (std::size_t q = 0; q < kQueries; ++q) {
+      for (std::size_t f = 0; f < kFactors; ++f) est[f] = books[f][0];
+      std::uint32_t it = 0;
+      bool exact = false;
+      bool changed = true;
+      while (it < kMaxIterations && changed && !exact) {
+        ++it;
+        changed = false;
+        for (std::size_t f = 0; f < kFactors; ++f) {
+          HyperVector<Dim, bool> unbound = queries[q];
+          for (std::size_t g = 0; g < kFactors; ++g) {
+            if (g != f) hyperstream::core::Bind(unbound, est[g], &unbound);
+          }
+          const HyperVector<Dim, bool> next = cleanup[f]->Restore(unbound, est[f]);
+          changed = changed || next.Words() != est[f].Words();
+          est[f] = next;
+        }
+        HyperVector<Dim, bool> composed = est[0];
+        for (std::size_t f = 1; f < kFactors; ++f) hyperstream::core::Bind(composed, est[f], &composed);
+        exact = composed.Words() == queries[q].Words();
+      }
+      loop_iterations[q] = it;
+      loop_exact[q] = exact;
+    }
+  };
+  restore_loop();
+  Quality loop_quality;
+  for (std::size_t q = 0; q < kQueries; ++q) {
+    loop_quality.accuracy += loop_exact[q] ? 1.0 : 0.0;  // random codewords: exact <=> correct
+    loop_quality.converged_rate += loop_exact[q] ? 1.0 : 0.0;
+    loop_quality.mean_iterations += loop_iterations[q];
+  }
+  loop_quality.accuracy /= kQueries;
+  loop_quality.converged_rate /= kQueries;
+  loop_quality.mean_iterations /= kQueries;
+  report(s, Dim, M, "restore_loop", 1, loop_quality, Measure(s, [&](volatile std::uint64_t* sink) {
+    restore_loop();
+    *sink ^= loop_iterations[0];
+  }));
+
+  hyperstream::memory::ResonatorOptions options;
+  options.max_iterations = kMaxIterations;
+  std::vector<std::uint32_t> found(kQueries * kFactors);
+  std::vector<ResonatorOutcome> outcomes(kQueries);
+  auto quality = [&]() {
+    Quality qy;
+    for (std::size_t q = 0; q < kQueries; ++q) {
+      qy.accuracy += std::equal(&found[q * kFactors], &found[q * kFactors] + kFactors, &truth[q * kFactors]) ? 1.0 : 0.0;
+      qy.converged_rate += outcomes[q].converged ? 1.0 : 0.0;
+      qy.mean_iterations += outcomes[q].iterations;
+    }
+    qy.accuracy /= kQueries;
+    qy.converged_rate /= kQueries;
+    qy.mean_iterations /= kQueries;
+    return qy;
+  };
+  auto run_batch = [&](const char* mode, hyperstream::backend::HammingTileFn tile, std::size_t mode_threads) {
+    auto batch = [&]() {
+      resonator.FactorizeBatch(queries.data(), kQueries, found.data(), outcomes.data(), options, tile,
+                               ThreadExecutor{mode_threads});
+    };
+    batch();
+    const Quality qy = quality();
+    report(s, Dim, M, mode, mode_threads, qy, Measure(s, [&](volatile std::uint64_t* sink) {
+      batch();
+      *sink ^= found[0];
+    }));
+  };
+  run_batch("batch_portable", &hyperstream::core::HammingTileWords, 1);
+  run_batch("batch_selected", hyperstream::backend::SelectHammingTileBackend(), threads);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+  bench_resonator<1024, 16>(s, threads);
+  bench_resonator<4096, 32>(s, threads);
+  bench_resonator<10000, 64>(s, threads);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+}
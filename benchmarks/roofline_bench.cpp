@@ -0,0 +1,387 @@
+// HyperStream roofline microbenchmark
+// Measures the host's roofs -- sustainable read and copy bandwidth per cache level (L1/L2/L3/DRAM)
+// and peak XOR / POPCNT throughput on L1-resident data -- then runs the core and policy-selected
+// kernels across dimensions and reports each one's achieved fraction of the roof for the regime
+// its working set lands in. All rates are GB/s of kernel input+output bytes.
+// Output lines:
+//   Roof/bandwidth,level,working_set_bytes,read_gb_per_sec,copy_gb_per_sec
+//   Roof/compute,isa,xor_gb_per_sec,popcount_gb_per_sec,popcount_kind
+//   Roofline/<kernel>,dim_bits,entries,working_set_bytes,level,bytes_per_iter,gb_per_sec,
+//     roof_gb_per_sec,bound,fraction_of_roof
+// Roof model: attainable = min(compute roof, memory roof at the working-set level). Read-only
+// kernels (Hamming, AM classify) use the read roof; kernels that write a result vector (Bind,
+// Permute) use the copy roof, which approximates their 2-read/1-write stream. Hamming kernels are
+// compute-capped by the scalar POPCNT loop, so a SIMD popcount can report fraction_of_roof > 1 in
+// the L1 regime. Cache sizes come from sysconf where available; override with --l1= --l2= --l3=
+// (bytes).
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/backend/policy.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::LargeArray;
+using hyperstream::memory::PrototypeMemory;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+
+enum Level { kL1 = 0, kL2 = 1, kL3 = 2, kDram = 3, kLevels = 4 };
+const char* const kLevelNames[kLevels] = {"L1", "L2", "L3", "DRAM"};
+
+struct CacheSizes {
+  std::size_t bytes[3] = {32u << 10, 1u << 20, 32u << 20};
+};
+
+static std::size_t flag_bytes(const Options& opts, const char* key, std::size_t fallback) {
+  const char* v = opts.FlagValue(key, nullptr);
+  if (!v) return fallback;
+  const unsigned long long n = std::strtoull(v, nullptr, 10);
+  return n ? static_cast<std::size_t>(n) : fallback;
+}
+
+static CacheSizes detect_caches(const Options& opts) {
+  CacheSizes c;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+  const long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+  const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (l1 > 0) c.bytes[0] = static_cast<std::size_t>(l1);
+  if (l2 > 0) c.bytes[1] = static_cast<std::size_t>(l2);
+  if (l3 > 0) c.bytes[2] = static_cast<std::size_t>(l3);
+#endif
+  c.bytes[0] = flag_bytes(opts, "--l1", c.bytes[0]);
+  c.bytes[1] = flag_bytes(opts, "--l2", c.bytes[1]);
+  c.bytes[2] = flag_bytes(opts, "--l3", c.bytes[2]);
+  return c;
+}
+
+static Level classify_level(const CacheSizes& c, std::size_t working_set) {
+  for (int l = 0; l < 3; ++l) {
+    if (working_set <= c.bytes[l]) return static_cast<Level>(l);
+  }
+  return kDram;
+}
+
+static std::vector<double> gbps(const std::vector<Sample>& samples, std::size_t bytes_per_iter) {
+  std::vector<double> v;
+  for (const auto& s : samples) v.push_back(static_cast<double>(bytes_per_iter) * s.iters / s.secs / 1e9);
+  return v;
+}
+
+// Kernels report the median sample; roofs report the best one, since a roof is what the host can
+// sustain when nothing else interferes.
+static double median_gbps(const std::vector<Sample>& samples, std::size_t bytes_per_iter) {
+  return hyperstream::bench::Summarize(gbps(samples, bytes_per_iter)).median;
+}
+
+static double best_gbps(const std::vector<Sample>& samples, std::size_t bytes_per_iter) {
+  const auto v = gbps(samples, bytes_per_iter);
+  return v.empty() ? 0.0 : *std::max_element(v.begin(), v.end());
+}
+
+static inline std::uint64_t splitmix64(std::uint64_t& x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  std::uint64_t z = x;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+static void fill_words(std::uint64_t* w, std::size_t n, std::uint64_t seed) {
+  for (std::size_t i = 0; i < n; ++i) w[i] = splitmix64(seed);
+}
+
+template <std::size_t Dim>
+static void fill_random(HyperVector<Dim, bool>* hv, std::uint64_t seed) {
+  auto& w = hv->Words();
+  fill_words(w.data(), w.size(), seed);
+  constexpr std::size_t extra_bits = HyperVector<Dim, bool>::WordCount() * 64ULL - Dim;
+  if constexpr (extra_bits > 0) w.back() &= ~0ULL >> extra_bits;
+}
+
+// ---- Roofs ----
+
+// Roof kernels are plain loops the compiler vectorizes; on x86 they are also built for AVX2 and
+// dispatched at runtime so the roof reflects the widest loads the host has, not the baseline ISA.
+#define HS_ROOF_READ_BODY                        \
+  std::uint64_t acc = 0;                         \
+  for (std::size_t i = 0; i < n; ++i) acc ^= p[i]; \
+  return acc;
+#define HS_ROOF_XOR_BODY \
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] ^ b[i];
+
+static std::uint64_t read_stream_base(const std::uint64_t* __restrict p, std::size_t n) { HS_ROOF_READ_BODY }
+static void xor_stream_base(const std::uint64_t* __restrict a, const std::uint64_t* __restrict b,
+                            std::uint64_t* __restrict out, std::size_t n) { HS_ROOF_XOR_BODY }
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HS_ROOF_X86_DISPATCH 1
+__attribute__((target("avx2")))
+static std::uint64_t read_stream_avx2(const std::uint64_t* __restrict p, std::size_t n) { HS_ROOF_READ_BODY }
+__attribute__((target("avx2")))
+static void xor_stream_avx2(const std::uint64_t* __restrict a, const std::uint64_t* __restrict b,
+                            std::uint64_t* __restrict out, std::size_t n) { HS_ROOF_XOR_BODY }
+#else
+#define HS_ROOF_X86_DISPATCH 0
+#endif
+#undef HS_ROOF_READ_BODY
+#undef HS_ROOF_XOR_BODY
+
+using ReadStreamFn = std::uint64_t (*)(const std::uint64_t*, std::size_t);
+using XorStreamFn = void (*)(const std::uint64_t*, const std::uint64_t*, std::uint64_t*, std::size_t);
+
+static bool host_has_avx2() {
+#if HS_ROOF_X86_DISPATCH
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+static ReadStreamFn select_read_stream() {
+#if HS_ROOF_X86_DISPATCH
+  if (host_has_avx2()) return &read_stream_avx2;
+#endif
+  return &read_stream_base;
+}
+
+static XorStreamFn select_xor_stream() {
+#if HS_ROOF_X86_DISPATCH
+  if (host_has_avx2()) return &xor_stream_avx2;
+#endif
+  return &xor_stream_base;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+__attribute__((target("popcnt")))
+static std::uint64_t popcount_stream_hw(const std::uint64_t* a, const std::uint64_t* b, std::size_t n) {
+  std::uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    c0 += static_cast<std::uint64_t>(__builtin_popcountll(a[i] ^ b[i]));
+    c1 += static_cast<std::uint64_t>(__builtin_popcountll(a[i + 1] ^ b[i + 1]));
+    c2 += static_cast<std::uint64_t>(__builtin_popcountll(a[i + 2] ^ b[i + 2]));
+    c3 += static_cast<std::uint64_t>(__builtin_popcountll(a[i + 3] ^ b[i + 3]));
+  }
+  for (; i < n; ++i) c0 += static_cast<std::uint64_t>(__builtin_popcountll(a[i] ^ b[i]));
+  return c0 + c1 + c2 + c3;
+}
+#endif
+
+static std::uint64_t popcount_stream(const std::uint64_t* a, const std::uint64_t* b, std::size_t n) {
+  std::uint64_t c0 = 0, c1 = 0;
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    c0 += hyperstream::core::detail::Popcount64(a[i] ^ b[i]);
+    c1 += hyperstream::core::detail::Popcount64(a[i + 1] ^ b[i + 1]);
+  }
+  for (; i < n; ++i) c0 += hyperstream::core::detail::Popcount64(a[i] ^ b[i]);
+  return c0 + c1;
+}
+
+struct Roofs {
+  double read[kLevels] = {};
+  double copy[kLevels] = {};
+  double xor_peak = 0.0;
+  double popcount_peak = 0.0;
+};
+
+static std::size_t level_probe_bytes(const CacheSizes& c, Level l) {
+  // Half of each cache level, so the probe stays resident without competing with the level's
+  // other occupants. DRAM: 4x LLC, at least 64 MiB, so neither the LLC nor prefetchers can hide it.
+  if (l == kDram) return std::max<std::size_t>(4 * c.bytes[2], 64u << 20);
+  return c.bytes[l] / 2;
+}
+
+static Roofs measure_roofs(const Options& kernel_opts, const CacheSizes& caches) {
+  Options opts = kernel_opts;
+  opts.samples = std::max(opts.samples, 3);
+  Roofs r;
+  const ReadStreamFn read_stream = select_read_stream();
+  for (int l = 0; l < kLevels; ++l) {
+    const std::size_t bytes = level_probe_bytes(caches, static_cast<Level>(l));
+    const std::size_t n = bytes / sizeof(std::uint64_t);
+    // Copy probe uses two buffers of half the working set each.
+    LargeArray<std::uint64_t> src(n), dst(n / 2 ? n / 2 : 1);
+    fill_words(src.data(), n, 0xB1u + static_cast<std::uint64_t>(l));
+    r.read[l] = best_gbps(Measure(opts, [&](volatile std::uint64_t* sink) {
+      *sink ^= read_stream(src.data(), n);
+    }), n * sizeof(std::uint64_t));
+    const std::size_t half = n / 2;
+    r.copy[l] = best_gbps(Measure(opts, [&](volatile std::uint64_t* sink) {
+      std::memcpy(dst.data(), src.data(), half * sizeof(std::uint64_t));
+      *sink ^= dst[0];
+    }), 2 * half * sizeof(std::uint64_t));
+    Record rec("Roof/bandwidth");
+    rec.Add("level", kLevelNames[l]).Add("working_set_bytes", bytes)
+       .Add("read_gb_per_sec", r.read[l], 3).Add("copy_gb_per_sec", r.copy[l], 3);
+    rec.Print(opts.json);
+  }
+
+  // Compute roofs on a quarter of L1 so loads never leave the first level.
+  const std::size_t n = std::max<std::size_t>(caches.bytes[0] / 4 / 3 / sizeof(std::uint64_t), 64);
+  LargeArray<std::uint64_t> a(n), b(n), out(n);
+  fill_words(a.data(), n, 1);
+  fill_words(b.data(), n, 2);
+  const XorStreamFn xor_stream = select_xor_stream();
+  r.xor_peak = best_gbps(Measure(opts, [&](volatile std::uint64_t* sink) {
+    xor_stream(a.data(), b.data(), out.data(), n);
+    *sink ^= out[0];
+  }), 3 * n * sizeof(std::uint64_t));
+  const char* popcount_kind = "portable";
+  auto popcount_fn = &popcount_stream;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  if (__builtin_cpu_supports("popcnt")) {
+    popcount_fn = &popcount_stream_hw;
+    popcount_kind = "popcnt";
+  }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  popcount_kind = "cnt";
+#endif
+  r.popcount_peak = best_gbps(Measure(opts, [&](volatile std::uint64_t* sink) {
+    *sink ^= popcount_fn(a.data(), b.data(), n);
+  }), 2 * n * sizeof(std::uint64_t));
+  Record rec("Roof/compute");
+  rec.Add("isa", host_has_avx2() ? "avx2" : "baseline").Add("xor_gb_per_sec", r.xor_peak, 3).Add("popcount_gb_per_sec", r.popcount_peak, 3)
+     .Add("popcount_kind", popcount_kind);
+  rec.Print(opts.json);
+  return r;
+}
+
+// ---- Kernels ----
+
+enum class Traffic { ReadOnly, ReadWrite };
+enum class Compute { None, Xor, Popcount };
+
+struct Context {
+  const Options* opts;
+  CacheSizes caches;
+  Roofs roofs;
+};
+
+static void report_kernel(const Context& ctx, const char* name, std::size_t dim_bits, std::size_t entries,
+                          std::size_t working_set, std::size_t bytes_per_iter, Traffic traffic,
+                          Compute compute, const std::vector<Sample>& samples) {
+  const Level level = classify_level(ctx.caches, working_set);
+  const double mem_roof = traffic == Traffic::ReadOnly ? ctx.roofs.read[level] : ctx.roofs.copy[level];
+  double compute_roof = 0.0;
+  if (compute == Compute::Xor) compute_roof = ctx.roofs.xor_peak;
+  if (compute == Compute::Popcount) compute_roof = ctx.roofs.popcount_peak;
+  const bool compute_bound = compute_roof > 0.0 && compute_roof < mem_roof;
+  const double roof = compute_bound ? compute_roof : mem_roof;
+  const double achieved = median_gbps(samples, bytes_per_iter);
+  Record r(name);
+  r.Add("dim_bits", dim_bits).Add("entries", entries).Add("working_set_bytes", working_set)
+   .Add("level", kLevelNames[level]).Add("bytes_per_iter", bytes_per_iter)
+   .Add("gb_per_sec", achieved, 3).Add("roof_gb_per_sec", roof, 3)
+   .Add("bound", compute_bound ? "compute" : "memory")
+   .Add("fraction_of_roof", roof > 0.0 ? achieved / roof : 0.0, 3);
+  r.Print(ctx.opts->json);
+}
+
+template <std::size_t Dim>
+static void bench_streaming(const Context& ctx) {
+  using HV = HyperVector<Dim, bool>;
+  // Heap-resident: the largest dims do not fit on the stack.
+  LargeArray<HV> v(3);
+  fill_random(&v[0], 11);
+  fill_random(&v[1], 22);
+  const std::size_t vb = HV::WordCount() * sizeof(std::uint64_t);
+  const Options& opts = *ctx.opts;
+
+  report_kernel(ctx, "Roofline/bind_core", Dim, 1, 3 * vb, 3 * vb, Traffic::ReadWrite, Compute::Xor,
+                Measure(opts, [&](volatile std::uint64_t* sink) {
+                  hyperstream::core::Bind(v[0], v[1], &v[2]);
+                  *sink ^= v[2].Words()[0];
+                }));
+  const auto bind_fn = hyperstream::backend::SelectBindBackend<Dim>();
+  report_kernel(ctx, "Roofline/bind_selected", Dim, 1, 3 * vb, 3 * vb, Traffic::ReadWrite, Compute::Xor,
+                Measure(opts, [&](volatile std::uint64_t* sink) {
+                  bind_fn(v[0], v[1], &v[2]);
+                  *sink ^= v[2].Words()[0];
+                }));
+  report_kernel(ctx, "Roofline/hamming_core", Dim, 1, 2 * vb, 2 * vb, Traffic::ReadOnly, Compute::Popcount,
+                Measure(opts, [&](volatile std::uint64_t* sink) {
+                  *sink ^= hyperstream::core::HammingDistance(v[0], v[1]);
+                }));
+  const auto hamming_fn = hyperstream::backend::SelectHammingBackend<Dim>();
+  report_kernel(ctx, "Roofline/hamming_selected", Dim, 1, 2 * vb, 2 * vb, Traffic::ReadOnly, Compute::Popcount,
+                Measure(opts, [&](volatile std::uint64_t* sink) {
+                  *sink ^= hamming_fn(v[0], v[1]);
+                }));
+  report_kernel(ctx, "Roofline/permute_core", Dim, 1, 2 * vb, 2 * vb, Traffic::ReadWrite, Compute::None,
+                Measure(opts, [&](volatile std::uint64_t* sink) {
+                  hyperstream::core::PermuteRotate(v[0], 13, &v[2]);
+                  *sink ^= v[2].Words()[0];
+                }));
+}
+
+template <std::size_t Dim, std::size_t Capacity>
+static void bench_classify(const Context& ctx) {
+  using HV = HyperVector<Dim, bool>;
+  auto am = std::make_unique<PrototypeMemory<Dim, Capacity>>();
+  HV hv;
+  for (std::size_t i = 0; i < Capacity; ++i) {
+    fill_random(&hv, 1000 + i);
+    (void)am->Learn(i + 1, hv);
+  }
+  fill_random(&hv, 7);
+  const std::size_t vb = HV::WordCount() * sizeof(std::uint64_t);
+  const std::size_t working_set = (Capacity + 1) * vb;
+  report_kernel(ctx, "Roofline/am_classify", Dim, Capacity, working_set, working_set, Traffic::ReadOnly,
+                Compute::Popcount, Measure(*ctx.opts, [&](volatile std::uint64_t* sink) {
+                  *sink ^= am->Classify(hv, 0);
+                }));
+  const auto hamming_fn = hyperstream::backend::SelectHammingBackend<Dim>();
+  report_kernel(ctx, "Roofline/am_classify_selected", Dim, Capacity, working_set, working_set, Traffic::ReadOnly,
+                Compute::Popcount, Measure(*ctx.opts, [&](volatile std::uint64_t* sink) {
+                  *sink ^= am->Classify(hv, hamming_fn, 0);
+                }));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options defaults;
+  defaults.measure_ms = 150;
+  const Options opts = hyperstream::bench::ParseArgs(argc, argv, defaults);
+  Context ctx;
+  ctx.opts = &opts;
+  ctx.caches = detect_caches(opts);
+  ctx.roofs = measure_roofs(opts, ctx.caches);
+
+  // 1 Kib .. 128 Mib vectors: L1-resident through DRAM-resident for typical hosts.
+  bench_streaming<1024>(ctx);
+  bench_streaming<10000>(ctx);
+  bench_streaming<262144>(ctx);
+  bench_streaming<4194304>(ctx);
+  bench_streaming<134217728>(ctx);
+
+  bench_classify<10000, 16>(ctx);
+  bench_classify<10000, 256>(ctx);
+  bench_classify<10000, 4096>(ctx);
+  bench_classify<10000, 65536>(ctx);
+  return 0;
+}
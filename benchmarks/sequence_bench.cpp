@@ -0,0 +1,222 @@
+// HyperStream sequence prediction microbenchmark
+// Learns next-symbol prediction from an order-3 source over 16 symbols (the successor is a fixed
+// random function of the last 3 symbols, replaced by a random symbol 10% of the time) and predicts
+// a held-out continuation. accuracy = fraction of predictions equal to the source's successor.
+// Output lines:
+//   Sequence/learn,dim_bits,window,alphabet,symbols,mode,iters,secs,symbols_per_sec[,learn_rate]
+//   Sequence/predict,dim_bits,window,alphabet,symbols,mode,threads,iters,secs,predictions_per_sec,accuracy
+//   mode=hash_map (std::unordered_map from the packed symbol tuple to successor counts, the
+//   non-hypervector baseline), bundled_* / prototype_* (SequenceMemory storage forms); *_loop uses
+//   Observe / Predict+Advance per symbol, *_batch PredictSequence with the policy-selected tile kernel.
+//   *_observe is the default mistake-driven Observe: every call runs a Predict (for bundled storage
+//   a HoloKVStore::Get), and learn_rate is the fraction of a cold pass over the training stream that
+//   was mispredicted and stored. *_observe_all stores every observation (learn_on_error=false).
+// Flags: --threads=N (executor threads for the *_batch modes; default 1)
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/memory/sequence.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::memory::SequenceMemory;
+using hyperstream::memory::SequenceMemoryOptions;
+using hyperstream::memory::SequenceStorage;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::ThreadExecutor;
+
+constexpr std::size_t kWindow = 3;
+constexpr std::size_t kAlphabet = 16;
+constexpr std::size_t kSymbols = 20000;  // per training and per test stream
+
+struct Streams {
+  std::vector<std::uint64_t> train;
+  std::vector<std::uint64_t> test;
+  std::vector<std::uint64_t> expected;  // successor of the source for each test position
+};
+
+Streams MakeStreams() {
+  std::mt19937_64 rng(0x69);
+  std::vector<std::uint64_t> table(kAlphabet * kAlphabet * kAlphabet);
+  for (auto& t : table) t = rng() % kAlphabet;
+  std::array<std::uint64_t, kWindow> recent{0, 1, 2};
+  auto next = [&](std::uint64_t* expected) {
+    *expected = table[(recent[0] * kAlphabet + recent[1]) * kAlphabet + recent[2]];
+    const std::uint64_t s = (rng() % 10 == 0) ? rng() % kAlphabet : *expected;
+    recent = {recent[1], recent[2], s};
+    return s;
+  };
+  Streams streams;
+  std::uint64_t expected = 0;
+  for (std::size_t t = 0; t < kSymbols; ++t) streams.train.push_back(next(&expected));
+  for (std::size_t t = 0; t < kSymbols; ++t) {
+    streams.test.push_back(next(&expected));
+    streams.expected.push_back(expected);
+  }
+  return streams;
+}
+
+double Accuracy(const Streams& streams, const std::vector<std::uint64_t>& predicted) {
+  std::size_t correct = 0;
+  for (std::size_t t = 0; t < kSymbols; ++t) correct += predicted[t] == streams.expected[t] ? 1 : 0;
+  return static_cast<double>(correct) / static_cast<double>(kSymbols - kWindow);
+}
+
+void report(const Options& s, const char* name, std::size_t dim, const char* mode, std::size_t threads,
+            const char* rate, const char* metric, double value, const std::vector<Sample>& samples) {
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    Record r(name);
+    r.Add("dim_bits", dim).Add("window", kWindow).Add("alphabet", kAlphabet).Add("symbols", kSymbols)
+     .Add("mode", mode);
+    if (threads > 0) r.Add("threads", threads);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6)
+     .Add(rate, static_cast<double>(kSymbols) * static_cast<double>(smp.iters) / smp.secs, 1);
+    if (value >= 0.0) r.Add(metric, value, 4);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters * kSymbols);
+    r.Print(s.json);
+  }
+}
+
+// Baseline: successor counts per packed context tuple.
+void bench_hash_map(const Options& s, const Streams& streams) {
+  using Counts = std::array<std::uint32_t, kAlphabet>;
+  std::unordered_map<std::uint64_t, Counts> table;
+  auto learn = [&]() {
+    std::uint64_t key = 0;
+    for (std::size_t t = 0; t < kSymbols; ++t) {
+      if (t >= kWindow) ++table[key][streams.train[t]];
+      key = ((key << 8) | streams.train[t]) & 0xffffffULL;
+    }
+  };
+  learn();
+  report(s, "Sequence/learn", 0, "hash_map", 0, "symbols_per_sec", "", -1.0,
+         Measure(s, [&](volatile std::uint64_t* sink) {
+           learn();
+           *sink ^= table.size();
+         }));
+  std::vector<std::uint64_t> predicted(kSymbols);
+  auto predict = [&]() {
+    std::uint64_t key = 0;
+    for (std::size_t t = 0; t < kSymbols; ++t) {
+      predicted[t] = static_cast<std::uint64_t>(-1);
+      if (t >= kWindow) {
+        const auto it = table.find(key);
+        if (it != table.end()) {
+          predicted[t] = static_cast<std::uint64_t>(std::max_element(it->second.begin(), it->second.end()) -
+                                                    it->second.begin());
+        }
+      }
+      key = ((key << 8) | streams.test[t]) & 0xffffffULL;
+    }
+  };
+  predict();
+  report(s, "Sequence/predict", 0, "hash_map", 1, "predictions_per_sec", "accuracy", Accuracy(streams, predicted),
+         Measure(s, [&](volatile std::uint64_t* sink) {
+           predict();
+           *sink ^= predicted[kWindow];
+         }));
+}
+
+// Fraction of the training stream a fresh memory mispredicts (and so stores) on one pass.
+template <std::size_t Dim, SequenceStorage Storage>
+double LearnRate(const SequenceMemoryOptions& options, const Streams& streams) {
+  SequenceMemory<Dim, kWindow, kAlphabet, Storage> memory(options);
+  std::size_t stored = 0;
+  for (std::size_t t = 0; t < kSymbols; ++t) {
+    if (t >= kWindow && memory.Predict() != streams.train[t]) ++stored;
+    (void)memory.Observe(streams.train[t]);
+  }
+  return static_cast<double>(stored) / static_cast<double>(kSymbols - kWindow);
+}
+
+template <std::size_t Dim, SequenceStorage Storage>
+void bench_observe(const Options& s, const Streams& streams, const SequenceMemoryOptions& options,
+                   const char* mode, double learn_rate) {
+  SequenceMemory<Dim, kWindow, kAlphabet, Storage> learner(options);
+  report(s, "Sequence/learn", Dim, mode, 0, "symbols_per_sec", "learn_rate", learn_rate,
+         Measure(s, [&](volatile std::uint64_t* sink) {
+           for (std::uint64_t sym : streams.train) *sink ^= learner.Observe(sym) ? 1u : 0u;
+         }));
+}
+
+template <std::size_t Dim, SequenceStorage Storage>
+void bench_memory(const Options& s, const Streams& streams, std::size_t threads, const char* learn_mode,
+                  const char* learn_all_mode, const char* loop_mode, const char* batch_mode) {
+  SequenceMemoryOptions options;
+  options.bundled.expected_pairs = kSymbols;
+  bench_observe<Dim, Storage>(s, streams, options, learn_mode, LearnRate<Dim, Storage>(options, streams));
+  SequenceMemoryOptions all = options;
+  all.learn_on_error = false;
+  bench_observe<Dim, Storage>(s, streams, all, learn_all_mode, -1.0);
+  SequenceMemory<Dim, kWindow, kAlphabet, Storage> memory(options);
+  for (std::uint64_t sym : streams.train) (void)memory.Observe(sym);
+  std::vector<std::uint64_t> predicted(kSymbols);
+  auto loop = [&]() {
+    memory.ResetContext();
+    for (std::size_t t = 0; t < kSymbols; ++t) {
+      predicted[t] = memory.Predict();
+      memory.Advance(streams.test[t]);
+    }
+  };
+  loop();
+  report(s, "Sequence/predict", Dim, loop_mode, 1, "predictions_per_sec", "accuracy", Accuracy(streams, predicted),
+         Measure(s, [&](volatile std::uint64_t* sink) {
+           loop();
+           *sink ^= predicted[kWindow];
+         }));
+  const auto tile = hyperstream::backend::SelectHammingTileBackend();
+  auto batch = [&]() {
+    memory.ResetContext();
+    memory.PredictSequence(streams.test.data(), kSymbols, predicted.data(), tile, ThreadExecutor{threads});
+  };
+  batch();
+  report(s, "Sequence/predict", Dim, batch_mode, threads, "predictions_per_sec", "accuracy", Accuracy(streams, predicted),
+         Measure(s, [&](volatile std::uint64_t* sink) {
+           batch();
+           *sink ^= predicted[kWindow];
+         }));
+}
+
+template <std::size_t Dim>
+void bench_dim(const Options& s, const Streams& streams, std::size_t threads) {
+  bench_memory<Dim, SequenceStorage::kBundled>(s, streams, threads, "bundled_observe", "bundled_observe_all",
+                                               "bundled_loop",
+                                               "bundled_batch");
+  bench_memory<Dim, SequenceStorage::kPrototype>(s, streams, threads, "prototype_observe",
+                                                 "prototype_observe_all", "prototype_loop",
+                                                 "prototype_batch");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+  const Streams streams = MakeStreams();
+  bench_hash_map(s, streams);
+  bench_dim<2048>(s, streams, threads);
+  bench_dim<10000>(s, streams, threads);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+}
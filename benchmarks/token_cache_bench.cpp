@@ -0,0 +1,130 @@
+// HyperStream token interning cache microbenchmark
+// Encodes a Zipf-distributed token stream (s = 1.3 over 100k distinct tokens: the 1k most frequent
+// tokens carry ~89% of the traffic) with SymbolEncoder and with CachedSymbolEncoder.
+// Output lines:
+//   TokenCache/encode,dim_bits,capacity,mode,threads,iters,secs,tokens_per_sec,ns_per_token,hit_rate
+//   mode=uncached (SymbolEncoder: hash + SplitMix64 generation per call), clock (CachedSymbolEncoder
+//   without admission), tinylfu (CLOCK eviction + TinyLFU admission). hit_rate covers warmup and
+//   measured iterations.
+// Flags: --threads=N (encoding threads sharing one cache; default 1)
+// Common harness flags (bench_harness.hpp): --warmup_ms= --measure_ms= --samples= --json --pin_cpu= --perf_counters
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/encoding/symbol.hpp"
+#include "hyperstream/encoding/token_cache.hpp"
+#include "bench_harness.hpp"
+
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::CachedSymbolEncoder;
+using hyperstream::encoding::SymbolEncoder;
+using hyperstream::encoding::TokenCacheOptions;
+
+namespace {
+
+using hyperstream::bench::Measure;
+using hyperstream::bench::Options;
+using hyperstream::bench::Record;
+using hyperstream::bench::Sample;
+using hyperstream::bench::ThreadExecutor;
+
+constexpr std::size_t kVocab = 100000;
+constexpr std::size_t kStream = 1 << 18;
+constexpr std::size_t kChunk = 4096;  // tokens per executor task
+constexpr double kZipfS = 1.3;
+constexpr std::uint64_t kSeed = 0x71ULL;
+
+struct Workload {
+  std::vector<std::string> vocab;
+  std::vector<std::size_t> stream;
+
+  Workload() {
+    for (std::size_t i = 0; i < kVocab; ++i) vocab.push_back("user:" + std::to_string(i * 7919 % kVocab) + "/event");
+    std::vector<double> cdf(kVocab);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < kVocab; ++i) cdf[i] = (sum += std::pow(static_cast<double>(i + 1), -kZipfS));
+    std::mt19937_64 rng(0x71);
+    std::uniform_real_distribution<double> u(0.0, sum);
+    stream.resize(kStream);
+    for (auto& s : stream) s = static_cast<std::size_t>(std::lower_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin());
+  }
+};
+
+void report(const Options& s, std::size_t dim, std::size_t capacity, const char* mode, std::size_t threads,
+            double hit_rate, const std::vector<Sample>& samples) {
+  for (std::size_t si = 0; si < samples.size(); ++si) {
+    const auto& smp = samples[si];
+    const double tokens = static_cast<double>(kStream) * static_cast<double>(smp.iters);
+    Record r("TokenCache/encode");
+    r.Add("dim_bits", dim).Add("capacity", capacity).Add("mode", mode).Add("threads", threads);
+    if (!s.json && s.samples > 1) r.Add("sample", static_cast<int>(si));
+    r.Add("iters", smp.iters).Add("secs", smp.secs, 6)
+     .Add("tokens_per_sec", tokens / smp.secs, 1).Add("ns_per_token", smp.secs * 1e9 / tokens, 1);
+    if (hit_rate >= 0.0) r.Add("hit_rate", hit_rate, 4);
+    if (s.json) r.Add("sample_index", static_cast<int>(si)).Add("warmup_ms", s.warmup_ms).Add("measure_ms", s.measure_ms);
+    r.Add(smp.counters, smp.iters * kStream);
+    r.Print(s.json);
+  }
+}
+
+// Runs `encode(token, out)` over the whole stream, kChunk tokens per executor task.
+template <std::size_t Dim, typename Encode>
+std::vector<Sample> run(const Options& s, const Workload& w, std::size_t threads, Encode&& encode) {
+  return Measure(s, [&](volatile std::uint64_t* sink) {
+    ThreadExecutor{threads}((kStream + kChunk - 1) / kChunk, [&](std::size_t t) {
+      HyperVector<Dim, bool> hv;
+      std::uint64_t acc = 0;
+      const std::size_t end = std::min(kStream, (t + 1) * kChunk);
+      for (std::size_t i = t * kChunk; i < end; ++i) {
+        encode(w.vocab[w.stream[i]], &hv);
+        acc ^= hv.Words()[0];
+      }
+      if (t == 0) *sink ^= acc;
+    });
+  });
+}
+
+template <std::size_t Dim>
+void bench_dim(const Options& s, const Workload& w, std::size_t threads) {
+  const SymbolEncoder<Dim> plain(kSeed);
+  report(s, Dim, 0, "uncached", threads, -1.0,
+         run<Dim>(s, w, threads, [&](const std::string& token, HyperVector<Dim, bool>* out) {
+           plain.EncodeToken(token, out);
+         }));
+  for (std::size_t capacity : {256, 1024, 4096}) {
+    for (bool admission : {false, true}) {
+      TokenCacheOptions options;
+      options.capacity = capacity;
+      options.admission = admission;
+      const CachedSymbolEncoder<Dim> cached(kSeed, options);
+      const auto samples = run<Dim>(s, w, threads, [&](const std::string& token, HyperVector<Dim, bool>* out) {
+        cached.EncodeToken(token, out);
+      });
+      report(s, Dim, capacity, admission ? "tinylfu" : "clock", threads, cached.stats().HitRate(), samples);
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+  setvbuf(stdout, nullptr, _IONBF, 0);
+  const Options s = hyperstream::bench::ParseArgs(argc, argv);
+  const std::size_t threads = std::max<std::size_t>(1, std::strtoull(s.FlagValue("--threads", "1"), nullptr, 10));
+  const Workload w;
+  bench_dim<1024>(s, w, threads);
+  bench_dim<10000>(s, w, threads);
+  return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+  std::fprintf(stderr, "ERROR: %s\n", e.what());
+  return EXIT_FAILURE;
+}
@@ -20,6 +20,7 @@ enum class CpuFeature : std::uint32_t {
   SSE2 = 0x1,
   AVX2 = 0x2,
   NEON = 0x4,
+  AVX512_VPOPCNTDQ = 0x8,  // AVX-512F + VPOPCNTDQ with ZMM state enabled by the OS
 };
 
 inline bool HasFeature(std::uint32_t mask, CpuFeature f) {
@@ -92,6 +93,35 @@ inline bool DetectAVX2() {
 #endif
 }
 
+inline bool DetectAVX512VPOPCNTDQ() {
+#if !(defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64))
+  return false;
+#else
+  unsigned int eax, ebx, ecx, edx;
+#if defined(_MSC_VER)
+  int regs[4];
+  __cpuid(regs, 1);
+  eax = regs[0]; ebx = regs[1]; ecx = regs[2]; edx = regs[3];
+#elif defined(__GNUC__) || defined(__clang__)
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+#endif
+  if ((ecx & (1u << 27)) == 0u) return false;  // OSXSAVE
+
+  // XCR0 must enable YMM (bits 1-2) and the opmask/ZMM state (bits 5-7)
+  if ((xgetbv_xcr0() & 0xE6) != 0xE6) return false;
+
+  // CPUID.7.0: EBX bit 16 AVX512F, ECX bit 14 AVX512_VPOPCNTDQ
+#if defined(_MSC_VER)
+  int regs7[4];
+  __cpuidex(regs7, 7, 0);
+  eax = regs7[0]; ebx = regs7[1]; ecx = regs7[2]; edx = regs7[3];
+#elif defined(__GNUC__) || defined(__clang__)
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+#endif
+  return (ebx & (1u << 16)) != 0u && (ecx & (1u << 14)) != 0u;
+#endif
+}
+
 inline bool DetectNEON() {
 #if defined(__aarch64__) || defined(_M_ARM64)
   // Advanced SIMD is mandatory in AArch64
@@ -109,6 +139,7 @@ inline std::uint32_t GetCpuFeatureMask() {
   if (DetectSSE2()) mask |= static_cast<std::uint32_t>(CpuFeature::SSE2);
   if (DetectAVX2()) mask |= static_cast<std::uint32_t>(CpuFeature::AVX2);
   if (DetectNEON()) mask |= static_cast<std::uint32_t>(CpuFeature::NEON);
+  if (DetectAVX512VPOPCNTDQ()) mask |= static_cast<std::uint32_t>(CpuFeature::AVX512_VPOPCNTDQ);
   return mask;
 #endif
 }
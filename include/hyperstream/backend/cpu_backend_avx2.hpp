@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <immintrin.h>
 
+#include "hyperstream/backend/fixed_dims.hpp"
 #include "hyperstream/core/hypervector.hpp"
 
 namespace hyperstream {
@@ -44,6 +45,21 @@ void BindWords(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* ou
 /// @return Total number of differing bits across all words
 std::size_t HammingWords(const std::uint64_t* a, const std::uint64_t* b, std::size_t word_count);
 
+/// @brief Signed dot product of the +/-1 bits of `words` with `dim_bits` int counters using AVX2
+/// (same result as core::SignedDotWords).
+/// @param counters Pointer to dim_bits counters
+/// @param words Pointer to ceil(dim_bits/64) words; bit i selects +counters[i] (set) or -counters[i]
+/// @param dim_bits Number of counters / bits
+std::int64_t SignedDotWords(const int* counters, const std::uint64_t* words, std::size_t dim_bits);
+
+/// @brief Hamming distances of all pairs of na rows `a` and nb rows `b` (word_count words each)
+/// into out[i*out_stride + j] (same contract as core::HammingTileWords). Rows shorter than
+/// kHammingTilePairWords are register-tiled 2x4 (4x4 scalar POPCNT below 8 words); longer rows go
+/// through the per-pair kernel of HammingDistanceAVX2.
+void HammingTileWords(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                      std::size_t nb, std::size_t word_count, std::uint32_t* out,
+                      std::size_t out_stride);
+
 // Harley-Seal popcount for __m256i (256-bit vector).
 // Uses CSA (Carry-Save Adder) approach to count bits in parallel.
 #if defined(__GNUC__) || defined(__clang__)
@@ -86,22 +102,297 @@ __attribute__((target("avx2"))) inline void BindWords(const std::uint64_t* a, co
   for (; i < word_count; ++i) out[i] = a[i] ^ b[i];
 }
 
-__attribute__((target("avx2"))) inline std::size_t HammingWords(const std::uint64_t* a, const std::uint64_t* b,
-                                                                 std::size_t word_count) {
-  const std::size_t avx2_words = (word_count / 4) * 4;
-  std::size_t total = 0; std::size_t i = 0;
-  for (; i < avx2_words; i += 4) {
-    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a[i]));
-    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b[i]));
-    __m256i vx = _mm256_xor_si256(va, vb);
-    total += Popcount256(vx);
+// Eight counters per step: the query byte is broadcast and compared against one bit per lane to
+// build +1/-1 multipliers for _mm256_sign_epi32. To stay exact for any int counters (the result
+// equals core::SignedDotWords'), each counter is split into c = hi * 2^16 + lo, a signed high and
+// an unsigned low 16-bit half, summed in separate int32 lanes: neither overflows nor hits the
+// unnegatable INT_MIN. The lanes are widened into the int64 total every 256 words. This keeps
+// eight counters per instruction; widening to int64 lanes halved the throughput.
+__attribute__((target("avx2"))) inline std::int64_t SignedDotWords(const int* counters,
+                                                                   const std::uint64_t* words,
+                                                                   std::size_t dim_bits) {
+  const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m256i ones = _mm256_set1_epi32(1);
+  const __m256i low_mask = _mm256_set1_epi32(0xFFFF);
+  std::int64_t total = 0;
+  std::size_t w = 0;
+  const std::size_t full = dim_bits / 64;
+  while (w < full) {
+    // int32 lanes add at most 8 * 2^16 per word in magnitude: widen every kBlock words.
+    constexpr std::size_t kBlock = 256;
+    const std::size_t end = (full - w < kBlock) ? full : w + kBlock;
+    __m256i acc_hi = _mm256_setzero_si256();
+    __m256i acc_lo = _mm256_setzero_si256();
+    for (; w < end; ++w) {
+      const std::uint64_t q = words[w];
+      const int* c = counters + w * 64;
+      for (std::size_t j = 0; j < 8; ++j) {
+        const __m256i byte = _mm256_set1_epi32(static_cast<int>((q >> (8 * j)) & 0xFFU));
+        const __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(byte, lane_bits), lane_bits);
+        const __m256i sign = _mm256_or_si256(_mm256_andnot_si256(set, _mm256_set1_epi32(-1)), ones);
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + 8 * j));
+        acc_hi = _mm256_add_epi32(acc_hi, _mm256_sign_epi32(_mm256_srai_epi32(v, 16), sign));
+        acc_lo = _mm256_add_epi32(acc_lo, _mm256_sign_epi32(_mm256_and_si256(v, low_mask), sign));
+      }
+    }
+    alignas(32) std::int32_t hi[8];
+    alignas(32) std::int32_t lo[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hi), acc_hi);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lo), acc_lo);
+    for (std::size_t l = 0; l < 8; ++l) total += static_cast<std::int64_t>(hi[l]) * 65536 + lo[l];
+  }
+  for (std::size_t b = w * 64; b < dim_bits; ++b) {
+    const std::int64_t c = counters[b];
+    total += ((words[w] >> (b - w * 64)) & 1ULL) ? c : -c;
+  }
+  return total;
+}
+
+// Fixed-size kernels for IsFixedDim dimensions (see fixed_dims.hpp). Words is a compile-time
+// constant, so the 4-vector (1024-bit) blocks run a constant trip count the compiler can unroll,
+// and the remaining whole vectors / single words are emitted only when Words requires them.
+// Hamming keeps the per-byte counts in registers and reduces with one SAD per block instead of
+// per vector. POPCNT is implied by every AVX2-capable CPU and is only used for the final words.
+namespace detail {
+
+template <std::size_t Words>
+__attribute__((target("avx2"))) inline void BindWordsFixed(const std::uint64_t* a, const std::uint64_t* b,
+                                                            std::uint64_t* out) {
+  constexpr std::size_t kBlocks = Words / 16;
+  constexpr std::size_t kVecTail = (Words % 16) / 4;
+  constexpr std::size_t kWordTail = Words % 4;
+  const __m256i* pa = reinterpret_cast<const __m256i*>(a);
+  const __m256i* pb = reinterpret_cast<const __m256i*>(b);
+  __m256i* po = reinterpret_cast<__m256i*>(out);
+  for (std::size_t blk = 0; blk < kBlocks; ++blk, pa += 4, pb += 4, po += 4) {
+    const __m256i x0 = _mm256_xor_si256(_mm256_loadu_si256(pa + 0), _mm256_loadu_si256(pb + 0));
+    const __m256i x1 = _mm256_xor_si256(_mm256_loadu_si256(pa + 1), _mm256_loadu_si256(pb + 1));
+    const __m256i x2 = _mm256_xor_si256(_mm256_loadu_si256(pa + 2), _mm256_loadu_si256(pb + 2));
+    const __m256i x3 = _mm256_xor_si256(_mm256_loadu_si256(pa + 3), _mm256_loadu_si256(pb + 3));
+    _mm256_storeu_si256(po + 0, x0);
+    _mm256_storeu_si256(po + 1, x1);
+    _mm256_storeu_si256(po + 2, x2);
+    _mm256_storeu_si256(po + 3, x3);
+  }
+  if constexpr (kVecTail > 0) {
+    for (std::size_t v = 0; v < kVecTail; ++v) {
+      _mm256_storeu_si256(po + v, _mm256_xor_si256(_mm256_loadu_si256(pa + v), _mm256_loadu_si256(pb + v)));
+    }
+  }
+  if constexpr (kWordTail > 0) {
+    for (std::size_t i = Words - kWordTail; i < Words; ++i) out[i] = a[i] ^ b[i];
+  }
+}
+
+// Per-byte popcount of x (each byte 0..8).
+__attribute__((target("avx2"))) inline __m256i PopcountBytes(__m256i x) {
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1,
+                                          2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_mask));
+  const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask));
+  return _mm256_add_epi8(lo, hi);
+}
+
+// Per-byte popcount of a^b (each byte 0..8).
+__attribute__((target("avx2"))) inline __m256i XorPopcountBytes(const std::uint64_t* a, const std::uint64_t* b) {
+  return PopcountBytes(_mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b))));
+}
+
+template <std::size_t Words>
+__attribute__((target("avx2,popcnt"))) inline std::size_t HammingWordsFixed(const std::uint64_t* a,
+                                                                             const std::uint64_t* b) {
+  constexpr std::size_t kBlocks = Words / 16;
+  constexpr std::size_t kVecTail = (Words % 16) / 4;
+  constexpr std::size_t kWordTail = Words % 4;
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc = zero;
+  for (std::size_t blk = 0; blk < kBlocks; ++blk) {
+    const std::size_t i = blk * 16;
+    // Four byte-count vectors sum to at most 32 per byte: no overflow before the SAD.
+    __m256i s = _mm256_add_epi8(XorPopcountBytes(a + i, b + i), XorPopcountBytes(a + i + 4, b + i + 4));
+    s = _mm256_add_epi8(s, XorPopcountBytes(a + i + 8, b + i + 8));
+    s = _mm256_add_epi8(s, XorPopcountBytes(a + i + 12, b + i + 12));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(s, zero));
+  }
+  if constexpr (kVecTail > 0) {
+    __m256i s = zero;
+    for (std::size_t v = 0; v < kVecTail; ++v) {
+      const std::size_t i = kBlocks * 16 + v * 4;
+      s = _mm256_add_epi8(s, XorPopcountBytes(a + i, b + i));
+    }
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(s, zero));
+  }
+  const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  alignas(16) std::uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), half);
+  std::size_t total = static_cast<std::size_t>(lanes[0] + lanes[1]);
+  if constexpr (kWordTail > 0) {
+    for (std::size_t i = Words - kWordTail; i < Words; ++i) {
+      total += static_cast<std::size_t>(__builtin_popcountll(a[i] ^ b[i]));
+    }
+  }
+  return total;
+}
+
+// R x C register tile for HammingTileWords: the R row vectors are loaded once per 4 words and
+// XORed against C column vectors. Per-byte counts accumulate for up to 31 vectors (at most 248
+// per byte) before one SAD per pair folds them into 64-bit totals.
+template <std::size_t R, std::size_t C>
+__attribute__((target("avx2,popcnt"))) inline void HammingMicroTile(const std::uint64_t* const* a,
+                                                                    const std::uint64_t* const* b,
+                                                                    std::size_t word_count, std::uint32_t* out,
+                                                                    std::size_t out_stride) {
+  constexpr std::size_t kMaxVectors = 31;
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i total[R][C];
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) total[r][c] = zero;
+  }
+  const std::size_t vec_words = word_count & ~std::size_t{3};
+  std::size_t w = 0;
+  while (w < vec_words) {
+    const std::size_t end = (vec_words - w > 4 * kMaxVectors) ? w + 4 * kMaxVectors : vec_words;
+    __m256i acc[R][C];
+    for (std::size_t r = 0; r < R; ++r) {
+      for (std::size_t c = 0; c < C; ++c) acc[r][c] = zero;
+    }
+    for (; w < end; w += 4) {
+      __m256i av[R];
+      for (std::size_t r = 0; r < R; ++r) av[r] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a[r] + w));
+      for (std::size_t c = 0; c < C; ++c) {
+        const __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b[c] + w));
+        for (std::size_t r = 0; r < R; ++r) {
+          acc[r][c] = _mm256_add_epi8(acc[r][c], PopcountBytes(_mm256_xor_si256(av[r], bv)));
+        }
+      }
+    }
+    for (std::size_t r = 0; r < R; ++r) {
+      for (std::size_t c = 0; c < C; ++c) total[r][c] = _mm256_add_epi64(total[r][c], _mm256_sad_epu8(acc[r][c], zero));
+    }
+  }
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) {
+      const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(total[r][c]), _mm256_extracti128_si256(total[r][c], 1));
+      std::uint64_t sum = static_cast<std::uint64_t>(_mm_cvtsi128_si64(half)) +
+                          static_cast<std::uint64_t>(_mm_extract_epi64(half, 1));
+      for (std::size_t t = vec_words; t < word_count; ++t) sum += __builtin_popcountll(a[r][t] ^ b[c][t]);
+      out[r * out_stride + c] = static_cast<std::uint32_t>(sum);
+    }
+  }
+}
+
+// Scalar POPCNT R x C tile for short rows (fewer than two vectors), where the per-pair SAD and
+// horizontal reduction of the vector tile cost more than the counting itself.
+template <std::size_t R, std::size_t C>
+__attribute__((target("popcnt"))) inline void HammingMicroTileShort(const std::uint64_t* const* a,
+                                                                    const std::uint64_t* const* b,
+                                                                    std::size_t word_count, std::uint32_t* out,
+                                                                    std::size_t out_stride) {
+  std::uint64_t acc[R][C] = {};
+  for (std::size_t w = 0; w < word_count; ++w) {
+    std::uint64_t av[R];
+    for (std::size_t r = 0; r < R; ++r) av[r] = a[r][w];
+    for (std::size_t c = 0; c < C; ++c) {
+      const std::uint64_t bv = b[c][w];
+      for (std::size_t r = 0; r < R; ++r) acc[r][c] += static_cast<std::uint64_t>(__builtin_popcountll(av[r] ^ bv));
+    }
+  }
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) out[r * out_stride + c] = static_cast<std::uint32_t>(acc[r][c]);
   }
-  for (; i < word_count; ++i) {
-    const std::uint64_t x = a[i] ^ b[i];
-    total += __builtin_popcountll(x);
+}
+
+// All pairs through the per-pair kernel: HammingWordsFixed when word_count is that of a kFixedDims
+// entry (the kernel HammingDistanceAVX2 runs for that Dim), else the runtime HammingWords.
+template <std::size_t I = 0>
+__attribute__((target("avx2,popcnt"))) inline void HammingTilePairs(const std::uint64_t* const* a, std::size_t na,
+                                                                    const std::uint64_t* const* b, std::size_t nb,
+                                                                    std::size_t word_count, std::uint32_t* out,
+                                                                    std::size_t out_stride) {
+  if constexpr (I < kFixedDimCount) {
+    constexpr std::size_t kWords = (kFixedDims[I] + 63) / 64;
+    if (word_count != kWords) {
+      HammingTilePairs<I + 1>(a, na, b, nb, word_count, out, out_stride);
+      return;
+    }
+    for (std::size_t i = 0; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) {
+        out[i * out_stride + j] = static_cast<std::uint32_t>(HammingWordsFixed<kWords>(a[i], b[j]));
+      }
+    }
+  } else {
+    for (std::size_t i = 0; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) {
+        out[i * out_stride + j] = static_cast<std::uint32_t>(HammingWords(a[i], b[j], word_count));
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+// Same block structure as detail::HammingWordsFixed with a runtime trip count: per-byte counts of
+// four vectors are summed before one SAD per 16 words, instead of a SAD and a horizontal sum per
+// vector (Popcount256).
+__attribute__((target("avx2,popcnt"))) inline std::size_t HammingWords(const std::uint64_t* a, const std::uint64_t* b,
+                                                                       std::size_t word_count) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc = zero;
+  std::size_t i = 0;
+  for (; i + 16 <= word_count; i += 16) {
+    __m256i s = _mm256_add_epi8(detail::XorPopcountBytes(a + i, b + i),
+                                detail::XorPopcountBytes(a + i + 4, b + i + 4));
+    s = _mm256_add_epi8(s, detail::XorPopcountBytes(a + i + 8, b + i + 8));
+    s = _mm256_add_epi8(s, detail::XorPopcountBytes(a + i + 12, b + i + 12));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(s, zero));
   }
+  if (i + 4 <= word_count) {
+    __m256i s = zero;
+    for (; i + 4 <= word_count; i += 4) s = _mm256_add_epi8(s, detail::XorPopcountBytes(a + i, b + i));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(s, zero));
+  }
+  const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  alignas(16) std::uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), half);
+  std::size_t total = static_cast<std::size_t>(lanes[0] + lanes[1]);
+  for (; i < word_count; ++i) total += static_cast<std::size_t>(__builtin_popcountll(a[i] ^ b[i]));
   return total;
 }
+
+__attribute__((target("avx2,popcnt"))) inline void HammingTileWords(const std::uint64_t* const* a, std::size_t na,
+                                                                    const std::uint64_t* const* b, std::size_t nb,
+                                                                    std::size_t word_count, std::uint32_t* out,
+                                                                    std::size_t out_stride) {
+  if (word_count >= kHammingTilePairWords) {
+    detail::HammingTilePairs(a, na, b, nb, word_count, out, out_stride);
+    return;
+  }
+  if (word_count < 8) {
+    std::size_t i = 0;
+    for (; i + 4 <= na; i += 4) {
+      std::size_t j = 0;
+      for (; j + 4 <= nb; j += 4) detail::HammingMicroTileShort<4, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+      for (; j < nb; ++j) detail::HammingMicroTileShort<4, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+    for (; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) detail::HammingMicroTileShort<1, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+    return;
+  }
+  std::size_t i = 0;
+  for (; i + 2 <= na; i += 2) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) detail::HammingMicroTile<2, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) detail::HammingMicroTile<2, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+  for (; i < na; ++i) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) detail::HammingMicroTile<1, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) detail::HammingMicroTile<1, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+}
 #endif
 
 // AVX2 implementation of Bind (XOR) for binary hypervectors.
@@ -111,6 +402,13 @@ void BindAVX2(const core::HyperVector<Dim, bool>& a, const core::HyperVector<Dim
   const auto& a_words = a.Words();
   const auto& b_words = b.Words();
   auto& out_words = out->Words();
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (IsFixedDim(Dim)) {
+    detail::BindWordsFixed<core::HyperVector<Dim, bool>::WordCount()>(a_words.data(), b_words.data(),
+                                                                      out_words.data());
+    return;
+  }
+#endif
   BindWords(a_words.data(), b_words.data(), out_words.data(), a_words.size());
 }
 
@@ -120,6 +418,11 @@ std::size_t HammingDistanceAVX2(const core::HyperVector<Dim, bool>& a,
                                 const core::HyperVector<Dim, bool>& b) {
   const auto& a_words = a.Words();
   const auto& b_words = b.Words();
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (IsFixedDim(Dim)) {
+    return detail::HammingWordsFixed<core::HyperVector<Dim, bool>::WordCount()>(a_words.data(), b_words.data());
+  }
+#endif
   return HammingWords(a_words.data(), b_words.data(), a_words.size());
 }
 
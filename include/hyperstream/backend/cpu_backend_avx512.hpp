@@ -0,0 +1,104 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+// AVX-512 backend primitives for x86-64 CPUs with AVX512F and AVX512_VPOPCNTDQ.
+// Currently provides the register-tiled all-pairs Hamming kernel, where VPOPCNTQ counts eight
+// words per instruction and the 32 ZMM registers hold a 4x4 tile of accumulators.
+//
+// Follows the I/O contract of the other SIMD backends (unaligned loads, contiguous words); the
+// word tail is handled with masked loads. Compiler targets: on GCC/Clang function-level target
+// attributes ("avx512f,avx512vpopcntdq"); on MSVC the raw entry points come from .cpp translation
+// units compiled with /arch:AVX512. Callers must check CpuFeature::AVX512_VPOPCNTDQ first.
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#include "hyperstream/backend/cpu_backend_avx2.hpp"
+
+namespace hyperstream {
+namespace backend {
+namespace avx512 {
+
+/// @brief Hamming distances of all pairs of na rows `a` and nb rows `b` (word_count words each)
+/// into out[i*out_stride + j], register-tiled 4x4 (same contract as core::HammingTileWords).
+void HammingTileWords(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                      std::size_t nb, std::size_t word_count, std::uint32_t* out,
+                      std::size_t out_stride);
+
+#if defined(__GNUC__) || defined(__clang__)
+namespace detail {
+
+template <std::size_t R, std::size_t C>
+__attribute__((target("avx512f,avx512vpopcntdq"))) inline void HammingMicroTile(
+    const std::uint64_t* const* a, const std::uint64_t* const* b, std::size_t word_count,
+    std::uint32_t* out, std::size_t out_stride) {
+  __m512i acc[R][C];
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) acc[r][c] = _mm512_setzero_si512();
+  }
+  std::size_t w = 0;
+  for (; w + 8 <= word_count; w += 8) {
+    __m512i av[R];
+    for (std::size_t r = 0; r < R; ++r) av[r] = _mm512_loadu_si512(a[r] + w);
+    for (std::size_t c = 0; c < C; ++c) {
+      const __m512i bv = _mm512_loadu_si512(b[c] + w);
+      for (std::size_t r = 0; r < R; ++r) {
+        acc[r][c] = _mm512_add_epi64(acc[r][c], _mm512_popcnt_epi64(_mm512_xor_si512(av[r], bv)));
+      }
+    }
+  }
+  if (w < word_count) {
+    const __mmask8 k = static_cast<__mmask8>((1u << (word_count - w)) - 1u);
+    __m512i av[R];
+    for (std::size_t r = 0; r < R; ++r) av[r] = _mm512_maskz_loadu_epi64(k, a[r] + w);
+    for (std::size_t c = 0; c < C; ++c) {
+      const __m512i bv = _mm512_maskz_loadu_epi64(k, b[c] + w);
+      for (std::size_t r = 0; r < R; ++r) {
+        acc[r][c] = _mm512_add_epi64(acc[r][c], _mm512_popcnt_epi64(_mm512_xor_si512(av[r], bv)));
+      }
+    }
+  }
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) {
+      // Spilled rather than _mm512_reduce_add_epi64, whose GCC 12 expansion trips -Wuninitialized.
+      alignas(64) std::uint64_t lanes[8];
+      _mm512_store_si512(lanes, acc[r][c]);
+      std::uint64_t sum = 0;
+      for (std::uint64_t lane : lanes) sum += lane;
+      out[r * out_stride + c] = static_cast<std::uint32_t>(sum);
+    }
+  }
+}
+
+}  // namespace detail
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) inline void HammingTileWords(
+    const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b, std::size_t nb,
+    std::size_t word_count, std::uint32_t* out, std::size_t out_stride) {
+  // Rows shorter than one ZMM vector: the AVX2 kernel's scalar POPCNT tile is faster than a masked
+  // vector plus a horizontal reduction per pair.
+  if (word_count < 8) {
+    avx2::HammingTileWords(a, na, b, nb, word_count, out, out_stride);
+    return;
+  }
+  std::size_t i = 0;
+  for (; i + 4 <= na; i += 4) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) detail::HammingMicroTile<4, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) detail::HammingMicroTile<4, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+  for (; i < na; ++i) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) detail::HammingMicroTile<1, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) detail::HammingMicroTile<1, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+}
+#endif
+
+}  // namespace avx512
+}  // namespace backend
+}  // namespace hyperstream
+
+#endif  // x86/x64 guard
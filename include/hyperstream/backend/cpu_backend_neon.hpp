@@ -14,7 +14,9 @@
 #include <cstdint>
 #include <arm_neon.h>
 
+#include "hyperstream/backend/fixed_dims.hpp"
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
 
 namespace hyperstream {
 namespace backend {
@@ -55,6 +57,100 @@ inline std::size_t HammingWords(const std::uint64_t* a, const std::uint64_t* b,
   return total;
 }
 
+// Fixed-size kernels for IsFixedDim dimensions (see fixed_dims.hpp). Words is a compile-time
+// constant, so the 4-vector (512-bit) blocks run a constant trip count and the remaining vectors /
+// word are emitted only when Words requires them. Hamming widens byte counts into a u16
+// accumulator once per block and reduces across lanes once per call instead of per vector.
+namespace detail {
+
+template <std::size_t Words>
+inline void BindWordsFixed(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) {
+  constexpr std::size_t kVecs = Words / 2;
+  for (std::size_t v = 0; v < kVecs; ++v) {
+    const uint64x2_t va = vld1q_u64(reinterpret_cast<const uint64_t*>(a + 2 * v));
+    const uint64x2_t vb = vld1q_u64(reinterpret_cast<const uint64_t*>(b + 2 * v));
+    vst1q_u64(reinterpret_cast<uint64_t*>(out + 2 * v), veorq_u64(va, vb));
+  }
+  if constexpr (Words % 2 != 0) out[Words - 1] = a[Words - 1] ^ b[Words - 1];
+}
+
+inline uint8x16_t XorPopcountBytes(const std::uint64_t* a, const std::uint64_t* b) {
+  const uint64x2_t x = veorq_u64(vld1q_u64(reinterpret_cast<const uint64_t*>(a)),
+                                 vld1q_u64(reinterpret_cast<const uint64_t*>(b)));
+  return vcntq_u8(vreinterpretq_u8_u64(x));
+}
+
+template <std::size_t Words>
+inline std::size_t HammingWordsFixed(const std::uint64_t* a, const std::uint64_t* b) {
+  constexpr std::size_t kBlocks = Words / 8;
+  constexpr std::size_t kVecTail = (Words % 8) / 2;
+  // Each block adds at most 64 to a u16 lane (two bytes of <= 32).
+  static_assert(kBlocks + 1 <= 65535 / 64, "fixed NEON Hamming accumulator would overflow");
+  uint16x8_t acc = vdupq_n_u16(0);
+  for (std::size_t blk = 0; blk < kBlocks; ++blk) {
+    const std::size_t i = blk * 8;
+    uint8x16_t s = vaddq_u8(XorPopcountBytes(a + i, b + i), XorPopcountBytes(a + i + 2, b + i + 2));
+    s = vaddq_u8(s, XorPopcountBytes(a + i + 4, b + i + 4));
+    s = vaddq_u8(s, XorPopcountBytes(a + i + 6, b + i + 6));
+    acc = vpadalq_u8(acc, s);
+  }
+  if constexpr (kVecTail > 0) {
+    uint8x16_t s = vdupq_n_u8(0);
+    for (std::size_t v = 0; v < kVecTail; ++v) {
+      const std::size_t i = kBlocks * 8 + v * 2;
+      s = vaddq_u8(s, XorPopcountBytes(a + i, b + i));
+    }
+    acc = vpadalq_u8(acc, s);
+  }
+  std::size_t total = static_cast<std::size_t>(vaddlvq_u16(acc));
+  if constexpr (Words % 2 != 0) {
+    total += static_cast<std::size_t>(__builtin_popcountll(a[Words - 1] ^ b[Words - 1]));
+  }
+  return total;
+}
+
+// All pairs through the per-pair kernel: HammingWordsFixed when word_count is that of a kFixedDims
+// entry (the kernel HammingDistanceNEON runs for that Dim), else the runtime HammingWords.
+template <std::size_t I = 0>
+inline void HammingTilePairs(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                             std::size_t nb, std::size_t word_count, std::uint32_t* out,
+                             std::size_t out_stride) {
+  if constexpr (I < kFixedDimCount) {
+    constexpr std::size_t kWords = (kFixedDims[I] + 63) / 64;
+    if (word_count != kWords) {
+      HammingTilePairs<I + 1>(a, na, b, nb, word_count, out, out_stride);
+      return;
+    }
+    for (std::size_t i = 0; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) {
+        out[i * out_stride + j] = static_cast<std::uint32_t>(HammingWordsFixed<kWords>(a[i], b[j]));
+      }
+    }
+  } else {
+    for (std::size_t i = 0; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) {
+        out[i * out_stride + j] = static_cast<std::uint32_t>(HammingWords(a[i], b[j], word_count));
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+/// Hamming distances of all pairs of na rows `a` and nb rows `b` (word_count words each) into
+/// out[i*out_stride + j] (same contract as core::HammingTileWords). Rows of at least
+/// kHammingTilePairWords words go through the per-pair kernel of HammingDistanceNEON; shorter
+/// rows through the portable tile, which counts with CNT on AArch64.
+inline void HammingTileWords(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                             std::size_t nb, std::size_t word_count, std::uint32_t* out,
+                             std::size_t out_stride) {
+  if (word_count < kHammingTilePairWords) {
+    core::HammingTileWords(a, na, b, nb, word_count, out, out_stride);
+    return;
+  }
+  detail::HammingTilePairs(a, na, b, nb, word_count, out, out_stride);
+}
+
 // NEON implementation of Bind (XOR) for binary hypervectors.
 template <std::size_t Dim>
 inline void BindNEON(const core::HyperVector<Dim, bool>& a,
@@ -63,6 +159,10 @@ inline void BindNEON(const core::HyperVector<Dim, bool>& a,
   const auto& aw = a.Words();
   const auto& bw = b.Words();
   auto& ow = out->Words();
+  if constexpr (IsFixedDim(Dim)) {
+    detail::BindWordsFixed<core::HyperVector<Dim, bool>::WordCount()>(aw.data(), bw.data(), ow.data());
+    return;
+  }
   BindWords(aw.data(), bw.data(), ow.data(), aw.size());
 }
 
@@ -72,6 +172,9 @@ inline std::size_t HammingDistanceNEON(const core::HyperVector<Dim, bool>& a,
                                        const core::HyperVector<Dim, bool>& b) {
   const auto& aw = a.Words();
   const auto& bw = b.Words();
+  if constexpr (IsFixedDim(Dim)) {
+    return detail::HammingWordsFixed<core::HyperVector<Dim, bool>::WordCount()>(aw.data(), bw.data());
+  }
   return HammingWords(aw.data(), bw.data(), aw.size());
 }
 
@@ -22,7 +22,9 @@
 #include <cstdint>
 #include <emmintrin.h>
 
+#include "hyperstream/backend/fixed_dims.hpp"
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
 
 namespace hyperstream {
 namespace backend {
@@ -43,6 +45,14 @@ void BindWords(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* ou
 /// @return Total number of differing bits across all words
 std::size_t HammingWords(const std::uint64_t* a, const std::uint64_t* b, std::size_t word_count);
 
+/// @brief Hamming distances of all pairs of na rows `a` and nb rows `b` (word_count words each)
+/// into out[i*out_stride + j] (same contract as core::HammingTileWords). Rows of a kFixedDims
+/// length go through the fixed-size per-pair kernel of HammingDistanceSSE2; other rows through
+/// core::HammingTileWords, which is faster than the runtime HammingWords without POPCNT.
+void HammingTileWords(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                      std::size_t nb, std::size_t word_count, std::uint32_t* out,
+                      std::size_t out_stride);
+
 #if defined(__GNUC__) || defined(__clang__)
 __attribute__((target("sse2"))) inline void BindWords(const std::uint64_t* a, const std::uint64_t* b,
                                                        std::uint64_t* out, std::size_t word_count) {
@@ -73,6 +83,119 @@ __attribute__((target("sse2"))) inline std::size_t HammingWords(const std::uint6
   for (; i < word_count; ++i) total += __builtin_popcountll(a[i] ^ b[i]);
   return total;
 }
+
+// Fixed-size kernels for IsFixedDim dimensions (see fixed_dims.hpp). Words is a compile-time
+// constant, so the 4-vector (512-bit) blocks run a constant trip count and the remaining vectors /
+// word are emitted only when Words requires them. SSE2 has neither POPCNT nor PSHUFB, so Hamming
+// uses a SWAR byte popcount in registers and one SAD per block rather than a popcount call per word.
+namespace detail {
+
+template <std::size_t Words>
+__attribute__((target("sse2"))) inline void BindWordsFixed(const std::uint64_t* a, const std::uint64_t* b,
+                                                            std::uint64_t* out) {
+  constexpr std::size_t kBlocks = Words / 8;
+  constexpr std::size_t kVecTail = (Words % 8) / 2;
+  const __m128i* pa = reinterpret_cast<const __m128i*>(a);
+  const __m128i* pb = reinterpret_cast<const __m128i*>(b);
+  __m128i* po = reinterpret_cast<__m128i*>(out);
+  for (std::size_t blk = 0; blk < kBlocks; ++blk, pa += 4, pb += 4, po += 4) {
+    const __m128i x0 = _mm_xor_si128(_mm_loadu_si128(pa + 0), _mm_loadu_si128(pb + 0));
+    const __m128i x1 = _mm_xor_si128(_mm_loadu_si128(pa + 1), _mm_loadu_si128(pb + 1));
+    const __m128i x2 = _mm_xor_si128(_mm_loadu_si128(pa + 2), _mm_loadu_si128(pb + 2));
+    const __m128i x3 = _mm_xor_si128(_mm_loadu_si128(pa + 3), _mm_loadu_si128(pb + 3));
+    _mm_storeu_si128(po + 0, x0);
+    _mm_storeu_si128(po + 1, x1);
+    _mm_storeu_si128(po + 2, x2);
+    _mm_storeu_si128(po + 3, x3);
+  }
+  if constexpr (kVecTail > 0) {
+    for (std::size_t v = 0; v < kVecTail; ++v) {
+      _mm_storeu_si128(po + v, _mm_xor_si128(_mm_loadu_si128(pa + v), _mm_loadu_si128(pb + v)));
+    }
+  }
+  if constexpr (Words % 2 != 0) out[Words - 1] = a[Words - 1] ^ b[Words - 1];
+}
+
+// Per-byte popcount of a^b (each byte 0..8).
+__attribute__((target("sse2"))) inline __m128i XorPopcountBytes(const std::uint64_t* a, const std::uint64_t* b) {
+  const __m128i m1 = _mm_set1_epi8(0x55);
+  const __m128i m2 = _mm_set1_epi8(0x33);
+  const __m128i m4 = _mm_set1_epi8(0x0f);
+  __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+  x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+  x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+  return _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), m4);
+}
+
+inline std::size_t PopcountSwar64(std::uint64_t x) {
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<std::size_t>((x * 0x0101010101010101ULL) >> 56);
+}
+
+template <std::size_t Words>
+__attribute__((target("sse2"))) inline std::size_t HammingWordsFixed(const std::uint64_t* a,
+                                                                       const std::uint64_t* b) {
+  constexpr std::size_t kBlocks = Words / 8;
+  constexpr std::size_t kVecTail = (Words % 8) / 2;
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = zero;
+  for (std::size_t blk = 0; blk < kBlocks; ++blk) {
+    const std::size_t i = blk * 8;
+    // Four byte-count vectors sum to at most 32 per byte: no overflow before the SAD.
+    __m128i s = _mm_add_epi8(XorPopcountBytes(a + i, b + i), XorPopcountBytes(a + i + 2, b + i + 2));
+    s = _mm_add_epi8(s, XorPopcountBytes(a + i + 4, b + i + 4));
+    s = _mm_add_epi8(s, XorPopcountBytes(a + i + 6, b + i + 6));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(s, zero));
+  }
+  if constexpr (kVecTail > 0) {
+    __m128i s = zero;
+    for (std::size_t v = 0; v < kVecTail; ++v) {
+      const std::size_t i = kBlocks * 8 + v * 2;
+      s = _mm_add_epi8(s, XorPopcountBytes(a + i, b + i));
+    }
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(s, zero));
+  }
+  alignas(16) std::uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  std::size_t total = static_cast<std::size_t>(lanes[0] + lanes[1]);
+  if constexpr (Words % 2 != 0) total += PopcountSwar64(a[Words - 1] ^ b[Words - 1]);
+  return total;
+}
+
+// All pairs through HammingWordsFixed when word_count is that of a kFixedDims entry, else the
+// portable tile.
+template <std::size_t I = 0>
+__attribute__((target("sse2"))) inline void HammingTileFixed(const std::uint64_t* const* a, std::size_t na,
+                                                             const std::uint64_t* const* b, std::size_t nb,
+                                                             std::size_t word_count, std::uint32_t* out,
+                                                             std::size_t out_stride) {
+  if constexpr (I < kFixedDimCount) {
+    constexpr std::size_t kWords = (kFixedDims[I] + 63) / 64;
+    if (word_count != kWords) {
+      HammingTileFixed<I + 1>(a, na, b, nb, word_count, out, out_stride);
+      return;
+    }
+    for (std::size_t i = 0; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) {
+        out[i * out_stride + j] = static_cast<std::uint32_t>(HammingWordsFixed<kWords>(a[i], b[j]));
+      }
+    }
+  } else {
+    core::HammingTileWords(a, na, b, nb, word_count, out, out_stride);
+  }
+}
+
+}  // namespace detail
+
+__attribute__((target("sse2"))) inline void HammingTileWords(const std::uint64_t* const* a, std::size_t na,
+                                                             const std::uint64_t* const* b, std::size_t nb,
+                                                             std::size_t word_count, std::uint32_t* out,
+                                                             std::size_t out_stride) {
+  detail::HammingTileFixed(a, na, b, nb, word_count, out, out_stride);
+}
 #endif
 
 // SSE2 implementation of Bind (XOR) for binary hypervectors.
@@ -82,6 +205,13 @@ void BindSSE2(const core::HyperVector<Dim, bool>& a, const core::HyperVector<Dim
   const auto& a_words = a.Words();
   const auto& b_words = b.Words();
   auto& out_words = out->Words();
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (IsFixedDim(Dim)) {
+    detail::BindWordsFixed<core::HyperVector<Dim, bool>::WordCount()>(a_words.data(), b_words.data(),
+                                                                      out_words.data());
+    return;
+  }
+#endif
   BindWords(a_words.data(), b_words.data(), out_words.data(), a_words.size());
 }
 
@@ -92,6 +222,11 @@ std::size_t HammingDistanceSSE2(const core::HyperVector<Dim, bool>& a,
                                 const core::HyperVector<Dim, bool>& b) {
   const auto& a_words = a.Words();
   const auto& b_words = b.Words();
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (IsFixedDim(Dim)) {
+    return detail::HammingWordsFixed<core::HyperVector<Dim, bool>::WordCount()>(a_words.data(), b_words.data());
+  }
+#endif
   return HammingWords(a_words.data(), b_words.data(), a_words.size());
 }
 
@@ -0,0 +1,39 @@
+#pragma once
+
+// Dimensions that get compile-time-specialized backend kernels.
+// Every backend entry point is templated on Dim, so for these common sizes the word count is a
+// constant: the SIMD backends select register-blocked kernels with constant trip counts and a tail
+// resolved at compile time (no tail at all when Dim is a multiple of the block width), instead of
+// the runtime word_count loops. Other dimensions keep the generic loops.
+
+#include <cstddef>
+
+#include "hyperstream/config.hpp"
+
+namespace hyperstream {
+namespace backend {
+
+inline constexpr std::size_t kFixedDims[] = {1024, 2048, 4096, 8192, 10000};
+inline constexpr std::size_t kFixedDimCount = sizeof(kFixedDims) / sizeof(kFixedDims[0]);
+
+// Row length (words) from which the SIMD all-pairs tiles (HammingTileWords) compute each pair with
+// the per-pair Hamming kernel instead of a register tile. The per-pair kernels reduce once per
+// 16-word block; the tiles' per-word or per-vector work only wins on shorter rows (matrix_bench).
+inline constexpr std::size_t kHammingTilePairWords = 16;
+
+// Upper bound for adding the profile's default dimension: beyond this, full unrolling buys nothing
+// and the NEON u16 accumulators would need intermediate widening.
+inline constexpr std::size_t kFixedDimMaxBits = 65536;
+
+/// True if Dim has a compile-time-specialized kernel in the SIMD backends. The active profile's
+/// default dimension is included when it is at most kFixedDimMaxBits.
+constexpr bool IsFixedDim(std::size_t dim) noexcept {
+  if (dim == config::kDefaultDimBits && dim <= kFixedDimMaxBits) return true;
+  for (std::size_t d : kFixedDims) {
+    if (d == dim) return true;
+  }
+  return false;
+}
+
+}  // namespace backend
+}  // namespace hyperstream
@@ -11,6 +11,7 @@
 #include "hyperstream/config.hpp"
 #include "hyperstream/backend/capability.hpp"
 #include "hyperstream/core/ops.hpp"
+#include "hyperstream/metrics.hpp"
 
 // Architecture detection
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
@@ -27,6 +28,7 @@
 #if HS_X86_ARCH
   #include "hyperstream/backend/cpu_backend_sse2.hpp"
   #include "hyperstream/backend/cpu_backend_avx2.hpp"
+  #include "hyperstream/backend/cpu_backend_avx512.hpp"
 #endif
 #if HS_ARM64_ARCH
   #include "hyperstream/backend/cpu_backend_neon.hpp"
@@ -86,6 +88,13 @@ template <std::size_t Dim>
 using HammingFn = std::size_t (*)(const core::HyperVector<Dim, bool>&,
                                   const core::HyperVector<Dim, bool>&);
 
+// Signed counter dot product over raw buffers (see core::SignedDotWords).
+using SignedDotFn = std::int64_t (*)(const int*, const std::uint64_t*, std::size_t);
+
+// All-pairs Hamming tile over row pointers (see core::HammingTileWords).
+using HammingTileFn = void (*)(const std::uint64_t* const*, std::size_t, const std::uint64_t* const*,
+                               std::size_t, std::size_t, std::uint32_t*, std::size_t);
+
 // Decision helpers
 namespace detail {
 struct Decision {
@@ -122,6 +131,13 @@ inline Decision DecideHamming(std::size_t dim, std::uint32_t mask) {
   return {BackendKind::Scalar, "no SIMD detected"};
 #endif
 }
+
+// Counts one backend selection; `first` is the Scalar entry of the Bind/Hamming counter group.
+inline void CountSelection(metrics::Counter first, BackendKind kind) noexcept {
+  (void)first; (void)kind;
+  HS_METRIC_ADD_AT(static_cast<metrics::Counter>(static_cast<std::uint8_t>(first) +
+                                                 static_cast<std::uint8_t>(kind)), 1);
+}
 } // namespace detail
 
 // Compile-time override mapping (placeholder for future string mapping)
@@ -142,6 +158,7 @@ template <std::size_t Dim>
 inline BindFn<Dim> SelectBindBackend(std::uint32_t feature_mask = GetCpuFeatureMask()) {
 #if HS_X86_ARCH
   const auto d = detail::DecideBind(Dim, feature_mask);
+  detail::CountSelection(metrics::Counter::BindSelectScalar, d.kind);
   switch (d.kind) {
     case BackendKind::AVX2: return &avx2::BindAVX2<Dim>;
     case BackendKind::SSE2: return &sse2::BindSSE2<Dim>;
@@ -150,12 +167,14 @@ inline BindFn<Dim> SelectBindBackend(std::uint32_t feature_mask = GetCpuFeatureM
 #elif HS_ARM64_ARCH
   (void)feature_mask;  // On ARM64, ignore synthetic x86 bits; use host features
   const auto d = detail::DecideBind(Dim, GetCpuFeatureMask());
+  detail::CountSelection(metrics::Counter::BindSelectScalar, d.kind);
   switch (d.kind) {
     case BackendKind::NEON: return &neon::BindNEON<Dim>;
     default: return &core::Bind<Dim>;
   }
 #else
   (void)feature_mask; // other arch: scalar
+  detail::CountSelection(metrics::Counter::BindSelectScalar, BackendKind::Scalar);
   return &core::Bind<Dim>;
 #endif
 }
@@ -165,6 +184,7 @@ template <std::size_t Dim>
 inline HammingFn<Dim> SelectHammingBackend(std::uint32_t feature_mask = GetCpuFeatureMask()) {
 #if HS_X86_ARCH
   const auto d = detail::DecideHamming(Dim, feature_mask);
+  detail::CountSelection(metrics::Counter::HammingSelectScalar, d.kind);
   switch (d.kind) {
     case BackendKind::AVX2: return &avx2::HammingDistanceAVX2<Dim>;
     case BackendKind::SSE2: return &sse2::HammingDistanceSSE2<Dim>;
@@ -173,16 +193,45 @@ inline HammingFn<Dim> SelectHammingBackend(std::uint32_t feature_mask = GetCpuFe
 #elif HS_ARM64_ARCH
   (void)feature_mask;  // On ARM64, ignore synthetic x86 bits; use host features
   const auto d = detail::DecideHamming(Dim, GetCpuFeatureMask());
+  detail::CountSelection(metrics::Counter::HammingSelectScalar, d.kind);
   switch (d.kind) {
     case BackendKind::NEON: return &neon::HammingDistanceNEON<Dim>;
     default: return &core::HammingDistance<Dim>;
   }
 #else
   (void)feature_mask; // other arch: scalar
+  detail::CountSelection(metrics::Counter::HammingSelectScalar, BackendKind::Scalar);
   return &core::HammingDistance<Dim>;
 #endif
 }
 
+// Select the signed counter dot product (ClusterMemory::Classify): AVX2 when available, otherwise
+// the portable loop, which the compiler vectorizes for the baseline ISA (SSE2/NEON).
+inline SignedDotFn SelectSignedDotBackend(std::uint32_t feature_mask = GetCpuFeatureMask()) {
+#if HS_X86_ARCH && !defined(HYPERSTREAM_FORCE_SCALAR)
+  if (HasFeature(feature_mask, CpuFeature::AVX2)) return &avx2::SignedDotWords;
+#endif
+  (void)feature_mask;
+  return &core::SignedDotWords;
+}
+
+// Select the all-pairs Hamming tile kernel (memory::HammingMatrix): AVX-512 VPOPCNTDQ 4x4 tiles,
+// else the AVX2, SSE2 or NEON kernel, else the portable 4x4 tile. Without VPOPCNTDQ a register
+// tile only beats the per-pair kernel on short rows, so those kernels tile rows shorter than
+// kHammingTilePairWords and run the per-pair Hamming kernel of their ISA on longer ones.
+inline HammingTileFn SelectHammingTileBackend(std::uint32_t feature_mask = GetCpuFeatureMask()) {
+#if HS_X86_ARCH && !defined(HYPERSTREAM_FORCE_SCALAR)
+  if (HasFeature(feature_mask, CpuFeature::AVX512_VPOPCNTDQ)) return &avx512::HammingTileWords;
+  if (HasFeature(feature_mask, CpuFeature::AVX2)) return &avx2::HammingTileWords;
+  if (HasFeature(feature_mask, CpuFeature::SSE2)) return &sse2::HammingTileWords;
+#elif HS_ARM64_ARCH && !defined(HYPERSTREAM_FORCE_SCALAR)
+  // As SelectHammingBackend: ignore synthetic x86 bits, use host features.
+  if (HasFeature(GetCpuFeatureMask(), CpuFeature::NEON)) return &neon::HammingTileWords;
+#endif
+  (void)feature_mask;
+  return &core::HammingTileWords;
+}
+
 // Policy report
 /** Summary of policy decisions for a given dimension and CPU feature mask. */
 struct PolicyReport {
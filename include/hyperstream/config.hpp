@@ -49,6 +49,9 @@ static constexpr std::size_t kDefaultCapacity = 256;
 // to avoid stack overflow and improve robustness across toolchains/runtimes.
 static constexpr std::size_t kHeapAllocThresholdBytes = 1024; // 1 KiB
 
+// Alignment guaranteed by memory::LargeAllocator implementations (one cache line).
+static constexpr std::size_t kLargeStructureAlignment = 64;
+
 // Helpers
 constexpr inline bool IsPowerOfTwo(std::size_t x) { return x && ((x & (x - 1)) == 0); }
 
@@ -61,11 +64,13 @@ constexpr inline std::size_t BinaryHyperVectorStorageBytes(std::size_t dim_bits)
 constexpr inline std::size_t PrototypeMemoryStorageBytes(std::size_t dim_bits, std::size_t capacity) {
   return capacity * (sizeof(std::uint64_t) + BinaryHyperVectorStorageBytes(dim_bits));
 }
-/// Returns the storage size in bytes of ClusterMemory<dim_bits,capacity> counters and metadata.
+/// Returns the storage size in bytes of ClusterMemory<dim_bits,capacity> counters, cached
+/// binarized prototypes and metadata.
 constexpr inline std::size_t ClusterMemoryStorageBytes(std::size_t dim_bits, std::size_t capacity) {
-  return capacity * sizeof(std::uint64_t) +  // labels
-         capacity * sizeof(int) +            // counts
-         capacity * dim_bits * sizeof(int);  // sums
+  return capacity * sizeof(std::uint64_t) +                   // labels
+         capacity * sizeof(int) +                             // counts
+         capacity * dim_bits * sizeof(int) +                  // sums
+         capacity * BinaryHyperVectorStorageBytes(dim_bits);  // binarized prototypes
 }
 /// Returns the storage size in bytes of CleanupMemory<dim_bits,capacity> entries.
 constexpr inline std::size_t CleanupMemoryStorageBytes(std::size_t dim_bits, std::size_t capacity) {
@@ -10,8 +10,26 @@
 #include <cstdint>
 #include <type_traits>
 #include <complex>
+#include <cstdio>
+#include <cstdlib>
 #include <stdexcept>
 
+// Bounds checks on the unchecked bit accessors (GetBitUnchecked/SetBitUnchecked/SetBits/...).
+// Define HYPERSTREAM_DEBUG_BOUNDS to abort with a message on an out-of-range index; otherwise the
+// checks compile away. Independent of NDEBUG so release builds can opt in.
+#if defined(HYPERSTREAM_DEBUG_BOUNDS)
+#define HS_DEBUG_BOUNDS_CHECK(cond, what)                                          \
+  do {                                                                             \
+    if (!(cond)) {                                                                 \
+      std::fprintf(stderr, "hyperstream: %s out of range (%s:%d)\n", what, __FILE__, \
+                   __LINE__);                                                      \
+      std::abort();                                                                \
+    }                                                                              \
+  } while (0)
+#else
+#define HS_DEBUG_BOUNDS_CHECK(cond, what) ((void)0)
+#endif
+
 namespace hyperstream {
 namespace core {
 
@@ -71,7 +89,8 @@ class HyperVector<Dim, bool> {
     }
   }
 
-  // Get/Set individual bit by index [0, Dim).
+  // Get/Set individual bit by index [0, Dim). Throws std::out_of_range on a bad index; internal
+  // loops use the unchecked variants below.
   [[nodiscard]] inline bool GetBit(std::size_t bit_index) const {
     const auto [w, mask] = WordAndMask(bit_index);
     return (word_[w] & mask) != 0ULL;
@@ -86,6 +105,53 @@ class HyperVector<Dim, bool> {
     }
   }
 
+  // Unchecked bit access for hot loops: the index must be in [0, Dim). Checked only under
+  // HYPERSTREAM_DEBUG_BOUNDS.
+  [[nodiscard]] inline bool GetBitUnchecked(std::size_t bit_index) const noexcept {
+    HS_DEBUG_BOUNDS_CHECK(bit_index < Dim, "HyperVector<bool>::GetBitUnchecked index");
+    return ((word_[bit_index / kWordBits] >> (bit_index % kWordBits)) & 1ULL) != 0ULL;
+  }
+
+  inline void SetBitUnchecked(std::size_t bit_index, bool value) noexcept {
+    HS_DEBUG_BOUNDS_CHECK(bit_index < Dim, "HyperVector<bool>::SetBitUnchecked index");
+    const std::uint64_t mask = 1ULL << (bit_index % kWordBits);
+    std::uint64_t& w = word_[bit_index / kWordBits];
+    w = value ? (w | mask) : (w & ~mask);
+  }
+
+  // Sets (to 1) the bits at indices[0..count). Indices must be in [0, Dim); duplicates are fine.
+  inline void SetBits(const std::size_t* indices, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+      HS_DEBUG_BOUNDS_CHECK(indices[i] < Dim, "HyperVector<bool>::SetBits index");
+      word_[indices[i] / kWordBits] |= 1ULL << (indices[i] % kWordBits);
+    }
+  }
+
+  // Packs bits[0..Dim) into the words (bit i of the vector = bits[i]), one store per word.
+  inline void FromBools(const bool* bits) noexcept {
+    for (std::size_t w = 0; w < kWordCount; ++w) {
+      const std::size_t base = w * kWordBits;
+      const std::size_t n = (Dim - base < kWordBits) ? Dim - base : kWordBits;
+      std::uint64_t word = 0;
+      for (std::size_t b = 0; b < n; ++b) {
+        word |= static_cast<std::uint64_t>(bits[base + b]) << b;
+      }
+      word_[w] = word;
+    }
+  }
+
+  // Unpacks the vector into bits[0..Dim).
+  inline void ToBools(bool* bits) const noexcept {
+    for (std::size_t w = 0; w < kWordCount; ++w) {
+      const std::size_t base = w * kWordBits;
+      const std::size_t n = (Dim - base < kWordBits) ? Dim - base : kWordBits;
+      const std::uint64_t word = word_[w];
+      for (std::size_t b = 0; b < n; ++b) {
+        bits[base + b] = ((word >> b) & 1ULL) != 0ULL;
+      }
+    }
+  }
+
   // Raw word access for backends/ops.
   [[nodiscard]] inline const std::array<std::uint64_t, kWordCount>& Words() const {
     return word_;
@@ -109,6 +175,44 @@ class HyperVector<Dim, bool> {
   alignas(64) std::array<std::uint64_t, kWordCount> word_{};  // bit-packed storage (64B aligned)
 };
 
+namespace detail {
+
+// Word-at-a-time helpers for O(Dim) internal loops: the inner loop has a fixed 64-iteration trip
+// (except in the last word) and no per-bit bounds check, so it vectorizes.
+
+// out bit i = pred(i) for i in [0, Dim).
+template <std::size_t Dim, typename Pred>
+inline void PackBits(HyperVector<Dim, bool>* out, Pred&& pred) {
+  constexpr std::size_t kBits = HyperVector<Dim, bool>::kWordBits;
+  auto& words = out->Words();
+  for (std::size_t w = 0; w < HyperVector<Dim, bool>::WordCount(); ++w) {
+    const std::size_t base = w * kBits;
+    const std::size_t n = (Dim - base < kBits) ? Dim - base : kBits;
+    std::uint64_t word = 0;
+    for (std::size_t b = 0; b < n; ++b) {
+      word |= static_cast<std::uint64_t>(pred(base + b) ? 1u : 0u) << b;
+    }
+    words[w] = word;
+  }
+}
+
+// Calls fn(i, bit_i) for i in [0, Dim) in index order.
+template <std::size_t Dim, typename Fn>
+inline void ForEachBit(const HyperVector<Dim, bool>& hv, Fn&& fn) {
+  constexpr std::size_t kBits = HyperVector<Dim, bool>::kWordBits;
+  const auto& words = hv.Words();
+  for (std::size_t w = 0; w < HyperVector<Dim, bool>::WordCount(); ++w) {
+    const std::size_t base = w * kBits;
+    const std::size_t n = (Dim - base < kBits) ? Dim - base : kBits;
+    const std::uint64_t word = words[w];
+    for (std::size_t b = 0; b < n; ++b) {
+      fn(base + b, ((word >> b) & 1ULL) != 0ULL);
+    }
+  }
+}
+
+}  // namespace detail
+
 // Common typedefs for convenience (these are suggestions; users can instantiate directly).
 using Binary10k = HyperVector<10000, bool>;
 using Complex5k = HyperVector<5000, std::complex<float>>;
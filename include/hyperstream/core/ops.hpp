@@ -12,6 +12,10 @@
 #include <cmath>
 #include <limits>
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/metrics.hpp"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace hyperstream {
 namespace core {
@@ -34,6 +38,45 @@ namespace detail {
     return c;
   }
 
+  // Branch-free SWAR popcount for bulk kernels, where Kernighan's data-dependent loop stalls.
+  constexpr inline std::uint64_t PopcountSwar64(std::uint64_t x) noexcept {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (x * 0x0101010101010101ULL) >> 56;
+  }
+
+  // Popcount for the tile kernel: the POPCNT / CNT instruction when the compilation target has one
+  // (x86 built with POPCNT or AVX2, AArch64), else SWAR. Not constexpr: intrinsics and builtins.
+  inline std::uint64_t PopcountTile64(std::uint64_t x) noexcept {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__POPCNT__) || defined(__aarch64__))
+    return static_cast<std::uint64_t>(__builtin_popcountll(x));
+#elif defined(_MSC_VER) && defined(_M_X64) && defined(__AVX2__)
+    return __popcnt64(x);
+#else
+    return PopcountSwar64(x);
+#endif
+  }
+
+  // R x C register tile of HammingTileWords: each loaded word is reused R or C times.
+  template <std::size_t R, std::size_t C>
+  inline void HammingMicroTile(const std::uint64_t* const* a, const std::uint64_t* const* b,
+                               std::size_t word_count, std::uint32_t* out,
+                               std::size_t out_stride) noexcept {
+    std::uint64_t acc[R][C] = {};
+    for (std::size_t w = 0; w < word_count; ++w) {
+      std::uint64_t av[R];
+      for (std::size_t r = 0; r < R; ++r) av[r] = a[r][w];
+      for (std::size_t c = 0; c < C; ++c) {
+        const std::uint64_t bv = b[c][w];
+        for (std::size_t r = 0; r < R; ++r) acc[r][c] += PopcountTile64(av[r] ^ bv);
+      }
+    }
+    for (std::size_t r = 0; r < R; ++r) {
+      for (std::size_t c = 0; c < C; ++c) out[r * out_stride + c] = static_cast<std::uint32_t>(acc[r][c]);
+    }
+  }
+
 // Inner-product term with conjugation for complex; supports arithmetic and complex types.
 template <typename T>
 constexpr double InnerProductTerm(const T& a, const T& b) noexcept {
@@ -113,34 +156,186 @@ class BinaryBundler {
   }
 
   void Accumulate(const HyperVector<Dim, bool>& hv) {
+    HS_METRIC_INC(BundlerAccumulates);
     // Streaming-friendly: avoid repeated thresholding to reduce drift.
+    // Word-at-a-time: one load per 64 bits and a branch-free update per lane, so the inner loop
+    // vectorizes instead of paying a bounds-checked GetBit per bit.
+    const auto& words = hv.Words();
+    constexpr std::size_t kBits = HyperVector<Dim, bool>::kWordBits;
+    for (std::size_t w = 0; w < HyperVector<Dim, bool>::WordCount(); ++w) {
+      const std::uint64_t word = words[w];
+      const std::size_t base = w * kBits;
+      const std::size_t n = (Dim - base < kBits) ? Dim - base : kBits;
+      counter_t* c = counters_.data() + base;
 #if defined(HYPERSTREAM_BUNDLER_COUNTER_WIDE)
-    // Wide counters: simple add/sub (±2e9 capacity).
-    for (std::size_t i = 0; i < Dim; ++i) {
-      counters_[i] += hv.GetBit(i) ? 1 : -1;
-    }
+      // Wide counters: simple add/sub (±2e9 capacity).
+      for (std::size_t b = 0; b < n; ++b) {
+        c[b] += static_cast<counter_t>(static_cast<counter_t>((word >> b) & 1ULL) * 2 - 1);
+      }
 #else
-    // Default: saturating add/sub to prevent overflow of 16-bit counters.
-    for (std::size_t i = 0; i < Dim; ++i) {
-      if (hv.GetBit(i)) {
-        if (counters_[i] != std::numeric_limits<counter_t>::max()) ++counters_[i];
-      } else {
-        if (counters_[i] != std::numeric_limits<counter_t>::min()) --counters_[i];
+      // Default: saturating add/sub to prevent overflow of 16-bit counters (computed in int32 and
+      // clamped, which is the same as skipping the step at the limit).
+      constexpr std::int32_t kMax = std::numeric_limits<counter_t>::max();
+      constexpr std::int32_t kMin = std::numeric_limits<counter_t>::min();
+      for (std::size_t b = 0; b < n; ++b) {
+        std::int32_t v = static_cast<std::int32_t>(c[b]) + static_cast<std::int32_t>(((word >> b) & 1ULL) * 2) - 1;
+        v = v > kMax ? kMax : v;
+        v = v < kMin ? kMin : v;
+        c[b] = static_cast<counter_t>(v);
       }
-    }
 #endif
+    }
   }
 
-  void Finalize(HyperVector<Dim, bool>* out) const {
+  // Per-Finalize telemetry derived from the counter array (Accumulate is untouched).
+  // Margin buckets are log2-spaced over |counter|: bucket 0 holds exact ties (resolved to 1 by
+  // the >= 0 rule), bucket k in [1, kMarginBuckets-2] holds margins in [2^(k-1), 2^k), and the
+  // last bucket holds everything >= 2^(kMarginBuckets-2). A large tie/low-margin mass means the
+  // window is too short to be stable; a growing saturated count means the int16 clamp is
+  // discarding votes and decay or HYPERSTREAM_BUNDLER_COUNTER_WIDE should be considered.
+  static constexpr std::size_t kMarginBuckets = 8;
+
+  struct Stats {
+    std::size_t saturated = 0;  // counters pinned at the counter_t limits
+    std::array<std::size_t, kMarginBuckets> margin_histogram{};
+
+    std::size_t ties() const noexcept { return margin_histogram[0]; }
+    // Counters with |counter| < 2^k (k clamped to the histogram range).
+    std::size_t MarginBelowPow2(std::size_t k) const noexcept {
+      std::size_t n = 0;
+      for (std::size_t b = 0; b <= k && b + 1 < kMarginBuckets; ++b) n += margin_histogram[b];
+      return n;
+    }
+    double SaturatedFraction() const noexcept {
+      return static_cast<double>(saturated) / static_cast<double>(Dim);
+    }
+  };
+
+  // Single branch-free pass over the counters; each threshold test is an independent reduction
+  // so the loop auto-vectorizes (8x int16 lanes on SSE2, 16x on AVX2).
+  Stats ComputeStats() const noexcept {
+    using wide_t = std::conditional_t<(sizeof(counter_t) < 4), std::int32_t, std::int64_t>;
+    constexpr wide_t kMax = std::numeric_limits<counter_t>::max();
+    constexpr wide_t kMin = std::numeric_limits<counter_t>::min();
+    constexpr std::size_t kCuts = kMarginBuckets - 1;  // cumulative thresholds 2^0 .. 2^(kCuts-1)
+    std::array<std::size_t, kCuts> below{};
+    std::size_t saturated = 0;
     for (std::size_t i = 0; i < Dim; ++i) {
-      out->SetBit(i, counters_[i] >= 0);
+      const wide_t c = counters_[i];
+      const wide_t m = c < 0 ? -c : c;
+      saturated += static_cast<std::size_t>((c == kMax) | (c == kMin));
+      for (std::size_t k = 0; k < kCuts; ++k) {
+        below[k] += static_cast<std::size_t>(m < (wide_t{1} << k));
+      }
     }
+    Stats s;
+    s.saturated = saturated;
+    s.margin_histogram[0] = below[0];
+    for (std::size_t k = 1; k < kCuts; ++k) s.margin_histogram[k] = below[k] - below[k - 1];
+    s.margin_histogram[kCuts] = Dim - below[kCuts - 1];
+    return s;
+  }
+
+  void Finalize(HyperVector<Dim, bool>* out) const { Finalize(out, nullptr); }
+
+  // Finalize and, when `stats` is non-null, report saturation and near-tie margins for this window.
+  void Finalize(HyperVector<Dim, bool>* out, Stats* stats) const {
+    HS_METRIC_TIMER(Finalize);
+    HS_METRIC_INC(BundlerFinalizes);
+    detail::PackBits(out, [this](std::size_t i) { return counters_[i] >= 0; });
+#if defined(HYPERSTREAM_ENABLE_METRICS)
+    const Stats s = ComputeStats();
+    HS_METRIC_ADD(BundlerSaturatedCounters, s.saturated);
+    if (stats != nullptr) *stats = s;
+#else
+    if (stats != nullptr) *stats = ComputeStats();
+#endif
   }
 
  private:
   std::array<counter_t, Dim> counters_{};  // per-bit counters
 };
 
+// Binary majority bundling over bit-sliced (vertical) counters for long streams of vectors.
+// The number of 1s each bit saw among the pending vectors is held across kPlanes words, one bit
+// per plane, so Accumulate is a ripple-carry add of whole words that stops at the first plane
+// without carries (about two planes on average) instead of Dim counter updates. Every
+// 2^kPlanes - 1 vectors the planes are folded into int32 counters.
+// Finalize equals BinaryBundler::Finalize (ties -> 1) while BinaryBundler does not saturate, i.e.
+// for fewer than 32768 vectors per window; the int32 counters here do not saturate.
+template <std::size_t Dim>
+class BitSlicedBundler {
+ public:
+  static constexpr std::size_t kPlanes = 8;
+
+  BitSlicedBundler() { Reset(); }
+
+  void Reset() {
+    for (auto& plane : planes_) plane.fill(0);
+    counters_.fill(0);
+    pending_ = 0;
+  }
+
+  void Accumulate(const HyperVector<Dim, bool>& hv) {
+    HS_METRIC_INC(BundlerAccumulates);
+    std::array<std::uint64_t, kWords> carry = hv.Words();
+    for (std::size_t k = 0; k < kPlanes; ++k) {
+      std::uint64_t any = 0;
+      for (std::size_t w = 0; w < kWords; ++w) {
+        const std::uint64_t c = planes_[k][w] & carry[w];
+        planes_[k][w] ^= carry[w];
+        carry[w] = c;
+        any |= c;
+      }
+      if (any == 0) break;
+    }
+    if (++pending_ == (std::size_t{1} << kPlanes) - 1) Fold();
+  }
+
+  void Finalize(HyperVector<Dim, bool>* out) const {
+    HS_METRIC_TIMER(Finalize);
+    HS_METRIC_INC(BundlerFinalizes);
+    const std::int32_t pending = static_cast<std::int32_t>(pending_);
+    detail::PackBits(out, [this, pending](std::size_t i) {
+      return counters_[i] + 2 * Pending(i) - pending >= 0;
+    });
+  }
+
+ private:
+  static constexpr std::size_t kWords = HyperVector<Dim, bool>::WordCount();
+
+  // 1s among the pending vectors at bit i.
+  std::int32_t Pending(std::size_t i) const noexcept {
+    std::int32_t n = 0;
+    for (std::size_t k = 0; k < kPlanes; ++k) {
+      n |= static_cast<std::int32_t>((planes_[k][i / 64] >> (i % 64)) & 1ULL) << k;
+    }
+    return n;
+  }
+
+  // counters += 2 * ones - pending (the +/-1 sum of the pending vectors); clears the planes.
+  void Fold() noexcept {
+    const std::int32_t pending = static_cast<std::int32_t>(pending_);
+    for (std::size_t w = 0; w < kWords; ++w) {
+      const std::size_t n = (Dim - w * 64 < 64) ? Dim - w * 64 : 64;
+      std::int32_t* c = counters_.data() + w * 64;
+      for (std::size_t b = 0; b < n; ++b) {
+        std::int32_t ones = 0;
+        for (std::size_t k = 0; k < kPlanes; ++k) {
+          ones |= static_cast<std::int32_t>((planes_[k][w] >> b) & 1ULL) << k;
+        }
+        c[b] += 2 * ones - pending;
+      }
+    }
+    for (auto& plane : planes_) plane.fill(0);
+    pending_ = 0;
+  }
+
+  std::array<std::array<std::uint64_t, kWords>, kPlanes> planes_{};
+  std::array<std::int32_t, Dim> counters_{};
+  std::size_t pending_ = 0;  // vectors in the planes (< 2^kPlanes)
+};
+
 // Numeric/complex bundling: element-wise sum; optionally normalized by caller.
 
 template <std::size_t Dim, typename T>
@@ -223,6 +418,72 @@ inline std::size_t HammingDistance(const HyperVector<Dim, bool>& a,
   return dist;
 }
 
+// Signed dot product of a binary vector's +/-1 bits (set = +1) with `dim_bits` integer counters:
+// sum_i (bit_i ? counters[i] : -counters[i]). Scores a query against bundling counters (e.g.
+// ClusterMemory sums) without thresholding them first. Branch-free per word so the loop
+// vectorizes; terms are negated and summed in int64, so the result is exact for any int counters
+// (INT_MIN included).
+inline std::int64_t SignedDotWords(const int* counters, const std::uint64_t* words,
+                                   std::size_t dim_bits) noexcept {
+  std::int64_t total = 0;
+  for (std::size_t w = 0; w * 64 < dim_bits; ++w) {
+    const std::size_t nb = (dim_bits - w * 64 < 64) ? dim_bits - w * 64 : 64;
+    const int* c = counters + w * 64;
+    const std::uint64_t q = words[w];
+    std::int64_t part = 0;
+    for (std::size_t b = 0; b < nb; ++b) {
+      const std::int64_t flip = static_cast<std::int64_t>((q >> b) & 1ULL) - 1;  // 0 or -1
+      part += (static_cast<std::int64_t>(c[b]) ^ flip) - flip;
+    }
+    total += part;
+  }
+  return total;
+}
+
+// counters[i] += bit_i ? step : -step for the first `dim_bits` bits of `words`: adds (step > 0) or
+// subtracts a binary vector's +/-1 bits to/from bundling counters (ClusterMemory::Update and
+// Reinforce). Branch-free like SignedDotWords.
+inline void AddSignedWords(int* counters, const std::uint64_t* words, std::size_t dim_bits,
+                           int step) noexcept {
+  for (std::size_t w = 0; w * 64 < dim_bits; ++w) {
+    const std::size_t nb = (dim_bits - w * 64 < 64) ? dim_bits - w * 64 : 64;
+    int* c = counters + w * 64;
+    const std::uint64_t q = words[w];
+    for (std::size_t b = 0; b < nb; ++b) {
+      const int flip = static_cast<int>((q >> b) & 1ULL) - 1;  // 0 or -1
+      c[b] += (step ^ flip) - flip;
+    }
+  }
+}
+
+// Hamming distance of every pair (a[i], b[j]), i < na, j < nb, of word_count-word rows into
+// out[i * out_stride + j]. Portable 4x4 register-tiled kernel (hardware popcount where the target
+// has one, see detail::PopcountTile64); backend::SelectHammingTileBackend() returns SIMD variants
+// with the same contract.
+inline void HammingTileWords(const std::uint64_t* const* a, std::size_t na,
+                             const std::uint64_t* const* b, std::size_t nb, std::size_t word_count,
+                             std::uint32_t* out, std::size_t out_stride) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= na; i += 4) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) {
+      detail::HammingMicroTile<4, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+    for (; j < nb; ++j) {
+      detail::HammingMicroTile<4, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+  }
+  for (; i < na; ++i) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) {
+      detail::HammingMicroTile<1, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+    for (; j < nb; ++j) {
+      detail::HammingMicroTile<1, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+  }
+}
+
 template <std::size_t Dim>
 inline float NormalizedHammingSimilarity(const HyperVector<Dim, bool>& a,
                                          const HyperVector<Dim, bool>& b) {
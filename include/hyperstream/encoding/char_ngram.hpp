@@ -0,0 +1,133 @@
+#pragma once
+
+// Character n-gram text encoder over raw byte streams (language ID, log templates).
+//
+// Bundles the n-gram vectors of SequentialNGramEncoder<Dim, N> over the bytes of the text,
+// g_t = H(b_t) ^ rho(H(b_t-1)) ^ ... ^ rho^(N-1)(H(b_t-N+1)), without tokenizing or hashing
+// n-gram strings:
+// - H(b) and rho^(N-1)(H(b)) are generated once per byte value (2 x 256 vectors per encoder).
+// - g_t is rolled forward instead of rebuilt: g_t = rho(g_t-1 ^ rho^(N-1)(H(b_t-N))) ^ H(b_t),
+//   one fused pass over the words per byte (drop the oldest byte, rotate by one, bind the new
+//   byte), independent of N.
+// - The n-grams are bundled by core::BitSlicedBundler, whose word-parallel add replaces the Dim
+//   per-bit counter updates of BinaryBundler.
+// Every complete n-gram of the stream is bundled, starting with the first N bytes (the
+// per-symbol SequentialNGramEncoder only starts at the (N+1)-th symbol).
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/metrics.hpp"
+
+namespace hyperstream {
+namespace encoding {
+
+/**
+ * @brief Streaming encoder of the byte n-grams of a text.
+ *
+ * @tparam Dim Hypervector dimension (bits)
+ * @tparam N   n-gram length in bytes (> 0)
+ *
+ * Invariants and behavior:
+ * - Update() calls continue the same stream: splitting a text across calls does not change the
+ *   result. Reset() starts a new text.
+ * - Finalize() equals BinaryBundler majority over the n-gram vectors (ties -> 1) for fewer than
+ *   32768 n-grams per text; longer texts are not clamped.
+ * - Thread-safety: not thread-safe; distinct instances are independent.
+ *
+ * Complexity: O(Dim/64) word operations per byte; construction generates 512 vectors.
+ */
+template <std::size_t Dim, std::size_t N>
+class CharNGramEncoder {
+ public:
+  static_assert(N > 0, "CharNGramEncoder requires N > 0");
+  using Vector = core::HyperVector<Dim, bool>;
+
+  explicit CharNGramEncoder(std::uint64_t seed = 0x27d4eb2f165667c5ULL) : items_(256), oldest_(256) {
+    for (std::size_t b = 0; b < 256; ++b) {
+      detail::GenerateRandomHypervector(seed, b, &items_[b]);
+      core::PermuteRotate(items_[b], N - 1, &oldest_[b]);
+    }
+    Reset();
+  }
+
+  void Reset() {
+    bundler_.Reset();
+    ngram_.Clear();
+    head_ = 0;
+    count_ = 0;
+    ngrams_ = 0;
+  }
+
+  /** Appends the bytes of `text` to the stream and bundles every n-gram they complete. */
+  void Update(std::string_view text) {
+    HS_METRIC_TIMER(Encode);
+    for (const char ch : text) {
+      const auto b = static_cast<unsigned char>(ch);
+      if (count_ == N) {
+        Roll<true>(oldest_[window_[head_]], items_[b]);
+      } else {
+        Roll<false>(items_[b], items_[b]);
+        ++count_;
+      }
+      window_[head_] = b;
+      head_ = (head_ + 1) % N;
+      if (count_ == N) {
+        bundler_.Accumulate(ngram_);
+        ++ngrams_;
+      }
+    }
+  }
+
+  void Finalize(Vector* out) const { bundler_.Finalize(out); }
+
+  /** Reset(), Update(text), Finalize(out). */
+  void Encode(std::string_view text, Vector* out) {
+    Reset();
+    Update(text);
+    Finalize(out);
+  }
+
+  /** N-grams bundled since Reset(). */
+  [[nodiscard]] std::size_t ngram_count() const noexcept { return ngrams_; }
+  /** The most recent n-gram vector (meaningful once ngram_count() > 0). */
+  [[nodiscard]] const Vector& ngram() const noexcept { return ngram_; }
+
+ private:
+  static constexpr std::size_t kWords = Vector::WordCount();
+
+  // ngram_ = rho(ngram_ ^ drop) ^ add (drop ignored unless Drop), with rho the one-bit
+  // core::PermuteRotate: a left shift across words, the top word wrapping into bit 0, masked to Dim.
+  template <bool Drop>
+  void Roll(const Vector& drop, const Vector& add) noexcept {
+    auto& g = ngram_.Words();
+    const auto& d = drop.Words();
+    const auto& a = add.Words();
+    std::uint64_t prev = g[kWords - 1] ^ (Drop ? d[kWords - 1] : 0);
+    for (std::size_t w = 0; w < kWords; ++w) {
+      const std::uint64_t x = g[w] ^ (Drop ? d[w] : 0);
+      g[w] = ((x << 1) | (prev >> 63)) ^ a[w];
+      prev = x;
+    }
+    constexpr std::size_t kExtra = kWords * 64 - Dim;
+    if constexpr (kExtra > 0) g[kWords - 1] &= ~0ULL >> kExtra;
+  }
+
+  std::vector<Vector> items_;   // H(b) per byte value
+  std::vector<Vector> oldest_;  // rho^(N-1)(H(b)) per byte value
+  Vector ngram_;
+  std::array<unsigned char, N> window_{};  // last N bytes (ring)
+  std::size_t head_ = 0;                   // ring slot of the oldest byte once full
+  std::size_t count_ = 0;                  // bytes in the window (<= N)
+  std::size_t ngrams_ = 0;
+  core::BitSlicedBundler<Dim> bundler_;
+};
+
+}  // namespace encoding
+}  // namespace hyperstream
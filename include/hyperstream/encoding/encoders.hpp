@@ -12,6 +12,8 @@
 
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/token_hash.hpp"
+#include "hyperstream/metrics.hpp"
 
 namespace hyperstream {
 namespace encoding {
@@ -52,21 +54,14 @@ inline void GenerateRandomHypervector(std::uint64_t seed, std::uint64_t symbol,
   }
 }
 
+// Legacy spellings of the kFnv1a token hash; the definition lives in token_hash.hpp.
 inline std::uint64_t Fnv1a64(std::string_view token, std::uint64_t seed) {
-  std::uint64_t hash = 1469598103934665603ULL ^ seed;
-  for (unsigned char c : token) {
-    hash ^= static_cast<std::uint64_t>(c);
-    hash *= 1099511628211ULL;
-  }
-  return hash;
+  return detail_tokenhash::Fnv1a64(token, seed);
 }
 
 inline std::pair<std::uint64_t, std::uint64_t> DoubleHash(std::string_view token,
                                                           std::uint64_t seed) {
-  const std::uint64_t h1 = Fnv1a64(token, seed);
-  std::uint64_t h2 = Fnv1a64(token, seed ^ 0x5bf03635f0b7a54dULL);
-  h2 = (h2 << 1) | 1ULL;  // ensure odd step
-  return {h1, h2};
+  return HashTokenPair(TokenHash::kFnv1a, token, seed);
 }
 
 template <std::size_t Dim>
@@ -111,6 +106,7 @@ class RandomBasisEncoder {
   }
 
   void Update(std::uint64_t symbol) {
+    HS_METRIC_TIMER(Encode);
     core::HyperVector<Dim, bool> hv;
     hv.Clear();
     detail::GenerateRandomHypervector(seed_, symbol, &hv);
@@ -136,10 +132,14 @@ class RandomBasisEncoder {
 };
 
 // Hash/streaming encoder using double hashing to set K positions.
+// `hash` selects the token hash family (encoding/token_hash.hpp); kFnv1a reproduces the
+// original encodings.
 template <std::size_t Dim>
 class HashEncoder {
  public:
-  explicit HashEncoder(int k = 4, std::uint64_t seed = 0x51ed2701f3a5c7b9ULL) : k_(k), seed_(seed) {
+  explicit HashEncoder(int k = 4, std::uint64_t seed = 0x51ed2701f3a5c7b9ULL,
+                       TokenHash hash = TokenHash::kFnv1a)
+      : k_(k), seed_(seed), hash_(hash) {
     Reset();
   }
 
@@ -148,6 +148,7 @@ class HashEncoder {
   }
 
   void Update(std::string_view token, std::size_t role = 0) {
+    HS_METRIC_TIMER(Encode);
     core::HyperVector<Dim, bool> hv;
     hv.Clear();
     EncodeToken(token, role, &hv);
@@ -161,11 +162,11 @@ class HashEncoder {
   void EncodeToken(std::string_view token, std::size_t role,
                    core::HyperVector<Dim, bool>* out) const {
     out->Clear();
-    const auto [h1, h2] = detail::DoubleHash(token, seed_);
+    const auto [h1, h2] = HashTokenPair(hash_, token, seed_);
     for (int i = 0; i < k_; ++i) {
       const std::size_t pos =
           static_cast<std::size_t>((h1 + static_cast<std::uint64_t>(i) * h2) % Dim);
-      out->SetBit(pos, true);
+      out->SetBitUnchecked(pos, true);
     }
     if (role != 0) {
       core::HyperVector<Dim, bool> rotated;
@@ -175,9 +176,12 @@ class HashEncoder {
     }
   }
 
+  [[nodiscard]] TokenHash token_hash() const noexcept { return hash_; }
+
  private:
   int k_;
   std::uint64_t seed_;
+  TokenHash hash_;
   core::BinaryBundler<Dim> bundler_;
 };
 
@@ -196,13 +200,15 @@ class UnaryIntensityEncoder {
   }
 
   void Update(std::size_t intensity) {
+    HS_METRIC_TIMER(Encode);
     const std::size_t clamped = (intensity > max_intensity_) ? max_intensity_ : intensity;
     core::HyperVector<Dim, bool> hv;
     hv.Clear();
-    for (std::size_t i = 0; i < clamped && i < Dim; ++i) {
-      const std::size_t index = order_[(phase_ + i) % Dim];
-      hv.SetBit(index, true);
-    }
+    // Bits order_[phase_ .. phase_ + count) modulo Dim: at most two contiguous runs of order_.
+    const std::size_t count = (clamped < Dim) ? clamped : Dim;
+    const std::size_t head = (count < Dim - phase_) ? count : Dim - phase_;
+    hv.SetBits(order_.data() + phase_, head);
+    hv.SetBits(order_.data(), count - head);
     bundler_.Accumulate(hv);
     phase_ = (phase_ + clamped) % Dim;
   }
@@ -236,6 +242,7 @@ class SequentialNGramEncoder {
   }
 
   void Update(std::uint64_t symbol) {
+    HS_METRIC_TIMER(Encode);
     history_[head_] = symbol;
     head_ = (head_ + 1) % Window;
     if (count_ < Window) {
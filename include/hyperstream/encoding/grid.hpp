@@ -0,0 +1,252 @@
+#pragma once
+
+// 2D grid / image encoder: bundles X(col) ^ Y(row) ^ V(intensity) over the pixels of a frame or patch.
+//
+// - Column, row and intensity codebooks are built once per encoder. Positions use either
+//   correlated level codes (nearby rows/columns share most bits, the two ends are orthogonal) or
+//   the binary export of a FractionalPowerEncoder (similarity localized to ~length_scale pixels).
+// - Per pixel, the three-way bind and a branch-free add into a 5-plane bit-sliced counter run in
+//   one word loop; every 31 pixels that counter is folded into the band's wide planes.
+// - Frames are cut into bands of kTileRows rows, one executor task per band. Each band's planes
+//   are unpacked into int32 counts, so the result is the exact majority whatever the executor.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/encoding/item_memory.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+#include "hyperstream/memory/executor.hpp"
+#include "hyperstream/metrics.hpp"
+
+namespace hyperstream {
+namespace encoding {
+
+/** Position codebook used by GridEncoder for rows and columns. */
+enum class GridPositionCode : std::uint8_t {
+  kLevel = 0,            // linear level codes: Hamming distance grows with |i - j|, ends orthogonal
+  kFractionalPower = 1,  // binary FractionalPowerEncoder export, Gaussian phases of length_scale
+};
+
+namespace detail_grid {
+
+// n correlated level vectors: level i is a random base vector with the first
+// floor(i * (Dim/2) / (n-1)) bits of a random bit order flipped.
+template <std::size_t Dim>
+inline void BuildLevels(std::uint64_t seed, std::uint64_t symbol, std::size_t n,
+                        std::vector<core::HyperVector<Dim, bool>>* out) {
+  out->resize(n);
+  if (n == 0) return;
+  core::HyperVector<Dim, bool> hv;
+  detail::GenerateRandomHypervector(seed, symbol, &hv);
+  std::vector<std::size_t> order(Dim);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::uint64_t state = detail_itemmemory::MixSymbol(seed, symbol ^ 0x4c564cULL);
+  for (std::size_t i = Dim; i > 1; --i) {
+    std::swap(order[i - 1], order[detail_itemmemory::SplitMix64Step(state) % i]);
+  }
+  std::size_t flipped = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t target = (n == 1) ? 0 : i * (Dim / 2) / (n - 1);
+    for (; flipped < target; ++flipped) {
+      hv.Words()[order[flipped] / 64] ^= 1ULL << (order[flipped] % 64);
+    }
+    (*out)[i] = hv;
+  }
+}
+
+}  // namespace detail_grid
+
+/**
+ * @brief Encoder of 8-bit grayscale frames and patches over a fixed width x height grid.
+ *
+ * @tparam Dim Hypervector dimension (bits)
+ *
+ * Encode() equals BinaryBundler majority (ties -> 1) over X[x] ^ Y[y] ^ V[q(p)] for the pixels
+ * (x, y) of the region, with absolute grid coordinates, so a patch shares its pixels' vectors
+ * with the full frame. q(p) = p * intensity_levels / 256; the intensity codebook uses level codes.
+ *
+ * Thread-safety: stateless after construction; reentrant.
+ * Complexity: O(pixels * Dim/64) word operations per encode; construction builds
+ * width + height + intensity_levels vectors.
+ */
+template <std::size_t Dim>
+class GridEncoder {
+ public:
+  using Vector = core::HyperVector<Dim, bool>;
+
+  static constexpr std::size_t kTileRows = 32;  // rows per executor task
+
+  /**
+   * @param intensity_levels clamped to [1, 256]
+   * @param length_scale     kFractionalPower only: kernel width in pixels
+   */
+  GridEncoder(std::size_t width, std::size_t height, std::uint64_t seed = 0x47524431ULL,
+              GridPositionCode code = GridPositionCode::kLevel, std::size_t intensity_levels = 16,
+              double length_scale = 4.0)
+      : width_(width),
+        height_(height),
+        intensity_levels_(std::clamp<std::size_t>(intensity_levels, 1, 256)),
+        code_(code) {
+    if (code == GridPositionCode::kFractionalPower) {
+      FractionalPowerEncoder<Dim> fx(seed ^ 0x58ULL, length_scale, FractionalPowerKernel::kGaussian);
+      FractionalPowerEncoder<Dim> fy(seed ^ 0x59ULL, length_scale, FractionalPowerKernel::kGaussian);
+      cols_.resize(width);
+      rows_.resize(height);
+      for (std::size_t x = 0; x < width; ++x) fx.Encode(static_cast<double>(x), &cols_[x]);
+      for (std::size_t y = 0; y < height; ++y) fy.Encode(static_cast<double>(y), &rows_[y]);
+    } else {
+      detail_grid::BuildLevels<Dim>(seed, 0x58ULL, width, &cols_);
+      detail_grid::BuildLevels<Dim>(seed, 0x59ULL, height, &rows_);
+    }
+    detail_grid::BuildLevels<Dim>(seed, 0x56ULL, intensity_levels_, &values_);
+  }
+
+  /** Encodes a full width x height frame of row-major pixels. */
+  template <typename Executor = memory::SerialExecutor>
+  void Encode(const std::uint8_t* pixels, Vector* out, Executor&& exec = Executor{}) const {
+    EncodePatch(pixels, width_, 0, 0, width_, height_, out, std::forward<Executor>(exec));
+  }
+
+  /**
+   * @brief Encodes the w x h region at (x0, y0), clipped to the grid. `pixels` points at the
+   * region's top-left pixel; rows are `stride` bytes apart.
+   */
+  template <typename Executor = memory::SerialExecutor>
+  void EncodePatch(const std::uint8_t* pixels, std::size_t stride, std::size_t x0, std::size_t y0,
+                   std::size_t w, std::size_t h, Vector* out, Executor&& exec = Executor{}) const {
+    HS_METRIC_TIMER(Encode);
+    w = (x0 >= width_) ? 0 : std::min(w, width_ - x0);
+    h = (y0 >= height_) ? 0 : std::min(h, height_ - y0);
+    const std::size_t tiles = (h + kTileRows - 1) / kTileRows;
+    std::vector<std::int32_t> counts(tiles * Dim);
+    exec(tiles, [&](std::size_t tile) {
+      const std::size_t r0 = tile * kTileRows;
+      const std::size_t r1 = std::min(h, r0 + kTileRows);
+      AccumulateTile(pixels + r0 * stride, stride, x0, y0 + r0, w, r1 - r0, &counts[tile * Dim]);
+    });
+    for (std::size_t tile = 1; tile < tiles; ++tile) {
+      const std::int32_t* c = &counts[tile * Dim];
+      for (std::size_t i = 0; i < Dim; ++i) counts[i] += c[i];
+    }
+    const std::int64_t threshold = static_cast<std::int64_t>((w * h + 1) / 2);
+    auto& ow = out->Words();
+    for (std::size_t wi = 0; wi < kWords; ++wi) {
+      const std::size_t n = (Dim - wi * 64 < 64) ? Dim - wi * 64 : 64;
+      std::uint64_t word = 0;
+      for (std::size_t b = 0; b < n; ++b) {
+        const std::int64_t c = (tiles == 0) ? 0 : counts[wi * 64 + b];
+        word |= static_cast<std::uint64_t>(c >= threshold) << b;
+      }
+      ow[wi] = word;
+    }
+  }
+
+  /** X[x] ^ Y[y]: the position vector of a grid cell (x < width, y < height). */
+  void Position(std::size_t x, std::size_t y, Vector* out) const {
+    const auto& a = cols_[x].Words();
+    const auto& b = rows_[y].Words();
+    auto& o = out->Words();
+    for (std::size_t w = 0; w < kWords; ++w) o[w] = a[w] ^ b[w];
+  }
+
+  [[nodiscard]] const Vector& column(std::size_t x) const noexcept { return cols_[x]; }
+  [[nodiscard]] const Vector& row(std::size_t y) const noexcept { return rows_[y]; }
+  [[nodiscard]] const Vector& intensity(std::size_t level) const noexcept { return values_[level]; }
+  [[nodiscard]] std::size_t IntensityLevel(std::uint8_t p) const noexcept {
+    return (static_cast<std::size_t>(p) * intensity_levels_) >> 8;
+  }
+
+  [[nodiscard]] std::size_t width() const noexcept { return width_; }
+  [[nodiscard]] std::size_t height() const noexcept { return height_; }
+  [[nodiscard]] std::size_t intensity_levels() const noexcept { return intensity_levels_; }
+  [[nodiscard]] GridPositionCode code() const noexcept { return code_; }
+
+ private:
+  static constexpr std::size_t kWords = Vector::WordCount();
+  static constexpr std::size_t kLowPlanes = 5;  // low counter: 31 pixels between folds
+  // Planes per band: counts up to kTileRows * width need bit_width(kTileRows * width) planes.
+  static std::size_t PlaneCount(std::size_t n) noexcept {
+    std::size_t b = 0;
+    for (; n != 0; n >>= 1) ++b;
+    return b;
+  }
+
+  // counts[i] = number of pixels of the band whose bound vector has bit i set. Pixels are first
+  // counted in kLowPlanes bit-sliced planes (a fixed, branch-free ripple: carries reach the top
+  // planes of some word on almost every add at these dimensions, so an early exit rarely helps),
+  // and every 2^kLowPlanes - 1 pixels the low count is added into the band's wide planes.
+  void AccumulateTile(const std::uint8_t* pixels, std::size_t stride, std::size_t x0, std::size_t y,
+                      std::size_t w, std::size_t h, std::int32_t* counts) const {
+    const std::size_t planes = std::max(kLowPlanes, PlaneCount(w * h));
+    std::vector<std::uint64_t> p(planes * kWords);
+    std::vector<std::uint64_t> lo(kLowPlanes * kWords);
+    std::size_t pending = 0;
+    for (std::size_t r = 0; r < h; ++r) {
+      const std::uint64_t* yw = rows_[y + r].Words().data();
+      const std::uint8_t* px = pixels + r * stride;
+      for (std::size_t c = 0; c < w; ++c) {
+        const std::uint64_t* xw = cols_[x0 + c].Words().data();
+        const std::uint64_t* vw = values_[IntensityLevel(px[c])].Words().data();
+        std::uint64_t* l = lo.data();
+        for (std::size_t k = 0; k < kWords; ++k) {
+          std::uint64_t carry = xw[k] ^ yw[k] ^ vw[k];
+          for (std::size_t plane = 0; plane < kLowPlanes; ++plane) {
+            const std::uint64_t cy = l[plane * kWords + k] & carry;
+            l[plane * kWords + k] ^= carry;
+            carry = cy;
+          }
+        }
+        if (++pending == (std::size_t{1} << kLowPlanes) - 1) {
+          FoldLow(&lo, &p, planes);
+          pending = 0;
+        }
+      }
+    }
+    FoldLow(&lo, &p, planes);
+    for (std::size_t i = 0; i < Dim; ++i) {
+      std::int32_t n = 0;
+      for (std::size_t plane = 0; plane < planes; ++plane) {
+        n |= static_cast<std::int32_t>((p[plane * kWords + i / 64] >> (i % 64)) & 1ULL) << plane;
+      }
+      counts[i] = n;
+    }
+  }
+
+  // p += lo (bit-sliced, per word; the carry dies out a few planes above kLowPlanes); clears lo.
+  static void FoldLow(std::vector<std::uint64_t>* lo, std::vector<std::uint64_t>* p, std::size_t planes) noexcept {
+    std::uint64_t* l = lo->data();
+    std::uint64_t* m = p->data();
+    for (std::size_t k = 0; k < kWords; ++k) {
+      std::uint64_t carry = 0;
+      for (std::size_t plane = 0; plane < kLowPlanes; ++plane) {
+        const std::uint64_t a = m[plane * kWords + k];
+        const std::uint64_t b = l[plane * kWords + k];
+        m[plane * kWords + k] = a ^ b ^ carry;
+        carry = (a & b) | (carry & (a ^ b));
+        l[plane * kWords + k] = 0;
+      }
+      for (std::size_t plane = kLowPlanes; carry != 0 && plane < planes; ++plane) {
+        const std::uint64_t a = m[plane * kWords + k];
+        m[plane * kWords + k] = a ^ carry;
+        carry &= a;
+      }
+    }
+  }
+
+  std::size_t width_;
+  std::size_t height_;
+  std::size_t intensity_levels_;
+  GridPositionCode code_;
+  std::vector<Vector> cols_;    // X[x]
+  std::vector<Vector> rows_;    // Y[y]
+  std::vector<Vector> values_;  // V[level]
+};
+
+}  // namespace encoding
+}  // namespace hyperstream
@@ -9,6 +9,7 @@
 #include <string_view>
 
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/encoding/token_hash.hpp"
 
 namespace hyperstream {
 namespace encoding {
@@ -32,13 +33,9 @@ inline std::uint64_t MixSymbol(std::uint64_t seed, std::uint64_t symbol) {
   return s;
 }
 
+// Legacy spelling of the kFnv1a token hash; the definition lives in token_hash.hpp.
 inline std::uint64_t Fnv1a64(std::string_view token, std::uint64_t seed) {
-  std::uint64_t hash = 1469598103934665603ULL ^ seed;
-  for (unsigned char c : token) {
-    hash ^= static_cast<std::uint64_t>(c);
-    hash *= 1099511628211ULL;
-  }
-  return hash;
+  return detail_tokenhash::Fnv1a64(token, seed);
 }
 
 }  // namespace detail_itemmemory
@@ -59,7 +56,8 @@ inline std::uint64_t Fnv1a64(std::string_view token, std::uint64_t seed) {
 template <std::size_t Dim>
 class ItemMemory {
  public:
-  explicit ItemMemory(std::uint64_t seed) : seed_(seed) {}
+  /** `hash` selects the token hash family for EncodeToken (kFnv1a: the original encodings). */
+  explicit ItemMemory(std::uint64_t seed, TokenHash hash = TokenHash::kFnv1a) : seed_(seed), hash_(hash) {}
 
   /** Encodes a 64-bit id into a binary HyperVector. */
   void EncodeId(std::uint64_t id, core::HyperVector<Dim, bool>* out) const noexcept {
@@ -83,13 +81,19 @@ class ItemMemory {
 
   /** Encodes a token (string) into a binary HyperVector. */
   void EncodeToken(std::string_view token, core::HyperVector<Dim, bool>* out) const {
-    using detail_itemmemory::Fnv1a64;
-    const std::uint64_t sym = Fnv1a64(token, seed_ ^ 0x5bf03635f0b7a54dULL);
-    EncodeId(sym, out);
+    EncodeId(TokenId(token), out);
+  }
+
+  /** The id EncodeToken encodes `token` as: tokens with equal ids have equal vectors. */
+  [[nodiscard]] std::uint64_t TokenId(std::string_view token) const noexcept {
+    return HashToken(hash_, token, seed_ ^ 0x5bf03635f0b7a54dULL);
   }
 
+  [[nodiscard]] TokenHash token_hash() const noexcept { return hash_; }
+
  private:
   std::uint64_t seed_;
+  TokenHash hash_;
 };
 
 }  // namespace encoding
@@ -1,16 +1,24 @@
 #pragma once
 
-// Numeric encoders: thermometer (scalar) and random projection (vector).
-// Header-only; deterministic with explicit seeds; no dynamic allocation.
+// Numeric encoders: thermometer (scalar), random projection (vector) and fractional power
+// (kernel-preserving phasor encoding of scalars or small vectors).
+// Header-only; deterministic with explicit seeds; no dynamic allocation except the fractional
+// power encoder's phase tables (allocated once at construction).
 
 #include <array>
+#include <cmath>
+#include <complex>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string_view>
+#include <vector>
 
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/core/ops.hpp"
 #include "hyperstream/encoding/item_memory.hpp"
+#include "hyperstream/memory/executor.hpp"
+#include "hyperstream/metrics.hpp"
 
 namespace hyperstream {
 namespace encoding {
@@ -43,6 +51,28 @@ inline std::array<std::size_t, Dim> BuildOrder() {
   return order;
 }
 
+// cos/sin of 2^kPhasorBits equal phase buckets (bucket midpoints), indexed by the top bits of a
+// 32-bit fixed-point phase in turns. Max phase error pi / 2^kPhasorBits (4e-4 rad at 12 bits).
+constexpr unsigned kPhasorBits = 12;
+
+inline const std::array<std::complex<float>, (1u << kPhasorBits)>& PhasorTable() {
+  static const auto table = [] {
+    std::array<std::complex<float>, (1u << kPhasorBits)> t{};
+    const double kTwoPi = 6.283185307179586476925286766559;
+    for (std::size_t i = 0; i < t.size(); ++i) {
+      const double phase = kTwoPi * (static_cast<double>(i) + 0.5) / static_cast<double>(t.size());
+      t[i] = std::complex<float>(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+    }
+    return t;
+  }();
+  return table;
+}
+
+// Uniform double in [0, 1) from a SplitMix64 stream (53 random bits).
+inline double UnitDouble(std::uint64_t& state) {
+  return static_cast<double>(detail_itemmemory::SplitMix64Step(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
 }  // namespace detail_numeric
 
 /**
@@ -62,6 +92,7 @@ class ThermometerEncoder {
       : min_(min), max_(max), order_(detail_numeric::BuildOrder<Dim>()) {}
 
   void Encode(double x, core::HyperVector<Dim, bool>* out) const {
+    HS_METRIC_TIMER(Encode);
     out->Clear();
     if (!(max_ > min_)) {
       return;  // degenerate range => zero vector
@@ -70,9 +101,7 @@ class ThermometerEncoder {
     if (p < 0.0) p = 0.0;
     if (p > 1.0) p = 1.0;
     const std::size_t k = static_cast<std::size_t>(p * static_cast<double>(Dim));
-    for (std::size_t i = 0; i < k && i < Dim; ++i) {
-      out->SetBit(order_[i], true);
-    }
+    out->SetBits(order_.data(), (k < Dim) ? k : Dim);
   }
 
  private:
@@ -98,6 +127,7 @@ class RandomProjectionEncoder {
       : im_(seed ^ 0xa5a5a5a5a5a5a5a5ULL) {}
 
   void Encode(const float* data, std::size_t n, core::HyperVector<Dim, bool>* out) const {
+    HS_METRIC_TIMER(Encode);
     // Per-bit floating counters avoid arbitrary integer scaling.
     std::array<float, Dim> acc{};  // zero-initialized
 
@@ -106,20 +136,185 @@ class RandomProjectionEncoder {
       if (v == 0.0f) continue;
       core::HyperVector<Dim, bool> basis;
       im_.EncodeId(static_cast<std::uint64_t>(i), &basis);
-      for (std::size_t bit = 0; bit < Dim; ++bit) {
-        acc[bit] += basis.GetBit(bit) ? v : -v;
+      core::detail::ForEachBit(basis, [&acc, v](std::size_t bit, bool set) {
+        acc[bit] += set ? v : -v;
+      });
+    }
+
+    // Strict > 0 ensures empty inputs lead to all-zero output.
+    core::detail::PackBits(out, [&acc](std::size_t bit) { return acc[bit] > 0.0f; });
+  }
+
+ private:
+  ItemMemory<Dim> im_;
+};
+
+/** Phase distribution of FractionalPowerEncoder, i.e. the shift-invariant kernel it realizes. */
+enum class FractionalPowerKernel : std::uint8_t {
+  kSinc = 0,      // theta ~ U(-pi/l, pi/l): K(d) = prod_j sin(pi d_j / l) / (pi d_j / l)
+  kGaussian = 1,  // theta ~ N(0, 1/l^2):    K(d) = exp(-|d|^2 / (2 l^2))
+};
+
+/**
+ * @brief Fractional power encoder: x in R^Inputs -> phasor hypervector z(x)_k = exp(i phi_k(x)),
+ * phi_k(x) = b_k + sum_j theta_jk x_j.
+ *
+ * @tparam Dim    Hypervector dimension (elements / bits)
+ * @tparam Inputs Input dimensionality; the per-input phasors exp(i theta_jk x_j) are bound
+ *                (element-wise multiplied, i.e. phases added)
+ *
+ * Re<z(x), z(y)> / Dim estimates the kernel K(x - y) of the phase distribution (error ~ 1/sqrt(Dim));
+ * the random offsets b_k cancel in the product and keep z(0) from being the all-ones vector.
+ * Binary export keeps the sign of the real part, bit_k = cos(phi_k(x)) >= 0: a localized,
+ * monotone similarity of width ~l usable with the binary memories, though not K itself.
+ *
+ * Phases are computed in double and reduced to 32-bit fixed-point turns; complex outputs come from
+ * a 4096-entry cos/sin table and binary outputs from the top two phase bits, so no sin/cos calls
+ * run per element.
+ *
+ * Thread-safety: stateless after construction; reentrant.
+ * Complexity: O(Dim * Inputs) per encode.
+ */
+template <std::size_t Dim, std::size_t Inputs = 1>
+class FractionalPowerEncoder {
+ public:
+  static_assert(Inputs > 0, "FractionalPowerEncoder requires Inputs > 0");
+  using ComplexVector = core::HyperVector<Dim, std::complex<float>>;
+  using BinaryVector = core::HyperVector<Dim, bool>;
+
+  explicit FractionalPowerEncoder(std::uint64_t seed, double length_scale = 1.0,
+                                  FractionalPowerKernel kernel = FractionalPowerKernel::kSinc)
+      : length_scale_(length_scale), kernel_(kernel), offsets_(Dim), theta_(Inputs * Dim) {
+    const double kTwoPi = 6.283185307179586476925286766559;
+    std::uint64_t state = detail_itemmemory::MixSymbol(seed, 0x46504531ULL);
+    for (auto& b : offsets_) b = detail_numeric::UnitDouble(state);
+    // Frequencies in turns per unit of x.
+    for (auto& t : theta_) {
+      if (kernel == FractionalPowerKernel::kSinc) {
+        t = (detail_numeric::UnitDouble(state) - 0.5) / length_scale;
+      } else {
+        // Box-Muller from the same stream (std::normal_distribution is not portable).
+        const double u1 = 1.0 - detail_numeric::UnitDouble(state);
+        const double u2 = detail_numeric::UnitDouble(state);
+        t = std::sqrt(-2.0 * std::log(u1)) * std::cos(kTwoPi * u2) / (kTwoPi * length_scale);
       }
     }
+  }
 
-    out->Clear();
-    for (std::size_t bit = 0; bit < Dim; ++bit) {
-      // Strict > 0 ensures empty inputs lead to all-zero output.
-      out->SetBit(bit, acc[bit] > 0.0f);
+  void Encode(const double* x, ComplexVector* out) const {
+    HS_METRIC_TIMER(Encode);
+    EncodeRange(x, 0, Dim, out);
+  }
+
+  void Encode(const double* x, BinaryVector* out) const {
+    HS_METRIC_TIMER(Encode);
+    EncodeRange(x, 0, Dim, out);
+  }
+
+  void Encode(double x, ComplexVector* out) const {
+    static_assert(Inputs == 1, "scalar Encode requires Inputs == 1");
+    Encode(&x, out);
+  }
+
+  void Encode(double x, BinaryVector* out) const {
+    static_assert(Inputs == 1, "scalar Encode requires Inputs == 1");
+    Encode(&x, out);
+  }
+
+  /**
+   * @brief out[i] = Encode(xs + i * Inputs) for i < n, in tasks of kBatchBlock inputs through
+   * `exec`. Each task walks the phase tables in L1-sized chunks once for all of its inputs.
+   */
+  template <typename Vector, typename Executor = memory::SerialExecutor>
+  void EncodeBatch(const double* xs, std::size_t n, Vector* out, Executor&& exec = Executor{}) const {
+    exec((n + kBatchBlock - 1) / kBatchBlock, [&](std::size_t task) {
+      const std::size_t i0 = task * kBatchBlock;
+      const std::size_t i1 = (n - i0 < kBatchBlock) ? n : i0 + kBatchBlock;
+      for (std::size_t k0 = 0; k0 < Dim; k0 += kChunk) {
+        const std::size_t k1 = (Dim - k0 < kChunk) ? Dim : k0 + kChunk;
+        for (std::size_t i = i0; i < i1; ++i) EncodeRange(xs + i * Inputs, k0, k1, &out[i]);
+      }
+    });
+  }
+
+  /** Expected Re<z(x), z(y)> / Dim: the kernel K(x - y) of the phase distribution. */
+  [[nodiscard]] double Kernel(const double* x, const double* y) const {
+    const double kPi = 3.14159265358979323846264338327950288;
+    double k = 1.0;
+    double sq = 0.0;
+    for (std::size_t j = 0; j < Inputs; ++j) {
+      const double u = (x[j] - y[j]) / length_scale_;
+      sq += u * u;
+      if (kernel_ == FractionalPowerKernel::kSinc && u != 0.0) k *= std::sin(kPi * u) / (kPi * u);
     }
+    return kernel_ == FractionalPowerKernel::kSinc ? k : std::exp(-0.5 * sq);
   }
 
+  [[nodiscard]] double Kernel(double x, double y) const {
+    static_assert(Inputs == 1, "scalar Kernel requires Inputs == 1");
+    return Kernel(&x, &y);
+  }
+
+  [[nodiscard]] double length_scale() const noexcept { return length_scale_; }
+  [[nodiscard]] FractionalPowerKernel kernel() const noexcept { return kernel_; }
+
  private:
-  ItemMemory<Dim> im_;
+  static constexpr std::size_t kChunk = 512;      // elements per phase chunk (multiple of 64)
+  static constexpr std::size_t kBatchBlock = 16;  // inputs per EncodeBatch task
+
+  // Fixed-point phases (turns * 2^32, mod 2^32) of elements [k0, k1). Adding 1.5 * 2^20 moves the
+  // binary point so that the low 32 mantissa bits hold round(phase * 2^32) mod 2^32: a plain
+  // vectorizable add instead of floor(). Exact for |phase| < 2^19 turns (|x| up to ~1e5 length
+  // scales); larger phases wrap incorrectly.
+  void Phases(const double* x, std::size_t k0, std::size_t k1, std::uint32_t* u) const noexcept {
+    constexpr double kShift = 1572864.0;  // 1.5 * 2^20
+    double phase[kChunk];
+    for (std::size_t k = k0; k < k1; ++k) {
+      double p = offsets_[k] + kShift;
+      for (std::size_t j = 0; j < Inputs; ++j) p += theta_[j * Dim + k] * x[j];
+      phase[k - k0] = p;
+    }
+    for (std::size_t k = 0; k < k1 - k0; ++k) {
+      std::uint64_t bits;
+      std::memcpy(&bits, &phase[k], sizeof(bits));
+      u[k] = static_cast<std::uint32_t>(bits);
+    }
+  }
+
+  void EncodeRange(const double* x, std::size_t k0, std::size_t k1, ComplexVector* out) const {
+    const auto& table = detail_numeric::PhasorTable();
+    std::uint32_t u[kChunk];
+    for (std::size_t c0 = k0; c0 < k1; c0 += kChunk) {
+      const std::size_t c1 = (k1 - c0 < kChunk) ? k1 : c0 + kChunk;
+      Phases(x, c0, c1, u);
+      for (std::size_t k = c0; k < c1; ++k) (*out)[k] = table[u[k - c0] >> (32 - detail_numeric::kPhasorBits)];
+    }
+  }
+
+  // k0 is a multiple of 64 (kChunk is), so each chunk fills whole words.
+  void EncodeRange(const double* x, std::size_t k0, std::size_t k1, BinaryVector* out) const {
+    auto& words = out->Words();
+    std::uint32_t u[kChunk];
+    for (std::size_t c0 = k0; c0 < k1; c0 += kChunk) {
+      const std::size_t c1 = (k1 - c0 < kChunk) ? k1 : c0 + kChunk;
+      Phases(x, c0, c1, u);
+      for (std::size_t w = c0 / 64; w * 64 < c1; ++w) {
+        const std::size_t nb = (c1 - w * 64 < 64) ? c1 - w * 64 : 64;
+        const std::uint32_t* uw = u + (w * 64 - c0);
+        std::uint64_t word = 0;
+        // cos(phase) >= 0 <=> phase in [-1/4, 1/4) turns <=> bit 31 of (u + 2^30) is clear.
+        for (std::size_t b = 0; b < nb; ++b) {
+          word |= static_cast<std::uint64_t>(((uw[b] + 0x40000000u) >> 31) ^ 1u) << b;
+        }
+        words[w] = word;
+      }
+    }
+  }
+
+  double length_scale_;
+  FractionalPowerKernel kernel_;
+  std::vector<double> offsets_;  // b_k in turns
+  std::vector<double> theta_;    // theta_jk in turns per unit, row j = input j
 };
 
 }  // namespace encoding
@@ -10,6 +10,7 @@
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/core/ops.hpp"
 #include "hyperstream/encoding/item_memory.hpp"
+#include "hyperstream/metrics.hpp"
 
 namespace hyperstream {
 namespace encoding {
@@ -25,19 +26,23 @@ namespace encoding {
 template <std::size_t Dim>
 class SymbolEncoder {
  public:
-  explicit SymbolEncoder(std::uint64_t seed) : im_(seed) {}
+  /** `hash` selects the token hash family (kFnv1a: the original encodings). */
+  explicit SymbolEncoder(std::uint64_t seed, TokenHash hash = TokenHash::kFnv1a) : im_(seed, hash) {}
 
   void EncodeToken(std::string_view token, core::HyperVector<Dim, bool>* out) const {
+    HS_METRIC_TIMER(Encode);
     im_.EncodeToken(token, out);
   }
 
   void EncodeId(std::uint64_t id, core::HyperVector<Dim, bool>* out) const noexcept {
+    HS_METRIC_TIMER(Encode);
     im_.EncodeId(id, out);
   }
 
   // Encode token with role-based rotation by 'role' steps.
   void EncodeTokenRole(std::string_view token, std::size_t role,
                        core::HyperVector<Dim, bool>* out) const {
+    HS_METRIC_TIMER(Encode);
     if (role == 0) {
       im_.EncodeToken(token, out);
       return;
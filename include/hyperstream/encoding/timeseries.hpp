@@ -0,0 +1,215 @@
+#pragma once
+
+// Multi-channel time-series window encoder (sensor streams, anomaly detection).
+//
+// Encodes a window of Window timesteps x Channels samples as the majority of
+// rho^t(L(x[t][c])) ^ C_c over all samples, the same vector as the hand-written loop
+// ThermometerEncoder::Encode -> core::PermuteRotate by t -> Bind with the channel vector ->
+// BinaryBundler, evaluated on the quantized sample values. Instead of several passes and
+// temporaries per sample:
+// - Samples are quantized to `levels` thermometer levels in one vectorizable float pass per window.
+// - The level and channel codebooks are built once. Each level is stored twice back to back, so
+//   rho^t(L) is read as one contiguous run of shifted words and bound to C_c in the same pass.
+// - Bound samples are added word-parallel into bit-sliced counters (ceil(log2(samples + 1))
+//   planes), and the majority is a word-parallel compare of the planes against the threshold:
+//   no per-bit counters are touched.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+#include "hyperstream/memory/executor.hpp"
+#include "hyperstream/metrics.hpp"
+
+namespace hyperstream {
+namespace encoding {
+
+namespace detail_timeseries {
+
+constexpr std::size_t BitWidth(std::size_t n) noexcept {
+  std::size_t b = 0;
+  while (n != 0) {
+    ++b;
+    n >>= 1;
+  }
+  return b;
+}
+
+}  // namespace detail_timeseries
+
+/**
+ * @brief Fused encoder of fixed-size multi-channel sample windows.
+ *
+ * @tparam Dim      Hypervector dimension (bits)
+ * @tparam Channels Samples per timestep (> 0)
+ * @tparam Window   Timesteps per window (> 0)
+ *
+ * Samples are time-major: sample (t, c) is x[t * Channels + c].
+ *
+ * Invariants and behavior:
+ * - levels is clamped to [2, 65536]. Level l is
+ *   ThermometerEncoder<Dim>(min, max).Encode(min + l * (max - min) / (levels - 1)); a sample maps
+ *   to the nearest level, clamped to [min, max] (NaN -> level 0).
+ * - Channel c is the random hypervector of symbol c under `seed` (as HashEncoder/ItemMemory).
+ * - Encode() equals BinaryBundler majority (ties -> 1) over rho^t(L) ^ C_c for all samples.
+ * - Thread-safety: stateless after construction; reentrant.
+ *
+ * Complexity: O(Window * Channels * Dim/64) word operations per window; construction builds
+ * levels + Channels vectors.
+ */
+template <std::size_t Dim, std::size_t Channels, std::size_t Window>
+class MultiChannelTimeSeriesEncoder {
+ public:
+  static_assert(Channels > 0, "MultiChannelTimeSeriesEncoder requires Channels > 0");
+  static_assert(Window > 0, "MultiChannelTimeSeriesEncoder requires Window > 0");
+  static_assert(Window * Channels < 65536, "MultiChannelTimeSeriesEncoder window exceeds 65535 samples");
+  using Vector = core::HyperVector<Dim, bool>;
+
+  static constexpr std::size_t kSamples = Window * Channels;  // samples per window
+
+  MultiChannelTimeSeriesEncoder(double min, double max, std::size_t levels = 64,
+                                std::uint64_t seed = 0x54534531ULL)
+      : min_(static_cast<float>(min)),
+        levels_((levels < 2) ? 2 : (levels > 65536) ? 65536 : levels),
+        scale_((max > min) ? static_cast<float>(static_cast<double>(levels_ - 1) / (max - min)) : 0.0f),
+        level_words_(levels_ * 2 * kWords),
+        channels_(Channels) {
+    auto thermo = std::make_unique<ThermometerEncoder<Dim>>(min, max);
+    Vector level;
+    for (std::size_t l = 0; l < levels_; ++l) {
+      thermo->Encode(min + static_cast<double>(l) * (max - min) / static_cast<double>(levels_ - 1), &level);
+      std::uint64_t* dst = &level_words_[l * 2 * kWords];
+      for (std::size_t w = 0; w < kWords; ++w) dst[w] = dst[w + kWords] = level.Words()[w];
+    }
+    for (std::size_t c = 0; c < Channels; ++c) detail::GenerateRandomHypervector(seed, c, &channels_[c]);
+  }
+
+  /** Encodes the window x[0 .. kSamples). */
+  void Encode(const float* x, Vector* out) const {
+    HS_METRIC_TIMER(Encode);
+    std::array<std::uint16_t, kSamples> q;
+    Quantize(x, q.data());
+    std::array<std::array<std::uint64_t, kWords>, kPlanes> planes{};
+    std::array<std::uint64_t, kWords> bound;
+    for (std::size_t t = 0; t < Window; ++t) {
+      for (std::size_t c = 0; c < Channels; ++c) {
+        RotateBind(q[t * Channels + c], t, channels_[c], bound.data());
+        Add(bound.data(), &planes);
+      }
+    }
+    Majority(planes, out);
+  }
+
+  /** Windows starting every `stride` timesteps (0 is treated as 1) in a stream of `timesteps`. */
+  [[nodiscard]] static std::size_t WindowCount(std::size_t timesteps, std::size_t stride) noexcept {
+    if (stride == 0) stride = 1;
+    return (timesteps < Window) ? 0 : (timesteps - Window) / stride + 1;
+  }
+
+  /**
+   * @brief out[i] = Encode(x + i * stride * Channels) for every complete window of the
+   * `timesteps`-step stream, one task per window through `exec`. Returns the window count;
+   * `out` must hold WindowCount(timesteps, stride) vectors.
+   */
+  template <typename Executor = memory::SerialExecutor>
+  std::size_t EncodeWindows(const float* x, std::size_t timesteps, std::size_t stride, Vector* out,
+                            Executor&& exec = Executor{}) const {
+    if (stride == 0) stride = 1;
+    const std::size_t n = WindowCount(timesteps, stride);
+    exec(n, [&](std::size_t i) { Encode(x + i * stride * Channels, &out[i]); });
+    return n;
+  }
+
+  /** Quantized level of a sample value. */
+  [[nodiscard]] std::size_t Level(float x) const noexcept {
+    std::uint16_t q;
+    QuantizeRange(&x, 1, &q);
+    return q;
+  }
+
+  [[nodiscard]] std::size_t levels() const noexcept { return levels_; }
+
+ private:
+  static constexpr std::size_t kWords = Vector::WordCount();
+
+  static constexpr std::size_t kPlanes = detail_timeseries::BitWidth(kSamples);  // counts up to kSamples fit
+  static constexpr std::size_t kThreshold = (kSamples + 1) / 2;  // count >= kThreshold -> 1
+
+  void Quantize(const float* x, std::uint16_t* q) const noexcept { QuantizeRange(x, kSamples, q); }
+
+  // Nearest level, clamped; written as selects so the loop vectorizes (and NaN lands on 0).
+  void QuantizeRange(const float* x, std::size_t n, std::uint16_t* q) const noexcept {
+    const float top = static_cast<float>(levels_ - 1);
+    for (std::size_t i = 0; i < n; ++i) {
+      float v = (x[i] - min_) * scale_ + 0.5f;
+      v = (v > 0.0f) ? v : 0.0f;
+      v = (v < top) ? v : top;
+      q[i] = static_cast<std::uint16_t>(static_cast<std::int32_t>(v));
+    }
+  }
+
+  // bound = core::PermuteRotate(L[level], t) ^ channel. With the level stored as w0..wN-1 w0..wN-1,
+  // word i of the rotation reads the contiguous pair (i + N - q - 1, i + N - q).
+  void RotateBind(std::size_t level, std::size_t t, const Vector& channel, std::uint64_t* bound) const noexcept {
+    const std::uint64_t* src = &level_words_[level * 2 * kWords] + (kWords - (t / 64) % kWords);
+    const auto& cw = channel.Words();
+    const unsigned s = static_cast<unsigned>(t % 64);
+    if (s == 0) {
+      for (std::size_t i = 0; i < kWords; ++i) bound[i] = src[i] ^ cw[i];
+    } else {
+      for (std::size_t i = 0; i < kWords; ++i) bound[i] = ((src[i] << s) | (src[i - 1] >> (64u - s))) ^ cw[i];
+    }
+    constexpr std::size_t kExtra = kWords * 64 - Dim;
+    if constexpr (kExtra > 0) bound[kWords - 1] &= ~0ULL >> kExtra;
+  }
+
+  // Ripple-carry add of one vector into the bit-sliced counts, stopping at the first plane that
+  // produces no carry (as core::BitSlicedBundler::Accumulate).
+  static void Add(std::uint64_t* carry, std::array<std::array<std::uint64_t, kWords>, kPlanes>* planes) noexcept {
+    for (std::size_t k = 0; k < kPlanes; ++k) {
+      auto& plane = (*planes)[k];
+      std::uint64_t any = 0;
+      for (std::size_t w = 0; w < kWords; ++w) {
+        const std::uint64_t c = plane[w] & carry[w];
+        plane[w] ^= carry[w];
+        carry[w] = c;
+        any |= c;
+      }
+      if (any == 0) break;
+    }
+  }
+
+  // out = count >= kThreshold per bit: an MSB-first compare of the planes against the constant.
+  static void Majority(const std::array<std::array<std::uint64_t, kWords>, kPlanes>& planes, Vector* out) noexcept {
+    auto& ow = out->Words();
+    for (std::size_t w = 0; w < kWords; ++w) {
+      std::uint64_t gt = 0;
+      std::uint64_t eq = ~0ULL;
+      for (std::size_t k = kPlanes; k-- > 0;) {
+        if ((kThreshold >> k) & 1U) {
+          eq &= planes[k][w];
+        } else {
+          gt |= eq & planes[k][w];
+          eq &= ~planes[k][w];
+        }
+      }
+      ow[w] = gt | eq;
+    }
+    constexpr std::size_t kExtra = kWords * 64 - Dim;
+    if constexpr (kExtra > 0) ow[kWords - 1] &= ~0ULL >> kExtra;
+  }
+
+  float min_;
+  std::size_t levels_;
+  float scale_;                             // levels per unit of x
+  std::vector<std::uint64_t> level_words_;  // level l at [2 l N, 2 (l + 1) N): its words twice
+  std::vector<Vector> channels_;            // C_c
+};
+
+}  // namespace encoding
+}  // namespace hyperstream
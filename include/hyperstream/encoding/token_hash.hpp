@@ -0,0 +1,155 @@
+#pragma once
+
+// Selectable string-token hash families for the token encoders (HashEncoder, ItemMemory,
+// SymbolEncoder). The family is a construction option next to the seed: kFnv1a is the original
+// byte-at-a-time FNV-1a and stays the default, so existing models keep their exact vectors;
+// kWyhash is a wyhash (final 4) style hash consuming 16 bytes per multiply (48 per loop iteration
+// in three independent lanes), much faster for long tokens such as URLs or log lines.
+// Header-only; zero external deps; reads bytes explicitly, so results are endian-independent.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+namespace hyperstream {
+namespace encoding {
+
+/// Token hash family. Values are stable: persist them alongside encoder seeds.
+enum class TokenHash : std::uint8_t {
+  kFnv1a = 0,   // FNV-1a, one byte per multiply (the original hash; default)
+  kWyhash = 1,  // wyhash-style, 16 bytes per 64x64->128 multiply
+};
+
+namespace detail_tokenhash {
+
+inline std::uint64_t Fnv1a64(std::string_view token, std::uint64_t seed) noexcept {
+  std::uint64_t hash = 1469598103934665603ULL ^ seed;
+  for (unsigned char c : token) {
+    hash ^= static_cast<std::uint64_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+constexpr std::uint64_t kWySecret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                                        0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+// 64x64 -> 128-bit product: *a = low half, *b = high half.
+inline void WyMum(std::uint64_t* a, std::uint64_t* b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 U128;
+  const U128 r = static_cast<U128>(*a) * *b;
+  *a = static_cast<std::uint64_t>(r);
+  *b = static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  *a = _umul128(*a, *b, b);
+#else
+  const std::uint64_t ha = *a >> 32;
+  const std::uint64_t hb = *b >> 32;
+  const std::uint64_t la = static_cast<std::uint32_t>(*a);
+  const std::uint64_t lb = static_cast<std::uint32_t>(*b);
+  const std::uint64_t rh = ha * hb;
+  const std::uint64_t rm0 = ha * lb;
+  const std::uint64_t rm1 = hb * la;
+  const std::uint64_t rl = la * lb;
+  const std::uint64_t t = rl + (rm0 << 32);
+  std::uint64_t c = t < rl ? 1 : 0;
+  const std::uint64_t lo = t + (rm1 << 32);
+  c += lo < t ? 1 : 0;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline std::uint64_t WyMix(std::uint64_t a, std::uint64_t b) noexcept {
+  WyMum(&a, &b);
+  return a ^ b;
+}
+
+// Little-endian loads composed from bytes; compilers fold them into single loads.
+inline std::uint64_t Read8(const unsigned char* p) noexcept {
+  std::uint64_t v = 0;
+  for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+  return v;
+}
+
+inline std::uint64_t Read4(const unsigned char* p) noexcept {
+  return static_cast<std::uint64_t>(p[0]) | (static_cast<std::uint64_t>(p[1]) << 8) |
+         (static_cast<std::uint64_t>(p[2]) << 16) | (static_cast<std::uint64_t>(p[3]) << 24);
+}
+
+inline std::uint64_t Read3(const unsigned char* p, std::size_t k) noexcept {
+  return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+inline std::uint64_t Wyhash64(std::string_view token, std::uint64_t seed) noexcept {
+  const auto* p = reinterpret_cast<const unsigned char*>(token.data());
+  const std::size_t len = token.size();
+  seed ^= WyMix(seed ^ kWySecret[0], kWySecret[1]);
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (Read4(p) << 32) | Read4(p + ((len >> 3) << 2));
+      b = (Read4(p + len - 4) << 32) | Read4(p + len - 4 - ((len >> 3) << 2));
+    } else if (len > 0) {
+      a = Read3(p, len);
+    }
+  } else {
+    std::size_t i = len;
+    if (i > 48) {
+      std::uint64_t see1 = seed;
+      std::uint64_t see2 = seed;
+      do {
+        seed = WyMix(Read8(p) ^ kWySecret[1], Read8(p + 8) ^ seed);
+        see1 = WyMix(Read8(p + 16) ^ kWySecret[2], Read8(p + 24) ^ see1);
+        see2 = WyMix(Read8(p + 32) ^ kWySecret[3], Read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = WyMix(Read8(p) ^ kWySecret[1], Read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = Read8(p + i - 16);
+    b = Read8(p + i - 8);
+  }
+  a ^= kWySecret[1];
+  b ^= seed;
+  WyMum(&a, &b);
+  return WyMix(a ^ kWySecret[0] ^ len, b ^ kWySecret[1]);
+}
+
+}  // namespace detail_tokenhash
+
+/** 64-bit hash of `token` under `seed` with the selected family. */
+inline std::uint64_t HashToken(TokenHash hash, std::string_view token, std::uint64_t seed) noexcept {
+  return hash == TokenHash::kWyhash ? detail_tokenhash::Wyhash64(token, seed)
+                                    : detail_tokenhash::Fnv1a64(token, seed);
+}
+
+/**
+ * @brief Two hashes of `token` for double hashing; the second is odd (a full-period step).
+ * kFnv1a hashes the token twice (seed, seed ^ salt), as HashEncoder always has; kWyhash hashes it
+ * once and derives the second value by remixing the first with the salt.
+ */
+inline std::pair<std::uint64_t, std::uint64_t> HashTokenPair(TokenHash hash, std::string_view token,
+                                                             std::uint64_t seed) noexcept {
+  constexpr std::uint64_t kSalt = 0x5bf03635f0b7a54dULL;
+  const std::uint64_t h1 = HashToken(hash, token, seed);
+  std::uint64_t h2 = hash == TokenHash::kWyhash ? detail_tokenhash::WyMix(h1 ^ kSalt, seed ^ detail_tokenhash::kWySecret[2])
+                                                : detail_tokenhash::Fnv1a64(token, seed ^ kSalt);
+  h2 = (h2 << 1) | 1ULL;  // ensure odd step
+  return {h1, h2};
+}
+
+}  // namespace encoding
+}  // namespace hyperstream
@@ -13,6 +13,7 @@
 
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/memory/associative.hpp"
+#include "hyperstream/metrics.hpp"
 
 namespace hyperstream {
 namespace io {
@@ -95,6 +96,8 @@ inline bool CheckMagic(const Header& h) { return std::memcmp(h.magic, "HSER1", 5
 /** Save PrototypeMemory to binary stream. v1.1: append trailer tag+CRC32(payload). */
 template <std::size_t Dim, std::size_t Capacity>
 bool SavePrototype(std::ostream& os, const memory::PrototypeMemory<Dim, Capacity>& mem) noexcept {
+  HS_METRIC_TIMER(Serialize);
+  HS_METRIC_INC(SerializeSaves);
   using HV = core::HyperVector<Dim, bool>;
   using Entry = typename memory::PrototypeMemory<Dim, Capacity>::Entry;
   const auto* data = mem.data();
@@ -122,6 +125,8 @@ bool SavePrototype(std::ostream& os, const memory::PrototypeMemory<Dim, Capacity
 /** Load PrototypeMemory from binary stream. Precondition: mem->size() == 0. */
 template <std::size_t Dim, std::size_t Capacity>
 bool LoadPrototype(std::istream& is, memory::PrototypeMemory<Dim, Capacity>* mem) noexcept {
+  HS_METRIC_TIMER(Serialize);
+  HS_METRIC_INC(SerializeLoads);
   if (mem == nullptr) return false;
   if (mem->size() != 0) return false;  // require empty
   Header h{};
@@ -153,6 +158,8 @@ bool LoadPrototype(std::istream& is, memory::PrototypeMemory<Dim, Capacity>* mem
 /** Save ClusterMemory to binary stream. v1.1: append trailer tag+CRC32(payload). */
 template <std::size_t Dim, std::size_t Capacity>
 bool SaveCluster(std::ostream& os, const memory::ClusterMemory<Dim, Capacity>& mem) noexcept {
+  HS_METRIC_TIMER(Serialize);
+  HS_METRIC_INC(SerializeSaves);
   const auto v = mem.view();
   const Header h = MakeHeader(ObjectKind::Cluster, Dim, Capacity, static_cast<std::uint64_t>(v.size));
   if (!detail_ser::Write(os, &h, sizeof(h))) return false;
@@ -180,6 +187,8 @@ bool SaveCluster(std::ostream& os, const memory::ClusterMemory<Dim, Capacity>& m
 /** Load ClusterMemory from binary stream. Precondition: mem->size() == 0. */
 template <std::size_t Dim, std::size_t Capacity>
 bool LoadCluster(std::istream& is, memory::ClusterMemory<Dim, Capacity>* mem) noexcept {
+  HS_METRIC_TIMER(Serialize);
+  HS_METRIC_INC(SerializeLoads);
   if (mem == nullptr) return false;
   if (mem->size() != 0) return false;
   Header h{};
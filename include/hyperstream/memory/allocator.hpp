@@ -0,0 +1,435 @@
+#pragma once
+
+// Pluggable allocators for large HyperStream structures (prototype entries, cluster counters,
+// cleanup codebooks). All allocators return zero-filled, 64-byte aligned storage and throw
+// std::bad_alloc on failure, mirroring the semantics of the value-initialized new[] they replace.
+//
+// Allocators:
+// - HeapAllocator:     aligned operator new (portable default).
+// - ArenaAllocator:    bump allocation out of one upstream region; Deallocate is a no-op.
+// - HugePageAllocator: Linux mmap + MADV_HUGEPAGE (2 MiB) or MAP_HUGETLB (1 GiB, falling back to
+//                      2 MiB transparent huge pages). Other POSIX: plain mmap. Windows: heap.
+// - NumaAllocator:     Linux mmap + mbind(MPOL_BIND) to one node, best effort; other platforms: heap.
+//
+// Prefaulting (touching every page at allocation time) moves page-fault and zeroing cost out of
+// the first Classify/Update scans and, for NUMA, commits pages on the bound node.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define HS_HAVE_MMAP 1
+#else
+#define HS_HAVE_MMAP 0
+#endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#include "hyperstream/config.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+/** Kind of large-structure allocator. */
+enum class AllocatorKind : std::uint8_t { Heap = 0, Arena = 1, HugePage2M = 2, HugePage1G = 3, Numa = 4 };
+
+/** Returns a short allocator name: "heap", "arena", "hugepage_2m", "hugepage_1g", or "numa". */
+inline const char* GetAllocatorName(AllocatorKind k) {
+  switch (k) {
+    case AllocatorKind::Heap:       return "heap";
+    case AllocatorKind::Arena:      return "arena";
+    case AllocatorKind::HugePage2M: return "hugepage_2m";
+    case AllocatorKind::HugePage1G: return "hugepage_1g";
+    case AllocatorKind::Numa:       return "numa";
+    default: return "unknown";
+  }
+}
+
+/**
+ * @brief Allocator interface for large, long-lived buffers.
+ *
+ * Contract:
+ * - Allocate(bytes) returns storage aligned to config::kLargeStructureAlignment and zero-filled;
+ *   throws std::bad_alloc on failure. Allocate(0) may return nullptr.
+ * - Deallocate(p, bytes) receives the same byte count passed to Allocate.
+ * - Thread-safety: implementations below are safe for concurrent Allocate/Deallocate.
+ */
+class LargeAllocator {
+ public:
+  virtual ~LargeAllocator() = default;
+  virtual void* Allocate(std::size_t bytes) = 0;
+  virtual void Deallocate(void* p, std::size_t bytes) noexcept = 0;
+  [[nodiscard]] virtual AllocatorKind kind() const noexcept = 0;
+};
+
+namespace detail_alloc {
+
+constexpr std::size_t kAlign = config::kLargeStructureAlignment;
+constexpr std::size_t kHugePage2M = std::size_t{1} << 21;
+constexpr std::size_t kHugePage1G = std::size_t{1} << 30;
+
+constexpr inline std::size_t RoundUp(std::size_t n, std::size_t a) { return (n + a - 1) / a * a; }
+
+inline std::size_t PageSize() noexcept {
+#if HS_HAVE_MMAP
+  const long ps = ::sysconf(_SC_PAGESIZE);
+  return ps > 0 ? static_cast<std::size_t>(ps) : 4096;
+#else
+  return 4096;
+#endif
+}
+
+// Touch one byte per page so the kernel commits (and zeroes) it now rather than on first scan.
+inline void Prefault(void* p, std::size_t bytes, std::size_t page) noexcept {
+  volatile unsigned char* b = static_cast<volatile unsigned char*>(p);
+  for (std::size_t off = 0; off < bytes; off += page) b[off] = 0;
+}
+
+inline void* HeapAllocate(std::size_t bytes) {
+  if (bytes == 0) return nullptr;
+  void* p = ::operator new(bytes, std::align_val_t{kAlign});
+  std::memset(p, 0, bytes);
+  return p;
+}
+
+inline void HeapDeallocate(void* p) noexcept {
+  if (p) ::operator delete(p, std::align_val_t{kAlign});
+}
+
+#if HS_HAVE_MMAP
+// Anonymous mapping of `len` bytes aligned to `align` (a multiple of the page size).
+// Over-maps by `align` and trims the misaligned head and the excess tail.
+inline void* MapAligned(std::size_t len, std::size_t align) noexcept {
+  const std::size_t span = len + align;
+  void* raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) return nullptr;
+  const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(raw);
+  const std::uintptr_t aligned = (base + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+  const std::size_t head = static_cast<std::size_t>(aligned - base);
+  const std::size_t tail = span - head - len;
+  if (head) ::munmap(raw, head);
+  if (tail) ::munmap(reinterpret_cast<void*>(aligned + len), tail);
+  return reinterpret_cast<void*>(aligned);
+}
+#endif
+
+// Records mapping lengths so Deallocate can unmap exactly what Allocate mapped,
+// independent of which fallback path produced the mapping.
+class MappingTable {
+ public:
+  void Add(void* p, std::size_t len) {
+    std::lock_guard<std::mutex> lock(mu_);
+    maps_.emplace_back(p, len);
+  }
+  std::size_t Remove(void* p) noexcept {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (std::size_t i = 0; i < maps_.size(); ++i) {
+      if (maps_[i].first == p) {
+        const std::size_t len = maps_[i].second;
+        maps_[i] = maps_.back();
+        maps_.pop_back();
+        return len;
+      }
+    }
+    return 0;
+  }
+  std::size_t TotalBytes() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    std::size_t total = 0;
+    for (const auto& m : maps_) total += m.second;
+    return total;
+  }
+
+ private:
+  mutable std::mutex mu_;
+  std::vector<std::pair<void*, std::size_t>> maps_;
+};
+
+}  // namespace detail_alloc
+
+/** Portable default: 64-byte aligned operator new, zero-filled (touching pages as a side effect). */
+class HeapAllocator final : public LargeAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override { return detail_alloc::HeapAllocate(bytes); }
+  void Deallocate(void* p, std::size_t) noexcept override { detail_alloc::HeapDeallocate(p); }
+  [[nodiscard]] AllocatorKind kind() const noexcept override { return AllocatorKind::Heap; }
+};
+
+/** Process-wide default allocator used when a structure is constructed without one. */
+inline LargeAllocator* DefaultAllocator() noexcept {
+  static HeapAllocator heap;
+  return &heap;
+}
+
+/**
+ * @brief Bump allocator over a single region obtained from an upstream allocator.
+ *
+ * Packs many structures contiguously (fewer distinct pages/TLB entries) and frees them all at
+ * once on destruction. Deallocate() is a no-op; Reset() rewinds the arena and requires that no
+ * structure allocated from it is still alive. Throws std::bad_alloc when the region is exhausted.
+ * The upstream allocator must outlive the arena.
+ */
+class ArenaAllocator final : public LargeAllocator {
+ public:
+  explicit ArenaAllocator(std::size_t capacity_bytes, LargeAllocator* upstream = nullptr)
+      : upstream_(upstream ? upstream : DefaultAllocator()),
+        capacity_(detail_alloc::RoundUp(capacity_bytes, detail_alloc::kAlign)) {
+    base_ = static_cast<unsigned char*>(upstream_->Allocate(capacity_));
+  }
+  ~ArenaAllocator() override { upstream_->Deallocate(base_, capacity_); }
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+  void* Allocate(std::size_t bytes) override {
+    if (bytes == 0) return nullptr;
+    const std::size_t need = detail_alloc::RoundUp(bytes, detail_alloc::kAlign);
+    std::lock_guard<std::mutex> lock(mu_);
+    if (need > capacity_ - offset_) throw std::bad_alloc();
+    unsigned char* p = base_ + offset_;
+    offset_ += need;
+    // Fresh upstream memory is already zero; memory reused after Reset() is not.
+    if (offset_ > high_water_) {
+      if (p < base_ + high_water_) std::memset(p, 0, static_cast<std::size_t>(base_ + high_water_ - p));
+      high_water_ = offset_;
+    } else {
+      std::memset(p, 0, bytes);
+    }
+    return p;
+  }
+  void Deallocate(void*, std::size_t) noexcept override {}
+  [[nodiscard]] AllocatorKind kind() const noexcept override { return AllocatorKind::Arena; }
+
+  /** Rewinds the arena. Precondition: no live structure references arena memory. */
+  void Reset() noexcept {
+    std::lock_guard<std::mutex> lock(mu_);
+    offset_ = 0;
+  }
+  [[nodiscard]] std::size_t used() const noexcept { return offset_; }
+  [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+ private:
+  LargeAllocator* upstream_;
+  unsigned char* base_ = nullptr;
+  std::size_t capacity_;
+  std::size_t offset_ = 0;
+  std::size_t high_water_ = 0;
+  std::mutex mu_;
+};
+
+/**
+ * @brief Huge-page backed allocator for TLB-heavy scans.
+ *
+ * HugePage2M: 2 MiB aligned anonymous mapping with MADV_HUGEPAGE (transparent huge pages).
+ * HugePage1G: MAP_HUGETLB|MAP_HUGE_1GB from the hugetlbfs pool; when no 1 GiB pages are reserved
+ * the allocation falls back to the 2 MiB path and huge_tlb_fallbacks() is incremented.
+ * Non-Linux POSIX maps without huge-page advice; Windows falls back to the heap.
+ */
+class HugePageAllocator final : public LargeAllocator {
+ public:
+  enum class PageSize : std::uint8_t { k2M = 0, k1G = 1 };
+
+  explicit HugePageAllocator(PageSize page = PageSize::k2M, bool prefault = false)
+      : page_(page), prefault_(prefault) {}
+
+  void* Allocate(std::size_t bytes) override {
+    if (bytes == 0) return nullptr;
+#if HS_HAVE_MMAP
+    void* p = nullptr;
+    std::size_t len = 0;
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (page_ == PageSize::k1G) {
+      len = detail_alloc::RoundUp(bytes, detail_alloc::kHugePage1G);
+      // MAP_HUGE_1GB = 30 << MAP_HUGE_SHIFT(26); spelled out for older libc headers.
+      const int huge_1g = 30 << 26;
+      void* m = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | huge_1g, -1, 0);
+      if (m != MAP_FAILED) {
+        p = m;
+      } else {
+        std::lock_guard<std::mutex> lock(mu_);
+        ++fallbacks_;
+      }
+    }
+#endif
+    if (p == nullptr) {
+      len = detail_alloc::RoundUp(bytes, detail_alloc::kHugePage2M);
+      p = detail_alloc::MapAligned(len, detail_alloc::kHugePage2M);
+      if (p == nullptr) throw std::bad_alloc();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      (void)::madvise(p, len, MADV_HUGEPAGE);  // advisory; THP may be disabled system-wide
+#endif
+    }
+    if (prefault_) detail_alloc::Prefault(p, len, detail_alloc::PageSize());
+    table_.Add(p, len);
+    return p;
+#else
+    return detail_alloc::HeapAllocate(bytes);
+#endif
+  }
+
+  void Deallocate(void* p, std::size_t bytes) noexcept override {
+    (void)bytes;
+    if (p == nullptr) return;
+#if HS_HAVE_MMAP
+    const std::size_t len = table_.Remove(p);
+    if (len) ::munmap(p, len);
+#else
+    detail_alloc::HeapDeallocate(p);
+#endif
+  }
+
+  [[nodiscard]] AllocatorKind kind() const noexcept override {
+    return page_ == PageSize::k1G ? AllocatorKind::HugePage1G : AllocatorKind::HugePage2M;
+  }
+  /** Number of 1 GiB requests served by the 2 MiB fallback path. */
+  [[nodiscard]] std::size_t huge_tlb_fallbacks() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return fallbacks_;
+  }
+  /** Total bytes currently mapped (after huge-page rounding). */
+  [[nodiscard]] std::size_t mapped_bytes() const { return table_.TotalBytes(); }
+
+ private:
+  PageSize page_;
+  bool prefault_;
+  mutable std::mutex mu_;
+  std::size_t fallbacks_ = 0;
+  detail_alloc::MappingTable table_;
+};
+
+/**
+ * @brief NUMA-bound allocator (Linux, best effort).
+ *
+ * Maps anonymous memory, binds it to `node` with mbind(MPOL_BIND) via the raw syscall (no libnuma
+ * dependency), optionally advises transparent huge pages, and prefaults so pages are committed on
+ * the bound node. If binding is rejected (single-node host, container policy), the memory is still
+ * returned and binding_failures() is incremented. Non-Linux platforms fall back to the heap.
+ */
+class NumaAllocator final : public LargeAllocator {
+ public:
+  explicit NumaAllocator(int node = 0, bool prefault = true, bool huge_pages = false)
+      : node_(node), prefault_(prefault), huge_pages_(huge_pages) {}
+
+  void* Allocate(std::size_t bytes) override {
+    if (bytes == 0) return nullptr;
+#if defined(__linux__) && defined(SYS_mbind)
+    const std::size_t align = huge_pages_ ? detail_alloc::kHugePage2M : detail_alloc::PageSize();
+    const std::size_t len = detail_alloc::RoundUp(bytes, align);
+    void* p = detail_alloc::MapAligned(len, align);
+    if (p == nullptr) throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+    if (huge_pages_) (void)::madvise(p, len, MADV_HUGEPAGE);
+#endif
+    bool bound = false;
+    if (node_ >= 0 && node_ < 64) {
+      const unsigned long mask = 1UL << node_;
+      constexpr int kMpolBind = 2;  // MPOL_BIND from <linux/mempolicy.h>
+      bound = ::syscall(SYS_mbind, p, len, kMpolBind, &mask, sizeof(mask) * 8 + 1, 0) == 0;
+    }
+    if (!bound) {
+      std::lock_guard<std::mutex> lock(mu_);
+      ++bind_failures_;
+    }
+    if (prefault_) detail_alloc::Prefault(p, len, detail_alloc::PageSize());
+    table_.Add(p, len);
+    return p;
+#else
+    std::lock_guard<std::mutex> lock(mu_);
+    ++bind_failures_;
+    return detail_alloc::HeapAllocate(bytes);
+#endif
+  }
+
+  void Deallocate(void* p, std::size_t bytes) noexcept override {
+    (void)bytes;
+    if (p == nullptr) return;
+#if defined(__linux__) && defined(SYS_mbind)
+    const std::size_t len = table_.Remove(p);
+    if (len) ::munmap(p, len);
+#else
+    detail_alloc::HeapDeallocate(p);
+#endif
+  }
+
+  [[nodiscard]] AllocatorKind kind() const noexcept override { return AllocatorKind::Numa; }
+  [[nodiscard]] int node() const noexcept { return node_; }
+  /** Number of allocations whose node binding was rejected (memory still usable). */
+  [[nodiscard]] std::size_t binding_failures() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return bind_failures_;
+  }
+
+ private:
+  int node_;
+  bool prefault_;
+  bool huge_pages_;
+  mutable std::mutex mu_;
+  std::size_t bind_failures_ = 0;
+  detail_alloc::MappingTable table_;
+};
+
+/**
+ * @brief Owning, move-only array of N value-initialized T over a LargeAllocator.
+ *
+ * Replaces `std::unique_ptr<T[]>(new T[N]{})` for large structures. T must be trivially
+ * destructible; elements are value-initialized on top of the allocator's zero-filled storage.
+ * The allocator must outlive the array.
+ */
+template <typename T>
+class LargeArray {
+ public:
+  static_assert(std::is_trivially_destructible<T>::value, "LargeArray requires trivially destructible T");
+  static_assert(alignof(T) <= config::kLargeStructureAlignment, "LargeArray element over-aligned");
+
+  explicit LargeArray(std::size_t count, LargeAllocator* alloc = nullptr)
+      : alloc_(alloc ? alloc : DefaultAllocator()), count_(count) {
+    if (count_ == 0) return;
+    data_ = static_cast<T*>(alloc_->Allocate(count_ * sizeof(T)));
+    for (std::size_t i = 0; i < count_; ++i) ::new (static_cast<void*>(data_ + i)) T();
+  }
+  ~LargeArray() { Release(); }
+
+  LargeArray(const LargeArray&) = delete;
+  LargeArray& operator=(const LargeArray&) = delete;
+  LargeArray(LargeArray&& other) noexcept
+      : alloc_(other.alloc_), data_(std::exchange(other.data_, nullptr)),
+        count_(std::exchange(other.count_, 0)) {}
+  LargeArray& operator=(LargeArray&& other) noexcept {
+    if (this != &other) {
+      Release();
+      alloc_ = other.alloc_;
+      data_ = std::exchange(other.data_, nullptr);
+      count_ = std::exchange(other.count_, 0);
+    }
+    return *this;
+  }
+
+  T& operator[](std::size_t i) noexcept { return data_[i]; }
+  const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+  [[nodiscard]] T* data() noexcept { return data_; }
+  [[nodiscard]] const T* data() const noexcept { return data_; }
+  [[nodiscard]] std::size_t size() const noexcept { return count_; }
+  [[nodiscard]] LargeAllocator* allocator() const noexcept { return alloc_; }
+
+ private:
+  void Release() noexcept {
+    if (data_) alloc_->Deallocate(data_, count_ * sizeof(T));
+    data_ = nullptr;
+  }
+
+  LargeAllocator* alloc_;
+  T* data_ = nullptr;
+  std::size_t count_;
+};
+
+}  // namespace memory
+}  // namespace hyperstream
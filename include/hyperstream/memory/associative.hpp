@@ -1,14 +1,18 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
-#include <memory>
 
 #include "hyperstream/config.hpp"
 #include "hyperstream/core/hypervector.hpp"
 #include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/cascade.hpp"
+#include "hyperstream/memory/prefetch.hpp"
+#include "hyperstream/metrics.hpp"
 
 namespace hyperstream {
 namespace memory {
@@ -24,10 +28,21 @@ namespace memory {
  * - When size()==0, Classify() returns the provided default_label (no computation performed).
  * - If Capacity==0, all mutating operations fail and size() remains 0 (compile-time constant capacity).
  * - Thread-safety: not thread-safe. External synchronization is required for concurrent access.
+ * - Storage: Capacity entries from a LargeAllocator (default heap; 64-byte aligned, zero-filled).
+ *   The allocator must outlive the memory. Move-only.
  *
  * Complexity (binary HyperVector):
  * - Learn: O(1) append
  * - Classify: O(size * Dim/64) Hamming distance over packed uint64_t words
+ * - ClassifyBatch: same per query; entries are visited in cache-sized tiles shared by a block of
+ *   queries, so memories larger than the LLC are streamed from DRAM once per block.
+ *
+ * - ClassifyCascade: prefix distance of every entry plus full refinement of the candidates that
+ *   can still win (memory/cascade.hpp); exact or approximate.
+ *
+ * Scans prefetch whole entries scan_tuning().prefetch_distance ahead (default from the entry size;
+ * CalibratePrefetchDistance() picks it by timing on the populated memory). Results and tie-breaking
+ * (first entry with the highest match) do not depend on the tuning.
  */
 template <std::size_t Dim, std::size_t Capacity>
 class PrototypeMemory {
@@ -37,7 +52,9 @@ class PrototypeMemory {
     core::HyperVector<Dim, bool> hv;
   };
 
-  PrototypeMemory() : entries_(new Entry[Capacity]{}) {}
+  PrototypeMemory() : PrototypeMemory(nullptr) {}
+  /** Allocates entry storage from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit PrototypeMemory(LargeAllocator* alloc) : entries_(Capacity, alloc) {}
 
   bool Learn(std::uint64_t label, const core::HyperVector<Dim, bool>& hv) {
     if (size_ >= Capacity) {
@@ -51,20 +68,7 @@ class PrototypeMemory {
 
   std::uint64_t Classify(const core::HyperVector<Dim, bool>& query,
                          std::uint64_t default_label = 0) const {
-    if (size_ == 0) {
-      return default_label;
-    }
-    std::size_t best_index = 0;
-    std::size_t best_match = 0;
-    for (std::size_t i = 0; i < size_; ++i) {
-      const std::size_t dist = core::HammingDistance(query, entries_[i].hv);
-      const std::size_t match = Dim - dist;
-      if (match > best_match) {
-        best_match = match;
-        best_index = i;
-      }
-    }
-    return entries_[best_index].label;
+    return Classify(query, DefaultDistance{}, default_label);
   }
 
   // Overload: classify using a caller-provided distance functor.
@@ -77,22 +81,157 @@ class PrototypeMemory {
   std::uint64_t Classify(const core::HyperVector<Dim, bool>& query,
                          DistFn&& dist_fn,
                          std::uint64_t default_label = 0) const {
+    HS_METRIC_TIMER(Classify);
+    HS_METRIC_INC(PrototypeClassifyCalls);
+    HS_METRIC_ADD(PrototypeScannedEntries, size_);
     if (size_ == 0) {
       return default_label;
     }
     std::size_t best_index = 0;
     std::size_t best_match = 0;
-    for (std::size_t i = 0; i < size_; ++i) {
-      const std::size_t dist = dist_fn(query, entries_[i].hv);
-      const std::size_t match = Dim - dist;
-      if (match > best_match) {
-        best_match = match;
-        best_index = i;
+    ScanRange(query, dist_fn, 0, size_, tuning_.prefetch_distance, &best_match, &best_index);
+    return entries_[best_index].label;
+  }
+
+  /**
+   * @brief Classifies queries[0..count) into labels[0..count); labels[i] == Classify(queries[i]).
+   * Queries are processed in blocks of kBatchQueryBlock against entry tiles of
+   * scan_tuning().tile_bytes, so each tile is loaded once per block rather than once per query.
+   */
+  void ClassifyBatch(const core::HyperVector<Dim, bool>* queries, std::size_t count,
+                     std::uint64_t* labels, std::uint64_t default_label = 0) const {
+    ClassifyBatch(queries, count, labels, DefaultDistance{}, default_label);
+  }
+
+  template <typename DistFn,
+            typename = std::enable_if_t<
+                std::is_invocable_r<std::size_t, DistFn,
+                                    const core::HyperVector<Dim, bool>&,
+                                    const core::HyperVector<Dim, bool>&>::value>>
+  void ClassifyBatch(const core::HyperVector<Dim, bool>* queries, std::size_t count,
+                     std::uint64_t* labels, DistFn&& dist_fn,
+                     std::uint64_t default_label = 0) const {
+    HS_METRIC_TIMER(Classify);
+    HS_METRIC_ADD(PrototypeClassifyCalls, count);
+    HS_METRIC_ADD(PrototypeScannedEntries, size_ * count);
+    if (size_ == 0) {
+      for (std::size_t q = 0; q < count; ++q) labels[q] = default_label;
+      return;
+    }
+    const std::size_t tile_entries =
+        tuning_.tile_bytes >= sizeof(Entry) ? tuning_.tile_bytes / sizeof(Entry) : 1;
+    for (std::size_t q0 = 0; q0 < count; q0 += kBatchQueryBlock) {
+      const std::size_t nq = (count - q0 < kBatchQueryBlock) ? count - q0 : kBatchQueryBlock;
+      std::array<std::size_t, kBatchQueryBlock> best_match{};
+      std::array<std::size_t, kBatchQueryBlock> best_index{};
+      for (std::size_t t0 = 0; t0 < size_; t0 += tile_entries) {
+        const std::size_t t1 = (size_ - t0 < tile_entries) ? size_ : t0 + tile_entries;
+        // Only the first query of the block pulls the tile in; the rest hit in cache.
+        for (std::size_t q = 0; q < nq; ++q) {
+          ScanRange(queries[q0 + q], dist_fn, t0, t1, q == 0 ? tuning_.prefetch_distance : 0,
+                    &best_match[q], &best_index[q]);
+        }
       }
+      for (std::size_t q = 0; q < nq; ++q) labels[q0 + q] = entries_[best_index[q]].label;
     }
-    return entries_[best_index].label;
   }
 
+  /**
+   * @brief Coarse-to-fine classification (see memory/cascade.hpp). With CascadeMode::kExact the
+   * label equals Classify(query, default_label); kApproximate may miss the nearest entry when its
+   * prefix distance is more than options.margin_bits above the smallest one.
+   * `dist` scores word ranges: size_t dist(const uint64_t* a, const uint64_t* b, size_t words);
+   * the overload without it uses the portable core popcount. `stats` (optional) reports the work.
+   */
+  std::uint64_t ClassifyCascade(const core::HyperVector<Dim, bool>& query,
+                                const CascadeOptions& options, std::uint64_t default_label = 0,
+                                CascadeStats* stats = nullptr) const {
+    return ClassifyCascade(query, options, detail_cascade::CoreWordsDistance{}, default_label, stats);
+  }
+
+  template <typename WordsDistFn,
+            typename = std::enable_if_t<
+                std::is_invocable_r<std::size_t, WordsDistFn, const std::uint64_t*,
+                                    const std::uint64_t*, std::size_t>::value>>
+  std::uint64_t ClassifyCascade(const core::HyperVector<Dim, bool>& query,
+                                const CascadeOptions& options, WordsDistFn&& dist,
+                                std::uint64_t default_label = 0,
+                                CascadeStats* stats = nullptr) const {
+    HS_METRIC_TIMER(Classify);
+    HS_METRIC_INC(PrototypeClassifyCalls);
+    HS_METRIC_ADD(PrototypeScannedEntries, size_);
+    if (size_ == 0) {
+      if (stats != nullptr) *stats = CascadeStats{};
+      return default_label;
+    }
+    // The coarse pass reads only the prefix of each entry, so the same bytes in flight need a
+    // proportionally larger distance (in entries).
+    const std::size_t pw = options.prefix_words < kWords ? options.prefix_words : kWords;
+    const std::size_t scale = pw == 0 ? 1 : (kWords + pw - 1) / pw;
+    const std::size_t pd = tuning_.prefetch_distance * (scale < 8 ? scale : 8);
+    const std::size_t prefix_bytes = pw * sizeof(std::uint64_t);
+    const std::size_t best = detail_cascade::Search(
+        query.Words().data(), size_, kWords,
+        [this](std::size_t i) { return entries_[i].hv.Words().data(); }, dist,
+        [this, pd, prefix_bytes](std::size_t i) {
+          if (pd != 0 && i + pd < size_) PrefetchReadRange(&entries_[i + pd], prefix_bytes);
+        },
+        options, stats);
+    return entries_[best].label;
+  }
+
+  /**
+   * @brief Picks the prefetch distance from kPrefetchDistanceCandidates that gives the fastest
+   * full scan with `dist_fn` (best of `trials`, entry 0 as the query) on this host and stores it.
+   * Calibrate with the distance used for classification: a slow distance hides memory stalls.
+   * Returns the chosen distance; a no-op returning the current one when the memory is empty.
+   * Costs a few dozen scans, so call it once after loading rather than per query.
+   */
+  template <typename DistFn,
+            typename = std::enable_if_t<
+                std::is_invocable_r<std::size_t, DistFn,
+                                    const core::HyperVector<Dim, bool>&,
+                                    const core::HyperVector<Dim, bool>&>::value>>
+  std::size_t CalibratePrefetchDistance(DistFn&& dist_fn, std::size_t trials = 3) {
+    if (size_ == 0) {
+      return tuning_.prefetch_distance;
+    }
+    using clock = std::chrono::steady_clock;
+    // Repeat short scans so each timing covers at least ~8 MiB of entries.
+    constexpr std::size_t kMinScanBytes = std::size_t{8} << 20;
+    const std::size_t scan_bytes = size_ * sizeof(Entry);
+    const std::size_t passes = scan_bytes >= kMinScanBytes ? 1 : kMinScanBytes / scan_bytes;
+    const auto& query = entries_[0].hv;
+    volatile std::size_t sink = 0;  // keeps the timed scans observable
+    std::size_t best_distance = tuning_.prefetch_distance;
+    double best_secs = 0.0;
+    for (std::size_t distance : kPrefetchDistanceCandidates) {
+      for (std::size_t t = 0; t < (trials == 0 ? 1 : trials); ++t) {
+        std::size_t best_match = 0;
+        std::size_t best_index = 0;
+        const auto t0 = clock::now();
+        for (std::size_t p = 0; p < passes; ++p) {
+          ScanRange(query, dist_fn, 0, size_, distance, &best_match, &best_index);
+        }
+        const double secs = std::chrono::duration<double>(clock::now() - t0).count();
+        sink = sink + best_index;
+        if (best_secs == 0.0 || secs < best_secs) {
+          best_secs = secs;
+          best_distance = distance;
+        }
+      }
+    }
+    tuning_.prefetch_distance = best_distance;
+    return best_distance;
+  }
+
+  std::size_t CalibratePrefetchDistance(std::size_t trials = 3) {
+    return CalibratePrefetchDistance(DefaultDistance{}, trials);
+  }
+
+  [[nodiscard]] const ScanTuning& scan_tuning() const noexcept { return tuning_; }
+  void set_scan_tuning(const ScanTuning& tuning) noexcept { tuning_ = tuning; }
+
   std::size_t size() const {
     return size_;
   }
@@ -100,12 +239,42 @@ class PrototypeMemory {
    * @brief Read-only access to the underlying entries buffer.
    * Returns a pointer to an array of size Capacity; only the first size() entries are valid.
    */
-  [[nodiscard]] const Entry* data() const noexcept { return entries_.get(); }
+  [[nodiscard]] const Entry* data() const noexcept { return entries_.data(); }
 
+  static constexpr std::size_t kBatchQueryBlock = 32;
 
  private:
-  std::unique_ptr<Entry[]> entries_;
+  static constexpr std::size_t kWords = core::HyperVector<Dim, bool>::WordCount();
+
+  struct DefaultDistance {
+    std::size_t operator()(const core::HyperVector<Dim, bool>& a,
+                           const core::HyperVector<Dim, bool>& b) const {
+      return core::HammingDistance(a, b);
+    }
+  };
+
+  // Folds entries [begin, end) into (best_match, best_index) with the strict > rule, so scanning
+  // consecutive ranges in order gives the same winner as one full scan.
+  template <typename DistFn>
+  void ScanRange(const core::HyperVector<Dim, bool>& query, DistFn& dist_fn, std::size_t begin,
+                 std::size_t end, std::size_t prefetch_distance, std::size_t* best_match,
+                 std::size_t* best_index) const {
+    for (std::size_t i = begin; i < end; ++i) {
+      if (prefetch_distance != 0 && i + prefetch_distance < end) {
+        PrefetchReadRange(&entries_[i + prefetch_distance], sizeof(Entry));
+      }
+      const std::size_t dist = dist_fn(query, entries_[i].hv);
+      const std::size_t match = Dim - dist;
+      if (match > *best_match) {
+        *best_match = match;
+        *best_index = i;
+      }
+    }
+  }
+
+  LargeArray<Entry> entries_;
   std::size_t size_ = 0;
+  ScanTuning tuning_{DefaultPrefetchDistance(sizeof(Entry))};
 };
 
 /**
@@ -117,19 +286,38 @@ class PrototypeMemory {
  * Invariants and behavior:
  * - Capacity is fixed at compile time; Update() returns false when full.
  * - When size()==0, Finalize() produces an all-zero vector; no-op for unknown label.
+ * - When size()==0, Classify() and ClassifyBinarized() return the provided default_label.
+ * - Classify() scores clusters directly on their counters: the label maximizing the signed dot
+ *   product sum_i (query_i ? sums[i] : -sums[i]) wins (first cluster on ties). Clusters with more
+ *   updates have larger counters and therefore weigh more.
+ * - ClassifyBinarized() returns the label PrototypeMemory::Classify would return over the
+ *   finalized clusters, using binarized prototypes cached per cluster. Update() invalidates the
+ *   updated cluster, ApplyDecay() and LoadRaw() invalidate all; stale prototypes are rebuilt on the
+ *   next ClassifyBinarized(), so that call mutates the cache even on a const memory.
  * - If Capacity==0, all mutating operations fail and size() remains 0.
- * - Thread-safety: not thread-safe. External synchronization is required.
+ * - Thread-safety: not thread-safe. External synchronization is required (including concurrent
+ *   ClassifyBinarized() calls, unless RefreshBinarized() ran after the last mutation).
+ * - Storage: Capacity*Dim counters plus Capacity cached prototypes from a LargeAllocator (default
+ *   heap); allocator must outlive the memory. Move-only.
  *
  * Complexity:
  * - Update:   O(Dim) to adjust counters per bit
  * - Finalize: O(Dim) to threshold counters into a binary HyperVector
+ * - Classify: O(size * Dim) counter reads (4 bytes per dimension)
+ * - ClassifyBinarized: O(stale * Dim) to rebuild, then O(size * Dim/64) Hamming distance
+ * - Reinforce, Accumulate: O(Dim) counter adjustments (plus O(size) label lookup)
  */
 template <std::size_t Dim, std::size_t Capacity>
 class ClusterMemory {
  public:
-  ClusterMemory() : sums_(new int[Capacity * Dim]{}) {}
+  ClusterMemory() : ClusterMemory(nullptr) {}
+  /** Allocates counter storage from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit ClusterMemory(LargeAllocator* alloc)
+      : sums_(Capacity * Dim, alloc), binarized_(Capacity, alloc) {}
 
   bool Update(std::uint64_t label, const core::HyperVector<Dim, bool>& hv) {
+    HS_METRIC_TIMER(Update);
+    HS_METRIC_INC(ClusterUpdates);
     int index = FindIndex(label);
     if (index < 0) {
       if (size_ >= Capacity) {
@@ -142,10 +330,50 @@ class ClusterMemory {
       ++size_;
     }
 
-    for (std::size_t bit = 0; bit < Dim; ++bit) {
-      sums_[index * Dim + bit] += hv.GetBit(bit) ? 1 : -1;
-    }
+    int* sums = &sums_[static_cast<std::size_t>(index) * Dim];
+    core::AddSignedWords(sums, hv.Words().data(), Dim, 1);
     ++counts_[index];
+    stale_[index] = true;
+    return true;
+  }
+
+  /**
+   * @brief Adds step * (hv_i ? +1 : -1) to every counter of an existing cluster; counts are not
+   * changed. Returns false for an unknown label. This is the perceptron update of retraining
+   * (memory/retrain.hpp): a positive step pulls the cluster towards hv, a negative one pushes it
+   * away. Calls on different labels touch disjoint state.
+   */
+  bool Reinforce(std::uint64_t label, const core::HyperVector<Dim, bool>& hv, int step) {
+    const int index = FindIndex(label);
+    if (index < 0) {
+      return false;
+    }
+    int* sums = &sums_[static_cast<std::size_t>(index) * Dim];
+    core::AddSignedWords(sums, hv.Words().data(), Dim, step);
+    stale_[index] = true;
+    return true;
+  }
+
+  /**
+   * @brief Adds another cluster's raw counters (Dim sums) and update count to `label`'s cluster,
+   * creating it when absent. Merges clusters trained on different shards of a stream; returns
+   * false when a new cluster is needed and the memory is full.
+   */
+  bool Accumulate(std::uint64_t label, const int* sums, int count) {
+    int index = FindIndex(label);
+    if (index < 0) {
+      if (size_ >= Capacity) {
+        return false;
+      }
+      index = static_cast<int>(size_);
+      labels_[index] = label;
+      counts_[index] = 0;
+      ++size_;
+    }
+    int* dst = &sums_[static_cast<std::size_t>(index) * Dim];
+    for (std::size_t bit = 0; bit < Dim; ++bit) dst[bit] += sums[bit];
+    counts_[index] += count;
+    stale_[index] = true;
     return true;
   }
 
@@ -160,6 +388,7 @@ class ClusterMemory {
       }
       counts_[i] = static_cast<int>(static_cast<float>(counts_[i]) * decay_factor);
     }
+    stale_.fill(true);
   }
 
   void Finalize(std::uint64_t label, core::HyperVector<Dim, bool>* out) const {
@@ -168,9 +397,74 @@ class ClusterMemory {
     if (index < 0) {
       return;
     }
-    for (std::size_t bit = 0; bit < Dim; ++bit) {
-      out->SetBit(bit, sums_[index * Dim + bit] >= 0);
+    const int* sums = &sums_[static_cast<std::size_t>(index) * Dim];
+    core::detail::PackBits(out, [sums](std::size_t bit) { return sums[bit] >= 0; });
+  }
+
+  /** Label of the cluster whose counters have the largest signed dot product with `query`. */
+  std::uint64_t Classify(const core::HyperVector<Dim, bool>& query,
+                         std::uint64_t default_label = 0) const {
+    return Classify(query, &core::SignedDotWords, default_label);
+  }
+
+  // DotFn must be callable as: int64_t dot(const int* counters, const uint64_t* words, size_t dim)
+  // (core::SignedDotWords or backend::SelectSignedDotBackend()).
+  template <typename DotFn,
+            typename = std::enable_if_t<
+                std::is_invocable_r<std::int64_t, DotFn, const int*, const std::uint64_t*,
+                                    std::size_t>::value>>
+  std::uint64_t Classify(const core::HyperVector<Dim, bool>& query, DotFn&& dot,
+                         std::uint64_t default_label = 0) const {
+    HS_METRIC_TIMER(Classify);
+    if (size_ == 0) {
+      return default_label;
+    }
+    const std::uint64_t* words = query.Words().data();
+    std::size_t best_index = 0;
+    std::int64_t best_score = dot(&sums_[0], words, Dim);
+    for (std::size_t i = 1; i < size_; ++i) {
+      const std::int64_t score = dot(&sums_[i * Dim], words, Dim);
+      if (score > best_score) {
+        best_score = score;
+        best_index = i;
+      }
+    }
+    return labels_[best_index];
+  }
+
+  /** Nearest finalized cluster by Hamming distance, from the cached binarized prototypes. */
+  std::uint64_t ClassifyBinarized(const core::HyperVector<Dim, bool>& query,
+                                  std::uint64_t default_label = 0) const {
+    return ClassifyBinarized(
+        query,
+        [](const core::HyperVector<Dim, bool>& a, const core::HyperVector<Dim, bool>& b) {
+          return core::HammingDistance(a, b);
+        },
+        default_label);
+  }
+
+  // DistFn must be callable as: size_t dist(const HV&, const HV&)
+  template <typename DistFn,
+            typename = std::enable_if_t<
+                std::is_invocable_r<std::size_t, DistFn, const core::HyperVector<Dim, bool>&,
+                                    const core::HyperVector<Dim, bool>&>::value>>
+  std::uint64_t ClassifyBinarized(const core::HyperVector<Dim, bool>& query, DistFn&& dist_fn,
+                                  std::uint64_t default_label = 0) const {
+    HS_METRIC_TIMER(Classify);
+    if (size_ == 0) {
+      return default_label;
+    }
+    RefreshBinarized();
+    std::size_t best_index = 0;
+    std::size_t best_dist = dist_fn(query, binarized_[0]);
+    for (std::size_t i = 1; i < size_ && best_dist != 0; ++i) {
+      const std::size_t dist = dist_fn(query, binarized_[i]);
+      if (dist < best_dist) {
+        best_dist = dist;
+        best_index = i;
+      }
     }
+    return labels_[best_index];
   }
 
   /** Lightweight read-only view of internal buffers (for serialization). */
@@ -182,7 +476,7 @@ class ClusterMemory {
   };
 
   /** Returns a read-only view over labels, counts, and sums; first size() clusters valid. */
-  [[nodiscard]] View view() const noexcept { return View{labels_.data(), counts_.data(), sums_.get(), size_}; }
+  [[nodiscard]] View view() const noexcept { return View{labels_.data(), counts_.data(), sums_.data(), size_}; }
 
   /**
    * @brief Load raw internal buffers. Intended for serialization; validates sizes.
@@ -200,6 +494,7 @@ class ClusterMemory {
       }
     }
     size_ = n;
+    stale_.fill(true);
     return true;
   }
 
@@ -207,6 +502,24 @@ class ClusterMemory {
     return size_;
   }
 
+  /**
+   * @brief Cached binarized prototype of the cluster at `index` (< size()), as of the last
+   * RefreshBinarized() or ClassifyBinarized(); it lags the counters while the cluster is stale.
+   */
+  [[nodiscard]] const core::HyperVector<Dim, bool>& prototype(std::size_t index) const noexcept {
+    return binarized_[index];
+  }
+
+  /** Rebuilds the stale cached prototypes now (ClassifyBinarized() does so lazily). */
+  void RefreshBinarized() const {
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (!stale_[i]) continue;
+      const int* sums = &sums_[i * Dim];
+      core::detail::PackBits(&binarized_[i], [sums](std::size_t bit) { return sums[bit] >= 0; });
+      stale_[i] = false;
+    }
+  }
+
  private:
   int FindIndex(std::uint64_t label) const {
     for (std::size_t i = 0; i < size_; ++i) {
@@ -219,7 +532,9 @@ class ClusterMemory {
 
   std::array<std::uint64_t, Capacity> labels_{};
   std::array<int, Capacity> counts_{};
-  std::unique_ptr<int[]> sums_;
+  LargeArray<int> sums_;
+  mutable LargeArray<core::HyperVector<Dim, bool>> binarized_;  // cached Finalize() per cluster
+  mutable std::array<bool, Capacity> stale_{};
   std::size_t size_ = 0;
 };
 
@@ -234,15 +549,20 @@ class ClusterMemory {
  * - When size()==0, Restore() returns the caller-provided fallback.
  * - If Capacity==0, all mutating operations fail and size() remains 0.
  * - Thread-safety: not thread-safe. External synchronization is required.
+ * - Storage: Capacity vectors from a LargeAllocator (default heap); allocator must outlive the
+ *   memory. Move-only.
  *
  * Complexity:
  * - Insert:  O(1)
- * - Restore: O(size * Dim/64) Hamming distance over packed uint64_t words
+ * - Restore, NearestIndex: O(size * Dim/64) Hamming distance over packed uint64_t words
+ * - RestoreCascade: prefix distances plus refinement of surviving candidates (memory/cascade.hpp)
  */
 template <std::size_t Dim, std::size_t Capacity>
 class CleanupMemory {
  public:
-  CleanupMemory() = default;
+  CleanupMemory() : CleanupMemory(nullptr) {}
+  /** Allocates codebook storage from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit CleanupMemory(LargeAllocator* alloc) : entries_(Capacity, alloc) {}
 
   bool Insert(const core::HyperVector<Dim, bool>& hv) {
     if (size_ >= Capacity) {
@@ -255,9 +575,20 @@ class CleanupMemory {
 
   core::HyperVector<Dim, bool> Restore(const core::HyperVector<Dim, bool>& noisy,
                                        const core::HyperVector<Dim, bool>& fallback) const {
-    if (size_ == 0) {
+    const std::size_t best_index = NearestIndex(noisy);
+    if (best_index == size_) {
       return fallback;
     }
+    return entries_[best_index];
+  }
+
+  /** Index of the stored vector Restore() would return, or size() when empty. */
+  std::size_t NearestIndex(const core::HyperVector<Dim, bool>& noisy) const {
+    HS_METRIC_INC(CleanupRestoreCalls);
+    HS_METRIC_ADD(CleanupScannedEntries, size_);
+    if (size_ == 0) {
+      return 0;
+    }
     std::size_t best_index = 0;
     std::size_t best_match = 0;
     for (std::size_t i = 0; i < size_; ++i) {
@@ -268,15 +599,53 @@ class CleanupMemory {
         best_index = i;
       }
     }
-    return entries_[best_index];
+    return best_index;
+  }
+
+  /**
+   * @brief Coarse-to-fine Restore (see memory/cascade.hpp). kExact returns the same vector as
+   * Restore(noisy, fallback); kApproximate trades recall for speed via options.margin_bits.
+   * `dist` scores word ranges as in PrototypeMemory::ClassifyCascade.
+   */
+  core::HyperVector<Dim, bool> RestoreCascade(const core::HyperVector<Dim, bool>& noisy,
+                                              const core::HyperVector<Dim, bool>& fallback,
+                                              const CascadeOptions& options,
+                                              CascadeStats* stats = nullptr) const {
+    return RestoreCascade(noisy, fallback, options, detail_cascade::CoreWordsDistance{}, stats);
+  }
+
+  template <typename WordsDistFn,
+            typename = std::enable_if_t<
+                std::is_invocable_r<std::size_t, WordsDistFn, const std::uint64_t*,
+                                    const std::uint64_t*, std::size_t>::value>>
+  core::HyperVector<Dim, bool> RestoreCascade(const core::HyperVector<Dim, bool>& noisy,
+                                              const core::HyperVector<Dim, bool>& fallback,
+                                              const CascadeOptions& options, WordsDistFn&& dist,
+                                              CascadeStats* stats = nullptr) const {
+    HS_METRIC_INC(CleanupRestoreCalls);
+    HS_METRIC_ADD(CleanupScannedEntries, size_);
+    if (size_ == 0) {
+      if (stats != nullptr) *stats = CascadeStats{};
+      return fallback;
+    }
+    const std::size_t best = detail_cascade::Search(
+        noisy.Words().data(), size_, core::HyperVector<Dim, bool>::WordCount(),
+        [this](std::size_t i) { return entries_[i].Words().data(); }, dist, [](std::size_t) {},
+        options, stats);
+    return entries_[best];
   }
 
   std::size_t size() const {
     return size_;
   }
 
+  /** Stored vector `index` (< size()), in insertion order. */
+  const core::HyperVector<Dim, bool>& entry(std::size_t index) const noexcept {
+    return entries_[index];
+  }
+
  private:
-  std::array<core::HyperVector<Dim, bool>, Capacity> entries_{};
+  LargeArray<core::HyperVector<Dim, bool>> entries_;
   std::size_t size_ = 0;
 };
 
@@ -0,0 +1,108 @@
+#pragma once
+
+// Coarse-to-fine (cascade) nearest-neighbour search for the associative memories.
+// The Hamming distance over a leading word prefix is a lower bound of the full distance and, for
+// random-like hypervectors, already ranks candidates well. Entries are processed in blocks of
+// kCascadeBlock: the prefix distances of a block are computed into a stack buffer, then only the
+// block's candidates are refined on the remaining words (block minimum first, so the bound
+// tightens early). The best full distance found so far is the pruning bound.
+// - kExact refines every entry whose prefix distance does not exceed that bound, so the result
+//   (including the first-entry-wins tie rule) equals a full linear scan. It prunes most entries
+//   when the query is close to its match and little when the match is far (noisy queries).
+// - kApproximate additionally skips entries whose prefix distance exceeds the smallest prefix
+//   distance seen so far by more than margin_bits, trading recall for fewer refinements.
+// No heap scratch is used, so searches on a const memory stay reentrant.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "hyperstream/core/ops.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+enum class CascadeMode { kExact, kApproximate };
+
+struct CascadeOptions {
+  std::size_t prefix_words = 32;  // leading 64-bit words scored in the coarse pass (2048 bits)
+  CascadeMode mode = CascadeMode::kExact;
+  std::size_t margin_bits = 32;   // kApproximate: keep prefix distances <= min + margin_bits
+};
+
+/// Work done by one cascade search (for tuning and benchmarks).
+struct CascadeStats {
+  std::size_t prefix_words = 0;  // effective prefix length after clamping to the word count
+  std::size_t refined = 0;       // entries whose remaining words were scored
+};
+
+namespace detail_cascade {
+
+// Portable words distance matching core::HammingDistance.
+struct CoreWordsDistance {
+  std::size_t operator()(const std::uint64_t* a, const std::uint64_t* b, std::size_t n) const {
+    std::size_t dist = 0;
+    for (std::size_t w = 0; w < n; ++w) {
+      dist += static_cast<std::size_t>(core::detail::Popcount64(a[w] ^ b[w]));
+    }
+    return dist;
+  }
+};
+
+inline constexpr std::size_t kCascadeBlock = 256;
+
+// Returns the index of the nearest of `n` entries (n > 0) of `word_count` words each; words_of(i)
+// yields entry i's words, dist(a, b, k) the Hamming distance over k words and prefetch(i) is
+// called before entry i's prefix is read, so callers can prefetch ahead of i.
+template <typename WordsOf, typename WordsDistFn, typename PrefetchFn>
+std::size_t Search(const std::uint64_t* query, std::size_t n, std::size_t word_count,
+                   WordsOf&& words_of, WordsDistFn& dist, PrefetchFn&& prefetch,
+                   const CascadeOptions& options, CascadeStats* stats) {
+  constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+  const std::size_t pw = options.prefix_words < word_count ? options.prefix_words : word_count;
+  const std::size_t rest = word_count - pw;
+  const bool approximate = options.mode == CascadeMode::kApproximate;
+  std::size_t best = kNone;  // best full distance so far
+  std::size_t best_index = 0;
+  std::size_t min_prefix = kNone;
+  std::size_t refined = 0;
+  std::array<std::size_t, kCascadeBlock> prefix{};
+
+  // Scores entry i given its prefix distance p unless the bound rules it out.
+  auto consider = [&](std::size_t i, std::size_t p) {
+    if (best != kNone && (p > best || (p == best && i > best_index))) return;
+    if (approximate && p > min_prefix + options.margin_bits) return;
+    const std::size_t d = p + (rest ? dist(query + pw, words_of(i) + pw, rest) : 0);
+    ++refined;
+    if (best == kNone || d < best || (d == best && i < best_index)) {
+      best = d;
+      best_index = i;
+    }
+  };
+
+  for (std::size_t b0 = 0; b0 < n; b0 += kCascadeBlock) {
+    const std::size_t bn = (n - b0 < kCascadeBlock) ? n - b0 : kCascadeBlock;
+    std::size_t block_min = 0;
+    for (std::size_t j = 0; j < bn; ++j) {
+      prefetch(b0 + j);
+      prefix[j] = dist(query, words_of(b0 + j), pw);
+      if (prefix[j] < prefix[block_min]) block_min = j;
+    }
+    if (prefix[block_min] < min_prefix) min_prefix = prefix[block_min];
+    consider(b0 + block_min, prefix[block_min]);
+    for (std::size_t j = 0; j < bn; ++j) {
+      if (j != block_min) consider(b0 + j, prefix[j]);
+    }
+  }
+  if (stats != nullptr) {
+    stats->prefix_words = pw;
+    stats->refined = refined;
+  }
+  return best_index;
+}
+
+}  // namespace detail_cascade
+
+}  // namespace memory
+}  // namespace hyperstream
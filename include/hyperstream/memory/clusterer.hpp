@@ -0,0 +1,210 @@
+#pragma once
+
+// Online (streaming) clustering of hypervectors, a binary analogue of sequential k-means.
+// Each vector is assigned to the nearest binarized centroid and bundled into that centroid's
+// counters; a vector farther than the spawn distance from every centroid starts a new cluster
+// instead. Centroids are the cached prototypes of a ClusterMemory (cluster id == insertion
+// index), so thresholding is not repeated per vector: prototypes are re-binarized every
+// refresh_every updates, and right after a cluster is spawned.
+//
+// Batched assignment scores a whole batch against the centroids frozen at its start (executor
+// tasks over chunks of vectors), then applies the updates in input order; a vector that would
+// spawn is first re-checked against the clusters spawned earlier in the same batch. Independent
+// shards of a stream can be clustered separately and combined with Merge(), which folds each
+// foreign cluster's counters into its nearest local centroid or appends it as a new cluster.
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "hyperstream/config.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/executor.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+struct StreamingClustererOptions {
+  float spawn_threshold = 0.35f;   // normalized Hamming distance above which a new cluster spawns
+  std::size_t refresh_every = 64;  // updates between prototype re-binarizations (1 = always fresh)
+};
+
+/**
+ * @brief Streaming clusterer over binary hypervectors with at most Capacity clusters.
+ *
+ * @tparam Dim      Hypervector dimension (bits)
+ * @tparam Capacity Maximum number of clusters; once full, far vectors join their nearest cluster.
+ *
+ * Invariants and behavior:
+ * - Cluster ids are 0..size()-1 in creation order and never change.
+ * - The first vector always spawns cluster 0. A vector spawns a cluster when its distance to the
+ *   nearest centroid exceeds spawn_threshold * Dim and size() < Capacity.
+ * - Assignments use the cached centroids, which lag the counters by fewer than refresh_every
+ *   updates; memory() exposes the counters (Finalize, Classify, ApplyDecay, serialization).
+ * - Results do not depend on the executor passed to AssignBatch.
+ * - Thread-safety: not thread-safe; shard the stream and Merge() instead.
+ * - Storage: one ClusterMemory<Dim, Capacity> (StorageBytes()).
+ *
+ * Complexity:
+ * - Assign: O(size * Dim/64) distance words plus O(Dim) counter update
+ * - Refresh: O(Dim) per cluster updated since the last refresh
+ * - Merge: O(other.size * (size * Dim/64 + Dim))
+ */
+template <std::size_t Dim, std::size_t Capacity>
+class StreamingClusterer {
+ public:
+  using Vector = core::HyperVector<Dim, bool>;
+
+  StreamingClusterer() : StreamingClusterer(StreamingClustererOptions{}) {}
+  /** Allocates the cluster memory from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit StreamingClusterer(const StreamingClustererOptions& options, LargeAllocator* alloc = nullptr)
+      : memory_(alloc),
+        spawn_distance_(static_cast<std::size_t>(options.spawn_threshold * static_cast<float>(Dim))),
+        refresh_every_(options.refresh_every == 0 ? 1 : options.refresh_every) {}
+
+  /** Assigns `hv` to a cluster (spawning one if needed), updates it and returns its id. */
+  std::uint64_t Assign(const Vector& hv) { return Assign(hv, DefaultDistance{}); }
+
+  // DistFn must be callable as: size_t dist(const HV&, const HV&)
+  // (e.g. backend::SelectHammingBackend<Dim>()).
+  template <typename DistFn,
+            typename = std::enable_if_t<std::is_invocable_r<std::size_t, DistFn, const Vector&, const Vector&>::value>>
+  std::uint64_t Assign(const Vector& hv, DistFn&& dist_fn) {
+    std::size_t dist = kFar;
+    const std::size_t nearest = NearestIn(hv, dist_fn, 0, memory_.size(), &dist);
+    return Absorb(hv, nearest, dist);
+  }
+
+  /**
+   * @brief Assigns hvs[0..n) in order, writing cluster ids to ids[0..n). Unlike a sequence of
+   * Assign() calls, each vector is matched against the centroids as of the start of the batch
+   * (computed by `exec` tasks), plus the clusters spawned earlier in the batch.
+   */
+  template <typename DistFn, typename Executor = SerialExecutor>
+  void AssignBatch(const Vector* hvs, std::size_t n, std::uint64_t* ids, DistFn&& dist_fn,
+                   Executor&& exec = Executor{}) {
+    if (n == 0) return;
+    nearest_.resize(n);
+    distance_.resize(n);
+    const std::size_t frozen = memory_.size();
+    exec((n + kAssignChunk - 1) / kAssignChunk, [&](std::size_t t) {
+      const std::size_t end = (n - t * kAssignChunk < kAssignChunk) ? n : (t + 1) * kAssignChunk;
+      for (std::size_t i = t * kAssignChunk; i < end; ++i) {
+        distance_[i] = kFar;
+        nearest_[i] = NearestIn(hvs[i], dist_fn, 0, frozen, &distance_[i]);
+      }
+    });
+    for (std::size_t i = 0; i < n; ++i) {
+      std::size_t dist = distance_[i];
+      std::size_t nearest = nearest_[i];
+      // Clusters spawned earlier in this batch were invisible to the parallel pass.
+      if (dist > spawn_distance_ && memory_.size() > frozen) {
+        const std::size_t late = NearestIn(hvs[i], dist_fn, frozen, memory_.size(), &dist);
+        if (late != kNone) nearest = late;
+      }
+      ids[i] = Absorb(hvs[i], nearest, dist);
+    }
+  }
+
+  void AssignBatch(const Vector* hvs, std::size_t n, std::uint64_t* ids) {
+    AssignBatch(hvs, n, ids, DefaultDistance{});
+  }
+
+  /**
+   * @brief Folds the clusters of `other` (e.g. trained on another shard) into this clusterer.
+   * Each foreign cluster joins the nearest local centroid within the spawn distance (or any, when
+   * full) or is appended as a new cluster. When `remap` is non-null, remap[j] receives the local
+   * id of other's cluster j (other.size() entries).
+   */
+  template <typename DistFn>
+  void Merge(const StreamingClusterer& other, DistFn&& dist_fn, std::uint64_t* remap = nullptr) {
+    other.memory_.RefreshBinarized();
+    memory_.RefreshBinarized();
+    const auto view = other.memory_.view();
+    for (std::size_t j = 0; j < view.size; ++j) {
+      std::size_t dist = kFar;
+      std::size_t target = NearestIn(other.memory_.prototype(j), dist_fn, 0, memory_.size(), &dist);
+      if (target == kNone || (dist > spawn_distance_ && memory_.size() < Capacity)) {
+        target = memory_.size();
+      }
+      (void)memory_.Accumulate(target, &view.sums[j * Dim], view.counts[j]);
+      memory_.RefreshBinarized();
+      if (remap != nullptr) remap[j] = target;
+    }
+    pending_ = 0;
+  }
+
+  void Merge(const StreamingClusterer& other, std::uint64_t* remap = nullptr) {
+    Merge(other, DefaultDistance{}, remap);
+  }
+
+  /** Re-binarizes the centroids updated since the last refresh. */
+  void Refresh() {
+    memory_.RefreshBinarized();
+    pending_ = 0;
+  }
+
+  /** Cached centroid of cluster `id` (< size()). */
+  [[nodiscard]] const Vector& centroid(std::size_t id) const noexcept { return memory_.prototype(id); }
+  [[nodiscard]] const ClusterMemory<Dim, Capacity>& memory() const noexcept { return memory_; }
+  [[nodiscard]] ClusterMemory<Dim, Capacity>& memory() noexcept { return memory_; }
+  [[nodiscard]] std::size_t spawn_distance() const noexcept { return spawn_distance_; }
+  std::size_t size() const { return memory_.size(); }
+
+  static constexpr std::size_t StorageBytes() noexcept {
+    return config::ClusterMemoryStorageBytes(Dim, Capacity);
+  }
+
+ private:
+  static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+  static constexpr std::size_t kFar = Dim + 1;  // farther than any centroid
+  // Vectors per AssignBatch distance task.
+  static constexpr std::size_t kAssignChunk = 16;
+
+  struct DefaultDistance {
+    std::size_t operator()(const Vector& a, const Vector& b) const { return core::HammingDistance(a, b); }
+  };
+
+  // Nearest cached centroid among ids [begin, end) with a distance below *dist (first on ties);
+  // kNone when there is none. Updates *dist.
+  template <typename DistFn>
+  std::size_t NearestIn(const Vector& hv, DistFn& dist_fn, std::size_t begin, std::size_t end,
+                        std::size_t* dist) const {
+    std::size_t best = kNone;
+    for (std::size_t c = begin; c < end && *dist != 0; ++c) {
+      const std::size_t d = dist_fn(hv, memory_.prototype(c));
+      if (d < *dist) {
+        *dist = d;
+        best = c;
+      }
+    }
+    return best;
+  }
+
+  // Bundles hv into cluster `nearest` at distance `dist`, or into a new cluster.
+  std::uint64_t Absorb(const Vector& hv, std::size_t nearest, std::size_t dist) {
+    if (nearest == kNone || (dist > spawn_distance_ && memory_.size() < Capacity)) {
+      const std::uint64_t id = memory_.size();
+      if (!memory_.Update(id, hv)) return 0;  // Capacity == 0
+      Refresh();  // the new centroid must be visible to the next vector
+      return id;
+    }
+    (void)memory_.Update(nearest, hv);
+    if (++pending_ >= refresh_every_) Refresh();
+    return nearest;
+  }
+
+  ClusterMemory<Dim, Capacity> memory_;
+  std::size_t spawn_distance_;
+  std::size_t refresh_every_;
+  std::size_t pending_ = 0;  // updates since the last refresh
+  std::vector<std::size_t> nearest_;   // AssignBatch scratch
+  std::vector<std::size_t> distance_;  // AssignBatch scratch
+};
+
+}  // namespace memory
+}  // namespace hyperstream
@@ -0,0 +1,23 @@
+#pragma once
+
+// Task executors for the batch kernels (HammingMatrix, HammingTopK, Retrain).
+// An executor is a callable exec(count, fn) that invokes fn(task) exactly once for every task in
+// [0, count), in any order and on any threads, and returns when all have finished. Kernels split
+// their work into tasks with disjoint outputs, so results never depend on the executor; a thread
+// pool adapter parallelizes them without the library depending on a threading runtime.
+
+#include <cstddef>
+
+namespace hyperstream {
+namespace memory {
+
+/// Runs tasks 0..count-1 in order on the calling thread.
+struct SerialExecutor {
+  template <typename Fn>
+  void operator()(std::size_t count, Fn&& fn) const {
+    for (std::size_t t = 0; t < count; ++t) fn(t);
+  }
+};
+
+}  // namespace memory
+}  // namespace hyperstream
@@ -0,0 +1,166 @@
+#pragma once
+
+// Blocked all-pairs Hamming distances (N x M matrix and top-k nearest per row).
+// Calling HammingDistance for every pair streams each B vector once per A row. Here B is visited
+// in column tiles sized for L2 and every tile is scored against a block of A rows with a
+// register-tiled kernel (core::HammingTileWords or backend::SelectHammingTileBackend()), so a B
+// vector is fetched from memory once per row block and each loaded word is reused across a
+// small register tile of pairs. Row blocks are independent tasks handed to an executor: the
+// default runs them in order on the calling thread (memory/executor.hpp).
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/executor.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+struct HammingMatrixOptions {
+  std::size_t row_tile = 64;                // A rows per task (the unit handed to the executor)
+  std::size_t col_tile_bytes = 256 * 1024;  // B vectors per column tile, in bytes (private L2)
+  bool skip_self = false;                   // HammingTopK: ignore pair (i, i), for A == B
+};
+
+/// One top-k result; rows with fewer than k candidates are padded with kNoNeighbor.
+struct HammingNeighbor {
+  std::uint32_t index;
+  std::uint32_t distance;
+};
+
+inline constexpr std::uint32_t kNoNeighbor = std::numeric_limits<std::uint32_t>::max();
+
+namespace detail_matrix {
+
+// HammingTopK scores this many columns of a tile at a time (64 rows x 256 x 4 B = 64 KiB scratch).
+inline constexpr std::size_t kTopKChunk = 256;
+
+template <std::size_t Dim>
+std::size_t ColTile(const HammingMatrixOptions& options) {
+  const std::size_t c = options.col_tile_bytes / sizeof(core::HyperVector<Dim, bool>);
+  return c < 4 ? 4 : c;
+}
+
+inline std::size_t RowTile(const HammingMatrixOptions& options) {
+  return options.row_tile == 0 ? 1 : options.row_tile;
+}
+
+// Runs fn(i0, rows, a_ptrs, j0, cols, b_ptrs) for every (row block of task t, column tile).
+template <std::size_t Dim, typename Fn>
+void ForEachTile(const core::HyperVector<Dim, bool>* a, std::size_t n,
+                 const core::HyperVector<Dim, bool>* b, std::size_t m,
+                 const HammingMatrixOptions& options, std::size_t t, Fn&& fn) {
+  const std::size_t rt = RowTile(options);
+  const std::size_t ct = ColTile<Dim>(options);
+  const std::size_t i0 = t * rt;
+  const std::size_t rows = (n - i0 < rt) ? n - i0 : rt;
+  std::vector<const std::uint64_t*> a_ptrs(rows);
+  std::vector<const std::uint64_t*> b_ptrs(ct < m ? ct : m);
+  for (std::size_t r = 0; r < rows; ++r) a_ptrs[r] = a[i0 + r].Words().data();
+  for (std::size_t j0 = 0; j0 < m; j0 += ct) {
+    const std::size_t cols = (m - j0 < ct) ? m - j0 : ct;
+    for (std::size_t c = 0; c < cols; ++c) b_ptrs[c] = b[j0 + c].Words().data();
+    fn(i0, rows, a_ptrs.data(), j0, cols, b_ptrs.data());
+  }
+}
+
+}  // namespace detail_matrix
+
+/**
+ * @brief out[i*m + j] = HammingDistance(a[i], b[j]) for i < n, j < m.
+ *
+ * `tile` has the signature of core::HammingTileWords (pass backend::SelectHammingTileBackend()
+ * for the SIMD kernels); `exec` runs the ceil(n/row_tile) row-block tasks (SerialExecutor by
+ * default). Complexity: O(n * m * Dim/64) word ops; B is streamed ceil(n/row_tile) times.
+ */
+template <std::size_t Dim, typename TileFn, typename Executor = SerialExecutor>
+void HammingMatrix(const core::HyperVector<Dim, bool>* a, std::size_t n,
+                   const core::HyperVector<Dim, bool>* b, std::size_t m, std::uint32_t* out,
+                   const HammingMatrixOptions& options, TileFn&& tile, Executor&& exec = Executor{}) {
+  if (n == 0 || m == 0) return;
+  constexpr std::size_t kWords = core::HyperVector<Dim, bool>::WordCount();
+  const std::size_t tasks = (n + detail_matrix::RowTile(options) - 1) / detail_matrix::RowTile(options);
+  exec(tasks, [&](std::size_t t) {
+    detail_matrix::ForEachTile<Dim>(
+        a, n, b, m, options, t,
+        [&](std::size_t i0, std::size_t rows, const std::uint64_t* const* ap, std::size_t j0,
+            std::size_t cols, const std::uint64_t* const* bp) {
+          tile(ap, rows, bp, cols, kWords, out + i0 * m + j0, m);
+        });
+  });
+}
+
+template <std::size_t Dim>
+void HammingMatrix(const core::HyperVector<Dim, bool>* a, std::size_t n,
+                   const core::HyperVector<Dim, bool>* b, std::size_t m, std::uint32_t* out,
+                   const HammingMatrixOptions& options = {}) {
+  HammingMatrix(a, n, b, m, out, options, &core::HammingTileWords);
+}
+
+/**
+ * @brief The k nearest b[j] of every a[i] into out[i*k .. i*k + k), ascending by distance, then
+ * by index. Only a row block x kTopKChunk columns of distances is materialized per task (kept in
+ * L2 while it is merged), so memory is O(n*k) regardless of m. Same `tile`/`exec` contract as HammingMatrix.
+ */
+template <std::size_t Dim, typename TileFn, typename Executor = SerialExecutor>
+void HammingTopK(const core::HyperVector<Dim, bool>* a, std::size_t n,
+                 const core::HyperVector<Dim, bool>* b, std::size_t m, std::size_t k,
+                 HammingNeighbor* out, const HammingMatrixOptions& options, TileFn&& tile,
+                 Executor&& exec = Executor{}) {
+  if (n == 0 || k == 0) return;
+  constexpr std::size_t kWords = core::HyperVector<Dim, bool>::WordCount();
+  const std::size_t rt = detail_matrix::RowTile(options);
+  const std::size_t ct = detail_matrix::ColTile<Dim>(options);
+  const std::size_t chunk = ct < detail_matrix::kTopKChunk ? ct : detail_matrix::kTopKChunk;
+  const std::size_t tasks = (n + rt - 1) / rt;
+  exec(tasks, [&](std::size_t t) {
+    std::vector<std::uint32_t> dist(rt * chunk);
+    std::vector<std::size_t> filled(rt, 0);
+    detail_matrix::ForEachTile<Dim>(
+        a, n, b, m, options, t,
+        [&](std::size_t i0, std::size_t rows, const std::uint64_t* const* ap, std::size_t j0,
+            std::size_t cols, const std::uint64_t* const* bp) {
+          for (std::size_t c0 = 0; c0 < cols; c0 += chunk) {
+            const std::size_t cn = (cols - c0 < chunk) ? cols - c0 : chunk;
+            tile(ap, rows, bp + c0, cn, kWords, dist.data(), chunk);
+            for (std::size_t r = 0; r < rows; ++r) {
+              HammingNeighbor* best = out + (i0 + r) * k;
+              std::size_t& count = filled[r];
+              const std::uint32_t* row = &dist[r * chunk];
+              for (std::size_t c = 0; c < cn; ++c) {
+                const std::size_t j = j0 + c0 + c;
+                if (options.skip_self && j == i0 + r) continue;
+                const std::uint32_t d = row[c];
+                // Columns arrive in increasing j, so an equal distance never displaces an entry.
+                if (count == k && d >= best[k - 1].distance) continue;
+                std::size_t pos = count < k ? count++ : k - 1;
+                while (pos > 0 && best[pos - 1].distance > d) {
+                  best[pos] = best[pos - 1];
+                  --pos;
+                }
+                best[pos] = HammingNeighbor{static_cast<std::uint32_t>(j), d};
+              }
+            }
+          }
+        });
+    const std::size_t i0 = t * rt;
+    const std::size_t rows = (n - i0 < rt) ? n - i0 : rt;
+    for (std::size_t r = 0; r < rows; ++r) {
+      for (std::size_t p = filled[r]; p < k; ++p) out[(i0 + r) * k + p] = HammingNeighbor{kNoNeighbor, kNoNeighbor};
+    }
+  });
+}
+
+template <std::size_t Dim>
+void HammingTopK(const core::HyperVector<Dim, bool>* a, std::size_t n,
+                 const core::HyperVector<Dim, bool>* b, std::size_t m, std::size_t k,
+                 HammingNeighbor* out, const HammingMatrixOptions& options = {}) {
+  HammingTopK(a, n, b, m, k, out, options, &core::HammingTileWords);
+}
+
+}  // namespace memory
+}  // namespace hyperstream
@@ -0,0 +1,331 @@
+#pragma once
+
+// Holographic key-value store: pairs are stored as bound vectors key ^ value bundled into memory
+// vectors; a lookup unbinds the key from its memory vector and restores the noisy result to the
+// nearest codeword of a CleanupMemory over the value codebook.
+//
+// Capacity: unbinding a majority bundle of n random pairs leaves the stored value with each bit
+// agreeing with probability about 1/2 + 1/sqrt(2*pi*n), so the stored value wins against one other
+// random codeword unless a normal deviate exceeds sqrt(Dim / (pi * n)). For V codewords the error
+// rate is bounded by (V - 1) * Q(sqrt(Dim / (pi * n))); HoloKVPairsPerShard() inverts that bound
+// for a target accuracy. Pairs are routed to shards (memory vectors) by a hash of the key, with
+// enough shards for expected_pairs at kHoloKVLoadFactor of the per-shard capacity, so random
+// routing imbalance rarely pushes a shard past its capacity.
+//
+// Each shard keeps int32 counters (core::AddSignedWords) and a cached binarized memory vector that
+// is rebuilt only for shards modified since the last lookup; ties (even pair counts) are broken by
+// a fixed pseudo-random vector so they do not bias the memory vector. Batched lookups score blocks
+// of unbound keys against the whole codebook with one tile-kernel call (memory/hamming_matrix.hpp).
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hyperstream/config.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/executor.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+struct HoloKVOptions {
+  double target_accuracy = 0.99;      // per-lookup probability of restoring the stored value
+  std::size_t expected_pairs = 1024;  // sizes the shard count; more pairs degrade accuracy
+  std::uint64_t seed = 0x9e3779b97f4a7c15ULL;  // shard routing and tie-breaking
+};
+
+// Shards are provisioned for expected_pairs at this fraction of the per-shard capacity.
+inline constexpr double kHoloKVLoadFactor = 0.8;
+
+namespace detail_holokv {
+
+inline double NormalTail(double x) { return 0.5 * std::erfc(x / std::sqrt(2.0)); }
+
+inline std::uint64_t Mix(std::uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace detail_holokv
+
+/// Estimated probability that a lookup in a memory vector bundling `pairs` pairs restores the
+/// stored value among `values` random codewords.
+inline double HoloKVAccuracy(std::size_t dim_bits, std::size_t values, std::size_t pairs) {
+  if (values <= 1 || pairs == 0) return 1.0;
+  const double margin = std::sqrt(static_cast<double>(dim_bits) / (3.141592653589793 * static_cast<double>(pairs)));
+  const double error = static_cast<double>(values - 1) * detail_holokv::NormalTail(margin);
+  return error >= 1.0 ? 0.0 : 1.0 - error;
+}
+
+/// Largest number of pairs per memory vector whose HoloKVAccuracy() meets `target_accuracy`
+/// (at least 1).
+inline std::size_t HoloKVPairsPerShard(std::size_t dim_bits, std::size_t values, double target_accuracy) {
+  if (values <= 1) return dim_bits;  // any memory restores the only value
+  const double error = target_accuracy >= 1.0 ? 1e-300 : 1.0 - target_accuracy;
+  // Smallest margin x with (values - 1) * Q(x) <= error, by bisection (Q is decreasing).
+  double lo = 0.0;
+  double hi = 40.0;
+  for (int i = 0; i < 100; ++i) {
+    const double mid = 0.5 * (lo + hi);
+    if (static_cast<double>(values - 1) * detail_holokv::NormalTail(mid) > error) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  const double pairs = static_cast<double>(dim_bits) / (3.141592653589793 * hi * hi);
+  return pairs < 1.0 ? 1 : static_cast<std::size_t>(pairs);
+}
+
+/**
+ * @brief Sharded holographic key-value store over a value codebook of at most ValueCapacity
+ * binary hypervectors.
+ *
+ * @tparam Dim           Hypervector dimension (bits)
+ * @tparam ValueCapacity Maximum number of codebook values; also the V used to size shards.
+ *
+ * Invariants and behavior:
+ * - Values are added with AddValue() and referenced by index; keys are arbitrary (random-like)
+ *   hypervectors, e.g. from encoding::ItemMemory. Storing a key twice bundles both pairs.
+ * - Get() returns the index of the nearest codeword to the unbound memory: a stored key returns its
+ *   value with about HoloKVAccuracy(Dim, ValueCapacity, load) probability; an unknown key returns
+ *   an arbitrary index. kNotFound only when the codebook is empty.
+ * - Results of the batched calls equal those of Put()/Get() and do not depend on the executor.
+ * - Thread-safety: not thread-safe (lookups rebuild cached memory vectors); batched calls
+ *   parallelize internally through the executor.
+ * - Storage: shard_count() * (Dim int32 counters + one memory vector) plus the codebook
+ *   (StorageBytes()).
+ *
+ * Complexity:
+ * - Put: O(Dim) counter adds, plus O(Dim/64) to hash the key to its shard
+ * - Get: O(Dim) to rebuild a modified shard, then O(values * Dim/64) distance words
+ */
+template <std::size_t Dim, std::size_t ValueCapacity>
+class HoloKVStore {
+ public:
+  using Vector = core::HyperVector<Dim, bool>;
+  static constexpr std::size_t kWords = Vector::WordCount();
+  static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+  HoloKVStore() : HoloKVStore(HoloKVOptions{}) {}
+  /** Allocates counters, memory vectors and codebook from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit HoloKVStore(const HoloKVOptions& options, LargeAllocator* alloc = nullptr)
+      : pairs_per_shard_(HoloKVPairsPerShard(Dim, ValueCapacity, options.target_accuracy)),
+        shards_(ShardCount(options.expected_pairs, pairs_per_shard_)),
+        seed_(options.seed),
+        values_(alloc),
+        sums_(shards_ * Dim, alloc),
+        memory_(shards_, alloc),
+        loads_(shards_, 0),
+        stale_(shards_, 0) {
+    for (std::size_t i = 0; i < shards_ * Dim; ++i) sums_[i] = 0;
+    std::uint64_t state = seed_;
+    for (auto& w : tie_.Words()) {
+      state += 0x9e3779b97f4a7c15ULL;
+      w = detail_holokv::Mix(state);
+    }
+    if (Dim % 64 != 0) tie_.Words()[kWords - 1] &= (1ULL << (Dim % 64)) - 1ULL;
+    for (std::size_t s = 0; s < shards_; ++s) memory_[s] = tie_;
+  }
+
+  /** Appends a codeword; returns its index, or kNotFound when the codebook is full. */
+  std::size_t AddValue(const Vector& value) {
+    if (!values_.Insert(value)) return kNotFound;
+    return values_.size() - 1;
+  }
+
+  /** Stores (key, value index); false if `value` is not a codebook index. */
+  bool Put(const Vector& key, std::size_t value) {
+    if (value >= values_.size()) return false;
+    Store(ShardOf(key), key, value);
+    return true;
+  }
+
+  /**
+   * @brief Stores pairs (keys[i], values[i]), i < n; returns how many were stored (invalid value
+   * indices are skipped). `exec` runs one task per shard over the pairs routed to it.
+   */
+  template <typename Executor = SerialExecutor>
+  std::size_t PutBatch(const Vector* keys, const std::size_t* values, std::size_t n,
+                       Executor&& exec = Executor{}) {
+    // Counting sort of the valid pairs by shard, so each task touches one shard's counters.
+    route_.assign(shards_ + 1, 0);
+    order_.resize(n);
+    shard_of_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      shard_of_[i] = values[i] < values_.size() ? ShardOf(keys[i]) : shards_;
+      ++route_[shard_of_[i]];
+    }
+    std::size_t offset = 0;
+    for (std::size_t s = 0; s <= shards_; ++s) {
+      const std::size_t count = route_[s];
+      route_[s] = offset;
+      offset += count;
+    }
+    cursor_ = route_;
+    for (std::size_t i = 0; i < n; ++i) order_[cursor_[shard_of_[i]]++] = i;
+    exec(shards_, [&](std::size_t s) {
+      for (std::size_t k = route_[s]; k < cursor_[s]; ++k) Store(s, keys[order_[k]], values[order_[k]]);
+    });
+    return route_[shards_];
+  }
+
+  /** Index of the value restored for `key`, or kNotFound when the codebook is empty. */
+  std::size_t Get(const Vector& key) const {
+    if (values_.size() == 0) return kNotFound;
+    Vector unbound;
+    Unbind(key, &unbound);
+    return values_.NearestIndex(unbound);
+  }
+
+  /** Restored value vector for `key`; `fallback` when the codebook is empty. */
+  Vector GetValue(const Vector& key, const Vector& fallback) const {
+    Vector unbound;
+    Unbind(key, &unbound);
+    return values_.Restore(unbound, fallback);
+  }
+
+  /**
+   * @brief out[i] = Get(keys[i]) for i < n. `tile` has the signature of core::HammingTileWords
+   * (pass backend::SelectHammingTileBackend() for the SIMD kernels); `exec` runs one task per
+   * block of kGetBlock keys.
+   */
+  template <typename TileFn, typename Executor = SerialExecutor>
+  void GetBatch(const Vector* keys, std::size_t n, std::size_t* out, TileFn&& tile,
+                Executor&& exec = Executor{}) const {
+    const std::size_t nv = values_.size();
+    if (nv == 0) {
+      for (std::size_t i = 0; i < n; ++i) out[i] = kNotFound;
+      return;
+    }
+    Refresh();
+    std::vector<const std::uint64_t*> codebook(nv);
+    for (std::size_t v = 0; v < nv; ++v) codebook[v] = values_.entry(v).Words().data();
+    exec((n + kGetBlock - 1) / kGetBlock, [&](std::size_t t) {
+      const std::size_t k0 = t * kGetBlock;
+      const std::size_t bn = (n - k0 < kGetBlock) ? n - k0 : kGetBlock;
+      Vector unbound[kGetBlock];
+      const std::uint64_t* a_ptrs[kGetBlock];
+      for (std::size_t k = 0; k < bn; ++k) {
+        Xor(keys[k0 + k], memory_[ShardOf(keys[k0 + k])], &unbound[k]);
+        a_ptrs[k] = unbound[k].Words().data();
+      }
+      std::vector<std::uint32_t> dist(bn * nv);
+      tile(a_ptrs, bn, codebook.data(), nv, kWords, dist.data(), nv);
+      for (std::size_t k = 0; k < bn; ++k) {
+        const std::uint32_t* d = &dist[k * nv];
+        std::size_t best = 0;
+        for (std::size_t v = 1; v < nv; ++v) best = d[v] < d[best] ? v : best;
+        out[k0 + k] = best;
+      }
+    });
+  }
+
+  void GetBatch(const Vector* keys, std::size_t n, std::size_t* out) const {
+    GetBatch(keys, n, out, &core::HammingTileWords);
+  }
+
+  /** Rebuilds the memory vectors of shards modified since the last lookup. */
+  void Refresh() const {
+    for (std::size_t s = 0; s < shards_; ++s) {
+      if (stale_[s] == 0) continue;
+      const int* c = &sums_[s * Dim];
+      const auto& tie = tie_.Words();
+      auto& mem = memory_[s].Words();
+      for (std::size_t w = 0; w < kWords; ++w) {
+        const std::size_t nb = (Dim - w * 64 < 64) ? Dim - w * 64 : 64;
+        const int* cw = c + w * 64;
+        std::uint64_t pos = 0;
+        std::uint64_t zero = 0;
+        for (std::size_t b = 0; b < nb; ++b) {
+          pos |= static_cast<std::uint64_t>(cw[b] > 0) << b;
+          zero |= static_cast<std::uint64_t>(cw[b] == 0) << b;
+        }
+        mem[w] = pos | (zero & tie[w]);
+      }
+      stale_[s] = 0;
+    }
+  }
+
+  /** Mean HoloKVAccuracy() over the stored pairs, given the current shard loads. */
+  [[nodiscard]] double EstimatedAccuracy() const {
+    std::size_t total = 0;
+    double hits = 0.0;
+    for (std::size_t s = 0; s < shards_; ++s) {
+      total += loads_[s];
+      hits += static_cast<double>(loads_[s]) * HoloKVAccuracy(Dim, ValueCapacity, loads_[s]);
+    }
+    return total == 0 ? 1.0 : hits / static_cast<double>(total);
+  }
+
+  [[nodiscard]] std::size_t shard_count() const noexcept { return shards_; }
+  [[nodiscard]] std::size_t pairs_per_shard() const noexcept { return pairs_per_shard_; }
+  [[nodiscard]] std::size_t shard_load(std::size_t shard) const noexcept { return loads_[shard]; }
+  [[nodiscard]] std::size_t ShardOf(const Vector& key) const noexcept {
+    // Every word feeds the hash: structured keys (level codes, role-bound records) often share
+    // their first and last words, and would otherwise all land in one shard.
+    std::uint64_t h = seed_;
+    for (const std::uint64_t w : key.Words()) h = detail_holokv::Mix(h ^ w);
+    return static_cast<std::size_t>(h % shards_);
+  }
+  [[nodiscard]] std::size_t size() const noexcept {
+    std::size_t total = 0;
+    for (std::size_t load : loads_) total += load;
+    return total;
+  }
+  [[nodiscard]] const CleanupMemory<Dim, ValueCapacity>& values() const noexcept { return values_; }
+
+  [[nodiscard]] std::size_t StorageBytes() const noexcept {
+    return shards_ * (Dim * sizeof(int) + kWords * sizeof(std::uint64_t)) +
+           config::CleanupMemoryStorageBytes(Dim, ValueCapacity);
+  }
+
+ private:
+  static constexpr std::size_t kGetBlock = 16;  // keys per GetBatch task and tile call
+
+  static std::size_t ShardCount(std::size_t expected_pairs, std::size_t pairs_per_shard) {
+    const double provisioned = kHoloKVLoadFactor * static_cast<double>(pairs_per_shard);
+    const double shards = std::ceil(static_cast<double>(expected_pairs) / (provisioned < 1.0 ? 1.0 : provisioned));
+    return shards < 1.0 ? 1 : static_cast<std::size_t>(shards);
+  }
+
+  void Store(std::size_t shard, const Vector& key, std::size_t value) {
+    Vector bound;
+    Xor(key, values_.entry(value), &bound);
+    core::AddSignedWords(&sums_[shard * Dim], bound.Words().data(), Dim, 1);
+    ++loads_[shard];
+    stale_[shard] = 1;
+  }
+
+  void Unbind(const Vector& key, Vector* out) const {
+    const std::size_t shard = ShardOf(key);
+    Refresh();
+    Xor(key, memory_[shard], out);
+  }
+
+  static void Xor(const Vector& a, const Vector& b, Vector* out) noexcept {
+    for (std::size_t w = 0; w < kWords; ++w) out->Words()[w] = a.Words()[w] ^ b.Words()[w];
+  }
+
+  std::size_t pairs_per_shard_;
+  std::size_t shards_;
+  std::uint64_t seed_;
+  CleanupMemory<Dim, ValueCapacity> values_;
+  LargeArray<int> sums_;                // shards_ rows of Dim counters
+  mutable LargeArray<Vector> memory_;   // binarized memory vector per shard
+  std::vector<std::size_t> loads_;      // pairs per shard
+  mutable std::vector<char> stale_;     // shard modified since its memory vector was built
+  Vector tie_;                          // tie-break bits for zero counters
+  std::vector<std::size_t> route_;      // PutBatch scratch: shard offsets into order_
+  std::vector<std::size_t> cursor_;     // PutBatch scratch: shard end offsets
+  std::vector<std::size_t> order_;      // PutBatch scratch: pair indices grouped by shard
+  std::vector<std::size_t> shard_of_;   // PutBatch scratch: shard per pair (shards_ = skipped)
+};
+
+}  // namespace memory
+}  // namespace hyperstream
@@ -0,0 +1,241 @@
+#pragma once
+
+// Resonator network: factorizes a bound product s = c_1[i_1] ^ c_2[i_2] ^ ... ^ c_F[i_F] of binary
+// codewords (XOR binding) back into the indices i_f, without enumerating all prod_f M_f
+// combinations. Each factor keeps an estimate, initialized to the majority of its whole codebook.
+// One iteration updates the factors in turn: the other estimates are unbound from s, the result
+// is compared with every codeword of the factor, and the new estimate is the sign of the
+// similarity-weighted superposition sum_i max(0, Dim - 2 * hamming_i) * c_i. Clamping negative
+// (bipolar) similarities to zero, so only positively correlated codewords vote, converges to the
+// right factors markedly more often than the plain projection onto the codebook (e.g. 99% vs 84%
+// of Dim=10000, 3 x 32 codeword problems) and skips about half of the superposition work. A query
+// has converged once the best codewords bind back to s exactly, or once an
+// iteration leaves every estimate unchanged (fixed point, e.g. for noisy queries).
+//
+// Layout and batching: each codebook is one contiguous, 64-byte aligned word matrix. Queries run
+// in lockstep blocks of kResonatorBlock, so the distances of all active queries of a block to a
+// codebook come from one register-tiled HammingTileWords call (memory/hamming_matrix.hpp kernels)
+// instead of one Hamming scan per query; converged queries leave the block. Superpositions use
+// int32 counters via core::AddSignedWords: the bundler's saturating int16 +/-1 counters cannot hold
+// similarity weights. Blocks are executor tasks with private scratch, allocated once per task.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/executor.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+struct ResonatorOptions {
+  std::size_t max_iterations = 64;  // iterations (full passes over the factors) per query; 0 acts as 1
+};
+
+/// Per-query result of Resonator::Factorize.
+struct ResonatorOutcome {
+  std::uint32_t iterations = 0;  // iterations run
+  bool converged = false;        // exact reconstruction or fixed point before max_iterations
+  bool exact = false;            // the returned codewords bind back to the query exactly
+};
+
+inline constexpr std::size_t kResonatorBlock = 16;
+
+/**
+ * @brief Resonator network over F codebooks of binary hypervectors.
+ *
+ * @tparam Dim Hypervector dimension (bits)
+ *
+ * Invariants and behavior:
+ * - Codebooks are appended with AddCodebook(); factor f of a result indexes codebook f.
+ * - Results are deterministic and independent of the executor and of how queries are batched.
+ * - A query without convergence returns the best codewords of its last iteration. Like any
+ *   resonator it can settle on a spurious fixed point (converged, not exact) or cycle; the chance
+ *   grows with prod_f M_f relative to Dim.
+ * - Thread-safety: Factorize/FactorizeBatch are const and reentrant; AddCodebook is not.
+ * - Storage: sum_f M_f * Dim/64 words of codebooks from a LargeAllocator (default heap), plus
+ *   per-task scratch of about kResonatorBlock * (F + 2) vectors and Dim int32 counters.
+ *
+ * Complexity per query iteration: sum_f M_f * Dim/64 distance words plus Dim counter adds per
+ * positively correlated codeword.
+ */
+template <std::size_t Dim>
+class Resonator {
+ public:
+  using Vector = core::HyperVector<Dim, bool>;
+  static constexpr std::size_t kWords = Vector::WordCount();
+
+  Resonator() : Resonator(nullptr) {}
+  /** Codebooks are allocated from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit Resonator(LargeAllocator* alloc) : alloc_(alloc) {}
+
+  /** Appends a codebook of `count` (> 0) codewords; returns its factor index. */
+  std::size_t AddCodebook(const Vector* codewords, std::size_t count) {
+    Codebook book{LargeArray<std::uint64_t>(count * kWords, alloc_), count, Vector{}};
+    std::vector<int> counters(Dim, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto& words = codewords[i].Words();
+      for (std::size_t w = 0; w < kWords; ++w) book.words[i * kWords + w] = words[w];
+      core::AddSignedWords(counters.data(), words.data(), Dim, 1);
+    }
+    core::detail::PackBits(&book.initial, [&counters](std::size_t bit) { return counters[bit] >= 0; });
+    books_.push_back(std::move(book));
+    return books_.size() - 1;
+  }
+
+  [[nodiscard]] std::size_t factors() const noexcept { return books_.size(); }
+  [[nodiscard]] std::size_t codebook_size(std::size_t f) const noexcept { return books_[f].count; }
+  [[nodiscard]] const std::uint64_t* codeword(std::size_t f, std::size_t i) const noexcept {
+    return &books_[f].words[i * kWords];
+  }
+
+  /** out = XOR of codeword(f, indices[f]) over all factors. */
+  void Compose(const std::uint32_t* indices, Vector* out) const {
+    out->Clear();
+    auto& words = out->Words();
+    for (std::size_t f = 0; f < books_.size(); ++f) {
+      const std::uint64_t* c = codeword(f, indices[f]);
+      for (std::size_t w = 0; w < kWords; ++w) words[w] ^= c[w];
+    }
+  }
+
+  /**
+   * @brief Factorizes queries[0..n): indices[q * factors() + f] receives the codeword index of
+   * factor f; outcomes (optional) one ResonatorOutcome per query.
+   *
+   * `tile` has the signature of core::HammingTileWords (pass backend::SelectHammingTileBackend()
+   * for the SIMD kernels); `exec` runs one task per block of kResonatorBlock queries.
+   */
+  template <typename TileFn, typename Executor = SerialExecutor>
+  void FactorizeBatch(const Vector* queries, std::size_t n, std::uint32_t* indices,
+                      ResonatorOutcome* outcomes, const ResonatorOptions& options, TileFn&& tile,
+                      Executor&& exec = Executor{}) const {
+    if (n == 0 || books_.empty()) return;
+    exec((n + kResonatorBlock - 1) / kResonatorBlock, [&](std::size_t t) {
+      const std::size_t q0 = t * kResonatorBlock;
+      const std::size_t bn = (n - q0 < kResonatorBlock) ? n - q0 : kResonatorBlock;
+      SolveBlock(queries + q0, bn, indices + q0 * books_.size(), outcomes ? outcomes + q0 : nullptr,
+                 options, tile);
+    });
+  }
+
+  void FactorizeBatch(const Vector* queries, std::size_t n, std::uint32_t* indices,
+                      ResonatorOutcome* outcomes = nullptr, const ResonatorOptions& options = {}) const {
+    FactorizeBatch(queries, n, indices, outcomes, options, &core::HammingTileWords);
+  }
+
+  /** Single-query convenience wrapper over FactorizeBatch (portable kernel). */
+  ResonatorOutcome Factorize(const Vector& query, std::uint32_t* indices,
+                             const ResonatorOptions& options = {}) const {
+    ResonatorOutcome outcome;
+    FactorizeBatch(&query, 1, indices, &outcome, options);
+    return outcome;
+  }
+
+  static constexpr std::size_t CodebookStorageBytes(std::size_t count) noexcept {
+    return count * kWords * sizeof(std::uint64_t);
+  }
+
+ private:
+  struct Codebook {
+    LargeArray<std::uint64_t> words;  // count rows of kWords
+    std::size_t count;
+    Vector initial;  // majority of the codebook: the starting estimate
+  };
+
+  template <typename TileFn>
+  void SolveBlock(const Vector* queries, std::size_t bn, std::uint32_t* indices,
+                  ResonatorOutcome* outcomes, const ResonatorOptions& options, TileFn& tile) const {
+    const std::size_t nf = books_.size();
+    std::size_t max_count = 0;
+    for (const auto& b : books_) max_count = b.count > max_count ? b.count : max_count;
+    std::vector<Vector> est(bn * nf);   // current estimate of factor f of query q at q * nf + f
+    std::vector<Vector> prod(bn);       // XOR of all estimates of query q
+    std::vector<Vector> unbound(bn);    // query with the other factors' estimates unbound
+    std::vector<std::uint32_t> dist(bn * max_count);
+    std::vector<int> counters(Dim);
+    std::vector<std::size_t> active(bn);
+    std::vector<bool> changed(bn);
+    std::vector<ResonatorOutcome> result(bn);
+    std::vector<const std::uint64_t*> a_ptrs(bn);
+    std::vector<const std::uint64_t*> b_ptrs(max_count);
+    for (std::size_t q = 0; q < bn; ++q) {
+      prod[q].Clear();
+      for (std::size_t f = 0; f < nf; ++f) {
+        est[q * nf + f] = books_[f].initial;
+        Xor(&prod[q], books_[f].initial);
+      }
+      active[q] = q;
+    }
+    const std::size_t max_iterations = options.max_iterations == 0 ? 1 : options.max_iterations;
+    std::size_t na = bn;
+    for (std::size_t it = 0; it < max_iterations && na > 0; ++it) {
+      for (std::size_t k = 0; k < na; ++k) changed[active[k]] = false;
+      for (std::size_t f = 0; f < nf; ++f) {
+        const Codebook& book = books_[f];
+        for (std::size_t k = 0; k < na; ++k) {
+          const std::size_t q = active[k];
+          unbound[k] = queries[q];
+          Xor(&unbound[k], prod[q]);
+          Xor(&unbound[k], est[q * nf + f]);
+          a_ptrs[k] = unbound[k].Words().data();
+        }
+        for (std::size_t i = 0; i < book.count; ++i) b_ptrs[i] = &book.words[i * kWords];
+        tile(a_ptrs.data(), na, b_ptrs.data(), book.count, kWords, dist.data(), book.count);
+        for (std::size_t k = 0; k < na; ++k) {
+          const std::size_t q = active[k];
+          const std::uint32_t* d = &dist[k * book.count];
+          std::fill(counters.begin(), counters.end(), 0);
+          std::size_t best = 0;
+          for (std::size_t i = 0; i < book.count; ++i) {
+            if (d[i] < d[best]) best = i;
+            const int weight = static_cast<int>(Dim) - 2 * static_cast<int>(d[i]);
+            if (weight > 0) core::AddSignedWords(counters.data(), b_ptrs[i], Dim, weight);
+          }
+          indices[q * nf + f] = static_cast<std::uint32_t>(best);
+          Vector next;
+          core::detail::PackBits(&next, [&counters](std::size_t bit) { return counters[bit] >= 0; });
+          Vector& cur = est[q * nf + f];
+          if (next.Words() != cur.Words()) {
+            changed[q] = true;
+            Xor(&prod[q], cur);
+            Xor(&prod[q], next);
+            cur = next;
+          }
+        }
+      }
+      // Retire converged queries; the rest keep their block order.
+      std::size_t kept = 0;
+      for (std::size_t k = 0; k < na; ++k) {
+        const std::size_t q = active[k];
+        ResonatorOutcome& r = result[q];
+        r.iterations = static_cast<std::uint32_t>(it + 1);
+        Vector composed;
+        Compose(&indices[q * nf], &composed);
+        r.exact = composed.Words() == queries[q].Words();
+        r.converged = r.exact || !changed[q];
+        if (!r.converged) active[kept++] = q;
+      }
+      na = kept;
+    }
+    if (outcomes != nullptr) {
+      for (std::size_t q = 0; q < bn; ++q) outcomes[q] = result[q];
+    }
+  }
+
+  static void Xor(Vector* dst, const Vector& src) noexcept {
+    auto& d = dst->Words();
+    const auto& s = src.Words();
+    for (std::size_t w = 0; w < kWords; ++w) d[w] ^= s[w];
+  }
+
+  LargeAllocator* alloc_;
+  std::vector<Codebook> books_;
+};
+
+}  // namespace memory
+}  // namespace hyperstream
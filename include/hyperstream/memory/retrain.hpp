@@ -0,0 +1,135 @@
+#pragma once
+
+// Iterative retraining of ClusterMemory classifiers (perceptron-style prototype refinement).
+// One-shot training bundles every sample into its class once, so classes whose samples overlap
+// keep misclassifying near the boundary. Retraining makes further passes over the training set:
+// each sample is classified against the binarized prototypes and, on a mistake, its hypervector is
+// added to the true class's counters and subtracted from the predicted class's
+// (ClusterMemory::Reinforce); only the touched prototypes are re-binarized. The accumulators are
+// the memory's own counters, so a retrained memory is queried and serialized like any other.
+//
+// Parallelism: the training set is processed in mini-batches. The samples of a batch are classified
+// against the model frozen at the start of the batch (tasks over chunks of samples), then the
+// batch's mistakes are applied by one task per class, each walking them in sample order. Updates
+// are integer additions into disjoint clusters, so the trained memory is identical for every
+// executor and thread count. batch_size = 1 is the classic sequential perceptron; larger batches
+// expose more parallelism at the cost of acting on slightly stale prototypes within a batch.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/executor.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+struct RetrainOptions {
+  std::size_t epochs = 10;          // maximum passes over the training set
+  std::size_t batch_size = 256;     // samples classified against one frozen model (0 acts as 1)
+  int step = 1;                     // counter change per mistake (learning rate)
+  bool stop_when_separated = true;  // stop after an epoch without mistakes
+};
+
+struct RetrainStats {
+  std::vector<std::size_t> mistakes_per_epoch;  // training mistakes seen in each epoch run
+  std::size_t skipped = 0;                      // samples whose label has no cluster (ignored)
+};
+
+namespace detail_retrain {
+
+inline constexpr std::size_t kNoClass = static_cast<std::size_t>(-1);
+// Samples per classification task.
+inline constexpr std::size_t kClassifyChunk = 16;
+
+template <typename View>
+std::size_t ClassIndex(const View& view, std::uint64_t label) {
+  for (std::size_t c = 0; c < view.size; ++c) {
+    if (view.labels[c] == label) return c;
+  }
+  return kNoClass;
+}
+
+}  // namespace detail_retrain
+
+/**
+ * @brief Retrains `memory` on samples[i] with labels[i], i < n, for up to options.epochs epochs.
+ *
+ * Every label should already have a cluster (typically from one Update() pass over the same
+ * data); samples with unknown labels are counted in RetrainStats::skipped and otherwise ignored.
+ * `dist_fn` is the Hamming kernel used for classification (see ClusterMemory::ClassifyBinarized);
+ * `exec` runs the classification and update tasks (memory/executor.hpp).
+ *
+ * Complexity per epoch: O(n * size * Dim/64) distance words plus O(mistakes * Dim) counter updates.
+ */
+template <std::size_t Dim, std::size_t Capacity, typename DistFn, typename Executor = SerialExecutor>
+RetrainStats Retrain(ClusterMemory<Dim, Capacity>& memory, const core::HyperVector<Dim, bool>* samples,
+                     const std::uint64_t* labels, std::size_t n, const RetrainOptions& options,
+                     DistFn&& dist_fn, Executor&& exec = Executor{}) {
+  using detail_retrain::kNoClass;
+  RetrainStats stats;
+  const auto view = memory.view();
+  if (n == 0 || view.size == 0) {
+    return stats;
+  }
+  std::vector<std::size_t> truth(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    truth[i] = detail_retrain::ClassIndex(view, labels[i]);
+    if (truth[i] == kNoClass) ++stats.skipped;
+  }
+  const std::size_t batch = options.batch_size == 0 ? 1 : options.batch_size;
+  std::vector<std::size_t> predicted(batch);
+  std::vector<std::size_t> mistakes;
+  mistakes.reserve(batch);
+  for (std::size_t epoch = 0; epoch < options.epochs; ++epoch) {
+    std::size_t epoch_mistakes = 0;
+    for (std::size_t b0 = 0; b0 < n; b0 += batch) {
+      const std::size_t bn = (n - b0 < batch) ? n - b0 : batch;
+      // With no stale prototype left, concurrent ClassifyBinarized calls only read.
+      memory.RefreshBinarized();
+      const std::size_t chunk = detail_retrain::kClassifyChunk;
+      exec((bn + chunk - 1) / chunk, [&](std::size_t t) {
+        const std::size_t end = (bn - t * chunk < chunk) ? bn : (t + 1) * chunk;
+        for (std::size_t i = t * chunk; i < end; ++i) {
+          predicted[i] = truth[b0 + i] == kNoClass
+                             ? kNoClass
+                             : detail_retrain::ClassIndex(view, memory.ClassifyBinarized(samples[b0 + i], dist_fn));
+        }
+      });
+      mistakes.clear();
+      for (std::size_t i = 0; i < bn; ++i) {
+        if (truth[b0 + i] != kNoClass && predicted[i] != truth[b0 + i]) mistakes.push_back(i);
+      }
+      epoch_mistakes += mistakes.size();
+      if (mistakes.empty()) continue;
+      exec(view.size, [&](std::size_t c) {
+        for (const std::size_t i : mistakes) {
+          if (truth[b0 + i] == c) {
+            (void)memory.Reinforce(view.labels[c], samples[b0 + i], options.step);
+          } else if (predicted[i] == c) {
+            (void)memory.Reinforce(view.labels[c], samples[b0 + i], -options.step);
+          }
+        }
+      });
+    }
+    stats.mistakes_per_epoch.push_back(epoch_mistakes);
+    if (options.stop_when_separated && epoch_mistakes == 0) break;
+  }
+  return stats;
+}
+
+template <std::size_t Dim, std::size_t Capacity>
+RetrainStats Retrain(ClusterMemory<Dim, Capacity>& memory, const core::HyperVector<Dim, bool>* samples,
+                     const std::uint64_t* labels, std::size_t n, const RetrainOptions& options = {}) {
+  return Retrain(
+      memory, samples, labels, n, options,
+      [](const core::HyperVector<Dim, bool>& a, const core::HyperVector<Dim, bool>& b) {
+        return core::HammingDistance(a, b);
+      });
+}
+
+}  // namespace memory
+}  // namespace hyperstream
@@ -0,0 +1,265 @@
+#pragma once
+
+// Sequence prediction memory: learns "after these Window symbols comes symbol s" from a symbol
+// stream and predicts the next symbol of the current context.
+//
+// The context is the n-gram hypervector of encoding::SequentialNGramEncoder,
+// ctx_t = H(s_t) ^ rho(H(s_t-1)) ^ ... ^ rho^(Window-1)(H(s_t-Window+1)), with rho a one-bit
+// rotation and H the seeded random symbol vectors of the encoders. It is maintained incrementally:
+// ctx_t+1 = H(s_t+1) ^ rho(ctx_t ^ rho^(Window-1)(H(s_t-Window+1))), where the rotated vector of
+// each symbol in the window is kept from when it entered, so a step costs one symbol vector and
+// one rotation instead of Window of each.
+//
+// Storage forms:
+// - kBundled: the pairs ctx ^ H(next) are bundled into a HoloKVStore (memory/holo_kv.hpp);
+//   prediction unbinds the context and restores the nearest symbol vector. Scales with the number
+//   of distinct contexts via sharding (HoloKVOptions::expected_pairs counts stored pairs).
+// - kPrototype: each symbol owns a ClusterMemory prototype bundling the contexts it followed;
+//   prediction is the nearest prototype. No per-context state, but each prototype must separate
+//   all contexts that precede its symbol, so it suits few contexts per symbol.
+//
+// By default learning is mistake-driven: a pair is stored only when the memory currently
+// mispredicts it. Storing every observation lets frequent contexts dominate the majority of a
+// shard or prototype and erase rare ones; on an order-3 source over 16 symbols with 10% noise,
+// Dim=2048 bundled storage predicts 92% correctly instead of 79% (prototype storage: 84% vs 71%).
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/executor.hpp"
+#include "hyperstream/memory/holo_kv.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+enum class SequenceStorage { kBundled, kPrototype };
+
+struct SequenceMemoryOptions {
+  std::uint64_t seed = 0x27d4eb2f165667c5ULL;  // symbol vectors (SequentialNGramEncoder default)
+  HoloKVOptions bundled{};                     // kBundled: shard sizing
+  bool learn_on_error = true;                  // store a pair only when it is mispredicted
+};
+
+/**
+ * @brief Next-symbol predictor over n-gram contexts of Window symbols.
+ *
+ * @tparam Dim            Hypervector dimension (bits)
+ * @tparam Window         Context length in symbols (> 0)
+ * @tparam SymbolCapacity Maximum number of distinct predicted symbols
+ * @tparam Storage        kBundled (HoloKVStore) or kPrototype (ClusterMemory)
+ *
+ * Invariants and behavior:
+ * - Observe(s) learns (current context -> s) once Window symbols have been seen (only when
+ *   mispredicted, with learn_on_error), then appends s to the context; Advance(s) only appends.
+ *   Contexts may contain symbols that are never learned.
+ * - Predict() returns kNoPrediction until the context holds Window symbols or while nothing has
+ *   been learned; otherwise some learned symbol.
+ * - PredictSequence() equals Predict() followed by Advance() per symbol, for any executor.
+ * - Thread-safety: not thread-safe; PredictSequence parallelizes internally through the executor.
+ *
+ * Complexity per symbol: O(Dim/64) context update; learning adds O(Dim) counter updates;
+ * prediction costs O(symbols * Dim/64) distance words (plus O(Dim) per stale shard/prototype).
+ * With learn_on_error (the default) every Observe() with a full context also pays a Predict():
+ * for kBundled a HoloKVStore::Get, i.e. a Refresh of the key's shard when a pair was stored since
+ * its last read plus the scan of all learned symbol vectors. Mistake-driven learning therefore
+ * makes learning cost about one lookup per symbol even once few pairs are stored (sequence_bench,
+ * Dim=2048 bundled: ~6x fewer Observe calls/sec than learn_on_error = false, which stores every
+ * pair without the lookup).
+ */
+template <std::size_t Dim, std::size_t Window, std::size_t SymbolCapacity,
+          SequenceStorage Storage = SequenceStorage::kBundled>
+class SequenceMemory {
+ public:
+  static_assert(Window > 0, "SequenceMemory requires Window > 0");
+  using Vector = core::HyperVector<Dim, bool>;
+  static constexpr std::uint64_t kNoPrediction = static_cast<std::uint64_t>(-1);
+
+  SequenceMemory() : SequenceMemory(SequenceMemoryOptions{}) {}
+  /** Allocates the store from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit SequenceMemory(const SequenceMemoryOptions& options, LargeAllocator* alloc = nullptr)
+      : seed_(options.seed), learn_on_error_(options.learn_on_error), store_(MakeStore(options, alloc)) {
+    ResetContext();
+  }
+
+  /** Forgets the context (not the learned pairs), e.g. between independent streams. */
+  void ResetContext() {
+    context_.Clear();
+    head_ = 0;
+    count_ = 0;
+  }
+
+  /**
+   * @brief Learns (context -> symbol) when the context is full, then advances the context.
+   * Returns false if the pair could not be stored (SymbolCapacity distinct symbols reached).
+   */
+  bool Observe(std::uint64_t symbol) {
+    Vector hv;
+    encoding::detail::GenerateRandomHypervector(seed_, symbol, &hv);
+    bool stored = true;
+    if (count_ == Window && (!learn_on_error_ || Predict() != symbol)) stored = Learn(symbol, hv);
+    Push(hv);
+    return stored;
+  }
+
+  /** Appends `symbol` to the context without learning. */
+  void Advance(std::uint64_t symbol) {
+    Vector hv;
+    encoding::detail::GenerateRandomHypervector(seed_, symbol, &hv);
+    Push(hv);
+  }
+
+  /** Most likely next symbol for the current context, or kNoPrediction. */
+  std::uint64_t Predict() const {
+    if (count_ < Window) return kNoPrediction;
+    if constexpr (Storage == SequenceStorage::kBundled) {
+      const std::size_t index = store_.Get(context_);
+      return index == store_.kNotFound ? kNoPrediction : symbols_[index];
+    } else {
+      return store_.ClassifyBinarized(context_, kNoPrediction);
+    }
+  }
+
+  /**
+   * @brief predicted[i] = the prediction made just before symbols[i] is appended, for i < n;
+   * advances the context through the whole sequence without learning. Contexts are built
+   * serially; lookups run in blocks through `tile` (signature of core::HammingTileWords, e.g.
+   * backend::SelectHammingTileBackend()) and `exec`.
+   */
+  template <typename TileFn, typename Executor = SerialExecutor>
+  void PredictSequence(const std::uint64_t* symbols, std::size_t n, std::uint64_t* predicted,
+                       TileFn&& tile, Executor&& exec = Executor{}) {
+    contexts_.clear();
+    positions_.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+      predicted[i] = kNoPrediction;
+      if (count_ == Window) {
+        contexts_.push_back(context_);
+        positions_.push_back(i);
+      }
+      Advance(symbols[i]);
+    }
+    const std::size_t m = contexts_.size();
+    if (m == 0) return;
+    if constexpr (Storage == SequenceStorage::kBundled) {
+      found_.resize(m);
+      store_.GetBatch(contexts_.data(), m, found_.data(), tile, exec);
+      for (std::size_t k = 0; k < m; ++k) {
+        if (found_[k] != store_.kNotFound) predicted[positions_[k]] = symbols_[found_[k]];
+      }
+    } else {
+      const std::size_t np = store_.size();
+      if (np == 0) return;
+      store_.RefreshBinarized();
+      std::vector<const std::uint64_t*> protos(np);
+      for (std::size_t p = 0; p < np; ++p) protos[p] = store_.prototype(p).Words().data();
+      const std::uint64_t* labels = store_.view().labels;
+      exec((m + kPredictBlock - 1) / kPredictBlock, [&](std::size_t t) {
+        const std::size_t k0 = t * kPredictBlock;
+        const std::size_t bn = (m - k0 < kPredictBlock) ? m - k0 : kPredictBlock;
+        const std::uint64_t* a_ptrs[kPredictBlock];
+        for (std::size_t k = 0; k < bn; ++k) a_ptrs[k] = contexts_[k0 + k].Words().data();
+        std::vector<std::uint32_t> dist(bn * np);
+        tile(a_ptrs, bn, protos.data(), np, Vector::WordCount(), dist.data(), np);
+        for (std::size_t k = 0; k < bn; ++k) {
+          const std::uint32_t* d = &dist[k * np];
+          std::size_t best = 0;
+          for (std::size_t p = 1; p < np; ++p) best = d[p] < d[best] ? p : best;
+          predicted[positions_[k0 + k]] = labels[best];
+        }
+      });
+    }
+  }
+
+  void PredictSequence(const std::uint64_t* symbols, std::size_t n, std::uint64_t* predicted) {
+    PredictSequence(symbols, n, predicted, &core::HammingTileWords);
+  }
+
+  /** Current context vector (meaningful once context_size() == Window). */
+  [[nodiscard]] const Vector& context() const noexcept { return context_; }
+  [[nodiscard]] std::size_t context_size() const noexcept { return count_; }
+  /** Distinct symbols learned as successors. */
+  [[nodiscard]] std::size_t symbol_count() const {
+    if constexpr (Storage == SequenceStorage::kBundled) {
+      return symbols_.size();
+    } else {
+      return store_.size();
+    }
+  }
+  /** The underlying HoloKVStore or ClusterMemory. */
+  [[nodiscard]] const auto& store() const noexcept { return store_; }
+
+ private:
+  using Store = std::conditional_t<Storage == SequenceStorage::kBundled, HoloKVStore<Dim, SymbolCapacity>,
+                                   ClusterMemory<Dim, SymbolCapacity>>;
+  static constexpr std::size_t kPredictBlock = 16;  // contexts per kPrototype PredictSequence task
+
+  static Store MakeStore(const SequenceMemoryOptions& options, LargeAllocator* alloc) {
+    if constexpr (Storage == SequenceStorage::kBundled) {
+      return Store(options.bundled, alloc);
+    } else {
+      return Store(alloc);
+    }
+  }
+
+  bool Learn(std::uint64_t symbol, const Vector& hv) {
+    if constexpr (Storage == SequenceStorage::kBundled) {
+      // Linear symbol lookup, like ClusterMemory labels: alphabets are small next to Dim work.
+      std::size_t index = 0;
+      while (index < symbols_.size() && symbols_[index] != symbol) ++index;
+      if (index == symbols_.size()) {
+        if (store_.AddValue(hv) == store_.kNotFound) return false;
+        symbols_.push_back(symbol);
+      }
+      return store_.Put(context_, index);
+    } else {
+      return store_.Update(symbol, context_);
+    }
+  }
+
+  // Slides the window: drops the oldest symbol's rotated vector, rotates, binds the new symbol.
+  void Push(const Vector& hv) {
+    Vector rotated;
+    if (count_ == Window) {
+      Xor(&context_, oldest_[head_]);
+      core::PermuteRotate(context_, 1, &rotated);
+      context_ = rotated;
+    } else if (count_ > 0) {
+      core::PermuteRotate(context_, 1, &rotated);
+      context_ = rotated;
+      ++count_;
+    } else {
+      ++count_;
+    }
+    Xor(&context_, hv);
+    // hv reaches position Window-1 (rho^(Window-1)) just before it leaves the window.
+    core::PermuteRotate(hv, Window - 1, &oldest_[head_]);
+    head_ = (head_ + 1) % Window;
+  }
+
+  static void Xor(Vector* dst, const Vector& src) noexcept {
+    for (std::size_t w = 0; w < Vector::WordCount(); ++w) dst->Words()[w] ^= src.Words()[w];
+  }
+
+  std::uint64_t seed_;
+  bool learn_on_error_;
+  Store store_;
+  std::vector<std::uint64_t> symbols_;    // kBundled: symbol id per codebook index
+  Vector context_;
+  std::array<Vector, Window> oldest_{};   // rho^(Window-1)(H(s)) per window slot (ring)
+  std::size_t head_ = 0;                  // ring slot of the oldest symbol once full
+  std::size_t count_ = 0;                 // symbols in the context (<= Window)
+  std::vector<Vector> contexts_;          // PredictSequence scratch
+  std::vector<std::size_t> positions_;    // PredictSequence scratch
+  std::vector<std::size_t> found_;        // PredictSequence scratch (kBundled)
+};
+
+}  // namespace memory
+}  // namespace hyperstream
@@ -0,0 +1,247 @@
+#pragma once
+
+// Bit-transposed (vertical) prototype memory for many-prototype Hamming search.
+// Prototypes are stored in groups of 64: word i of a group's plane block holds bit i of its 64
+// prototypes (bit k = prototype 64*group + k). Classify walks the query bits once per group; each
+// query bit turns one plane word into a 64-lane mismatch mask, and the masks of 16 dimensions are
+// summed with a carry-save tree into 64 bit-sliced distance counters (one uint64 per counter bit).
+// Because every lane's partial distance is a lower bound of its final distance, lanes at or above
+// the best distance found in earlier groups are masked off periodically, and a group stops early
+// once none is left. Best suited to small Dim and many prototypes, where the row-major scan pays
+// per-entry call and reduction overhead for only a few words each.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/metrics.hpp"
+
+namespace hyperstream {
+namespace memory {
+
+namespace detail_transposed {
+
+constexpr std::size_t BitWidth(std::size_t x) noexcept {
+  std::size_t n = 0;
+  while (x != 0) {
+    ++n;
+    x >>= 1;
+  }
+  return n;
+}
+
+inline std::size_t LowestLane(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_ctzll(x));
+#else
+  std::size_t n = 0;
+  while ((x & 1ULL) == 0ULL) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// Carry-save adder: (high, low) = a + b + c per bit.
+inline void Csa(std::uint64_t* high, std::uint64_t* low, std::uint64_t a, std::uint64_t b,
+                std::uint64_t c) noexcept {
+  const std::uint64_t u = a ^ b;
+  *high = (a & b) | (u & c);
+  *low = u ^ c;
+}
+
+// Adds the per-lane population of 16 masks to the bit-sliced counter c[0..K). The masks are first
+// reduced to a 5-bit count with a Harley-Seal carry-save tree, then added with one branch-free
+// ripple over the counter planes (a per-mask ripple carry mispredicts on every add).
+template <std::size_t K>
+inline void AddCount16(const std::array<std::uint64_t, 16>& x,
+                       std::array<std::uint64_t, K>* c) noexcept {
+  std::uint64_t ones = 0, twos = 0, fours = 0, eights = 0, sixteens = 0;
+  std::uint64_t twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+  Csa(&twos_a, &ones, ones, x[0], x[1]);
+  Csa(&twos_b, &ones, ones, x[2], x[3]);
+  Csa(&fours_a, &twos, twos, twos_a, twos_b);
+  Csa(&twos_a, &ones, ones, x[4], x[5]);
+  Csa(&twos_b, &ones, ones, x[6], x[7]);
+  Csa(&fours_b, &twos, twos, twos_a, twos_b);
+  Csa(&eights_a, &fours, fours, fours_a, fours_b);
+  Csa(&twos_a, &ones, ones, x[8], x[9]);
+  Csa(&twos_b, &ones, ones, x[10], x[11]);
+  Csa(&fours_a, &twos, twos, twos_a, twos_b);
+  Csa(&twos_a, &ones, ones, x[12], x[13]);
+  Csa(&twos_b, &ones, ones, x[14], x[15]);
+  Csa(&fours_b, &twos, twos, twos_a, twos_b);
+  Csa(&eights_b, &fours, fours, fours_a, fours_b);
+  Csa(&sixteens, &eights, eights, eights_a, eights_b);
+  const std::uint64_t sum[5] = {ones, twos, fours, eights, sixteens};
+  std::uint64_t carry = 0;
+  for (std::size_t k = 0; k < K; ++k) {
+    const std::uint64_t a = (*c)[k];
+    const std::uint64_t b = k < 5 ? sum[k] : 0ULL;
+    const std::uint64_t u = a ^ b;
+    (*c)[k] = u ^ carry;
+    carry = (a & b) | (u & carry);
+  }
+}
+
+// Lanes whose bit-sliced counter (planes c[0..K)) is >= t (t < 2^K).
+template <std::size_t K>
+inline std::uint64_t LanesAtLeast(const std::array<std::uint64_t, K>& c, std::size_t t) noexcept {
+  std::uint64_t gt = 0;
+  std::uint64_t eq = ~0ULL;
+  for (std::size_t k = K; k-- > 0;) {
+    if ((t >> k) & 1U) {
+      eq &= c[k];
+    } else {
+      gt |= eq & c[k];
+      eq &= ~c[k];
+    }
+  }
+  return gt | eq;
+}
+
+// Smallest counter value among `lanes` (non-zero) and the lowest lane holding it.
+template <std::size_t K>
+inline std::size_t MinLane(const std::array<std::uint64_t, K>& c, std::uint64_t lanes,
+                           std::size_t* lane) noexcept {
+  std::size_t value = 0;
+  for (std::size_t k = K; k-- > 0;) {
+    const std::uint64_t zero = lanes & ~c[k];
+    if (zero != 0ULL) {
+      lanes = zero;
+    } else {
+      value |= std::size_t{1} << k;
+    }
+  }
+  *lane = LowestLane(lanes);
+  return value;
+}
+
+}  // namespace detail_transposed
+
+/**
+ * @brief Prototype memory in bit-transposed layout with a vertical-counter Hamming engine.
+ *
+ * @tparam Dim      Hypervector dimension (bits)
+ * @tparam Capacity Maximum number of (prototype,label) entries; no eviction policy.
+ *
+ * Invariants and behavior:
+ * - Classify returns the same label as PrototypeMemory::Classify over the same entries in the
+ *   same order (nearest by Hamming distance, first entry on ties; default_label when empty).
+ * - Built from a PrototypeMemory (constructor or Assign) or filled with Learn().
+ * - Thread-safety: not thread-safe. External synchronization is required for concurrent access.
+ * - Storage: ceil(Capacity/64) * Dim plane words plus Capacity labels from a LargeAllocator
+ *   (default heap); the allocator must outlive the memory. Move-only.
+ *
+ * Complexity:
+ * - Learn: O(Dim/64 + popcount(hv)) scattered bit sets
+ * - Classify: O(ceil(size/64) * Dim) word ops, cut short per group by the pruning bound
+ */
+template <std::size_t Dim, std::size_t Capacity>
+class TransposedPrototypeMemory {
+ public:
+  static constexpr std::size_t kLanes = 64;
+  static constexpr std::size_t kGroups = (Capacity + kLanes - 1) / kLanes;
+  static constexpr std::size_t kCounterBits = detail_transposed::BitWidth(Dim);
+  // Query words between pruning checks.
+  static constexpr std::size_t kPruneEveryWords = 2;
+
+  TransposedPrototypeMemory() : TransposedPrototypeMemory(nullptr) {}
+  /** Allocates plane and label storage from `alloc` (nullptr selects DefaultAllocator()). */
+  explicit TransposedPrototypeMemory(LargeAllocator* alloc)
+      : planes_(kGroups * Dim, alloc), labels_(Capacity, alloc) {}
+  explicit TransposedPrototypeMemory(const PrototypeMemory<Dim, Capacity>& source,
+                                     LargeAllocator* alloc = nullptr)
+      : TransposedPrototypeMemory(alloc) {
+    Assign(source);
+  }
+
+  /** Replaces the contents with the entries of `source`, in order. */
+  void Assign(const PrototypeMemory<Dim, Capacity>& source) {
+    for (std::size_t i = 0; i < kGroups * Dim; ++i) planes_[i] = 0;
+    size_ = 0;
+    const auto* entries = source.data();
+    for (std::size_t i = 0; i < source.size(); ++i) (void)Learn(entries[i].label, entries[i].hv);
+  }
+
+  bool Learn(std::uint64_t label, const core::HyperVector<Dim, bool>& hv) {
+    if (size_ >= Capacity) {
+      return false;
+    }
+    std::uint64_t* planes = &planes_[(size_ / kLanes) * Dim];
+    const std::uint64_t lane_bit = 1ULL << (size_ % kLanes);
+    const auto& words = hv.Words();
+    for (std::size_t w = 0; w < words.size(); ++w) {
+      std::uint64_t word = words[w];
+      while (word != 0ULL) {
+        planes[w * 64 + detail_transposed::LowestLane(word)] |= lane_bit;
+        word &= word - 1;
+      }
+    }
+    labels_[size_] = label;
+    ++size_;
+    return true;
+  }
+
+  std::uint64_t Classify(const core::HyperVector<Dim, bool>& query,
+                         std::uint64_t default_label = 0) const {
+    HS_METRIC_TIMER(Classify);
+    HS_METRIC_INC(PrototypeClassifyCalls);
+    HS_METRIC_ADD(PrototypeScannedEntries, size_);
+    if (size_ == 0) {
+      return default_label;
+    }
+    constexpr std::size_t kWords = core::HyperVector<Dim, bool>::WordCount();
+    const auto& qw = query.Words();
+    std::size_t best = Dim + 1;  // sentinel: nothing found yet, prunes nothing
+    std::size_t best_index = 0;
+    for (std::size_t g = 0; g * kLanes < size_; ++g) {
+      const std::size_t lanes = (size_ - g * kLanes < kLanes) ? size_ - g * kLanes : kLanes;
+      std::uint64_t alive = lanes == kLanes ? ~0ULL : (1ULL << lanes) - 1ULL;
+      std::array<std::uint64_t, kCounterBits> counter{};
+      const std::uint64_t* planes = &planes_[g * Dim];
+      for (std::size_t w = 0; w < kWords && alive != 0ULL; ++w) {
+        const std::uint64_t q = qw[w];
+        const std::size_t nb = (Dim - w * 64 < 64) ? Dim - w * 64 : 64;
+        for (std::size_t b0 = 0; b0 < nb; b0 += 16) {
+          // Mismatch lanes per dimension: plane bit differs from the broadcast query bit.
+          std::array<std::uint64_t, 16> x{};
+          const std::size_t n = (nb - b0 < 16) ? nb - b0 : 16;
+          for (std::size_t i = 0; i < n; ++i) {
+            x[i] = (planes[w * 64 + b0 + i] ^ (0ULL - ((q >> (b0 + i)) & 1ULL))) & alive;
+          }
+          detail_transposed::AddCount16(x, &counter);
+        }
+        // Lanes already at the best distance can at most tie, and ties go to the earlier group.
+        if (best <= Dim && (w + 1) % kPruneEveryWords == 0) {
+          alive &= ~detail_transposed::LanesAtLeast(counter, best);
+        }
+      }
+      if (alive == 0ULL) continue;
+      std::size_t lane = 0;
+      const std::size_t dist = detail_transposed::MinLane(counter, alive, &lane);
+      if (dist < best) {
+        best = dist;
+        best_index = g * kLanes + lane;
+      }
+    }
+    return labels_[best_index];
+  }
+
+  std::size_t size() const {
+    return size_;
+  }
+  [[nodiscard]] std::uint64_t label(std::size_t index) const noexcept { return labels_[index]; }
+
+ private:
+  LargeArray<std::uint64_t> planes_;
+  LargeArray<std::uint64_t> labels_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace memory
+}  // namespace hyperstream
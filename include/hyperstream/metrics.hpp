@@ -0,0 +1,286 @@
+#pragma once
+
+// HyperStream hot-path metrics: per-op counters and HDR-style latency histograms.
+//
+// Opt-in at compile time with HYPERSTREAM_ENABLE_METRICS (CMake: -DHYPERSTREAM_ENABLE_METRICS=ON).
+// When disabled, the HS_METRIC_* macros expand to nothing, so instrumented code compiles to the
+// same instructions as before; the snapshot API remains available and reports enabled=false.
+//
+// When enabled:
+// - Counters are process-wide relaxed atomics, one cache line each (no false sharing between
+//   counters updated from different threads).
+// - Latency histograms are log-linear (8 sub-buckets per power of two, <=12.5% relative error,
+//   exact below 8 ns) over steady_clock nanoseconds, as in HdrHistogram with 1 significant digit.
+// - SnapshotNdjson() renders one JSON object per line, matching the bench NDJSON style.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace hyperstream {
+namespace metrics {
+
+#if defined(HYPERSTREAM_ENABLE_METRICS)
+static constexpr bool kEnabled = true;
+#else
+static constexpr bool kEnabled = false;
+#endif
+
+/** Monotonic event counters. Bind/Hamming selection counters are ordered like BackendKind. */
+enum class Counter : std::uint8_t {
+  PrototypeClassifyCalls = 0,
+  PrototypeScannedEntries,
+  CleanupRestoreCalls,
+  CleanupScannedEntries,
+  ClusterUpdates,
+  BundlerAccumulates,
+  BundlerFinalizes,
+  BundlerSaturatedCounters,  ///< counters at the int16 clamp, summed over Finalize calls
+  BindSelectScalar,
+  BindSelectSSE2,
+  BindSelectAVX2,
+  BindSelectNEON,
+  HammingSelectScalar,
+  HammingSelectSSE2,
+  HammingSelectAVX2,
+  HammingSelectNEON,
+  SerializeSaves,
+  SerializeLoads,
+  TokenCacheHits,
+  TokenCacheMisses,
+  TokenCacheEvictions,
+  kCount
+};
+
+/** Operations with latency histograms. */
+enum class Op : std::uint8_t { Encode = 0, Classify, Update, Finalize, Serialize, kCount };
+
+inline const char* GetCounterName(Counter c) {
+  static constexpr const char* kNames[] = {
+      "prototype_classify_calls", "prototype_scanned_entries", "cleanup_restore_calls",
+      "cleanup_scanned_entries",  "cluster_updates",           "bundler_accumulates",
+      "bundler_finalizes",        "bundler_saturated_counters", "bind_select_scalar",
+      "bind_select_sse2",         "bind_select_avx2",          "bind_select_neon",
+      "hamming_select_scalar",    "hamming_select_sse2",       "hamming_select_avx2",
+      "hamming_select_neon",      "serialize_saves",           "serialize_loads",
+      "token_cache_hits",         "token_cache_misses",        "token_cache_evictions"};
+  static_assert(sizeof(kNames) / sizeof(kNames[0]) == static_cast<std::size_t>(Counter::kCount),
+                "counter names out of sync");
+  return kNames[static_cast<std::size_t>(c)];
+}
+
+inline const char* GetOpName(Op op) {
+  static constexpr const char* kNames[] = {"encode", "classify", "update", "finalize", "serialize"};
+  static_assert(sizeof(kNames) / sizeof(kNames[0]) == static_cast<std::size_t>(Op::kCount),
+                "op names out of sync");
+  return kNames[static_cast<std::size_t>(op)];
+}
+
+/**
+ * @brief Lock-free log-linear latency histogram (values in nanoseconds).
+ *
+ * Bucket i < 8 holds exactly value i; above that each power-of-two range [2^e, 2^(e+1)) is split
+ * into 8 equal sub-buckets. Values of 2^44 ns (~4.9 h) and above land in the last bucket.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr unsigned kSubBucketBits = 3;
+  static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+  static constexpr unsigned kMaxShift = 40;
+  static constexpr std::size_t kBuckets = (kMaxShift + 2) * kSubBuckets;
+
+  void Record(std::uint64_t ns) noexcept {
+    buckets_[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+    std::uint64_t cur = max_.load(std::memory_order_relaxed);
+    while (ns > cur && !max_.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  void Reset() noexcept {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::uint64_t sum() const noexcept { return sum_.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+  /** Upper bound (inclusive) of the bucket containing quantile q in [0,1]; 0 when empty. */
+  [[nodiscard]] std::uint64_t ValueAtQuantile(double q) const noexcept {
+    const std::uint64_t n = count();
+    if (n == 0) return 0;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+    std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(n));
+    if (rank == 0) rank = 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen >= rank) {
+        const std::uint64_t hi = BucketUpperBound(i);
+        const std::uint64_t mx = max();
+        return hi < mx ? hi : mx;
+      }
+    }
+    return max();
+  }
+
+  static std::size_t BucketIndex(std::uint64_t v) noexcept {
+    if (v < kSubBuckets) return static_cast<std::size_t>(v);
+    const unsigned msb = HighestBit(v);
+    const unsigned shift = msb - kSubBucketBits;
+    if (shift > kMaxShift) return kBuckets - 1;
+    const std::size_t sub = static_cast<std::size_t>((v >> shift) & (kSubBuckets - 1));
+    return (static_cast<std::size_t>(shift) + 1) * kSubBuckets + sub;
+  }
+
+  static std::uint64_t BucketUpperBound(std::size_t i) noexcept {
+    if (i < kSubBuckets) return i;
+    const unsigned shift = static_cast<unsigned>(i / kSubBuckets) - 1;
+    const std::uint64_t lower = (kSubBuckets + (i % kSubBuckets)) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1);
+  }
+
+ private:
+  static unsigned HighestBit(std::uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+    unsigned b = 0;
+    while (v >>= 1) ++b;
+    return b;
+#endif
+  }
+
+  std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::uint64_t> sum_{0};
+  std::atomic<std::uint64_t> max_{0};
+};
+
+/** Process-wide metrics registry. Only referenced by instrumented code when metrics are enabled. */
+class Registry {
+ public:
+  static Registry& Instance() {
+    static Registry instance;
+    return instance;
+  }
+
+  void Add(Counter c, std::uint64_t n) noexcept {
+    counters_[static_cast<std::size_t>(c)].value.fetch_add(n, std::memory_order_relaxed);
+  }
+  [[nodiscard]] std::uint64_t Get(Counter c) const noexcept {
+    return counters_[static_cast<std::size_t>(c)].value.load(std::memory_order_relaxed);
+  }
+  LatencyHistogram& Histogram(Op op) noexcept { return histograms_[static_cast<std::size_t>(op)]; }
+  const LatencyHistogram& Histogram(Op op) const noexcept {
+    return histograms_[static_cast<std::size_t>(op)];
+  }
+
+  void Reset() noexcept {
+    for (auto& c : counters_) c.value.store(0, std::memory_order_relaxed);
+    for (auto& h : histograms_) h.Reset();
+  }
+
+ private:
+  Registry() = default;
+  struct alignas(64) PaddedCounter {
+    std::atomic<std::uint64_t> value{0};
+  };
+  std::array<PaddedCounter, static_cast<std::size_t>(Counter::kCount)> counters_{};
+  std::array<LatencyHistogram, static_cast<std::size_t>(Op::kCount)> histograms_{};
+};
+
+/** Records the lifetime of the enclosing scope into the histogram of `op`. */
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Op op) noexcept : op_(op), t0_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer() {
+    const auto dt = std::chrono::steady_clock::now() - t0_;
+    Registry::Instance().Histogram(op_).Record(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count()));
+  }
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  Op op_;
+  std::chrono::steady_clock::time_point t0_;
+};
+
+/**
+ * @brief Renders all counters and non-empty histograms as NDJSON.
+ *
+ * Lines:
+ *   {"name":"metrics/counter","metric":"<counter>","value":N}
+ *   {"name":"metrics/latency","op":"<op>","count":N,"sum_ns":S,"p50_ns":..,"p90_ns":..,
+ *    "p99_ns":..,"p999_ns":..,"max_ns":..}
+ * When metrics are compiled out, a single {"name":"metrics","enabled":false} line is returned.
+ */
+inline std::string SnapshotNdjson() {
+  std::string out;
+  char line[256];
+  if (!kEnabled) {
+    out = "{\"name\":\"metrics\",\"enabled\":false}\n";
+    return out;
+  }
+  const Registry& r = Registry::Instance();
+  for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::kCount); ++i) {
+    const Counter c = static_cast<Counter>(i);
+    std::snprintf(line, sizeof(line), "{\"name\":\"metrics/counter\",\"metric\":\"%s\",\"value\":%llu}\n",
+                  GetCounterName(c), static_cast<unsigned long long>(r.Get(c)));
+    out += line;
+  }
+  for (std::size_t i = 0; i < static_cast<std::size_t>(Op::kCount); ++i) {
+    const Op op = static_cast<Op>(i);
+    const LatencyHistogram& h = r.Histogram(op);
+    if (h.count() == 0) continue;
+    std::snprintf(line, sizeof(line),
+                  "{\"name\":\"metrics/latency\",\"op\":\"%s\",\"count\":%llu,\"sum_ns\":%llu,"
+                  "\"p50_ns\":%llu,\"p90_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu}\n",
+                  GetOpName(op), static_cast<unsigned long long>(h.count()),
+                  static_cast<unsigned long long>(h.sum()),
+                  static_cast<unsigned long long>(h.ValueAtQuantile(0.50)),
+                  static_cast<unsigned long long>(h.ValueAtQuantile(0.90)),
+                  static_cast<unsigned long long>(h.ValueAtQuantile(0.99)),
+                  static_cast<unsigned long long>(h.ValueAtQuantile(0.999)),
+                  static_cast<unsigned long long>(h.max()));
+    out += line;
+  }
+  return out;
+}
+
+/** Clears all counters and histograms (no-op semantics when compiled out). */
+inline void ResetAll() noexcept {
+  if (kEnabled) Registry::Instance().Reset();
+}
+
+}  // namespace metrics
+}  // namespace hyperstream
+
+// Instrumentation macros (compile to nothing unless HYPERSTREAM_ENABLE_METRICS is defined).
+#define HS_METRIC_CONCAT_INNER(a, b) a##b
+#define HS_METRIC_CONCAT(a, b) HS_METRIC_CONCAT_INNER(a, b)
+#if defined(HYPERSTREAM_ENABLE_METRICS)
+#define HS_METRIC_ADD(counter, n)                                        \
+  ::hyperstream::metrics::Registry::Instance().Add(                     \
+      ::hyperstream::metrics::Counter::counter, static_cast<std::uint64_t>(n))
+#define HS_METRIC_ADD_AT(counter_enum_value, n) \
+  ::hyperstream::metrics::Registry::Instance().Add(counter_enum_value, static_cast<std::uint64_t>(n))
+#define HS_METRIC_TIMER(op)                                              \
+  ::hyperstream::metrics::ScopedTimer HS_METRIC_CONCAT(hs_metric_timer_, __LINE__)( \
+      ::hyperstream::metrics::Op::op)
+#else
+#define HS_METRIC_ADD(counter, n) ((void)0)
+#define HS_METRIC_ADD_AT(counter_enum_value, n) ((void)0)
+#define HS_METRIC_TIMER(op) ((void)0)
+#endif
+#define HS_METRIC_INC(counter) HS_METRIC_ADD(counter, 1)
@@ -13,6 +13,37 @@ REQ_CLUSTER = [
     "sample_index","warmup_ms","measure_ms"
 ]
 
+REQ_APP = [
+    "name","dim_bits","classes","events_per_iter","iters","secs",
+    "events_per_sec","accuracy","model_bytes","sample_index","warmup_ms","measure_ms"
+]
+
+# Streaming-kernel benches (bind/hamming/permute) share one row shape from the harness.
+REQ_KERNEL = [
+    "name","dim_bits","bytes_per_iter","iters","secs","gb_per_sec",
+    "sample_index","warmup_ms","measure_ms"
+]
+KERNEL_BENCHES = ("hamming_bench", "bind_bench", "permute_bench")
+
+# bundler_bench timed rows (accumulate/finalize/finalize_stats); Bundler/window telemetry rows lack
+# iters/secs and are not compared.
+REQ_BUNDLER = ["name","dim_bits","iters","secs","ns_per_op","sample_index","warmup_ms","measure_ms"]
+
+REQ_CONFIG = ["name","dim_bits","bind","bind_reason","hamming","hamming_reason"]
+
+def load_required(schema_path, fallback):
+    # Schemas under ci/ndjson_schema are "required"-only object schemas; rows may carry extra
+    # harness fields (e.g. perf counters) without breaking the lock.
+    try:
+        with open(schema_path, 'r', encoding='utf-8') as f:
+            req = json.load(f).get("required")
+    except (OSError, ValueError) as e:
+        print(f"WARN: cannot read schema '{schema_path}' ({e}); using built-in field list", file=sys.stderr)
+        return fallback
+    if not isinstance(req, list) or not req:
+        return fallback
+    return [str(k) for k in req]
+
 def load_ndjson(path):
     rows=[]
     # Read raw bytes to handle Windows PowerShell redirection (UTF-16 LE by default)
@@ -56,6 +87,138 @@ def group_key_am(o):
 def group_key_cluster(o):
     return (o["name"], int(o["dim_bits"]), int(o["capacity"]), int(o["updates"]))
 
+def group_key_app(o):
+    return (o["name"], int(o["dim_bits"]))
+
+def group_key_kernel(o):
+    return (o["name"], int(o["dim_bits"]))
+
+
+def collect(rows, keyfn, metric):
+    g=defaultdict(list)
+    for o in rows:
+        g[keyfn(o)].append(float(o[metric]))
+    return g
+
+
+def median(values):
+    v=sorted(values)
+    n=len(v)
+    if not n:
+        return 0.0
+    return v[n//2] if n%2==1 else 0.5*(v[n//2-1]+v[n//2])
+
+
+def mann_whitney_less(cur, base):
+    """One-sided Mann-Whitney U p-value for H1: cur tends to be smaller than base.
+
+    Exact null distribution for small tie-free samples, normal approximation with tie and
+    continuity correction otherwise. No SciPy dependency so the script runs on bare runners.
+    """
+    n, m = len(cur), len(base)
+    if n == 0 or m == 0:
+        return 1.0
+    pooled=sorted([(x,0) for x in cur]+[(x,1) for x in base])
+    ranks=[0.0]*len(pooled)
+    tie_term=0.0
+    i=0
+    while i < len(pooled):
+        j=i
+        while j+1 < len(pooled) and pooled[j+1][0]==pooled[i][0]:
+            j+=1
+        for k in range(i, j+1):
+            ranks[k]=0.5*(i+j)+1.0
+        t=j-i+1
+        tie_term+=t**3-t
+        i=j+1
+    r_cur=sum(r for r,(_,grp) in zip(ranks,pooled) if grp==0)
+    u=r_cur-n*(n+1)/2.0  # number of (cur, base) pairs with cur > base (ties count 1/2)
+    if tie_term == 0 and n*m <= 400:
+        # counts[k] = number of rank arrangements with U == k (Mann & Whitney recurrence)
+        counts=[[ [0]*(a*b+1) for b in range(m+1)] for a in range(n+1)]
+        for a in range(n+1):
+            for b in range(m+1):
+                if a==0 or b==0:
+                    counts[a][b][0]=1
+                    continue
+                for k in range(a*b+1):
+                    c=counts[a-1][b][k-b] if k-b>=0 else 0
+                    c+=counts[a][b-1][k] if k<=a*(b-1) else 0
+                    counts[a][b][k]=c
+        dist=counts[n][m]
+        return sum(dist[:int(round(u))+1])/float(sum(dist))
+    mu=n*m/2.0
+    var=n*m/12.0*((n+m+1)-tie_term/((n+m)*(n+m-1)))
+    if var <= 0:
+        return 1.0
+    z=(u-mu+0.5)/math.sqrt(var)
+    return 0.5*math.erfc(-z/math.sqrt(2.0))
+
+
+class DiffTable:
+    """Per-metric comparison rows; printed as one table pointing at the regressed kernel/backend."""
+
+    def __init__(self):
+        self.rows=[]
+
+    def add(self, kind, key, metric, base, cur, p, verdict):
+        name=str(key[0])
+        kernel, _, backend=name.partition('/')
+        self.rows.append({
+            "kind":kind, "kernel":kernel, "backend":backend or "-",
+            "params":",".join(str(x) for x in key[1:]), "metric":metric,
+            "baseline":base, "current":cur, "p":p, "verdict":verdict,
+        })
+
+    def render(self):
+        hdr=["kind","kernel","backend","params","metric","baseline","current","delta%","p","verdict"]
+        def fmt(v):
+            return f"{v:.4g}" if isinstance(v, float) else str(v)
+        body=[]
+        for r in self.rows:
+            base, cur=r["baseline"], r["current"]
+            numeric=isinstance(base, float) and isinstance(cur, float) and base
+            body.append([r["kind"], r["kernel"], r["backend"], r["params"], r["metric"],
+                         fmt(base), fmt(cur), f"{100.0*(cur/base-1.0):+.1f}" if numeric else "-",
+                         "-" if r["p"] is None else f"{r['p']:.3f}", r["verdict"]])
+        widths=[max(len(h), *(len(b[i]) for b in body)) if body else len(h) for i,h in enumerate(hdr)]
+        lines=["  ".join(h.ljust(w) for h,w in zip(hdr,widths))]
+        lines.append("  ".join("-"*w for w in widths))
+        for b in body:
+            lines.append("  ".join(c.ljust(w) for c,w in zip(b,widths)))
+        return "\n".join(lines)
+
+
+def compare_group(table, kind, key, metric, cur_values, base_metric, tol_pct, alpha):
+    """Compares one higher-is-better metric; returns a failure string or None.
+
+    Baselines that carry raw "samples" get a noise-aware verdict: a regression needs both a
+    significant one-sided Mann-Whitney test (p < alpha) and a median drop beyond tol_pct. Legacy
+    baselines with only a mean keep the plain mean-vs-tolerance rule.
+    """
+    base_samples=[float(x) for x in base_metric.get("samples", [])]
+    if base_samples and len(base_samples) >= 3 and len(cur_values) >= 3:
+        base=median(base_samples)
+        cur=median(cur_values)
+        p=mann_whitney_less(cur_values, base_samples)
+        dropped=base > 0 and cur < (1.0-tol_pct/100.0)*base
+        regressed=dropped and p < alpha
+        improved=base > 0 and cur > (1.0+tol_pct/100.0)*base and mann_whitney_less(base_samples, cur_values) < alpha
+        verdict="REGRESSED" if regressed else ("improved" if improved else ("noise" if dropped else "ok"))
+    else:
+        base=float(base_metric.get("median", base_metric.get("mean", 0.0)))
+        cur=sum(cur_values)/len(cur_values) if cur_values else 0.0
+        p=None
+        ok,_=compare_metric(cur, base, tol_pct, metric)
+        regressed=not ok
+        verdict="REGRESSED" if regressed else "ok"
+    table.add(kind, key, metric, base, cur, p, verdict)
+    if regressed:
+        p_txt="" if p is None else f", p={p:.3f}"
+        return (f"{kind} {metric}: current={cur:.2f}, baseline={base:.2f}, "
+                f"allowed>= {(1.0-tol_pct/100.0)*base:.2f} (tol={tol_pct}%{p_txt}) key={key}")
+    return None
+
 
 def aggregates(values):
     values=sorted(values)
@@ -95,6 +258,115 @@ def compute_aggregates_cluster(rows):
     return out
 
 
+def compute_aggregates_app(rows):
+    g=defaultdict(lambda: {"eps":[], "acc":[]})
+    for o in rows:
+        g[group_key_app(o)]["eps"].append(float(o["events_per_sec"]))
+        g[group_key_app(o)]["acc"].append(float(o["accuracy"]))
+    out={}
+    for k,v in g.items():
+        out[k]={
+            "events_per_sec": aggregates(v["eps"]),
+            "accuracy": aggregates(v["acc"]),
+        }
+    return out
+
+
+def _load_optional_baseline(path, label):
+    # Missing per-OS baseline => skip (baselines are only recorded on hosts where they were measured).
+    if not os.path.exists(path):
+        print(f"NOTE: no {label} baseline at {path}; skipping {label} comparison")
+        return None
+    with open(path,'r',encoding='utf-8') as f:
+        return json.load(f)
+
+
+def compare_app(app_rows, baseline_path, tol_eps, tol_acc, table, alpha):
+    failures=[]
+    base=_load_optional_baseline(baseline_path, "app")
+    if base is None:
+        return failures
+    app_aggr=compute_aggregates_app(app_rows)
+    eps=collect(app_rows, group_key_app, "events_per_sec")
+    for key_str, base_obj in base.items():
+        key=tuple(json.loads(key_str))  # [name,dim]
+        cur=app_aggr.get(key)
+        if not cur:
+            failures.append(f"Missing App group in current run: {key}")
+            continue
+        f=compare_group(table, "App", key, "events_per_sec", eps[key], base_obj["events_per_sec"], tol_eps, alpha)
+        if f: failures.append(f)
+        # Accuracy is deterministic for a given dataset; allow only a small absolute drop.
+        acc=cur["accuracy"]["mean"]; base_acc=float(base_obj["accuracy"])
+        acc_ok=acc >= base_acc - tol_acc
+        table.add("App", key, "accuracy", base_acc, acc, None, "ok" if acc_ok else "REGRESSED")
+        if not acc_ok:
+            failures.append(f"App accuracy: current={acc:.4f}, baseline={base_acc:.4f}, allowed>= {base_acc-tol_acc:.4f} key={key}")
+    return failures
+
+
+def compare_kernel(bench, rows, baseline_path, tol_gbps, table, alpha):
+    # Per-(kernel/backend, dim) GB/s. A backend the host cannot run (e.g. avx2 rows on an ARM
+    # runner) is simply absent from both the run and that OS's baseline.
+    failures=[]
+    base=_load_optional_baseline(baseline_path, bench)
+    if base is None:
+        return failures
+    gbps=collect(rows, group_key_kernel, "gb_per_sec")
+    for key_str, base_obj in base.items():
+        key=tuple(json.loads(key_str))  # [name,dim]
+        if key not in gbps:
+            failures.append(f"Missing {bench} group in current run: {key}")
+            continue
+        f=compare_group(table, bench, key, "gb_per_sec", gbps[key], base_obj["gb_per_sec"], tol_gbps, alpha)
+        if f: failures.append(f)
+    return failures
+
+
+def compare_bundler(rows, baseline_path, tol_qps, table, alpha):
+    # Per-(case, dim) ops/sec, derived from ns_per_op so the higher-is-better rule applies.
+    failures=[]
+    base=_load_optional_baseline(baseline_path, "bundler_bench")
+    if base is None:
+        return failures
+    ops=defaultdict(list)
+    for o in rows:
+        ns=float(o["ns_per_op"])
+        if ns > 0:
+            ops[group_key_kernel(o)].append(1e9/ns)
+    for key_str, base_obj in base.items():
+        key=tuple(json.loads(key_str))  # [name,dim]
+        if key not in ops:
+            failures.append(f"Missing bundler_bench group in current run: {key}")
+            continue
+        f=compare_group(table, "bundler_bench", key, "ops_per_sec", ops[key], base_obj["ops_per_sec"], tol_qps, alpha)
+        if f: failures.append(f)
+    return failures
+
+
+def compare_config(rows, baseline_path, table):
+    # config_bench is not timed: lock which backend the policy selects per dim, since a silent
+    # fallback to scalar is the regression that matters there.
+    failures=[]
+    base=_load_optional_baseline(baseline_path, "config_bench")
+    if base is None:
+        return failures
+    cur={(o["name"], int(o["dim_bits"])): o for o in rows}
+    for key_str, expected in base.items():
+        key=tuple(json.loads(key_str))  # [name,dim]
+        row=cur.get(key)
+        if row is None:
+            failures.append(f"Missing config_bench row in current run: {key}")
+            continue
+        for field, want in expected.items():
+            got=row.get(field)
+            ok=got == want
+            table.add("config_bench", key, field, want, got, None, "ok" if ok else "REGRESSED")
+            if not ok:
+                failures.append(f"config_bench {field}: current={got}, baseline={want} key={key}")
+    return failures
+
+
 # --- Phase D additions: variance-bounds and provenance helpers ---
 
 def _var_threshold(os_name: str) -> float:
@@ -129,7 +401,7 @@ def _get_provenance():
     return prov
 
 
-def _write_aggregates_ndjson(path, am_aggr, cl_aggr, provenance):
+def _write_aggregates_ndjson(path, am_aggr, cl_aggr, provenance, app_aggr=None):
     try:
         with open(path, "w", encoding="utf-8") as out:
             for k, v in am_aggr.items():
@@ -142,6 +414,11 @@ def _write_aggregates_ndjson(path, am_aggr, cl_aggr, provenance):
                 rec.update(v)
                 rec.update(provenance)
                 out.write(json.dumps(rec, separators=(",", ":")) + "\n")
+            for k, v in (app_aggr or {}).items():
+                rec = {"kind": "App", "key": list(k)}
+                rec.update(v)
+                rec.update(provenance)
+                out.write(json.dumps(rec, separators=(",", ":")) + "\n")
     except Exception as e:
         print(f"WARN: failed to write aggregates NDJSON '{path}': {e}", file=sys.stderr)
 
@@ -190,10 +467,16 @@ def compare_metric(current, baseline, tol_pct, label):
 
 
 def run(args):
-    am_rows=filter_rows(load_ndjson(args.am), REQ_AM)
-    cl_rows=filter_rows(load_ndjson(args.cluster), REQ_CLUSTER)
-    require_fields(am_rows, REQ_AM)
-    require_fields(cl_rows, REQ_CLUSTER)
+    req_am=load_required(args.am_schema, REQ_AM)
+    req_cl=load_required(args.cluster_schema, REQ_CLUSTER)
+    am_rows=filter_rows(load_ndjson(args.am), req_am)
+    cl_rows=filter_rows(load_ndjson(args.cluster), req_cl)
+    if not am_rows:
+        raise SystemExit(f"No AM rows carry the schema-required fields {req_am}")
+    if not cl_rows:
+        raise SystemExit(f"No Cluster rows carry the schema-required fields {req_cl}")
+    require_fields(am_rows, req_am)
+    require_fields(cl_rows, req_cl)
 
     # Aggregates
     am_aggr=compute_aggregates_am(am_rows)
@@ -205,30 +488,31 @@ def run(args):
 
     am_base, cl_base=load_baseline(args.baseline_dir, args.os)
 
+    table=DiffTable()
     failures=[]
     # Compare AM
+    am_qps=collect(am_rows, group_key_am, "queries_per_sec")
+    am_gbps=collect(am_rows, group_key_am, "eff_gb_per_sec")
     for key_str, base_obj in am_base.items():
         key=tuple(json.loads(key_str))  # keys are serialized tuples: [name,dim,cap,size]
-        cur=am_aggr.get(key)
-        if not cur:
+        if key not in am_aggr:
             failures.append(f"Missing AM group in current run: {key}")
             continue
-        ok1,d1=compare_metric(cur["queries_per_sec"]["mean"], base_obj["queries_per_sec"]["mean"], args.tol_qps, "AM qps")
-        ok2,d2=compare_metric(cur["eff_gb_per_sec"]["mean"], base_obj["eff_gb_per_sec"]["mean"], args.tol_gbps, "AM gbps")
-        if not ok1: failures.append(d1+f" key={key}")
-        if not ok2: failures.append(d2+f" key={key}")
+        for f in (compare_group(table, "AM", key, "queries_per_sec", am_qps[key], base_obj["queries_per_sec"], args.tol_qps, args.alpha),
+                  compare_group(table, "AM", key, "eff_gb_per_sec", am_gbps[key], base_obj["eff_gb_per_sec"], args.tol_gbps, args.alpha)):
+            if f: failures.append(f)
 
     # Compare Cluster
+    cl_ups=collect(cl_rows, group_key_cluster, "updates_per_sec")
+    cl_fps=collect(cl_rows, group_key_cluster, "finalizes_per_sec")
     for key_str, base_obj in cl_base.items():
         key=tuple(json.loads(key_str))  # [name,dim,cap,updates]
-        cur=cl_aggr.get(key)
-        if not cur:
+        if key not in cl_aggr:
             failures.append(f"Missing Cluster group in current run: {key}")
             continue
-        ok1,d1=compare_metric(cur["updates_per_sec"]["mean"], base_obj["updates_per_sec"]["mean"], args.tol_qps, "Cluster updates")
-        ok2,d2=compare_metric(cur["finalizes_per_sec"]["mean"], base_obj["finalizes_per_sec"]["mean"], args.tol_qps, "Cluster finalizes")
-        if not ok1: failures.append(d1+f" key={key}")
-        if not ok2: failures.append(d2+f" key={key}")
+        for f in (compare_group(table, "Cluster", key, "updates_per_sec", cl_ups[key], base_obj["updates_per_sec"], args.tol_qps, args.alpha),
+                  compare_group(table, "Cluster", key, "finalizes_per_sec", cl_fps[key], base_obj["finalizes_per_sec"], args.tol_qps, args.alpha)):
+            if f: failures.append(f)
 
     # Variance-bounds enforcement (only when sufficient samples)
     thr=_var_threshold(args.os)
@@ -251,8 +535,51 @@ def run(args):
             if mean>0 and (std/mean)>thr:
                 failures.append(f"Cluster finalizes variance too high: stdev/mean={(std/mean):.3f} > {thr:.3f} key={k}")
 
+    sub={"ubuntu-latest":"linux","windows-latest":"windows","macos-latest":"macos"}.get(args.os, args.os)
+
+    # Optional end-to-end app workloads
+    app_aggr={}
+    if args.app:
+        req_app=load_required(args.app_schema, REQ_APP) if args.app_schema else REQ_APP
+        app_rows=filter_rows(load_ndjson(args.app), req_app)
+        if not app_rows:
+            raise SystemExit(f"No App rows carry the schema-required fields {req_app}")
+        require_fields(app_rows, req_app)
+        app_aggr=compute_aggregates_app(app_rows)
+        failures.extend(compare_app(app_rows, os.path.join(args.baseline_dir, sub, "app_bench.json"),
+                                    args.tol_qps, args.tol_acc, table, args.alpha))
+
+    # Optional streaming-kernel benches: --kernel hamming_bench=hamming.ndjson (repeatable)
+    for spec in args.kernel or []:
+        bench, sep, path=spec.partition('=')
+        if not sep or bench not in KERNEL_BENCHES:
+            raise SystemExit(f"--kernel expects BENCH=PATH with BENCH in {KERNEL_BENCHES}, got '{spec}'")
+        req=load_required(os.path.join(args.schema_dir, f"{bench}.schema.json"), REQ_KERNEL)
+        rows=filter_rows(load_ndjson(path), req)
+        if not rows:
+            raise SystemExit(f"No {bench} rows carry the schema-required fields {req}")
+        failures.extend(compare_kernel(bench, rows, os.path.join(args.baseline_dir, sub, f"{bench}.json"),
+                                       args.tol_gbps, table, args.alpha))
+
+    # Optional bundler_bench (BinaryBundler accumulate/finalize)
+    if args.bundler:
+        req=load_required(os.path.join(args.schema_dir, "bundler_bench.schema.json"), REQ_BUNDLER)
+        rows=filter_rows(load_ndjson(args.bundler), req)
+        if not rows:
+            raise SystemExit(f"No bundler_bench rows carry the schema-required fields {req}")
+        failures.extend(compare_bundler(rows, os.path.join(args.baseline_dir, sub, "bundler_bench.json"),
+                                        args.tol_qps, table, args.alpha))
+
+    # Optional config_bench policy lock
+    if args.config:
+        req=load_required(os.path.join(args.schema_dir, "config_bench.schema.json"), REQ_CONFIG)
+        rows=filter_rows(load_ndjson(args.config), req)
+        if not rows:
+            raise SystemExit(f"No config_bench rows carry the schema-required fields {req}")
+        failures.extend(compare_config(rows, os.path.join(args.baseline_dir, sub, "config_bench.json"), table))
+
     # Emit aggregates with provenance for artifacting
-    _write_aggregates_ndjson("perf_agg.ndjson", am_aggr, cl_aggr, _get_provenance())
+    _write_aggregates_ndjson("perf_agg.ndjson", am_aggr, cl_aggr, _get_provenance(), app_aggr)
 
     # Log summary
     print("=== Aggregates (AM) ===")
@@ -261,6 +588,13 @@ def run(args):
     print("=== Aggregates (Cluster) ===")
     for k,v in cl_aggr.items():
         print(json.dumps({"key":k, **v}, separators=(",",":")))
+    if app_aggr:
+        print("=== Aggregates (App) ===")
+        for k,v in app_aggr.items():
+            print(json.dumps({"key":k, **v}, separators=(",",":")))
+
+    print("=== Baseline diff ===")
+    print(table.render())
 
     if failures:
         print("\nPERF REGRESSION DETECTED:")
@@ -279,10 +613,19 @@ if __name__=="__main__":
     ap.add_argument('--os', required=True)
     ap.add_argument('--tol-qps', type=float, required=True)
     ap.add_argument('--tol-gbps', type=float, required=True)
+    ap.add_argument('--app', help='app_bench NDJSON (optional)')
+    ap.add_argument('--app-schema', help='app_bench schema (optional)')
+    ap.add_argument('--tol-acc', type=float, default=0.02, help='allowed absolute accuracy drop for app workloads')
+    ap.add_argument('--kernel', action='append', metavar='BENCH=PATH',
+                    help='streaming-kernel NDJSON, e.g. hamming_bench=hamming.ndjson (repeatable)')
+    ap.add_argument('--bundler', help='bundler_bench NDJSON (optional)')
+    ap.add_argument('--config', help='config_bench NDJSON (optional backend-selection lock)')
+    ap.add_argument('--schema-dir', default='ci/ndjson_schema', help='schemas for --kernel/--bundler/--config benches')
+    ap.add_argument('--alpha', type=float, default=0.05,
+                    help='significance level of the one-sided Mann-Whitney test for sample baselines')
     args=ap.parse_args()
 
-    # Note: schema paths are currently informational; schema-lock is enforced via key presence checks above.
-    # If needed, JSON Schema validation can be added without external deps by manual checks.
+    # Schema lock: the "required" list of each schema is enforced via key presence checks.
 
     sys.exit(run(args))
 
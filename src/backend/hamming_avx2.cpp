@@ -7,16 +7,42 @@
 
 namespace hyperstream { namespace backend { namespace avx2 {
 
-// MSVC TU: compile with /arch:AVX2. Implements raw AVX2 Hamming on 64-bit words.
+namespace {
+
+// Per-byte popcount of a^b (each byte 0..8).
+__m256i XorPopcountBytes(const std::uint64_t* a, const std::uint64_t* b) {
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1,
+                                          2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  const __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));
+  const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_mask));
+  const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask));
+  return _mm256_add_epi8(lo, hi);
+}
+
+}  // namespace
+
+// MSVC TU: compile with /arch:AVX2. Implements raw AVX2 Hamming on 64-bit words, one SAD per
+// 16 words (see the GCC/Clang definition in cpu_backend_avx2.hpp).
 std::size_t HammingWords(const std::uint64_t* a, const std::uint64_t* b, std::size_t word_count) {
-  const std::size_t avx2_words = (word_count / 4) * 4;
-  std::size_t total = 0; std::size_t i = 0;
-  for (; i < avx2_words; i += 4) {
-    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a[i]));
-    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b[i]));
-    __m256i vx = _mm256_xor_si256(va, vb);
-    total += Popcount256(vx);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc = zero;
+  std::size_t i = 0;
+  for (; i + 16 <= word_count; i += 16) {
+    __m256i s = _mm256_add_epi8(XorPopcountBytes(a + i, b + i), XorPopcountBytes(a + i + 4, b + i + 4));
+    s = _mm256_add_epi8(s, XorPopcountBytes(a + i + 8, b + i + 8));
+    s = _mm256_add_epi8(s, XorPopcountBytes(a + i + 12, b + i + 12));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(s, zero));
+  }
+  if (i + 4 <= word_count) {
+    __m256i s = zero;
+    for (; i + 4 <= word_count; i += 4) s = _mm256_add_epi8(s, XorPopcountBytes(a + i, b + i));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(s, zero));
   }
+  const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  std::size_t total = static_cast<std::size_t>(_mm_cvtsi128_si64(half)) +
+                      static_cast<std::size_t>(_mm_extract_epi64(half, 1));
   for (; i < word_count; ++i) {
 #if defined(_MSC_VER)
     total += __popcnt64(a[i] ^ b[i]);
@@ -0,0 +1,122 @@
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include "hyperstream/backend/cpu_backend_avx2.hpp"
+
+namespace hyperstream { namespace backend { namespace avx2 {
+
+namespace {
+
+// Per-byte popcount of x (each byte 0..8).
+__m256i PopcountBytes(__m256i x) {
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1,
+                                          2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_mask));
+  const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask));
+  return _mm256_add_epi8(lo, hi);
+}
+
+// MSVC TU: compile with /arch:AVX2. R x C register tile of the all-pairs Hamming kernel.
+template <std::size_t R, std::size_t C>
+void HammingMicroTile(const std::uint64_t* const* a, const std::uint64_t* const* b, std::size_t word_count,
+                      std::uint32_t* out, std::size_t out_stride) {
+  constexpr std::size_t kMaxVectors = 31;
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i total[R][C];
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) total[r][c] = zero;
+  }
+  const std::size_t vec_words = word_count & ~std::size_t{3};
+  std::size_t w = 0;
+  while (w < vec_words) {
+    const std::size_t end = (vec_words - w > 4 * kMaxVectors) ? w + 4 * kMaxVectors : vec_words;
+    __m256i acc[R][C];
+    for (std::size_t r = 0; r < R; ++r) {
+      for (std::size_t c = 0; c < C; ++c) acc[r][c] = zero;
+    }
+    for (; w < end; w += 4) {
+      __m256i av[R];
+      for (std::size_t r = 0; r < R; ++r) av[r] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a[r] + w));
+      for (std::size_t c = 0; c < C; ++c) {
+        const __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b[c] + w));
+        for (std::size_t r = 0; r < R; ++r) {
+          acc[r][c] = _mm256_add_epi8(acc[r][c], PopcountBytes(_mm256_xor_si256(av[r], bv)));
+        }
+      }
+    }
+    for (std::size_t r = 0; r < R; ++r) {
+      for (std::size_t c = 0; c < C; ++c) total[r][c] = _mm256_add_epi64(total[r][c], _mm256_sad_epu8(acc[r][c], zero));
+    }
+  }
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) {
+      const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(total[r][c]), _mm256_extracti128_si256(total[r][c], 1));
+      std::uint64_t sum = static_cast<std::uint64_t>(_mm_cvtsi128_si64(half)) +
+                          static_cast<std::uint64_t>(_mm_extract_epi64(half, 1));
+      for (std::size_t t = vec_words; t < word_count; ++t) sum += __popcnt64(a[r][t] ^ b[c][t]);
+      out[r * out_stride + c] = static_cast<std::uint32_t>(sum);
+    }
+  }
+}
+
+// Scalar POPCNT R x C tile for short rows (fewer than two vectors).
+template <std::size_t R, std::size_t C>
+void HammingMicroTileShort(const std::uint64_t* const* a, const std::uint64_t* const* b, std::size_t word_count,
+                           std::uint32_t* out, std::size_t out_stride) {
+  std::uint64_t acc[R][C] = {};
+  for (std::size_t w = 0; w < word_count; ++w) {
+    std::uint64_t av[R];
+    for (std::size_t r = 0; r < R; ++r) av[r] = a[r][w];
+    for (std::size_t c = 0; c < C; ++c) {
+      const std::uint64_t bv = b[c][w];
+      for (std::size_t r = 0; r < R; ++r) acc[r][c] += __popcnt64(av[r] ^ bv);
+    }
+  }
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) out[r * out_stride + c] = static_cast<std::uint32_t>(acc[r][c]);
+  }
+}
+
+}  // namespace
+
+void HammingTileWords(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                      std::size_t nb, std::size_t word_count, std::uint32_t* out, std::size_t out_stride) {
+  // Long rows: the per-pair kernel (no fixed-size kernels in the MSVC build).
+  if (word_count >= kHammingTilePairWords) {
+    for (std::size_t i = 0; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) {
+        out[i * out_stride + j] = static_cast<std::uint32_t>(HammingWords(a[i], b[j], word_count));
+      }
+    }
+    return;
+  }
+  if (word_count < 8) {
+    std::size_t i = 0;
+    for (; i + 4 <= na; i += 4) {
+      std::size_t j = 0;
+      for (; j + 4 <= nb; j += 4) HammingMicroTileShort<4, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+      for (; j < nb; ++j) HammingMicroTileShort<4, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+    for (; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) HammingMicroTileShort<1, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    }
+    return;
+  }
+  std::size_t i = 0;
+  for (; i + 2 <= na; i += 2) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) HammingMicroTile<2, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) HammingMicroTile<2, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+  for (; i < na; ++i) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) HammingMicroTile<1, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) HammingMicroTile<1, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+}
+
+}}} // namespace hyperstream::backend::avx2
+#endif // x86/x64 guard
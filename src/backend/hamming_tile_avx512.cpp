@@ -0,0 +1,79 @@
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include "hyperstream/backend/cpu_backend_avx2.hpp"
+#include "hyperstream/backend/cpu_backend_avx512.hpp"
+
+namespace hyperstream { namespace backend { namespace avx512 {
+
+namespace {
+
+// MSVC TU: compile with /arch:AVX512. R x C register tile of the all-pairs Hamming kernel.
+template <std::size_t R, std::size_t C>
+void HammingMicroTile(const std::uint64_t* const* a, const std::uint64_t* const* b, std::size_t word_count,
+                      std::uint32_t* out, std::size_t out_stride) {
+  __m512i acc[R][C];
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) acc[r][c] = _mm512_setzero_si512();
+  }
+  std::size_t w = 0;
+  for (; w + 8 <= word_count; w += 8) {
+    __m512i av[R];
+    for (std::size_t r = 0; r < R; ++r) av[r] = _mm512_loadu_si512(a[r] + w);
+    for (std::size_t c = 0; c < C; ++c) {
+      const __m512i bv = _mm512_loadu_si512(b[c] + w);
+      for (std::size_t r = 0; r < R; ++r) {
+        acc[r][c] = _mm512_add_epi64(acc[r][c], _mm512_popcnt_epi64(_mm512_xor_si512(av[r], bv)));
+      }
+    }
+  }
+  if (w < word_count) {
+    const __mmask8 k = static_cast<__mmask8>((1u << (word_count - w)) - 1u);
+    __m512i av[R];
+    for (std::size_t r = 0; r < R; ++r) av[r] = _mm512_maskz_loadu_epi64(k, a[r] + w);
+    for (std::size_t c = 0; c < C; ++c) {
+      const __m512i bv = _mm512_maskz_loadu_epi64(k, b[c] + w);
+      for (std::size_t r = 0; r < R; ++r) {
+        acc[r][c] = _mm512_add_epi64(acc[r][c], _mm512_popcnt_epi64(_mm512_xor_si512(av[r], bv)));
+      }
+    }
+  }
+  for (std::size_t r = 0; r < R; ++r) {
+    for (std::size_t c = 0; c < C; ++c) {
+      // Spilled rather than _mm512_reduce_add_epi64, whose GCC 12 expansion trips -Wuninitialized.
+      alignas(64) std::uint64_t lanes[8];
+      _mm512_store_si512(lanes, acc[r][c]);
+      std::uint64_t sum = 0;
+      for (std::uint64_t lane : lanes) sum += lane;
+      out[r * out_stride + c] = static_cast<std::uint32_t>(sum);
+    }
+  }
+}
+
+}  // namespace
+
+void HammingTileWords(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                      std::size_t nb, std::size_t word_count, std::uint32_t* out, std::size_t out_stride) {
+  // Rows shorter than one ZMM vector: the AVX2 kernel's scalar POPCNT tile is faster than a masked
+  // vector plus a horizontal reduction per pair.
+  if (word_count < 8) {
+    avx2::HammingTileWords(a, na, b, nb, word_count, out, out_stride);
+    return;
+  }
+  std::size_t i = 0;
+  for (; i + 4 <= na; i += 4) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) HammingMicroTile<4, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) HammingMicroTile<4, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+  for (; i < na; ++i) {
+    std::size_t j = 0;
+    for (; j + 4 <= nb; j += 4) HammingMicroTile<1, 4>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+    for (; j < nb; ++j) HammingMicroTile<1, 1>(a + i, b + j, word_count, out + i * out_stride + j, out_stride);
+  }
+}
+
+}}} // namespace hyperstream::backend::avx512
+#endif // x86/x64 guard
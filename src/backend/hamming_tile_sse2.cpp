@@ -0,0 +1,26 @@
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include <cstddef>
+#include <cstdint>
+#include "hyperstream/backend/cpu_backend_sse2.hpp"
+#include "hyperstream/core/ops.hpp"
+
+namespace hyperstream { namespace backend { namespace sse2 {
+
+// MSVC TU: compile with /arch:SSE2. No fixed-size kernels in the MSVC build, but HammingWords
+// counts with POPCNT here, so long rows go through it per pair; short rows use the portable tile.
+void HammingTileWords(const std::uint64_t* const* a, std::size_t na, const std::uint64_t* const* b,
+                      std::size_t nb, std::size_t word_count, std::uint32_t* out, std::size_t out_stride) {
+  if (word_count < kHammingTilePairWords) {
+    core::HammingTileWords(a, na, b, nb, word_count, out, out_stride);
+    return;
+  }
+  for (std::size_t i = 0; i < na; ++i) {
+    for (std::size_t j = 0; j < nb; ++j) {
+      out[i * out_stride + j] = static_cast<std::uint32_t>(HammingWords(a[i], b[j], word_count));
+    }
+  }
+}
+
+}}} // namespace hyperstream::backend::sse2
+#endif // x86/x64 guard
@@ -0,0 +1,51 @@
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include "hyperstream/backend/cpu_backend_avx2.hpp"
+
+namespace hyperstream { namespace backend { namespace avx2 {
+
+// MSVC TU: compile with /arch:AVX2. Implements the AVX2 signed counter dot product (exact for any
+// int counters; see the hi/lo 16-bit split in cpu_backend_avx2.hpp).
+std::int64_t SignedDotWords(const int* counters, const std::uint64_t* words, std::size_t dim_bits) {
+  const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m256i ones = _mm256_set1_epi32(1);
+  const __m256i low_mask = _mm256_set1_epi32(0xFFFF);
+  std::int64_t total = 0;
+  std::size_t w = 0;
+  const std::size_t full = dim_bits / 64;
+  while (w < full) {
+    // int32 lanes add at most 8 * 2^16 per word in magnitude: widen every kBlock words.
+    constexpr std::size_t kBlock = 256;
+    const std::size_t end = (full - w < kBlock) ? full : w + kBlock;
+    __m256i acc_hi = _mm256_setzero_si256();
+    __m256i acc_lo = _mm256_setzero_si256();
+    for (; w < end; ++w) {
+      const std::uint64_t q = words[w];
+      const int* c = counters + w * 64;
+      for (std::size_t j = 0; j < 8; ++j) {
+        const __m256i byte = _mm256_set1_epi32(static_cast<int>((q >> (8 * j)) & 0xFFU));
+        const __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(byte, lane_bits), lane_bits);
+        const __m256i sign = _mm256_or_si256(_mm256_andnot_si256(set, _mm256_set1_epi32(-1)), ones);
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + 8 * j));
+        acc_hi = _mm256_add_epi32(acc_hi, _mm256_sign_epi32(_mm256_srai_epi32(v, 16), sign));
+        acc_lo = _mm256_add_epi32(acc_lo, _mm256_sign_epi32(_mm256_and_si256(v, low_mask), sign));
+      }
+    }
+    alignas(32) std::int32_t hi[8];
+    alignas(32) std::int32_t lo[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hi), acc_hi);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lo), acc_lo);
+    for (std::size_t l = 0; l < 8; ++l) total += static_cast<std::int64_t>(hi[l]) * 65536 + lo[l];
+  }
+  for (std::size_t b = w * 64; b < dim_bits; ++b) {
+    const std::int64_t c = counters[b];
+    total += ((words[w] >> (b - w * 64)) & 1ULL) ? c : -c;
+  }
+  return total;
+}
+
+}}} // namespace hyperstream::backend::avx2
+#endif // x86/x64 guard
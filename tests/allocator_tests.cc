@@ -0,0 +1,112 @@
+// Tests for pluggable large-structure allocators and their use by associative memories.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/allocator.hpp"
+#include "hyperstream/memory/associative.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::AllocatorKind;
+using hyperstream::memory::ArenaAllocator;
+using hyperstream::memory::CleanupMemory;
+using hyperstream::memory::ClusterMemory;
+using hyperstream::memory::HeapAllocator;
+using hyperstream::memory::HugePageAllocator;
+using hyperstream::memory::LargeAllocator;
+using hyperstream::memory::LargeArray;
+using hyperstream::memory::NumaAllocator;
+using hyperstream::memory::PrototypeMemory;
+
+void ExpectAlignedAndZeroed(LargeAllocator* alloc, std::size_t bytes) {
+  void* p = alloc->Allocate(bytes);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64u, 0u) << "kind=" << static_cast<int>(alloc->kind());
+  const auto* b = static_cast<const unsigned char*>(p);
+  for (std::size_t i = 0; i < bytes; ++i) {
+    ASSERT_EQ(b[i], 0u) << "byte " << i;
+  }
+  alloc->Deallocate(p, bytes);
+}
+
+TEST(Allocator, AllKindsReturnAlignedZeroedStorage) {
+  HeapAllocator heap;
+  ArenaAllocator arena(1 << 16);
+  HugePageAllocator huge2m(HugePageAllocator::PageSize::k2M, /*prefault=*/true);
+  HugePageAllocator huge1g(HugePageAllocator::PageSize::k1G);
+  NumaAllocator numa(0);
+  LargeAllocator* all[] = {&heap, &arena, &huge2m, &huge1g, &numa};
+  for (LargeAllocator* a : all) {
+    ExpectAlignedAndZeroed(a, 1);
+    ExpectAlignedAndZeroed(a, 4099);
+  }
+  EXPECT_EQ(huge1g.kind(), AllocatorKind::HugePage1G);
+  EXPECT_EQ(huge2m.mapped_bytes(), 0u) << "all mappings released";
+}
+
+TEST(Allocator, ArenaBumpsExhaustsAndRezeroesAfterReset) {
+  ArenaAllocator arena(256);
+  void* a = arena.Allocate(10);
+  void* b = arena.Allocate(64);
+  EXPECT_EQ(static_cast<unsigned char*>(b) - static_cast<unsigned char*>(a), 64);
+  EXPECT_EQ(arena.used(), 128u);
+  EXPECT_THROW(arena.Allocate(200), std::bad_alloc);
+
+  static_cast<unsigned char*>(a)[3] = 0xAB;
+  arena.Reset();
+  auto* again = static_cast<unsigned char*>(arena.Allocate(10));
+  EXPECT_EQ(again, a);
+  EXPECT_EQ(again[3], 0u);
+}
+
+TEST(Allocator, LargeArrayMoveTransfersOwnership) {
+  ArenaAllocator arena(1024);
+  LargeArray<int> x(16, &arena);
+  x[5] = 42;
+  LargeArray<int> y(std::move(x));
+  EXPECT_EQ(x.data(), nullptr);
+  EXPECT_EQ(y.size(), 16u);
+  EXPECT_EQ(y[5], 42);
+  EXPECT_EQ(y.allocator(), &arena);
+}
+
+TEST(Allocator, MemoriesProduceSameResultsOnEveryAllocator) {
+  static constexpr std::size_t kDim = 256;
+  static constexpr std::size_t kCap = 8;
+  HeapAllocator heap;
+  ArenaAllocator arena(1 << 16);
+  HugePageAllocator huge(HugePageAllocator::PageSize::k2M);
+  NumaAllocator numa(0, /*prefault=*/false);
+  LargeAllocator* all[] = {&heap, &arena, &huge, &numa};
+
+  HyperVector<kDim, bool> a, b;
+  a.Clear(); b.Clear();
+  for (std::size_t i = 0; i < kDim; i += 3) a.SetBit(i, true);
+  for (std::size_t i = 1; i < kDim; i += 2) b.SetBit(i, true);
+
+  for (LargeAllocator* alloc : all) {
+    PrototypeMemory<kDim, kCap> pm(alloc);
+    ASSERT_TRUE(pm.Learn(1, a));
+    ASSERT_TRUE(pm.Learn(2, b));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pm.data()) % 64u, 0u);
+    EXPECT_EQ(pm.Classify(b, 0), 2u);
+
+    ClusterMemory<kDim, kCap> cm(alloc);
+    ASSERT_TRUE(cm.Update(7, a));
+    HyperVector<kDim, bool> out;
+    cm.Finalize(7, &out);
+    EXPECT_EQ(out.Words(), a.Words());
+
+    CleanupMemory<kDim, kCap> cl(alloc);
+    ASSERT_TRUE(cl.Insert(a));
+    EXPECT_EQ(cl.Restore(a, b).Words(), a.Words());
+  }
+}
+
+}  // namespace
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "hyperstream/backend/policy.hpp"
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
 #include "hyperstream/memory/associative.hpp"
 
 namespace {
@@ -98,6 +106,111 @@ TEST(ClusterMemory, DecayReducesCounts) {
   EXPECT_TRUE(finalized.GetBit(1));
 }
 
+TEST(ClusterMemory, ClassifyScoresCountersAndBinarizedCacheTracksUpdates) {
+  static constexpr std::size_t kDim = 200;  // partial last word
+  static constexpr std::size_t kCap = 4;
+  ClusterMemory<kDim, kCap> memory;
+  EXPECT_EQ(memory.Classify(HyperVector<kDim, bool>{}, 99u), 99u);
+  EXPECT_EQ(memory.ClassifyBinarized(HyperVector<kDim, bool>{}, 99u), 99u);
+
+  std::mt19937_64 rng(63);
+  std::vector<HyperVector<kDim, bool>> centers(kCap);
+  for (auto& hv : centers) {
+    for (std::size_t i = 0; i < kDim; ++i) hv.SetBit(i, (rng() & 1ULL) != 0ULL);
+  }
+  // Noisy samples around each center.
+  auto noisy = [&](const HyperVector<kDim, bool>& c, std::size_t flips) {
+    HyperVector<kDim, bool> hv = c;
+    for (std::size_t f = 0; f < flips; ++f) {
+      const std::size_t bit = static_cast<std::size_t>(rng() % kDim);
+      hv.SetBit(bit, !hv.GetBit(bit));
+    }
+    return hv;
+  };
+  for (std::size_t round = 0; round < 5; ++round) {
+    for (std::size_t c = 0; c < kCap; ++c) ASSERT_TRUE(memory.Update(100 + c, noisy(centers[c], 20)));
+  }
+
+  // Counter scores equal the explicit signed sums, for the portable and selected kernels.
+  const auto view = memory.view();
+  const HyperVector<kDim, bool> query = noisy(centers[2], 40);
+  for (std::size_t c = 0; c < kCap; ++c) {
+    std::int64_t expected = 0;
+    for (std::size_t i = 0; i < kDim; ++i) {
+      const int s = view.sums[c * kDim + i];
+      expected += query.GetBit(i) ? s : -s;
+    }
+    EXPECT_EQ(hyperstream::core::SignedDotWords(&view.sums[c * kDim], query.Words().data(), kDim),
+              expected);
+    EXPECT_EQ(hyperstream::backend::SelectSignedDotBackend()(&view.sums[c * kDim],
+                                                             query.Words().data(), kDim),
+              expected);
+  }
+  EXPECT_EQ(memory.Classify(query), 102u);
+  EXPECT_EQ(memory.Classify(query, hyperstream::backend::SelectSignedDotBackend()), 102u);
+
+  // Binarized mode matches finalize-then-classify, before and after updates and decay.
+  auto finalized_label = [&](const HyperVector<kDim, bool>& q) {
+    PrototypeMemory<kDim, kCap> protos;
+    for (std::size_t c = 0; c < memory.size(); ++c) {
+      HyperVector<kDim, bool> hv;
+      memory.Finalize(view.labels[c], &hv);
+      protos.Learn(view.labels[c], hv);
+    }
+    return protos.Classify(q, 0);
+  };
+  for (std::size_t c = 0; c < kCap; ++c) {
+    const HyperVector<kDim, bool> q = noisy(centers[c], 30);
+    EXPECT_EQ(memory.ClassifyBinarized(q), finalized_label(q));
+    EXPECT_EQ(memory.ClassifyBinarized(q), 100u + c);
+  }
+  // Pull cluster 101 onto center 3: the cached prototype must be rebuilt.
+  for (std::size_t round = 0; round < 20; ++round) ASSERT_TRUE(memory.Update(101, centers[3]));
+  EXPECT_EQ(memory.ClassifyBinarized(centers[3]), finalized_label(centers[3]));
+  EXPECT_EQ(memory.ClassifyBinarized(centers[3]), 101u);
+  memory.ApplyDecay(0.25f);
+  for (std::size_t c = 0; c < kCap; ++c) {
+    EXPECT_EQ(memory.ClassifyBinarized(centers[c]), finalized_label(centers[c]));
+  }
+}
+
+TEST(ClusterMemory, SignedDotIsExactForLargeCounters) {
+  // Counters far beyond the 2^25 range at which 64-counter int32 partial sums overflow, including
+  // INT_MIN; the portable and selected kernels must agree with the exact int64 sum.
+  std::mt19937_64 rng(63);
+  for (std::size_t dim : {256u, 300u}) {
+    std::vector<int> counters(dim);
+    std::vector<std::uint64_t> words((dim + 63) / 64);
+    for (auto& w : words) w = rng();
+    for (std::size_t i = 0; i < dim; ++i) {
+      counters[i] = (i % 3 == 0) ? std::numeric_limits<int>::min()
+                                 : static_cast<int>(rng() % 2 ? std::numeric_limits<int>::max() - i : (1 << 30) + i);
+    }
+    std::int64_t expected = 0;
+    for (std::size_t i = 0; i < dim; ++i) {
+      const std::int64_t c = counters[i];
+      expected += ((words[i / 64] >> (i % 64)) & 1ULL) ? c : -c;
+    }
+    EXPECT_EQ(hyperstream::core::SignedDotWords(counters.data(), words.data(), dim), expected) << dim;
+    EXPECT_EQ(hyperstream::backend::SelectSignedDotBackend()(counters.data(), words.data(), dim), expected) << dim;
+  }
+
+  // A long-trained cluster (large counters) still wins for its own center.
+  static constexpr std::size_t kDim = 512;
+  ClusterMemory<kDim, 2> memory;
+  HyperVector<kDim, bool> a, b;
+  for (auto& w : a.Words()) w = rng();
+  for (auto& w : b.Words()) w = rng();
+  ASSERT_TRUE(memory.Update(1, a));
+  ASSERT_TRUE(memory.Update(2, b));
+  ASSERT_TRUE(memory.Reinforce(1, a, 1 << 30));
+  ASSERT_TRUE(memory.Reinforce(2, b, 1 << 26));
+  EXPECT_EQ(memory.Classify(a), 1u);
+  EXPECT_EQ(memory.Classify(a, hyperstream::backend::SelectSignedDotBackend()), 1u);
+  EXPECT_EQ(memory.Classify(b), 2u);
+  EXPECT_EQ(memory.Classify(b, hyperstream::backend::SelectSignedDotBackend()), 2u);
+}
+
 TEST(CleanupMemory, RestoreReturnsNearestStoredHV) {
   static constexpr std::size_t kDim = 64;
   CleanupMemory<kDim, 3> cleanup;
@@ -143,6 +256,130 @@ TEST(PrototypeMemory, ZeroCapacityBehavior) {
   EXPECT_EQ(memory.Classify(query, kDefault), kDefault) << "Empty memory should return default label";
 }
 
+// Prefetching, tiling and calibration are performance-only: labels (including the first-wins tie
+// rule, exercised by duplicate prototypes) must match the plain single-query scan.
+TEST(PrototypeMemory, BatchAndTunedScansMatchSingleClassify) {
+  static constexpr std::size_t kDim = 256;
+  static constexpr std::size_t kCap = 300;
+  PrototypeMemory<kDim, kCap> memory;
+  std::mt19937_64 rng(0xA550C1A7EULL);
+  std::vector<HyperVector<kDim, bool>> protos(kCap);
+  for (std::size_t i = 0; i < kCap; ++i) {
+    if (i % 7 == 3) {
+      protos[i] = protos[i - 1];  // exact duplicate: ties must resolve to the earlier entry
+    } else {
+      for (auto& w : protos[i].Words()) w = rng();
+    }
+    ASSERT_TRUE(memory.Learn(1000 + i, protos[i]));
+  }
+  std::vector<HyperVector<kDim, bool>> queries(70);  // not a multiple of kBatchQueryBlock
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    queries[q] = protos[(q * 37) % kCap];
+    for (std::size_t f = 0; f < 40; ++f) {
+      const std::size_t bit = static_cast<std::size_t>(rng() % kDim);
+      queries[q].SetBit(bit, !queries[q].GetBit(bit));
+    }
+  }
+  std::vector<std::uint64_t> expected(queries.size());
+  for (std::size_t q = 0; q < queries.size(); ++q) expected[q] = memory.Classify(queries[q], 0);
+
+  const std::size_t entry = sizeof(PrototypeMemory<kDim, kCap>::Entry);
+  for (std::size_t distance : {std::size_t{0}, std::size_t{1}, std::size_t{5}, std::size_t{500}}) {
+    for (std::size_t tile_bytes : {std::size_t{0}, entry * 7, entry * kCap * 2}) {
+      memory.set_scan_tuning({distance, tile_bytes});
+      std::vector<std::uint64_t> labels(queries.size(), 0);
+      memory.ClassifyBatch(queries.data(), queries.size(), labels.data(), 0);
+      EXPECT_EQ(labels, expected) << "distance=" << distance << " tile_bytes=" << tile_bytes;
+      for (std::size_t q = 0; q < queries.size(); ++q) {
+        EXPECT_EQ(memory.Classify(queries[q], 0), expected[q]);
+      }
+    }
+  }
+
+  const std::size_t chosen = memory.CalibratePrefetchDistance(1);
+  EXPECT_EQ(memory.scan_tuning().prefetch_distance, chosen);
+  EXPECT_NE(std::find(std::begin(hyperstream::memory::kPrefetchDistanceCandidates),
+                      std::end(hyperstream::memory::kPrefetchDistanceCandidates), chosen),
+            std::end(hyperstream::memory::kPrefetchDistanceCandidates));
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    EXPECT_EQ(memory.Classify(queries[q], 0), expected[q]);
+  }
+
+  PrototypeMemory<kDim, kCap> empty;
+  std::uint64_t label = 0;
+  empty.ClassifyBatch(queries.data(), 1, &label, 42);
+  EXPECT_EQ(label, 42u);
+}
+
+// Exact cascade must reproduce the full scan (ties included) for any prefix length; approximate
+// mode with an unbounded margin is exact too, and a zero margin refines far fewer entries.
+TEST(PrototypeMemory, CascadeExactMatchesClassifyAndApproximateTradesWork) {
+  static constexpr std::size_t kDim = 1000;  // 16 words, partial last word
+  static constexpr std::size_t kCap = 200;
+  using hyperstream::memory::CascadeMode;
+  using hyperstream::memory::CascadeOptions;
+  using hyperstream::memory::CascadeStats;
+  PrototypeMemory<kDim, kCap> memory;
+  CleanupMemory<kDim, kCap> cleanup;
+  std::mt19937_64 rng(0xCA5CADEULL);
+  std::vector<HyperVector<kDim, bool>> protos(kCap);
+  for (std::size_t i = 0; i < kCap; ++i) {
+    if (i % 9 == 5) {
+      protos[i] = protos[i - 2];  // duplicates: first entry must win
+    } else {
+      for (auto& w : protos[i].Words()) w = rng();
+      protos[i].Words().back() &= (1ULL << (kDim % 64)) - 1;
+    }
+    ASSERT_TRUE(memory.Learn(i, protos[i]));
+    ASSERT_TRUE(cleanup.Insert(protos[i]));
+  }
+
+  std::size_t exact_refined = 0;
+  std::size_t tight_refined = 0;
+  for (std::size_t q = 0; q < 60; ++q) {
+    HyperVector<kDim, bool> query = protos[(q * 13) % kCap];
+    const std::size_t flips = (q % 3) * 150;  // 0%, 15%, 30% noise
+    for (std::size_t f = 0; f < flips; ++f) {
+      const std::size_t bit = static_cast<std::size_t>(rng() % kDim);
+      query.SetBit(bit, !query.GetBit(bit));
+    }
+    const std::uint64_t expected = memory.Classify(query, 0);
+    for (std::size_t prefix : {std::size_t{0}, std::size_t{1}, std::size_t{4}, std::size_t{15},
+                               std::size_t{16}, std::size_t{64}}) {
+      CascadeOptions exact;
+      exact.prefix_words = prefix;
+      CascadeStats stats;
+      EXPECT_EQ(memory.ClassifyCascade(query, exact, 0, &stats), expected) << "prefix=" << prefix;
+      EXPECT_EQ(stats.prefix_words, prefix < 16 ? prefix : 16u);
+      if (prefix == 4) exact_refined += stats.refined;
+
+      CascadeOptions loose = exact;
+      loose.mode = CascadeMode::kApproximate;
+      loose.margin_bits = kDim;
+      EXPECT_EQ(memory.ClassifyCascade(query, loose, 0), expected);
+
+      const auto restored = cleanup.RestoreCascade(query, query, exact);
+      EXPECT_TRUE(restored.Words() == cleanup.Restore(query, query).Words());
+    }
+    CascadeOptions tight;
+    tight.prefix_words = 4;
+    tight.mode = CascadeMode::kApproximate;
+    tight.margin_bits = 0;
+    CascadeStats stats;
+    const std::uint64_t approx = memory.ClassifyCascade(query, tight, 0, &stats);
+    tight_refined += stats.refined;
+    if (flips == 0) {
+      EXPECT_EQ(approx, expected) << "exact copy has prefix distance 0";
+    }
+  }
+  EXPECT_LT(tight_refined, exact_refined);
+
+  PrototypeMemory<kDim, kCap> empty;
+  CascadeStats stats;
+  EXPECT_EQ(empty.ClassifyCascade(protos[0], CascadeOptions{}, 9, &stats), 9u);
+  EXPECT_EQ(stats.refined, 0u);
+}
+
 TEST(CleanupMemory, ZeroCapacityBehavior) {
   static constexpr std::size_t kDim = 32;
   static constexpr std::size_t kCap = 0;
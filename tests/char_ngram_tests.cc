@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/char_ngram.hpp"
+
+namespace {
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::BitSlicedBundler;
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::CharNGramEncoder;
+
+template <std::size_t D>
+void ExpectBitSlicedMatchesBinaryBundler() {
+  std::mt19937_64 rng(D);
+  BinaryBundler<D> reference;
+  BitSlicedBundler<D> sliced;
+  HyperVector<D, bool> hv, expected, got;
+  for (std::size_t n = 1; n <= 1200; ++n) {
+    for (auto& w : hv.Words()) w = rng() & rng();  // biased bits: counters drift away from 0
+    if (D % 64 != 0) hv.Words().back() &= ~0ULL >> (64 - D % 64);
+    reference.Accumulate(hv);
+    sliced.Accumulate(hv);
+    if (n <= 3 || n % 127 == 0 || n % 255 <= 1) {  // around the plane folds, even counts (ties)
+      reference.Finalize(&expected);
+      sliced.Finalize(&got);
+      ASSERT_EQ(got.Words(), expected.Words()) << "n=" << n;
+    }
+  }
+  sliced.Reset();
+  sliced.Finalize(&got);
+  for (std::size_t i = 0; i < D; ++i) ASSERT_TRUE(got.GetBit(i));  // empty window: all ties
+}
+
+TEST(BitSlicedBundler, FinalizeMatchesBinaryBundler) {
+  ExpectBitSlicedMatchesBinaryBundler<1000>();
+  ExpectBitSlicedMatchesBinaryBundler<1024>();
+}
+
+// Reference: every n-gram built from scratch as in SequentialNGramEncoder, majority-bundled.
+template <std::size_t D, std::size_t N>
+void ReferenceEncode(const std::string& text, std::uint64_t seed, HyperVector<D, bool>* out) {
+  BinaryBundler<D> bundler;
+  for (std::size_t t = N - 1; t < text.size(); ++t) {
+    HyperVector<D, bool> ngram;
+    ngram.Clear();
+    for (std::size_t i = 0; i < N; ++i) {
+      HyperVector<D, bool> hv, rotated;
+      hyperstream::encoding::detail::GenerateRandomHypervector(seed, static_cast<unsigned char>(text[t - i]), &hv);
+      hyperstream::core::PermuteRotate(hv, i, &rotated);
+      hyperstream::core::Bind(ngram, rotated, &ngram);
+    }
+    bundler.Accumulate(ngram);
+  }
+  bundler.Finalize(out);
+}
+
+template <std::size_t D, std::size_t N>
+void ExpectMatchesReference(const std::string& text) {
+  const std::uint64_t seed = 0x27d4eb2f165667c5ULL;
+  CharNGramEncoder<D, N> encoder(seed);
+  HyperVector<D, bool> expected, got;
+  ReferenceEncode<D, N>(text, seed, &expected);
+  encoder.Encode(text, &got);
+  EXPECT_EQ(got.Words(), expected.Words()) << "D=" << D << " N=" << N;
+  EXPECT_EQ(encoder.ngram_count(), text.size() >= N ? text.size() - N + 1 : 0);
+}
+
+TEST(CharNGramEncoder, MatchesNGramsBuiltFromScratch) {
+  std::mt19937_64 rng(7);
+  std::string text;
+  for (int i = 0; i < 700; ++i) text.push_back(static_cast<char>(i % 3 == 0 ? rng() & 0xff : 'a' + rng() % 6));
+  ExpectMatchesReference<1000, 3>(text);
+  ExpectMatchesReference<1024, 3>(text);
+  ExpectMatchesReference<1000, 1>(text);
+  ExpectMatchesReference<256, 5>(text);
+  ExpectMatchesReference<1000, 3>("ab");  // shorter than N: no n-grams
+}
+
+TEST(CharNGramEncoder, SplitUpdatesContinueTheStream) {
+  const std::string text = "the quick brown fox jumps over the lazy dog; le renard brun saute";
+  CharNGramEncoder<2048, 4> whole;
+  CharNGramEncoder<2048, 4> pieces;
+  HyperVector<2048, bool> a, b;
+  whole.Encode(text, &a);
+  pieces.Update("xyz");  // discarded by Reset
+  pieces.Reset();
+  for (std::size_t pos = 0; pos < text.size(); pos += 1 + pos % 5) pieces.Update(text.substr(pos, 1 + pos % 5));
+  pieces.Finalize(&b);
+  EXPECT_EQ(a.Words(), b.Words());
+  EXPECT_EQ(whole.ngram_count(), pieces.ngram_count());
+  EXPECT_EQ(whole.ngram().Words(), pieces.ngram().Words());
+}
+
+}  // namespace
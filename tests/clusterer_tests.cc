@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/clusterer.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::StreamingClusterer;
+using hyperstream::memory::StreamingClustererOptions;
+using hyperstream::test::ReverseExecutor;
+
+constexpr std::size_t kDim = 2048;
+constexpr std::size_t kCenters = 6;
+
+// Noisy copies (10% flips) of kCenters random centers; truth[i] is the center of stream[i].
+struct Stream {
+  std::vector<HyperVector<kDim, bool>> vectors;
+  std::vector<std::size_t> truth;
+};
+
+Stream MakeStream(std::size_t n, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<HyperVector<kDim, bool>> centers(kCenters);
+  for (auto& c : centers) {
+    for (auto& w : c.Words()) w = rng();
+  }
+  Stream s;
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t c = static_cast<std::size_t>(rng() % kCenters);
+    HyperVector<kDim, bool> hv = centers[c];
+    for (std::size_t f = 0; f < kDim / 10; ++f) {
+      const std::size_t bit = static_cast<std::size_t>(rng() % kDim);
+      hv.SetBit(bit, !hv.GetBit(bit));
+    }
+    s.vectors.push_back(hv);
+    s.truth.push_back(c);
+  }
+  return s;
+}
+
+// Every center maps to exactly one cluster id and every cluster id to one center.
+void ExpectPure(const Stream& s, const std::vector<std::uint64_t>& ids) {
+  std::map<std::size_t, std::uint64_t> by_center;
+  std::map<std::uint64_t, std::size_t> by_id;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    const auto c = by_center.emplace(s.truth[i], ids[i]).first;
+    EXPECT_EQ(c->second, ids[i]) << "vector " << i;
+    const auto d = by_id.emplace(ids[i], s.truth[i]).first;
+    EXPECT_EQ(d->second, s.truth[i]) << "vector " << i;
+  }
+}
+
+TEST(StreamingClusterer, AssignFindsOneClusterPerCenter) {
+  const Stream s = MakeStream(600, 1);
+  StreamingClusterer<kDim, 16> clusterer;
+  std::vector<std::uint64_t> ids;
+  for (const auto& hv : s.vectors) ids.push_back(clusterer.Assign(hv));
+  EXPECT_EQ(clusterer.size(), kCenters);
+  ExpectPure(s, ids);
+  // Counts add up and each centroid is close to its members.
+  const auto view = clusterer.memory().view();
+  int total = 0;
+  for (std::size_t c = 0; c < view.size; ++c) total += view.counts[c];
+  EXPECT_EQ(total, 600);
+  clusterer.Refresh();
+  for (std::size_t i = 0; i < s.vectors.size(); i += 37) {
+    EXPECT_LT(hyperstream::core::HammingDistance(s.vectors[i], clusterer.centroid(ids[i])), kDim / 5);
+  }
+}
+
+TEST(StreamingClusterer, BatchAssignmentIsExecutorIndependent) {
+  const Stream s = MakeStream(640, 2);
+  auto hamming = [](const HyperVector<kDim, bool>& a, const HyperVector<kDim, bool>& b) {
+    return hyperstream::core::HammingDistance(a, b);
+  };
+  StreamingClusterer<kDim, 16> forward;
+  StreamingClusterer<kDim, 16> reverse;
+  std::vector<std::uint64_t> ids_f(s.vectors.size());
+  std::vector<std::uint64_t> ids_r(s.vectors.size());
+  for (std::size_t b0 = 0; b0 < s.vectors.size(); b0 += 128) {
+    forward.AssignBatch(&s.vectors[b0], 128, &ids_f[b0], hamming);
+    reverse.AssignBatch(&s.vectors[b0], 128, &ids_r[b0], hamming, ReverseExecutor{});
+  }
+  EXPECT_EQ(ids_f, ids_r);
+  EXPECT_EQ(forward.size(), kCenters);  // the first batch spawns every center exactly once
+  ExpectPure(s, ids_f);
+  for (std::size_t i = 0; i < kCenters * kDim; ++i) {
+    ASSERT_EQ(forward.memory().view().sums[i], reverse.memory().view().sums[i]);
+  }
+}
+
+TEST(StreamingClusterer, MergeCombinesShardsAndRemapsIds) {
+  const Stream s = MakeStream(900, 3);
+  StreamingClusterer<kDim, 16> whole;
+  StreamingClusterer<kDim, 16> shard_a;
+  StreamingClusterer<kDim, 16> shard_b;
+  std::vector<std::uint64_t> ids_b;
+  for (std::size_t i = 0; i < s.vectors.size(); ++i) {
+    (void)whole.Assign(s.vectors[i]);
+    if (i % 2 == 0) {
+      (void)shard_a.Assign(s.vectors[i]);
+    } else {
+      ids_b.push_back(shard_b.Assign(s.vectors[i]));
+    }
+  }
+  std::vector<std::uint64_t> remap(shard_b.size());
+  shard_a.Merge(shard_b, remap.data());
+  ASSERT_EQ(shard_a.size(), kCenters);
+  // Shard b's vectors keep their grouping under the remapped ids.
+  std::vector<std::uint64_t> merged_ids;
+  Stream odd;
+  for (std::size_t i = 1; i < s.vectors.size(); i += 2) {
+    odd.vectors.push_back(s.vectors[i]);
+    odd.truth.push_back(s.truth[i]);
+    merged_ids.push_back(remap[ids_b[(i - 1) / 2]]);
+  }
+  ExpectPure(odd, merged_ids);
+  // Merged counters equal the single-pass counters up to cluster order.
+  const auto merged = shard_a.memory().view();
+  const auto single = whole.memory().view();
+  for (std::size_t c = 0; c < merged.size; ++c) {
+    std::size_t match = single.size;
+    for (std::size_t k = 0; k < single.size; ++k) {
+      if (hyperstream::core::HammingDistance(shard_a.centroid(c), whole.centroid(k)) < kDim / 10) match = k;
+    }
+    ASSERT_LT(match, single.size);
+    EXPECT_EQ(merged.counts[c], single.counts[match]);
+    for (std::size_t bit = 0; bit < kDim; ++bit) {
+      ASSERT_EQ(merged.sums[c * kDim + bit], single.sums[match * kDim + bit]);
+    }
+  }
+}
+
+TEST(StreamingClusterer, FullClustererAssignsFarVectorsToNearest) {
+  StreamingClustererOptions options;
+  options.refresh_every = 1;
+  StreamingClusterer<64, 2> clusterer(options);
+  std::mt19937_64 rng(4);
+  HyperVector<64, bool> hv;
+  for (int i = 0; i < 20; ++i) {
+    hv.Words()[0] = rng();
+    EXPECT_LT(clusterer.Assign(hv), 2u);
+  }
+  EXPECT_EQ(clusterer.size(), 2u);
+  EXPECT_EQ(clusterer.spawn_distance(), static_cast<std::size_t>(0.35f * 64));
+
+  StreamingClusterer<64, 0> none;
+  EXPECT_EQ(none.Assign(hv), 0u);
+  EXPECT_EQ(none.size(), 0u);
+}
+
+}  // namespace
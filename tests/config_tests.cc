@@ -28,8 +28,8 @@ TEST(Config, FootprintHelpersAreCorrectForSmallDims) {
   EXPECT_EQ(BinaryHyperVectorStorageBytes(64), static_cast<std::size_t>(8));
   // PrototypeMemory: 2 entries of (label 8 + hv 8) = 32
   EXPECT_EQ(PrototypeMemoryStorageBytes(64, 2), static_cast<std::size_t>(32));
-  // ClusterMemory: labels 2*8 + counts 2*4 + sums 2*64*4 = 8*2 + 4*2 + 512 = 536
-  EXPECT_EQ(ClusterMemoryStorageBytes(64, 2), static_cast<std::size_t>(536));
+  // ClusterMemory: labels 2*8 + counts 2*4 + sums 2*64*4 + prototypes 2*8 = 16 + 8 + 512 + 16 = 552
+  EXPECT_EQ(ClusterMemoryStorageBytes(64, 2), static_cast<std::size_t>(552));
   // CleanupMemory: 2 * 8 = 16
   EXPECT_EQ(CleanupMemoryStorageBytes(64, 2), static_cast<std::size_t>(16));
 }
@@ -265,4 +265,50 @@ TEST_F(CoreOpsTest, HammingTriangleInequality_FixedSeed) {
   EXPECT_LE(d13, d12 + d23);
 }
 
+TEST_F(CoreOpsTest, BundlerStatsReportTiesMarginsAndSaturation) {
+  using Bundler = BinaryBundler<kTestDimension>;
+  Bundler bundler;
+  Bundler::Stats stats;
+
+  // Fresh bundler: every counter is an exact tie.
+  bundler.Finalize(&result_, &stats);
+  EXPECT_EQ(stats.ties(), kTestDimension);
+  EXPECT_EQ(stats.saturated, 0u);
+
+  // hv1 + ~hv1 cancels everywhere; a third vote gives every counter margin 1.
+  HyperVector<kTestDimension, bool> inv;
+  for (size_t i = 0; i < kTestDimension; ++i) inv.SetBit(i, !hv1_.GetBit(i));
+  bundler.Accumulate(hv1_);
+  bundler.Accumulate(inv);
+  bundler.Finalize(&result_, &stats);
+  EXPECT_EQ(stats.ties(), kTestDimension);
+  bundler.Accumulate(hv2_);
+  bundler.Finalize(&result_, &stats);
+  EXPECT_EQ(stats.ties(), 0u);
+  EXPECT_EQ(stats.margin_histogram[1], kTestDimension);
+  EXPECT_EQ(stats.MarginBelowPow2(1), kTestDimension);
+
+  // Histogram always partitions Dim; 100 identical votes land in [64, inf).
+  bundler.Reset();
+  for (int i = 0; i < 100; ++i) bundler.Accumulate(hv3_);
+  bundler.Finalize(&result_, &stats);
+  size_t total = 0;
+  for (size_t n : stats.margin_histogram) total += n;
+  EXPECT_EQ(total, kTestDimension);
+  EXPECT_EQ(stats.margin_histogram[Bundler::kMarginBuckets - 1], kTestDimension);
+  EXPECT_EQ(stats.MarginBelowPow2(6), 0u);
+
+  // Stats do not change the finalized vector.
+  HyperVector<kTestDimension, bool> plain;
+  bundler.Finalize(&plain);
+  EXPECT_EQ(plain.Words(), result_.Words());
+
+#if !defined(HYPERSTREAM_BUNDLER_COUNTER_WIDE)
+  for (int i = 0; i < 40000; ++i) bundler.Accumulate(hv3_);
+  bundler.Finalize(&result_, &stats);
+  EXPECT_EQ(stats.saturated, kTestDimension);
+  EXPECT_DOUBLE_EQ(stats.SaturatedFraction(), 1.0);
+#endif
+}
+
 }  // namespace
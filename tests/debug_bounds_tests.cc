@@ -0,0 +1,29 @@
+// Built with HYPERSTREAM_DEBUG_BOUNDS: the unchecked bit accessors abort on out-of-range indices
+// (in every build type), while in-range use behaves exactly like the checked accessors.
+#include "hyperstream/core/hypervector.hpp"
+#include "gtest/gtest.h"
+
+using hyperstream::core::HyperVector;
+
+TEST(DebugBounds, InRangeAccessWorks) {
+  constexpr std::size_t D = 70;
+  HyperVector<D, bool> hv;
+  hv.Clear();
+  hv.SetBitUnchecked(D - 1, true);
+  const std::size_t idx[] = {0, 64};
+  hv.SetBits(idx, 2);
+  EXPECT_TRUE(hv.GetBitUnchecked(0));
+  EXPECT_TRUE(hv.GetBitUnchecked(64));
+  EXPECT_TRUE(hv.GetBitUnchecked(D - 1));
+  EXPECT_FALSE(hv.GetBitUnchecked(1));
+}
+
+TEST(DebugBoundsDeathTest, OutOfRangeAborts) {
+  constexpr std::size_t D = 70;
+  HyperVector<D, bool> hv;
+  hv.Clear();
+  EXPECT_DEATH({ volatile bool sink = hv.GetBitUnchecked(D); (void)sink; }, "out of range");
+  EXPECT_DEATH(hv.SetBitUnchecked(D, true), "out of range");
+  const std::size_t idx[] = {3, D + 5};
+  EXPECT_DEATH(hv.SetBits(idx, 2), "out of range");
+}
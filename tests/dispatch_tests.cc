@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <cstdlib>
+#include <random>
 #ifdef _MSC_VER
 #include <stdlib.h>
 #endif
@@ -7,6 +8,7 @@
 #include "hyperstream/backend/policy.hpp"
 #include "hyperstream/backend/capability.hpp"
 #include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
 
 
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
@@ -222,3 +224,74 @@ TEST(Dispatch, SelectedBackend_ExecutesOnHost_NoIllegalInstruction) {
   EXPECT_GE(dist, static_cast<std::size_t>(0));
 }
 
+
+namespace {
+
+template <std::size_t D>
+void FillRandom(std::mt19937_64* rng, HyperVector<D, bool>* hv) {
+  auto& w = hv->Words();
+  for (auto& x : w) x = (*rng)();
+  constexpr std::size_t extra_bits = HyperVector<D, bool>::WordCount() * 64ULL - D;
+  if constexpr (extra_bits > 0) w.back() &= ~0ULL >> extra_bits;
+}
+
+// Compile-time-specialized kernels (IsFixedDim) must agree bit-for-bit with core and with the
+// generic runtime-word_count loops of the same backend.
+template <std::size_t D>
+void CheckFixedDimKernels() {
+  using namespace hyperstream::backend;
+  static_assert(IsFixedDim(D), "dimension is expected to have a specialized kernel");
+  constexpr std::size_t kWords = HyperVector<D, bool>::WordCount();
+  std::mt19937_64 rng(D);
+  for (int trial = 0; trial < 8; ++trial) {
+    HyperVector<D, bool> a, b, core_out, out;
+    FillRandom(&rng, &a);
+    FillRandom(&rng, &b);
+    if (trial == 0) b = a;  // distance 0
+    hyperstream::core::Bind(a, b, &core_out);
+    const std::size_t core_dist = hyperstream::core::HammingDistance(a, b);
+#if HS_X86_ARCH
+    sse2::BindSSE2(a, b, &out);
+    EXPECT_TRUE(out.Words() == core_out.Words()) << "sse2 bind D=" << D;
+    EXPECT_EQ(sse2::HammingDistanceSSE2(a, b), core_dist) << "sse2 D=" << D;
+    EXPECT_EQ(sse2::HammingWords(a.Words().data(), b.Words().data(), kWords), core_dist);
+    if (HasFeature(GetCpuFeatureMask(), CpuFeature::AVX2)) {
+      avx2::BindAVX2(a, b, &out);
+      EXPECT_TRUE(out.Words() == core_out.Words()) << "avx2 bind D=" << D;
+      EXPECT_EQ(avx2::HammingDistanceAVX2(a, b), core_dist) << "avx2 D=" << D;
+      EXPECT_EQ(avx2::HammingWords(a.Words().data(), b.Words().data(), kWords), core_dist);
+    }
+#elif HS_ARM64_ARCH
+    neon::BindNEON(a, b, &out);
+    EXPECT_TRUE(out.Words() == core_out.Words()) << "neon bind D=" << D;
+    EXPECT_EQ(neon::HammingDistanceNEON(a, b), core_dist) << "neon D=" << D;
+    EXPECT_EQ(neon::HammingWords(a.Words().data(), b.Words().data(), kWords), core_dist);
+#else
+    (void)kWords;
+#endif
+  }
+  // All bits differ: exercises the widest per-byte counts in every block.
+  HyperVector<D, bool> zeros, ones;
+  zeros.Clear();
+  ones.Clear();
+  for (std::size_t i = 0; i < D; ++i) ones.SetBit(i, true);
+#if HS_X86_ARCH
+  EXPECT_EQ(sse2::HammingDistanceSSE2(zeros, ones), D);
+  if (HasFeature(GetCpuFeatureMask(), CpuFeature::AVX2)) {
+    EXPECT_EQ(avx2::HammingDistanceAVX2(zeros, ones), D);
+  }
+#elif HS_ARM64_ARCH
+  EXPECT_EQ(neon::HammingDistanceNEON(zeros, ones), D);
+#endif
+}
+
+}  // namespace
+
+TEST(Dispatch, FixedDimKernels_MatchCoreAndGeneric) {
+  CheckFixedDimKernels<1024>();
+  CheckFixedDimKernels<2048>();
+  CheckFixedDimKernels<4096>();
+  CheckFixedDimKernels<8192>();
+  CheckFixedDimKernels<10000>();
+  EXPECT_FALSE(hyperstream::backend::IsFixedDim(10048));
+}
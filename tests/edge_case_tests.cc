@@ -94,6 +94,36 @@ TEST(EdgeCaseTests, OutOfRangeThrows) {
     EXPECT_THROW(hv.SetBit(D, true), std::out_of_range);
 }
 
+// Unchecked and bulk accessors agree with the checked GetBit/SetBit, including a partial last word
+TEST(EdgeCaseTests, UncheckedAndBulkAccessorsMatchChecked) {
+    constexpr size_t D = 130;
+    HyperVector<D, bool> checked, unchecked, bulk;
+    checked.Clear();
+    unchecked.Clear();
+    bulk.Clear();
+    const size_t idx[] = {0, 1, 63, 64, 65, 127, 128, 129, 64};  // duplicate is harmless
+    for (size_t i : idx) {
+        checked.SetBit(i, true);
+        unchecked.SetBitUnchecked(i, true);
+    }
+    bulk.SetBits(idx, sizeof(idx) / sizeof(idx[0]));
+    EXPECT_TRUE(checked.Words() == unchecked.Words());
+    EXPECT_TRUE(checked.Words() == bulk.Words());
+    for (size_t i = 0; i < D; ++i) {
+        EXPECT_EQ(unchecked.GetBitUnchecked(i), checked.GetBit(i)) << "bit " << i;
+    }
+    unchecked.SetBitUnchecked(64, false);
+    EXPECT_FALSE(unchecked.GetBit(64));
+
+    bool bits[D];
+    checked.ToBools(bits);
+    for (size_t i = 0; i < D; ++i) EXPECT_EQ(bits[i], checked.GetBit(i));
+    HyperVector<D, bool> round;
+    round.FromBools(bits);
+    EXPECT_TRUE(round.Words() == checked.Words());
+    EXPECT_EQ(round.Words().back() >> (D % 64), 0u) << "padding bits must stay zero";
+}
+
 // Float and complex types: value set/get and cosine similarity
 TEST(EdgeCaseTests, FloatAndComplexTypes) {
     constexpr size_t D = 16;
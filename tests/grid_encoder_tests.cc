@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/grid.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::HammingDistance;
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::FractionalPowerEncoder;
+using hyperstream::encoding::FractionalPowerKernel;
+using hyperstream::encoding::GridEncoder;
+using hyperstream::encoding::GridPositionCode;
+using hyperstream::test::ReverseExecutor;
+
+// Bind column, row and intensity per pixel, then BinaryBundler.
+template <std::size_t D>
+void Reference(const GridEncoder<D>& enc, const std::uint8_t* pixels, std::size_t stride, std::size_t x0,
+               std::size_t y0, std::size_t w, std::size_t h, HyperVector<D, bool>* out) {
+  BinaryBundler<D> bundler;
+  HyperVector<D, bool> pos, bound;
+  for (std::size_t y = 0; y < h; ++y) {
+    for (std::size_t x = 0; x < w; ++x) {
+      enc.Position(x0 + x, y0 + y, &pos);
+      hyperstream::core::Bind(pos, enc.intensity(enc.IntensityLevel(pixels[y * stride + x])), &bound);
+      bundler.Accumulate(bound);
+    }
+  }
+  bundler.Finalize(out);
+}
+
+TEST(GridEncoder, MatchesPerPixelBindAndBundle) {
+  static constexpr std::size_t D = 1000;  // partial last word
+  std::mt19937_64 rng(75);
+  const std::size_t width = 40, height = 70;  // 3 row bands, the last one partial
+  std::vector<std::uint8_t> img(width * height);
+  for (auto& p : img) p = static_cast<std::uint8_t>(rng());
+  for (GridPositionCode code : {GridPositionCode::kLevel, GridPositionCode::kFractionalPower}) {
+    const GridEncoder<D> enc(width, height, 9, code, 8);
+    HyperVector<D, bool> got, expected;
+    enc.Encode(img.data(), &got);
+    Reference(enc, img.data(), width, 0, 0, width, height, &expected);
+    EXPECT_EQ(got.Words(), expected.Words());
+    enc.Encode(img.data(), &got, ReverseExecutor{});
+    EXPECT_EQ(got.Words(), expected.Words());
+
+    // Patch at an offset; an even pixel count exercises ties -> 1.
+    const std::uint8_t* patch = img.data() + 5 * width + 3;
+    enc.EncodePatch(patch, width, 3, 5, 6, 35, &got, ReverseExecutor{});
+    Reference(enc, patch, width, 3, 5, 6, 35, &expected);
+    EXPECT_EQ(got.Words(), expected.Words());
+  }
+}
+
+TEST(GridEncoder, PatchIsClippedToTheGrid) {
+  static constexpr std::size_t D = 256;
+  const GridEncoder<D> enc(8, 8);
+  std::vector<std::uint8_t> img(64, 200);
+  HyperVector<D, bool> clipped, inside, empty;
+  enc.EncodePatch(img.data() + 6 * 8 + 6, 8, 6, 6, 10, 10, &clipped);
+  enc.EncodePatch(img.data() + 6 * 8 + 6, 8, 6, 6, 2, 2, &inside);
+  EXPECT_EQ(clipped.Words(), inside.Words());
+  enc.EncodePatch(img.data(), 8, 8, 0, 4, 4, &empty);  // outside: empty bundle, all ties
+  for (std::size_t i = 0; i < D; ++i) ASSERT_TRUE(empty.GetBit(i));
+}
+
+TEST(GridEncoder, LevelPositionsAreCorrelatedAndEndsOrthogonal) {
+  static constexpr std::size_t D = 2048;
+  const GridEncoder<D> enc(33, 17, 3);
+  EXPECT_EQ(HammingDistance(enc.column(0), enc.column(32)), D / 2);
+  EXPECT_EQ(HammingDistance(enc.row(0), enc.row(16)), D / 2);
+  EXPECT_EQ(HammingDistance(enc.column(0), enc.column(1)), D / 2 / 32);
+  EXPECT_LT(HammingDistance(enc.column(4), enc.column(6)), HammingDistance(enc.column(4), enc.column(12)));
+  EXPECT_EQ(HammingDistance(enc.intensity(0), enc.intensity(15)), D / 2);
+  EXPECT_EQ(enc.IntensityLevel(0), 0u);
+  EXPECT_EQ(enc.IntensityLevel(255), 15u);
+  // Independent codebooks: column and row vectors are unrelated.
+  const double d = static_cast<double>(HammingDistance(enc.column(0), enc.row(0))) / D;
+  EXPECT_NEAR(d, 0.5, 0.05);
+}
+
+TEST(GridEncoder, FractionalPowerPositionsFollowTheEncoder) {
+  static constexpr std::size_t D = 1024;
+  const GridEncoder<D> enc(16, 16, 11, GridPositionCode::kFractionalPower, 16, 3.0);
+  const FractionalPowerEncoder<D> fx(11 ^ 0x58ULL, 3.0, FractionalPowerKernel::kGaussian);
+  HyperVector<D, bool> hv;
+  fx.Encode(7.0, &hv);
+  EXPECT_EQ(enc.column(7).Words(), hv.Words());
+  EXPECT_LT(HammingDistance(enc.row(5), enc.row(6)), HammingDistance(enc.row(5), enc.row(14)));
+}
+
+TEST(GridEncoder, SimilarImagesEncodeCloserThanDifferentOnes) {
+  static constexpr std::size_t D = 4096;
+  const std::size_t n = 32;
+  const GridEncoder<D> enc(n, n);
+  std::vector<std::uint8_t> a(n * n), b(n * n), c(n * n);
+  for (std::size_t y = 0; y < n; ++y) {
+    for (std::size_t x = 0; x < n; ++x) {
+      a[y * n + x] = static_cast<std::uint8_t>(x * 8);           // horizontal ramp
+      b[y * n + x] = static_cast<std::uint8_t>(x * 8 + (y % 3));  // same ramp, slight noise
+      c[y * n + x] = static_cast<std::uint8_t>(y * 8);           // vertical ramp
+    }
+  }
+  HyperVector<D, bool> ha, hb, hc;
+  enc.Encode(a.data(), &ha);
+  enc.Encode(b.data(), &hb);
+  enc.Encode(c.data(), &hc);
+  EXPECT_LT(HammingDistance(ha, hb), HammingDistance(ha, hc));
+}
+
+}  // namespace
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "hyperstream/backend/capability.hpp"
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/hamming_matrix.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::backend::HammingTileFn;
+using hyperstream::core::HyperVector;
+using hyperstream::memory::HammingMatrixOptions;
+using hyperstream::memory::HammingNeighbor;
+using hyperstream::test::ReverseExecutor;
+
+template <std::size_t Dim>
+std::vector<HyperVector<Dim, bool>> RandomSet(std::size_t n, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<HyperVector<Dim, bool>> v(n);
+  for (auto& hv : v) {
+    for (auto& w : hv.Words()) w = rng();
+    if (Dim % 64 != 0) hv.Words().back() &= (1ULL << (Dim % 64)) - 1ULL;
+  }
+  return v;
+}
+
+// Every kernel the host can run: portable, AVX2 and AVX-512 when present, and the selected one.
+std::vector<HammingTileFn> TileKernels() {
+  std::vector<HammingTileFn> fns = {&hyperstream::core::HammingTileWords,
+                                    hyperstream::backend::SelectHammingTileBackend()};
+#if HS_X86_ARCH && !defined(HYPERSTREAM_FORCE_SCALAR)
+  using hyperstream::backend::CpuFeature;
+  const std::uint32_t mask = hyperstream::backend::GetCpuFeatureMask();
+  if (hyperstream::backend::HasFeature(mask, CpuFeature::SSE2)) {
+    fns.push_back(&hyperstream::backend::sse2::HammingTileWords);
+  }
+  if (hyperstream::backend::HasFeature(mask, CpuFeature::AVX2)) {
+    fns.push_back(&hyperstream::backend::avx2::HammingTileWords);
+  }
+  if (hyperstream::backend::HasFeature(mask, CpuFeature::AVX512_VPOPCNTDQ)) {
+    fns.push_back(&hyperstream::backend::avx512::HammingTileWords);
+  }
+#elif HS_ARM64_ARCH && !defined(HYPERSTREAM_FORCE_SCALAR)
+  fns.push_back(&hyperstream::backend::neon::HammingTileWords);
+#endif
+  return fns;
+}
+
+template <std::size_t Dim>
+void ExpectMatrixMatchesPairwise(std::size_t n, std::size_t m) {
+  const auto a = RandomSet<Dim>(n, 64 + n);
+  const auto b = RandomSet<Dim>(m, 640 + m);
+  HammingMatrixOptions options;
+  options.row_tile = 6;         // several row blocks with a partial last one
+  options.col_tile_bytes = 1;   // minimum column tile (4 vectors)
+  for (HammingTileFn tile : TileKernels()) {
+    std::vector<std::uint32_t> out(n * m, 0xDEADBEEFu);
+    hyperstream::memory::HammingMatrix(a.data(), n, b.data(), m, out.data(), options, tile,
+                                       ReverseExecutor{});
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < m; ++j) {
+        ASSERT_EQ(out[i * m + j], hyperstream::core::HammingDistance(a[i], b[j]))
+            << "Dim=" << Dim << " i=" << i << " j=" << j;
+      }
+    }
+  }
+  std::vector<std::uint32_t> out(n * m);
+  hyperstream::memory::HammingMatrix(a.data(), n, b.data(), m, out.data());
+  EXPECT_EQ(out[(n - 1) * m + (m - 1)], hyperstream::core::HammingDistance(a[n - 1], b[m - 1]));
+}
+
+TEST(HammingMatrix, MatchesPairwiseDistanceForAllKernels) {
+  ExpectMatrixMatchesPairwise<64>(9, 11);
+  ExpectMatrixMatchesPairwise<200>(13, 7);     // partial last word, word tail < vector width
+  ExpectMatrixMatchesPairwise<640>(11, 10);    // 10 words: tiled, vector plus word tail
+  ExpectMatrixMatchesPairwise<1000>(17, 23);   // 16 words: fixed-size per-pair kernel of Dim=1024
+  ExpectMatrixMatchesPairwise<1536>(7, 6);     // 24 words: runtime per-pair kernel, vector tail
+  ExpectMatrixMatchesPairwise<4000>(6, 5);     // runtime blocks, vector and word tails
+  ExpectMatrixMatchesPairwise<10000>(5, 9);    // fixed-size kernel with tails
+}
+
+TEST(HammingMatrix, TopKMatchesSortedBruteForce) {
+  constexpr std::size_t kDim = 256;
+  const std::size_t n = 21;
+  auto set = RandomSet<kDim>(n, 99);
+  set[5] = set[2];  // duplicate: equal distances must order by index
+  set[9] = set[2];
+  for (bool skip_self : {false, true}) {
+    for (std::size_t k : {std::size_t{1}, std::size_t{4}, n + 3}) {
+      HammingMatrixOptions options;
+      options.row_tile = 4;
+      options.col_tile_bytes = 5 * sizeof(HyperVector<kDim, bool>);
+      options.skip_self = skip_self;
+      for (HammingTileFn tile : TileKernels()) {
+        std::vector<HammingNeighbor> out(n * k);
+        hyperstream::memory::HammingTopK(set.data(), n, set.data(), n, k, out.data(), options, tile);
+        for (std::size_t i = 0; i < n; ++i) {
+          std::vector<std::pair<std::uint32_t, std::uint32_t>> expected;  // (distance, index)
+          for (std::size_t j = 0; j < n; ++j) {
+            if (skip_self && j == i) continue;
+            expected.emplace_back(static_cast<std::uint32_t>(hyperstream::core::HammingDistance(set[i], set[j])),
+                                  static_cast<std::uint32_t>(j));
+          }
+          std::sort(expected.begin(), expected.end());
+          for (std::size_t p = 0; p < k; ++p) {
+            const HammingNeighbor& got = out[i * k + p];
+            if (p < expected.size()) {
+              EXPECT_EQ(got.distance, expected[p].first) << "i=" << i << " p=" << p;
+              EXPECT_EQ(got.index, expected[p].second) << "i=" << i << " p=" << p;
+            } else {
+              EXPECT_EQ(got.index, hyperstream::memory::kNoNeighbor);
+              EXPECT_EQ(got.distance, hyperstream::memory::kNoNeighbor);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
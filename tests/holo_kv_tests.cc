@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+#include "hyperstream/memory/holo_kv.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::HoloKVOptions;
+using hyperstream::memory::HoloKVStore;
+using hyperstream::test::ReverseExecutor;
+
+constexpr std::size_t kDim = 2048;
+constexpr std::size_t kValues = 64;
+
+HyperVector<kDim, bool> RandomVector(std::mt19937_64* rng) {
+  HyperVector<kDim, bool> hv;
+  for (auto& w : hv.Words()) w = (*rng)();
+  return hv;
+}
+
+TEST(HoloKVStore, ShardsAreSizedForTheTargetAccuracy) {
+  using hyperstream::memory::HoloKVAccuracy;
+  using hyperstream::memory::HoloKVPairsPerShard;
+  const std::size_t loose = HoloKVPairsPerShard(kDim, kValues, 0.9);
+  const std::size_t tight = HoloKVPairsPerShard(kDim, kValues, 0.999);
+  EXPECT_GT(loose, tight);
+  EXPECT_GE(HoloKVAccuracy(kDim, kValues, tight), 0.999);
+  EXPECT_LT(HoloKVAccuracy(kDim, kValues, tight + 1), 0.999);
+  EXPECT_EQ(HoloKVPairsPerShard(kDim, 1, 0.99), kDim);
+
+  HoloKVOptions options;
+  options.target_accuracy = 0.99;
+  options.expected_pairs = 1000;
+  std::mt19937_64 rng(1);
+  HoloKVStore<kDim, kValues> store(options);
+  EXPECT_EQ(store.pairs_per_shard(), HoloKVPairsPerShard(kDim, kValues, 0.99));
+  EXPECT_GE(store.shard_count() * store.pairs_per_shard(), options.expected_pairs);
+  for (std::size_t v = 0; v < kValues; ++v) ASSERT_EQ(store.AddValue(RandomVector(&rng)), v);
+  EXPECT_EQ(store.AddValue(RandomVector(&rng)), store.kNotFound);
+
+  std::vector<HyperVector<kDim, bool>> keys;
+  std::vector<std::size_t> values;
+  for (std::size_t i = 0; i < options.expected_pairs; ++i) {
+    keys.push_back(RandomVector(&rng));
+    values.push_back(static_cast<std::size_t>(rng() % kValues));
+    ASSERT_TRUE(store.Put(keys.back(), values.back()));
+  }
+  EXPECT_EQ(store.size(), options.expected_pairs);
+  EXPECT_GE(store.EstimatedAccuracy(), 0.98);
+  std::size_t correct = 0;
+  for (std::size_t i = 0; i < keys.size(); ++i) correct += store.Get(keys[i]) == values[i] ? 1 : 0;
+  EXPECT_GE(correct, 975u);
+  // GetValue restores the codeword itself.
+  const HyperVector<kDim, bool> restored = store.GetValue(keys[0], keys[0]);
+  EXPECT_EQ(restored.Words(), store.values().entry(store.Get(keys[0])).Words());
+}
+
+TEST(HoloKVStore, BatchedCallsMatchSingleCallsForAnyExecutorAndKernel) {
+  HoloKVOptions options;
+  options.expected_pairs = 300;
+  std::mt19937_64 rng(2);
+  HoloKVStore<kDim, kValues> single(options);
+  HoloKVStore<kDim, kValues> batched(options);
+  for (std::size_t v = 0; v < kValues; ++v) {
+    const auto hv = RandomVector(&rng);
+    (void)single.AddValue(hv);
+    (void)batched.AddValue(hv);
+  }
+  std::vector<HyperVector<kDim, bool>> keys;
+  std::vector<std::size_t> values;
+  for (std::size_t i = 0; i < 301; ++i) {
+    keys.push_back(RandomVector(&rng));
+    values.push_back(i == 7 ? kValues : static_cast<std::size_t>(rng() % kValues));  // one invalid
+    EXPECT_EQ(single.Put(keys.back(), values.back()), i != 7);
+  }
+  EXPECT_EQ(batched.PutBatch(keys.data(), values.data(), keys.size(), ReverseExecutor{}), 300u);
+  for (std::size_t s = 0; s < single.shard_count(); ++s) EXPECT_EQ(single.shard_load(s), batched.shard_load(s));
+
+  std::vector<std::size_t> portable(keys.size());
+  std::vector<std::size_t> selected(keys.size());
+  batched.GetBatch(keys.data(), keys.size(), portable.data());
+  batched.GetBatch(keys.data(), keys.size(), selected.data(), hyperstream::backend::SelectHammingTileBackend(),
+                   ReverseExecutor{});
+  EXPECT_EQ(portable, selected);
+  for (std::size_t i = 0; i < keys.size(); ++i) ASSERT_EQ(portable[i], single.Get(keys[i])) << "key " << i;
+}
+
+TEST(HoloKVStore, StructuredKeysSpreadAcrossShards) {
+  // Thermometer keys of nearby values differ in a few bits each, and keys that only differ in
+  // their middle words share both end words: routing must still balance the shards.
+  HoloKVOptions options;
+  options.expected_pairs = 2000;
+  HoloKVStore<kDim, kValues> store(options);
+  std::mt19937_64 rng(4);
+  for (std::size_t v = 0; v < kValues; ++v) (void)store.AddValue(RandomVector(&rng));
+  ASSERT_GT(store.shard_count(), 4u);
+  auto thermo = std::make_unique<hyperstream::encoding::ThermometerEncoder<kDim>>(0.0, 1.0);
+  HyperVector<kDim, bool> key;
+  for (std::size_t i = 0; i < options.expected_pairs / 2; ++i) {
+    thermo->Encode(static_cast<double>(i) / static_cast<double>(options.expected_pairs / 2), &key);
+    ASSERT_TRUE(store.Put(key, i % kValues));
+  }
+  const auto prefix = RandomVector(&rng);
+  for (std::size_t i = 0; i < options.expected_pairs / 2; ++i) {
+    key = prefix;
+    key.Words()[kDim / 128] ^= static_cast<std::uint64_t>(i + 1);
+    ASSERT_TRUE(store.Put(key, i % kValues));
+  }
+  const double mean = static_cast<double>(options.expected_pairs) / static_cast<double>(store.shard_count());
+  std::size_t max_load = 0;
+  for (std::size_t s = 0; s < store.shard_count(); ++s) max_load = std::max(max_load, store.shard_load(s));
+  EXPECT_LE(static_cast<double>(max_load), 1.5 * mean);
+  EXPECT_GE(store.EstimatedAccuracy(), 0.97);
+}
+
+TEST(HoloKVStore, EmptyCodebookAndSinglePairShards) {
+  HoloKVStore<kDim, kValues> empty;
+  std::mt19937_64 rng(3);
+  const auto key = RandomVector(&rng);
+  EXPECT_EQ(empty.Get(key), empty.kNotFound);
+  EXPECT_FALSE(empty.Put(key, 0));
+  EXPECT_EQ(empty.GetValue(key, key).Words(), key.Words());
+  std::size_t out = 0;
+  empty.GetBatch(&key, 1, &out);
+  EXPECT_EQ(out, empty.kNotFound);
+
+  // A shard holding one pair stores key ^ value exactly, so lookups are exact.
+  HoloKVStore<64, 4> tiny;
+  HyperVector<64, bool> v[4];
+  for (auto& hv : v) {
+    hv.Words()[0] = rng();
+    ASSERT_NE(tiny.AddValue(hv), tiny.kNotFound);
+  }
+  HyperVector<64, bool> k;
+  k.Words()[0] = rng();
+  ASSERT_TRUE(tiny.Put(k, 2));
+  ASSERT_EQ(tiny.shard_load(tiny.ShardOf(k)), 1u);
+  EXPECT_EQ(tiny.Get(k), 2u);
+}
+
+}  // namespace
@@ -0,0 +1,146 @@
+// Tests for the opt-in metrics surface (built with HYPERSTREAM_ENABLE_METRICS).
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/io/serialization.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/metrics.hpp"
+
+namespace {
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::HyperVector;
+using hyperstream::memory::ClusterMemory;
+using hyperstream::memory::PrototypeMemory;
+using hyperstream::metrics::Counter;
+using hyperstream::metrics::LatencyHistogram;
+using hyperstream::metrics::Op;
+using hyperstream::metrics::Registry;
+
+TEST(Metrics, EnabledForThisTarget) {
+  EXPECT_TRUE(hyperstream::metrics::kEnabled);
+}
+
+TEST(Metrics, HistogramBucketsAreLogLinear) {
+  for (std::uint64_t v = 0; v < 16; ++v) {
+    EXPECT_EQ(LatencyHistogram::BucketIndex(v), v) << "exact region";
+  }
+  // [16,32) has width-2 sub-buckets.
+  EXPECT_EQ(LatencyHistogram::BucketIndex(16), LatencyHistogram::BucketIndex(17));
+  EXPECT_NE(LatencyHistogram::BucketIndex(17), LatencyHistogram::BucketIndex(18));
+  for (std::uint64_t v : {100ULL, 1000ULL, 123456ULL, 987654321ULL}) {
+    const std::uint64_t hi = LatencyHistogram::BucketUpperBound(LatencyHistogram::BucketIndex(v));
+    EXPECT_GE(hi, v);
+    EXPECT_LE(static_cast<double>(hi - v), 0.125 * static_cast<double>(v)) << v;
+  }
+  EXPECT_EQ(LatencyHistogram::BucketIndex(~0ULL), LatencyHistogram::kBuckets - 1);
+}
+
+TEST(Metrics, HistogramQuantiles) {
+  LatencyHistogram h;
+  for (std::uint64_t v = 1; v <= 1000; ++v) h.Record(v);
+  EXPECT_EQ(h.count(), 1000u);
+  EXPECT_EQ(h.sum(), 500500u);
+  EXPECT_EQ(h.max(), 1000u);
+  const std::uint64_t p50 = h.ValueAtQuantile(0.5);
+  EXPECT_GE(p50, 500u);
+  EXPECT_LE(p50, 563u);
+  EXPECT_EQ(h.ValueAtQuantile(1.0), 1000u);
+}
+
+TEST(Metrics, MemoriesAndBundlerUpdateCounters) {
+  Registry::Instance().Reset();
+  static constexpr std::size_t kDim = 128;
+  PrototypeMemory<kDim, 8> pm;
+  HyperVector<kDim, bool> a;
+  a.Clear();
+  a.SetBit(3, true);
+  ASSERT_TRUE(pm.Learn(1, a));
+  ASSERT_TRUE(pm.Learn(2, a));
+  (void)pm.Classify(a, 0);
+  (void)pm.Classify(a, 0);
+  EXPECT_EQ(Registry::Instance().Get(Counter::PrototypeClassifyCalls), 2u);
+  EXPECT_EQ(Registry::Instance().Get(Counter::PrototypeScannedEntries), 4u);
+  EXPECT_EQ(Registry::Instance().Histogram(Op::Classify).count(), 2u);
+
+  ClusterMemory<kDim, 2> cm;
+  ASSERT_TRUE(cm.Update(9, a));
+  EXPECT_EQ(Registry::Instance().Get(Counter::ClusterUpdates), 1u);
+  EXPECT_EQ(Registry::Instance().Histogram(Op::Update).count(), 1u);
+
+  // 40000 identical votes drive every int16 counter into saturation.
+  BinaryBundler<kDim> bundler;
+  for (int i = 0; i < 40000; ++i) bundler.Accumulate(a);
+  HyperVector<kDim, bool> out;
+  bundler.Finalize(&out);
+  EXPECT_EQ(Registry::Instance().Get(Counter::BundlerAccumulates), 40000u);
+  EXPECT_EQ(Registry::Instance().Get(Counter::BundlerFinalizes), 1u);
+  EXPECT_EQ(Registry::Instance().Get(Counter::BundlerSaturatedCounters), kDim);
+}
+
+TEST(Metrics, EncodeSerializeAndBackendSelection) {
+  Registry::Instance().Reset();
+  static constexpr std::size_t kDim = 256;
+  hyperstream::encoding::HashEncoder<kDim> enc;
+  enc.Update("alpha");
+  enc.Update("beta");
+  EXPECT_EQ(Registry::Instance().Histogram(Op::Encode).count(), 2u);
+
+  PrototypeMemory<kDim, 2> pm;
+  HyperVector<kDim, bool> hv;
+  hv.Clear();
+  ASSERT_TRUE(pm.Learn(5, hv));
+  std::stringstream ss;
+  ASSERT_TRUE(hyperstream::io::SavePrototype(ss, pm));
+  PrototypeMemory<kDim, 2> loaded;
+  ASSERT_TRUE(hyperstream::io::LoadPrototype(ss, &loaded));
+  EXPECT_EQ(Registry::Instance().Get(Counter::SerializeSaves), 1u);
+  EXPECT_EQ(Registry::Instance().Get(Counter::SerializeLoads), 1u);
+  EXPECT_EQ(Registry::Instance().Histogram(Op::Serialize).count(), 2u);
+
+  (void)hyperstream::backend::SelectBindBackend<kDim>(0u);
+  (void)hyperstream::backend::SelectHammingBackend<kDim>();
+  std::uint64_t bind_total = 0, hamming_total = 0;
+  for (int k = 0; k < 4; ++k) {
+    bind_total += Registry::Instance().Get(static_cast<Counter>(static_cast<int>(Counter::BindSelectScalar) + k));
+    hamming_total +=
+        Registry::Instance().Get(static_cast<Counter>(static_cast<int>(Counter::HammingSelectScalar) + k));
+  }
+  EXPECT_EQ(bind_total, 1u);
+  EXPECT_EQ(hamming_total, 1u);
+#if HS_X86_ARCH
+  EXPECT_EQ(Registry::Instance().Get(Counter::BindSelectScalar), 1u) << "mask=0 selects scalar";
+#endif
+}
+
+TEST(Metrics, SnapshotIsNdjson) {
+  Registry::Instance().Reset();
+  PrototypeMemory<64, 1> pm;
+  HyperVector<64, bool> q;
+  q.Clear();
+  (void)pm.Classify(q, 0);
+  const std::string snap = hyperstream::metrics::SnapshotNdjson();
+  std::istringstream lines(snap);
+  std::string line;
+  int counters = 0, latencies = 0;
+  while (std::getline(lines, line)) {
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.front(), '{');
+    EXPECT_EQ(line.back(), '}');
+    if (line.find("\"name\":\"metrics/counter\"") != std::string::npos) ++counters;
+    if (line.find("\"name\":\"metrics/latency\"") != std::string::npos) ++latencies;
+  }
+  EXPECT_EQ(counters, static_cast<int>(Counter::kCount));
+  EXPECT_EQ(latencies, 1) << "only non-empty histograms are emitted";
+  EXPECT_NE(snap.find("\"metric\":\"prototype_classify_calls\",\"value\":1"), std::string::npos);
+  EXPECT_NE(snap.find("\"op\":\"classify\",\"count\":1"), std::string::npos);
+}
+
+}  // namespace
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
 #include <cstdint>
 #include <vector>
 
@@ -6,11 +8,16 @@
 #include "hyperstream/core/ops.hpp"
 #include "hyperstream/encoding/numeric.hpp"
 
+#include "test_executors.hpp"
+
 namespace {
 
 using hyperstream::core::HyperVector;
 using hyperstream::encoding::ThermometerEncoder;
 using hyperstream::encoding::RandomProjectionEncoder;
+using hyperstream::encoding::FractionalPowerEncoder;
+using hyperstream::encoding::FractionalPowerKernel;
+using hyperstream::test::ReverseExecutor;
 
 static int CountOnes128(const HyperVector<128, bool>& hv) {
   int c = 0;
@@ -82,5 +89,81 @@ TEST(RandomProjectionEncoder, SignInversionFlipsManyBits) {
   EXPECT_GT(frac, 0.60) << frac;
 }
 
+TEST(FractionalPowerEncoder, ComplexSimilarityApproximatesKernel) {
+  static constexpr std::size_t D = 8192;
+  const double tol = 4.0 / std::sqrt(static_cast<double>(D));
+  for (auto kernel : {FractionalPowerKernel::kSinc, FractionalPowerKernel::kGaussian}) {
+    FractionalPowerEncoder<D> enc(0x5eedULL, 2.0, kernel);
+    HyperVector<D, std::complex<float>> a, b;
+    enc.Encode(0.3, &a);
+    for (double d : {0.0, 0.5, 1.0, 2.0, 3.0, 6.0, -1.5}) {
+      enc.Encode(0.3 + d, &b);
+      const double sim = hyperstream::core::CosineSimilarity(a, b);
+      EXPECT_NEAR(sim, enc.Kernel(0.3, 0.3 + d), tol) << "kernel=" << static_cast<int>(kernel) << " d=" << d;
+    }
+    for (std::size_t k = 0; k < D; ++k) ASSERT_NEAR(std::abs(a[k]), 1.0f, 1e-5f);
+  }
+}
+
+TEST(FractionalPowerEncoder, MultiInputEncodingBindsPerInputPhasors) {
+  static constexpr std::size_t D = 4096;
+  FractionalPowerEncoder<D, 2> enc(7, 1.5, FractionalPowerKernel::kGaussian);
+  const double x[2] = {0.25, -1.0};
+  const double y[2] = {1.0, 0.0};
+  HyperVector<D, std::complex<float>> hx, hy, hx2, hbound;
+  enc.Encode(x, &hx);
+  enc.Encode(y, &hy);
+  enc.Encode(x, &hx2);
+  EXPECT_EQ(hx.Raw(), hx2.Raw());
+  // Binding composes: z(x + y) = z(x) * z(y) / z(0), since the phases are affine in x.
+  const double sum[2] = {x[0] + y[0], x[1] + y[1]};
+  const double zero[2] = {0.0, 0.0};
+  HyperVector<D, std::complex<float>> hsum, hzero;
+  enc.Encode(sum, &hsum);
+  enc.Encode(zero, &hzero);
+  for (std::size_t k = 0; k < D; ++k) hbound[k] = hx[k] * hy[k] * std::conj(hzero[k]);
+  EXPECT_GT(hyperstream::core::CosineSimilarity(hsum, hbound), 0.99f);
+  // The 2-D kernel is the product of the per-input kernels.
+  EXPECT_NEAR(enc.Kernel(x, y), std::exp(-0.5 * (0.75 * 0.75 + 1.0) / (1.5 * 1.5)), 1e-12);
+  EXPECT_NEAR(hyperstream::core::CosineSimilarity(hx, hy), enc.Kernel(x, y), 4.0 / std::sqrt(static_cast<double>(D)));
+}
+
+TEST(FractionalPowerEncoder, BinaryExportIsLocalizedAndMonotone) {
+  static constexpr std::size_t D = 4096;
+  FractionalPowerEncoder<D> enc(11, 1.0);
+  HyperVector<D, bool> a, b;
+  enc.Encode(0.0, &a);
+  enc.Encode(0.0, &b);
+  EXPECT_EQ(a.Words(), b.Words());
+  double prev = 1.0;
+  for (double d : {0.1, 0.25, 0.5, 0.75}) {
+    enc.Encode(d, &b);
+    const double sim = hyperstream::core::NormalizedHammingSimilarity(a, b);
+    EXPECT_LT(sim, prev) << d;
+    prev = sim;
+  }
+  enc.Encode(5.0, &b);
+  EXPECT_NEAR(hyperstream::core::NormalizedHammingSimilarity(a, b), 0.0, 0.1);
+}
+
+TEST(FractionalPowerEncoder, EncodeBatchMatchesEncode) {
+  static constexpr std::size_t D = 1000;  // not a multiple of 64 or of the phase chunk
+  FractionalPowerEncoder<D, 3> enc(3, 0.7, FractionalPowerKernel::kGaussian);
+  std::vector<double> xs;
+  for (std::size_t i = 0; i < 37 * 3; ++i) xs.push_back(std::sin(static_cast<double>(i)) * 4.0);
+  std::vector<HyperVector<D, bool>> bits(37);
+  std::vector<HyperVector<D, std::complex<float>>> phasors(37);
+  enc.EncodeBatch(xs.data(), 37, bits.data(), ReverseExecutor{});
+  enc.EncodeBatch(xs.data(), 37, phasors.data());
+  for (std::size_t i = 0; i < 37; ++i) {
+    HyperVector<D, bool> b;
+    HyperVector<D, std::complex<float>> c;
+    enc.Encode(xs.data() + i * 3, &b);
+    enc.Encode(xs.data() + i * 3, &c);
+    EXPECT_EQ(bits[i].Words(), b.Words()) << i;
+    EXPECT_EQ(phasors[i].Raw(), c.Raw()) << i;
+  }
+}
+
 }  // namespace
 
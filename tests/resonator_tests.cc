@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/resonator.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::Resonator;
+using hyperstream::memory::ResonatorOutcome;
+using hyperstream::test::ReverseExecutor;
+
+template <std::size_t Dim>
+void RandomFill(std::mt19937_64* rng, HyperVector<Dim, bool>* hv) {
+  for (auto& w : hv->Words()) w = (*rng)();
+  if (Dim % 64 != 0) hv->Words().back() &= (1ULL << (Dim % 64)) - 1ULL;
+}
+
+// F codebooks of M random codewords and n products of random index tuples.
+template <std::size_t Dim>
+struct Problem {
+  Resonator<Dim> resonator;
+  std::vector<std::uint32_t> truth;  // n * F
+  std::vector<HyperVector<Dim, bool>> queries;
+};
+
+template <std::size_t Dim>
+void MakeProblem(std::size_t factors, std::size_t m, std::size_t n, std::uint64_t seed, Problem<Dim>* p) {
+  std::mt19937_64 rng(seed);
+  for (std::size_t f = 0; f < factors; ++f) {
+    std::vector<HyperVector<Dim, bool>> book(m);
+    for (auto& hv : book) RandomFill(&rng, &hv);
+    EXPECT_EQ(p->resonator.AddCodebook(book.data(), m), f);
+  }
+  p->truth.resize(n * factors);
+  p->queries.resize(n);
+  for (std::size_t q = 0; q < n; ++q) {
+    for (std::size_t f = 0; f < factors; ++f) p->truth[q * factors + f] = static_cast<std::uint32_t>(rng() % m);
+    p->resonator.Compose(&p->truth[q * factors], &p->queries[q]);
+  }
+}
+
+// An exact outcome always names the true factors (random codewords do not collide), and at this
+// size almost every product resolves.
+TEST(Resonator, FactorizesExactProducts) {
+  constexpr std::size_t kDim = 4096;
+  Problem<kDim> p;
+  MakeProblem<kDim>(3, 16, 60, 1, &p);
+  const std::size_t nf = p.resonator.factors();
+  std::vector<std::uint32_t> found(p.truth.size());
+  std::vector<ResonatorOutcome> outcomes(p.queries.size());
+  p.resonator.FactorizeBatch(p.queries.data(), p.queries.size(), found.data(), outcomes.data());
+  std::size_t exact = 0;
+  for (std::size_t q = 0; q < p.queries.size(); ++q) {
+    EXPECT_GE(outcomes[q].iterations, 1u);
+    EXPECT_LE(outcomes[q].iterations, 64u);
+    if (!outcomes[q].exact) continue;
+    ++exact;
+    EXPECT_TRUE(outcomes[q].converged);
+    for (std::size_t f = 0; f < nf; ++f) EXPECT_EQ(found[q * nf + f], p.truth[q * nf + f]) << "query " << q;
+  }
+  EXPECT_GE(exact, 57u);
+}
+
+TEST(Resonator, RecoversFactorsOfNoisyProducts) {
+  constexpr std::size_t kDim = 4096;
+  Problem<kDim> p;
+  MakeProblem<kDim>(3, 16, 40, 2, &p);
+  std::mt19937_64 rng(3);
+  for (auto& q : p.queries) {
+    for (std::size_t f = 0; f < kDim / 10; ++f) {
+      const std::size_t bit = static_cast<std::size_t>(rng() % kDim);
+      q.SetBit(bit, !q.GetBit(bit));
+    }
+  }
+  const std::size_t nf = p.resonator.factors();
+  std::vector<std::uint32_t> found(p.truth.size());
+  std::vector<ResonatorOutcome> outcomes(p.queries.size());
+  p.resonator.FactorizeBatch(p.queries.data(), p.queries.size(), found.data(), outcomes.data());
+  std::size_t correct = 0;
+  for (std::size_t q = 0; q < p.queries.size(); ++q) {
+    EXPECT_FALSE(outcomes[q].exact);  // the noise cannot be reproduced
+    bool all = true;
+    for (std::size_t f = 0; f < nf; ++f) all = all && found[q * nf + f] == p.truth[q * nf + f];
+    correct += all ? 1 : 0;
+  }
+  EXPECT_GE(correct, 36u);
+}
+
+TEST(Resonator, ResultsIndependentOfBatchingKernelAndExecutor) {
+  constexpr std::size_t kDim = 1000;  // partial last word
+  Problem<kDim> p;
+  MakeProblem<kDim>(4, 12, 37, 4, &p);  // 37 queries: two full blocks and a partial one
+  const std::size_t nf = p.resonator.factors();
+  hyperstream::memory::ResonatorOptions options;
+  options.max_iterations = 20;
+  std::vector<std::uint32_t> batched(p.truth.size());
+  std::vector<ResonatorOutcome> batched_out(p.queries.size());
+  p.resonator.FactorizeBatch(p.queries.data(), p.queries.size(), batched.data(), batched_out.data(), options,
+                             hyperstream::backend::SelectHammingTileBackend(), ReverseExecutor{});
+  for (std::size_t q = 0; q < p.queries.size(); ++q) {
+    std::vector<std::uint32_t> single(nf);
+    const ResonatorOutcome o = p.resonator.Factorize(p.queries[q], single.data(), options);
+    for (std::size_t f = 0; f < nf; ++f) EXPECT_EQ(single[f], batched[q * nf + f]) << "query " << q;
+    EXPECT_EQ(o.iterations, batched_out[q].iterations);
+    EXPECT_EQ(o.converged, batched_out[q].converged);
+    EXPECT_EQ(o.exact, batched_out[q].exact);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/retrain.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::ClusterMemory;
+using hyperstream::memory::RetrainOptions;
+using hyperstream::test::ReverseExecutor;
+
+constexpr std::size_t kDim = 1024;
+constexpr std::size_t kClasses = 4;
+
+void Flip(std::mt19937_64* rng, HyperVector<kDim, bool>* hv, std::size_t flips) {
+  for (std::size_t f = 0; f < flips; ++f) {
+    const std::size_t bit = static_cast<std::size_t>((*rng)() % kDim);
+    hv->SetBit(bit, !hv->GetBit(bit));
+  }
+}
+
+// Multi-modal classes: class c draws from two modes, and mode 1 of every class lies close to mode 0
+// of the next class, so the bundled (one-shot) prototypes confuse neighbouring classes.
+struct Dataset {
+  std::vector<HyperVector<kDim, bool>> samples;
+  std::vector<std::uint64_t> labels;
+};
+
+Dataset MakeDataset(std::size_t per_class, std::uint64_t mode_seed, std::uint64_t noise_seed) {
+  std::mt19937_64 rng(mode_seed);
+  std::vector<HyperVector<kDim, bool>> modes(2 * kClasses);
+  for (std::size_t c = 0; c < kClasses; ++c) {
+    for (auto& w : modes[2 * c].Words()) w = rng();
+  }
+  for (std::size_t c = 0; c < kClasses; ++c) {
+    modes[2 * c + 1] = modes[2 * ((c + 1) % kClasses)];
+    Flip(&rng, &modes[2 * c + 1], kDim / 6);
+  }
+  rng.seed(noise_seed);
+  Dataset d;
+  for (std::size_t i = 0; i < per_class * kClasses; ++i) {
+    const std::size_t c = i % kClasses;
+    // Mode 0 dominates, so the bundled prototype sits near it.
+    HyperVector<kDim, bool> hv = modes[2 * c + ((i / kClasses) % 4 == 3 ? 1 : 0)];
+    Flip(&rng, &hv, kDim / 5);
+    d.samples.push_back(hv);
+    d.labels.push_back(100 + c);
+  }
+  return d;
+}
+
+template <typename Memory>
+std::size_t Mistakes(const Memory& memory, const Dataset& d) {
+  std::size_t mistakes = 0;
+  for (std::size_t i = 0; i < d.samples.size(); ++i) {
+    mistakes += memory.ClassifyBinarized(d.samples[i]) != d.labels[i] ? 1 : 0;
+  }
+  return mistakes;
+}
+
+TEST(Retrain, ReducesTrainingAndHeldOutErrors) {
+  const Dataset train = MakeDataset(200, 1, 10);
+  ClusterMemory<kDim, kClasses> memory;
+  for (std::size_t i = 0; i < train.samples.size(); ++i) ASSERT_TRUE(memory.Update(train.labels[i], train.samples[i]));
+  const std::size_t one_shot = Mistakes(memory, train);
+  ASSERT_GT(one_shot, 0u);
+
+  RetrainOptions options;
+  options.epochs = 20;
+  options.batch_size = 32;
+  const auto stats = hyperstream::memory::Retrain(memory, train.samples.data(), train.labels.data(),
+                                                  train.samples.size(), options);
+  ASSERT_FALSE(stats.mistakes_per_epoch.empty());
+  EXPECT_LE(stats.mistakes_per_epoch.size(), options.epochs);
+  EXPECT_EQ(stats.skipped, 0u);
+  EXPECT_LT(stats.mistakes_per_epoch.back(), stats.mistakes_per_epoch.front());
+  EXPECT_LT(Mistakes(memory, train), one_shot / 2);
+
+  // The same memory generalizes to fresh samples of the same modes better than the one-shot one.
+  const Dataset test = MakeDataset(100, 1, 11);
+  ClusterMemory<kDim, kClasses> baseline;
+  for (std::size_t i = 0; i < train.samples.size(); ++i) (void)baseline.Update(train.labels[i], train.samples[i]);
+  EXPECT_LT(Mistakes(memory, test), Mistakes(baseline, test));
+}
+
+TEST(Retrain, ResultIsIndependentOfTaskOrderAndBatchOneIsSequentialPerceptron) {
+  const Dataset train = MakeDataset(60, 2, 20);
+  RetrainOptions options;
+  options.epochs = 3;
+  options.batch_size = 16;
+  auto hamming = [](const HyperVector<kDim, bool>& a, const HyperVector<kDim, bool>& b) {
+    return hyperstream::core::HammingDistance(a, b);
+  };
+  ClusterMemory<kDim, kClasses> forward;
+  ClusterMemory<kDim, kClasses> reverse;
+  for (std::size_t i = 0; i < train.samples.size(); ++i) {
+    (void)forward.Update(train.labels[i], train.samples[i]);
+    (void)reverse.Update(train.labels[i], train.samples[i]);
+  }
+  const auto sf = hyperstream::memory::Retrain(forward, train.samples.data(), train.labels.data(),
+                                               train.samples.size(), options, hamming);
+  const auto sr = hyperstream::memory::Retrain(reverse, train.samples.data(), train.labels.data(),
+                                               train.samples.size(), options, hamming, ReverseExecutor{});
+  EXPECT_EQ(sf.mistakes_per_epoch, sr.mistakes_per_epoch);
+  for (std::size_t i = 0; i < kClasses * kDim; ++i) ASSERT_EQ(forward.view().sums[i], reverse.view().sums[i]);
+
+  // batch_size 1: classify, then update on a mistake, one sample at a time.
+  ClusterMemory<kDim, kClasses> batched;
+  ClusterMemory<kDim, kClasses> manual;
+  for (std::size_t i = 0; i < train.samples.size(); ++i) {
+    (void)batched.Update(train.labels[i], train.samples[i]);
+    (void)manual.Update(train.labels[i], train.samples[i]);
+  }
+  options.batch_size = 1;
+  options.epochs = 1;
+  options.step = 2;
+  (void)hyperstream::memory::Retrain(batched, train.samples.data(), train.labels.data(),
+                                     train.samples.size(), options);
+  for (std::size_t i = 0; i < train.samples.size(); ++i) {
+    const std::uint64_t predicted = manual.ClassifyBinarized(train.samples[i]);
+    if (predicted != train.labels[i]) {
+      ASSERT_TRUE(manual.Reinforce(train.labels[i], train.samples[i], 2));
+      ASSERT_TRUE(manual.Reinforce(predicted, train.samples[i], -2));
+    }
+  }
+  for (std::size_t i = 0; i < kClasses * kDim; ++i) ASSERT_EQ(batched.view().sums[i], manual.view().sums[i]);
+}
+
+TEST(Retrain, ReinforceAdjustsCountersAndUnknownLabelsAreSkipped) {
+  ClusterMemory<64, 2> memory;
+  HyperVector<64, bool> hv;
+  hv.Clear();
+  hv.SetBit(3, true);
+  ASSERT_TRUE(memory.Update(7, hv));
+  EXPECT_FALSE(memory.Reinforce(8, hv, 1));
+  ASSERT_TRUE(memory.Reinforce(7, hv, -3));
+  const auto view = memory.view();
+  EXPECT_EQ(view.sums[3], 1 - 3);
+  EXPECT_EQ(view.sums[0], -1 + 3);
+  EXPECT_EQ(view.counts[0], 1);  // Reinforce leaves the update count alone
+  HyperVector<64, bool> proto;
+  memory.Finalize(7, &proto);
+  EXPECT_FALSE(proto.GetBit(3));
+  EXPECT_TRUE(proto.GetBit(0));
+
+  const HyperVector<64, bool> samples[2] = {hv, hv};
+  const std::uint64_t labels[2] = {7, 9};
+  const auto stats = hyperstream::memory::Retrain(memory, samples, labels, 2);
+  EXPECT_EQ(stats.skipped, 1u);
+  // With a single class every known sample is predicted correctly, so training stops at once.
+  ASSERT_EQ(stats.mistakes_per_epoch.size(), 1u);
+  EXPECT_EQ(stats.mistakes_per_epoch[0], 0u);
+}
+
+}  // namespace
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "hyperstream/backend/policy.hpp"
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/memory/sequence.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::SequenceMemory;
+using hyperstream::memory::SequenceStorage;
+using hyperstream::test::ReverseExecutor;
+
+constexpr std::size_t kDim = 4096;
+constexpr std::size_t kWindow = 3;
+constexpr std::size_t kAlphabet = 16;
+
+// Order-kWindow source: the next symbol is a fixed random function of the last kWindow symbols,
+// replaced by a uniformly random symbol with probability `noise`.
+struct Source {
+  std::vector<std::uint64_t> table;
+  std::mt19937_64 rng;
+  std::vector<std::uint64_t> recent{0, 1, 2};
+
+  explicit Source(std::uint64_t seed) : table(kAlphabet * kAlphabet * kAlphabet), rng(seed) {
+    for (auto& t : table) t = rng() % kAlphabet;
+  }
+  std::size_t Context() const { return (recent[0] * kAlphabet + recent[1]) * kAlphabet + recent[2]; }
+  std::uint64_t Expected() const { return table[Context()]; }
+  std::uint64_t Next(double noise) {
+    std::uint64_t s = Expected();
+    if (std::uniform_real_distribution<double>(0.0, 1.0)(rng) < noise) s = rng() % kAlphabet;
+    recent = {recent[1], recent[2], s};
+    return s;
+  }
+};
+
+TEST(SequenceMemory, IncrementalContextEqualsNGramOfTheLastWindowSymbols) {
+  constexpr std::size_t kOddDim = 1000;
+  const std::uint64_t seed = 0x27d4eb2f165667c5ULL;
+  SequenceMemory<kOddDim, kWindow, 8> memory;
+  std::mt19937_64 rng(1);
+  std::vector<std::uint64_t> stream;
+  for (std::size_t t = 0; t < 40; ++t) {
+    stream.push_back(rng() % 100);
+    memory.Advance(stream.back());
+    ASSERT_EQ(memory.context_size(), t + 1 < kWindow ? t + 1 : kWindow);
+    if (t + 1 < kWindow) continue;
+    // Newest symbol unrotated, the one before rotated once, ... (SequentialNGramEncoder order).
+    HyperVector<kOddDim, bool> expected;
+    expected.Clear();
+    for (std::size_t i = 0; i < kWindow; ++i) {
+      HyperVector<kOddDim, bool> hv;
+      HyperVector<kOddDim, bool> rotated;
+      hyperstream::encoding::detail::GenerateRandomHypervector(seed, stream[t - i], &hv);
+      hyperstream::core::PermuteRotate(hv, i, &rotated);
+      hyperstream::core::Bind(expected, rotated, &expected);
+    }
+    ASSERT_EQ(memory.context().Words(), expected.Words()) << "t=" << t;
+  }
+  memory.ResetContext();
+  EXPECT_EQ(memory.context_size(), 0u);
+}
+
+// Predicts noisy continuations of several sources about as well as an exact table of successor
+// counts trained on the same streams (most frequent successor per context, the sequence_bench
+// hash_map baseline). Contexts missing from training cap both, so the bound is relative to the
+// table; storage that loses pairs (e.g. overloaded shards) falls well below it.
+template <SequenceStorage Storage>
+void ExpectLearnsSource() {
+  std::size_t correct = 0;
+  std::size_t table_correct = 0;
+  for (std::uint64_t seed = 1; seed <= 4; ++seed) {
+    hyperstream::memory::SequenceMemoryOptions options;
+    options.bundled.expected_pairs = 4000;
+    SequenceMemory<kDim, kWindow, kAlphabet, Storage> memory(options);
+    Source source(seed);
+    std::vector<std::array<std::size_t, kAlphabet>> counts(kAlphabet * kAlphabet * kAlphabet);
+    for (std::size_t t = 0; t < 4000; ++t) {
+      const std::size_t context = source.Context();
+      const std::uint64_t s = source.Next(0.1);
+      ASSERT_TRUE(memory.Observe(s));
+      if (t >= kWindow) ++counts[context][s];
+    }
+    EXPECT_EQ(memory.symbol_count(), kAlphabet);
+    if constexpr (Storage == SequenceStorage::kBundled) {
+      EXPECT_GE(memory.store().EstimatedAccuracy(), options.bundled.target_accuracy);  // shards not overloaded
+    }
+    for (std::size_t t = 0; t < 1000; ++t) {
+      const auto& c = counts[source.Context()];
+      const auto best = std::max_element(c.begin(), c.end());
+      table_correct += (*best > 0 && static_cast<std::uint64_t>(best - c.begin()) == source.Expected()) ? 1 : 0;
+      correct += memory.Predict() == source.Expected() ? 1 : 0;
+      memory.Advance(source.Next(0.1));
+    }
+  }
+  EXPECT_GE(correct, table_correct * 9 / 10);
+}
+
+TEST(SequenceMemory, BundledStoragePredictsTheLearnedSuccessor) {
+  ExpectLearnsSource<SequenceStorage::kBundled>();
+}
+
+TEST(SequenceMemory, PrototypeStoragePredictsTheLearnedSuccessor) {
+  ExpectLearnsSource<SequenceStorage::kPrototype>();
+}
+
+template <SequenceStorage Storage>
+void ExpectSequenceMatchesLoop() {
+  SequenceMemory<kDim, kWindow, kAlphabet, Storage> looped;
+  SequenceMemory<kDim, kWindow, kAlphabet, Storage> batched;
+  Source source(3);
+  for (std::size_t t = 0; t < 500; ++t) {
+    const std::uint64_t s = source.Next(0.2);
+    (void)looped.Observe(s);
+    (void)batched.Observe(s);
+  }
+  std::vector<std::uint64_t> test;
+  for (std::size_t t = 0; t < 203; ++t) test.push_back(source.Next(0.2));
+  std::vector<std::uint64_t> expected;
+  for (std::uint64_t s : test) {
+    expected.push_back(looped.Predict());
+    looped.Advance(s);
+  }
+  std::vector<std::uint64_t> got(test.size());
+  batched.PredictSequence(test.data(), test.size(), got.data(), hyperstream::backend::SelectHammingTileBackend(),
+                          ReverseExecutor{});
+  EXPECT_EQ(got, expected);
+  EXPECT_EQ(batched.context().Words(), looped.context().Words());
+}
+
+TEST(SequenceMemory, PredictSequenceMatchesPredictAndAdvance) {
+  ExpectSequenceMatchesLoop<SequenceStorage::kBundled>();
+  ExpectSequenceMatchesLoop<SequenceStorage::kPrototype>();
+}
+
+TEST(SequenceMemory, NoPredictionWithoutContextOrLearnedSymbols) {
+  SequenceMemory<kDim, kWindow, 2> memory;
+  EXPECT_EQ(memory.Predict(), memory.kNoPrediction);
+  for (std::uint64_t s : {5, 6, 7}) EXPECT_TRUE(memory.Observe(s));  // fills the context only
+  EXPECT_EQ(memory.Predict(), memory.kNoPrediction);                 // nothing learned yet
+  EXPECT_TRUE(memory.Observe(5));
+  EXPECT_TRUE(memory.Observe(6));
+  EXPECT_FALSE(memory.Observe(7));  // a third distinct symbol exceeds SymbolCapacity
+  EXPECT_EQ(memory.symbol_count(), 2u);
+  const std::uint64_t p = memory.Predict();
+  EXPECT_TRUE(p == 5 || p == 6);
+
+  std::uint64_t out[2] = {0, 0};
+  SequenceMemory<kDim, kWindow, 2, SequenceStorage::kPrototype> empty;
+  const std::uint64_t symbols[2] = {1, 2};
+  empty.PredictSequence(symbols, 2, out);
+  EXPECT_EQ(out[0], empty.kNoPrediction);
+  EXPECT_EQ(out[1], empty.kNoPrediction);
+}
+
+}  // namespace
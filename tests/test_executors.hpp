@@ -0,0 +1,19 @@
+#pragma once
+
+// Executors shared by the tests of executor-parameterized APIs.
+
+#include <cstddef>
+
+namespace hyperstream {
+namespace test {
+
+// Runs tasks in reverse order: results must not depend on task order.
+struct ReverseExecutor {
+  template <typename Fn>
+  void operator()(std::size_t count, Fn&& fn) const {
+    for (std::size_t t = count; t-- > 0;) fn(t);
+  }
+};
+
+}  // namespace test
+}  // namespace hyperstream
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/core/ops.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/encoding/numeric.hpp"
+#include "hyperstream/encoding/timeseries.hpp"
+
+#include "test_executors.hpp"
+
+namespace {
+
+using hyperstream::core::BinaryBundler;
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::MultiChannelTimeSeriesEncoder;
+using hyperstream::encoding::ThermometerEncoder;
+using hyperstream::test::ReverseExecutor;
+
+// Thermometer -> rotate by timestep -> bind channel -> BinaryBundler, on the quantized values.
+template <std::size_t D, std::size_t C, std::size_t W>
+void Reference(const MultiChannelTimeSeriesEncoder<D, C, W>& enc, double min, double max,
+               std::uint64_t seed, const float* x, HyperVector<D, bool>* out) {
+  auto thermo = std::make_unique<ThermometerEncoder<D>>(min, max);
+  const double step = (max - min) / static_cast<double>(enc.levels() - 1);
+  BinaryBundler<D> bundler;
+  HyperVector<D, bool> level, rotated, channel, bound;
+  for (std::size_t t = 0; t < W; ++t) {
+    for (std::size_t c = 0; c < C; ++c) {
+      thermo->Encode(min + static_cast<double>(enc.Level(x[t * C + c])) * step, &level);
+      hyperstream::core::PermuteRotate(level, t, &rotated);
+      hyperstream::encoding::detail::GenerateRandomHypervector(seed, c, &channel);
+      hyperstream::core::Bind(rotated, channel, &bound);
+      bundler.Accumulate(bound);
+    }
+  }
+  bundler.Finalize(out);
+}
+
+template <std::size_t D, std::size_t C, std::size_t W>
+void ExpectMatchesReference() {
+  const MultiChannelTimeSeriesEncoder<D, C, W> enc(-1.0, 3.0, 21, 7);
+  std::mt19937_64 rng(D + C + W);
+  std::uniform_real_distribution<float> dist(-1.5f, 3.5f);  // includes clamped samples
+  std::vector<float> x(C * W);
+  HyperVector<D, bool> got, expected;
+  for (int trial = 0; trial < 3; ++trial) {
+    for (auto& v : x) v = dist(rng);
+    enc.Encode(x.data(), &got);
+    Reference(enc, -1.0, 3.0, 7, x.data(), &expected);
+    ASSERT_EQ(got.Words(), expected.Words()) << "trial=" << trial;
+  }
+}
+
+TEST(MultiChannelTimeSeriesEncoder, MatchesHandWrittenLoop) {
+  ExpectMatchesReference<1000, 3, 70>();  // partial last word, rotations past one word
+  ExpectMatchesReference<128, 2, 5>();    // even sample count: ties -> 1
+  ExpectMatchesReference<64, 1, 130>();   // rotations wrap the whole vector
+}
+
+TEST(MultiChannelTimeSeriesEncoder, QuantizesToNearestClampedLevel) {
+  const MultiChannelTimeSeriesEncoder<256, 1, 4> enc(0.0, 10.0, 11);
+  EXPECT_EQ(enc.levels(), 11u);
+  EXPECT_EQ(enc.Level(0.0f), 0u);
+  EXPECT_EQ(enc.Level(4.4f), 4u);
+  EXPECT_EQ(enc.Level(4.6f), 5u);
+  EXPECT_EQ(enc.Level(10.0f), 10u);
+  EXPECT_EQ(enc.Level(-3.0f), 0u);
+  EXPECT_EQ(enc.Level(42.0f), 10u);
+  EXPECT_EQ(enc.Level(std::numeric_limits<float>::quiet_NaN()), 0u);
+  EXPECT_EQ((MultiChannelTimeSeriesEncoder<256, 1, 4>(0.0, 1.0, 1).levels()), 2u);
+
+  // Nearby windows stay similar; distant ones do not.
+  HyperVector<256, bool> a, b, c;
+  const float lo[4] = {2.0f, 3.0f, 4.0f, 5.0f};
+  const float near[4] = {2.0f, 3.0f, 5.0f, 5.0f};
+  const float far[4] = {9.0f, 8.0f, 0.0f, 1.0f};
+  enc.Encode(lo, &a);
+  enc.Encode(near, &b);
+  enc.Encode(far, &c);
+  EXPECT_LT(hyperstream::core::HammingDistance(a, b), hyperstream::core::HammingDistance(a, c));
+}
+
+TEST(MultiChannelTimeSeriesEncoder, EncodeWindowsSlidesByStride) {
+  using Encoder = MultiChannelTimeSeriesEncoder<300, 2, 8>;
+  const Encoder enc(-1.0, 1.0);
+  std::vector<float> x(2 * 50);
+  for (std::size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(std::sin(0.3 * static_cast<double>(i)));
+
+  EXPECT_EQ(Encoder::WindowCount(7, 1), 0u);
+  EXPECT_EQ(Encoder::WindowCount(8, 3), 1u);
+  EXPECT_EQ(Encoder::WindowCount(50, 3), 15u);
+  EXPECT_EQ(Encoder::WindowCount(50, 0), 43u);  // stride 0 -> 1
+
+  std::vector<HyperVector<300, bool>> out(Encoder::WindowCount(50, 3));
+  ASSERT_EQ(enc.EncodeWindows(x.data(), 50, 3, out.data(), ReverseExecutor{}), out.size());
+  HyperVector<300, bool> hv;
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    enc.Encode(x.data() + i * 3 * 2, &hv);
+    EXPECT_EQ(out[i].Words(), hv.Words()) << i;
+  }
+}
+
+}  // namespace
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/encoding/symbol.hpp"
+#include "hyperstream/encoding/token_cache.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::CachedSymbolEncoder;
+using hyperstream::encoding::SymbolEncoder;
+using hyperstream::encoding::TokenCacheOptions;
+using hyperstream::encoding::TokenHash;
+
+constexpr std::size_t kDim = 1000;
+constexpr std::uint64_t kSeed = 0x71ULL;
+
+// Token indices drawn from a Zipf(s = 1) distribution over `vocab` tokens.
+std::vector<std::size_t> ZipfStream(std::size_t vocab, std::size_t n, std::uint64_t seed) {
+  std::vector<double> cdf(vocab);
+  double sum = 0.0;
+  for (std::size_t i = 0; i < vocab; ++i) cdf[i] = (sum += 1.0 / static_cast<double>(i + 1));
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> u(0.0, sum);
+  std::vector<std::size_t> stream(n);
+  for (auto& s : stream) s = static_cast<std::size_t>(std::lower_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin());
+  return stream;
+}
+
+std::string Token(std::size_t i) { return "token-" + std::to_string(i); }
+
+TEST(TokenCache, EncodingsEqualSymbolEncoderThroughEvictions) {
+  for (TokenHash hash : {TokenHash::kFnv1a, TokenHash::kWyhash}) {
+    TokenCacheOptions options;
+    options.capacity = 32;
+    options.shards = 4;
+    const CachedSymbolEncoder<kDim> cached(kSeed, options, hash);
+    const SymbolEncoder<kDim> plain(kSeed, hash);
+    HyperVector<kDim, bool> got, expected;
+    for (std::size_t i : ZipfStream(500, 3000, 1)) {
+      const std::string token = Token(i);
+      cached.EncodeToken(token, &got);
+      plain.EncodeToken(token, &expected);
+      ASSERT_EQ(got.Words(), expected.Words()) << token;
+      cached.EncodeTokenRole(token, i % 5, &got);
+      plain.EncodeTokenRole(token, i % 5, &expected);
+      ASSERT_EQ(got.Words(), expected.Words()) << token;
+    }
+    EXPECT_LE(cached.size(), cached.capacity());
+    EXPECT_EQ(cached.capacity(), 32u);
+    const auto st = cached.stats();
+    EXPECT_EQ(st.hits + st.misses, 6000u);
+    EXPECT_GT(st.hits, 0u);
+    EXPECT_GT(st.evictions + st.rejections, 0u);
+  }
+}
+
+TEST(TokenCache, AdmissionKeepsTheHotSetOfAZipfStream) {
+  const auto stream = ZipfStream(20000, 60000, 2);
+  std::vector<std::string> tokens;
+  for (std::size_t i : stream) tokens.push_back(Token(i));
+  auto hit_rate = [&](bool admission) {
+    TokenCacheOptions options;
+    options.capacity = 512;
+    options.admission = admission;
+    const CachedSymbolEncoder<kDim> cached(kSeed, options);
+    HyperVector<kDim, bool> hv;
+    for (const auto& t : tokens) cached.EncodeToken(t, &hv);
+    EXPECT_EQ(cached.size(), cached.capacity());
+    return cached.stats().HitRate();
+  };
+  const double clock = hit_rate(false);
+  const double tinylfu = hit_rate(true);
+  EXPECT_GT(clock, 0.3);
+  EXPECT_GT(tinylfu, clock + 0.03) << "clock=" << clock;
+}
+
+TEST(TokenCache, ConcurrentEncodersAgreeWithTheUncachedEncoder) {
+  TokenCacheOptions options;
+  options.capacity = 64;
+  options.shards = 2;
+  const CachedSymbolEncoder<kDim> cached(kSeed, options);
+  const SymbolEncoder<kDim> plain(kSeed);
+  std::vector<HyperVector<kDim, bool>> expected(300);
+  for (std::size_t i = 0; i < expected.size(); ++i) plain.EncodeToken(Token(i), &expected[i]);
+  std::vector<int> failures(4, 0);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < failures.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      HyperVector<kDim, bool> hv;
+      for (std::size_t i : ZipfStream(expected.size(), 4000, 10 + t)) {
+        cached.EncodeToken(Token(i), &hv);
+        failures[t] += hv.Words() == expected[i].Words() ? 0 : 1;
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+  for (int f : failures) EXPECT_EQ(f, 0);
+  const auto st = cached.stats();
+  EXPECT_EQ(st.hits + st.misses, 16000u);
+}
+
+TEST(TokenCache, ZeroCapacityAndClear) {
+  TokenCacheOptions options;
+  options.capacity = 0;
+  const CachedSymbolEncoder<kDim> off(kSeed, options);
+  HyperVector<kDim, bool> hv;
+  off.EncodeToken("alpha", &hv);
+  off.EncodeToken("alpha", &hv);
+  EXPECT_EQ(off.size(), 0u);
+  EXPECT_EQ(off.stats().hits, 0u);
+
+  CachedSymbolEncoder<kDim> cached(kSeed);
+  cached.EncodeToken("alpha", &hv);
+  cached.EncodeToken("alpha", &hv);
+  EXPECT_EQ(cached.stats().hits, 1u);
+  EXPECT_EQ(cached.size(), 1u);
+  cached.Clear();
+  cached.ResetStats();
+  EXPECT_EQ(cached.size(), 0u);
+  cached.EncodeToken("alpha", &hv);
+  EXPECT_EQ(cached.stats().misses, 1u);
+}
+
+}  // namespace
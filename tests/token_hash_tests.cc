@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/encoding/encoders.hpp"
+#include "hyperstream/encoding/item_memory.hpp"
+#include "hyperstream/encoding/symbol.hpp"
+#include "hyperstream/encoding/token_hash.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::encoding::HashToken;
+using hyperstream::encoding::HashTokenPair;
+using hyperstream::encoding::TokenHash;
+
+std::string RandomToken(std::mt19937_64* rng, std::size_t len) {
+  std::string token(len, '\0');
+  for (auto& c : token) c = static_cast<char>((*rng)() & 0xff);
+  return token;
+}
+
+TEST(TokenHash, Fnv1aFamilyReproducesTheOriginalHashes) {
+  // Pinned outputs of the historical FNV-1a (offset basis 1469598103934665603 ^ seed), so the
+  // single definition in token_hash.hpp cannot drift; the legacy detail helpers forward to it.
+  EXPECT_EQ(HashToken(TokenHash::kFnv1a, "", 0), 0x14650fb0739d0383ULL);
+  EXPECT_EQ(HashToken(TokenHash::kFnv1a, "a", 0), 0x44bd8ad473cd9906ULL);
+  EXPECT_EQ(HashToken(TokenHash::kFnv1a, "foobar", 0), 0x88fad7c0a8ff07f2ULL);
+  EXPECT_EQ(HashToken(TokenHash::kFnv1a, "hello", 42), 0x9099720630c910e7ULL);
+  EXPECT_EQ(HashTokenPair(TokenHash::kFnv1a, "hello", 42).second, 0x72ba1259471153a9ULL);
+
+  std::mt19937_64 rng(1);
+  for (std::size_t len = 0; len < 80; ++len) {
+    const std::string token = RandomToken(&rng, len);
+    const std::uint64_t seed = rng();
+    const auto [h1, h2] = HashTokenPair(TokenHash::kFnv1a, token, seed);
+    EXPECT_EQ(h1, HashToken(TokenHash::kFnv1a, token, seed));
+    EXPECT_EQ(h2, (HashToken(TokenHash::kFnv1a, token, seed ^ 0x5bf03635f0b7a54dULL) << 1) | 1ULL);
+  }
+}
+
+TEST(TokenHash, WyhashIsDeterministicAndSensitiveToEveryByteLengthAndSeed) {
+  std::mt19937_64 rng(2);
+  std::set<std::uint64_t> seen;
+  std::size_t hashes = 0;
+  for (std::size_t len = 0; len <= 600; len += (len < 64 ? 1 : 37)) {
+    std::string token = RandomToken(&rng, len);
+    const std::uint64_t h = HashToken(TokenHash::kWyhash, token, 7);
+    EXPECT_EQ(h, HashToken(TokenHash::kWyhash, std::string(token), 7)) << "len=" << len;
+    seen.insert(h);
+    seen.insert(HashToken(TokenHash::kWyhash, token, 8));
+    hashes += 2;
+    for (std::size_t i = 0; i < len; ++i) {  // every byte position reaches the result
+      token[i] ^= 0x01;
+      seen.insert(HashToken(TokenHash::kWyhash, token, 7));
+      token[i] ^= 0x01;
+      ++hashes;
+    }
+  }
+  // Zero-filled tokens of different lengths differ too (the empty token is already counted).
+  for (std::size_t len = 1; len <= 64; ++len) seen.insert(HashToken(TokenHash::kWyhash, std::string(len, '\0'), 7));
+  EXPECT_EQ(seen.size(), hashes + 64);
+}
+
+TEST(TokenHash, WyMumMatchesSchoolbookProduct) {
+  std::mt19937_64 rng(3);
+  for (int i = 0; i < 1000; ++i) {
+    const std::uint64_t x = rng();
+    const std::uint64_t y = i == 0 ? ~0ULL : rng();
+    std::uint64_t lo = x;
+    std::uint64_t hi = y;
+    hyperstream::encoding::detail_tokenhash::WyMum(&lo, &hi);
+    // 32-bit limbs, accumulated column by column.
+    const std::uint64_t x0 = x & 0xffffffffULL, x1 = x >> 32, y0 = y & 0xffffffffULL, y1 = y >> 32;
+    const std::uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+    const std::uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffULL) + (p10 & 0xffffffffULL);
+    EXPECT_EQ(lo, (mid << 32) | (p00 & 0xffffffffULL));
+    EXPECT_EQ(hi, p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32));
+  }
+}
+
+TEST(TokenHash, EncodersSelectTheFamilyAndDefaultToFnv1a) {
+  constexpr std::size_t D = 1024;
+  const std::string token = "https://example.com/a/rather/long/token/that/spans/many/words";
+  HyperVector<D, bool> fnv, wy, again, legacy;
+
+  hyperstream::encoding::HashEncoder<D> hash_default;
+  hyperstream::encoding::HashEncoder<D> hash_wy(4, 0x51ed2701f3a5c7b9ULL, TokenHash::kWyhash);
+  hash_default.EncodeToken(token, 3, &fnv);
+  hash_wy.EncodeToken(token, 3, &wy);
+  hash_wy.EncodeToken(token, 3, &again);
+  EXPECT_NE(fnv.Words(), wy.Words());
+  EXPECT_EQ(wy.Words(), again.Words());
+  EXPECT_EQ(hash_wy.token_hash(), TokenHash::kWyhash);
+  EXPECT_EQ(hash_default.token_hash(), TokenHash::kFnv1a);
+
+  hyperstream::encoding::ItemMemory<D> im_default(42);
+  hyperstream::encoding::ItemMemory<D> im_wy(42, TokenHash::kWyhash);
+  im_default.EncodeToken(token, &fnv);
+  im_default.EncodeId(HashToken(TokenHash::kFnv1a, token, 42 ^ 0x5bf03635f0b7a54dULL), &legacy);
+  EXPECT_EQ(fnv.Words(), legacy.Words());
+  im_wy.EncodeToken(token, &wy);
+  EXPECT_NE(fnv.Words(), wy.Words());
+
+  hyperstream::encoding::SymbolEncoder<D> sym_wy(42, TokenHash::kWyhash);
+  sym_wy.EncodeToken(token, &again);
+  EXPECT_EQ(wy.Words(), again.Words());
+}
+
+}  // namespace
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "hyperstream/core/hypervector.hpp"
+#include "hyperstream/memory/associative.hpp"
+#include "hyperstream/memory/transposed.hpp"
+
+namespace {
+
+using hyperstream::core::HyperVector;
+using hyperstream::memory::PrototypeMemory;
+using hyperstream::memory::TransposedPrototypeMemory;
+
+template <std::size_t Dim>
+void RandomFill(std::mt19937_64* rng, HyperVector<Dim, bool>* hv) {
+  for (auto& w : hv->Words()) w = (*rng)();
+  if (Dim % 64 != 0) hv->Words().back() &= (1ULL << (Dim % 64)) - 1ULL;
+}
+
+// Same labels as the row-major scan for close, noisy and unrelated queries; duplicates and
+// partially filled last groups exercise the first-entry tie rule and lane masking.
+template <std::size_t Dim, std::size_t Cap>
+void ExpectMatchesRowMajor(std::size_t size, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  PrototypeMemory<Dim, Cap> rows;
+  std::vector<HyperVector<Dim, bool>> protos(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    if (i % 11 == 7) {
+      protos[i] = protos[i / 2];
+    } else {
+      RandomFill(&rng, &protos[i]);
+    }
+    ASSERT_TRUE(rows.Learn(100 + i, protos[i]));
+  }
+  const TransposedPrototypeMemory<Dim, Cap> cols(rows);
+  ASSERT_EQ(cols.size(), size);
+  for (std::size_t q = 0; q < 120; ++q) {
+    HyperVector<Dim, bool> query;
+    if (q % 4 == 3) {
+      RandomFill(&rng, &query);
+    } else {
+      query = protos[(q * 29) % size];
+      const std::size_t flips = (q % 4) * Dim / 8;
+      for (std::size_t f = 0; f < flips; ++f) {
+        const std::size_t bit = static_cast<std::size_t>(rng() % Dim);
+        query.SetBit(bit, !query.GetBit(bit));
+      }
+    }
+    EXPECT_EQ(cols.Classify(query, 0), rows.Classify(query, 0)) << "query " << q;
+  }
+}
+
+TEST(TransposedPrototypeMemory, MatchesRowMajorClassify) {
+  ExpectMatchesRowMajor<64, 256>(256, 1);
+  ExpectMatchesRowMajor<100, 300>(291, 2);   // partial word and partial last group
+  ExpectMatchesRowMajor<1000, 200>(130, 3);
+  ExpectMatchesRowMajor<10000, 70>(70, 4);
+}
+
+TEST(TransposedPrototypeMemory, LearnMatchesAssignAndHandlesLimits) {
+  static constexpr std::size_t kDim = 128;
+  static constexpr std::size_t kCap = 65;
+  std::mt19937_64 rng(9);
+  PrototypeMemory<kDim, kCap> rows;
+  TransposedPrototypeMemory<kDim, kCap> learned;
+  HyperVector<kDim, bool> query;
+  RandomFill(&rng, &query);
+  EXPECT_EQ(learned.Classify(query, 77), 77u) << "empty memory returns the default label";
+  for (std::size_t i = 0; i < kCap; ++i) {
+    HyperVector<kDim, bool> hv;
+    RandomFill(&rng, &hv);
+    ASSERT_TRUE(rows.Learn(i, hv));
+    ASSERT_TRUE(learned.Learn(i, hv));
+  }
+  EXPECT_FALSE(learned.Learn(999, query)) << "full memory rejects Learn";
+  TransposedPrototypeMemory<kDim, kCap> assigned;
+  assigned.Assign(rows);
+  for (int q = 0; q < 50; ++q) {
+    RandomFill(&rng, &query);
+    EXPECT_EQ(learned.Classify(query), rows.Classify(query));
+    EXPECT_EQ(assigned.Classify(query), rows.Classify(query));
+  }
+  EXPECT_EQ(assigned.label(64), 64u);
+
+  TransposedPrototypeMemory<kDim, 0> none;
+  EXPECT_FALSE(none.Learn(1, query));
+  EXPECT_EQ(none.Classify(query, 5), 5u);
+}
+
+}  // namespace
@@ -10,3 +10,17 @@ TEST(WideBundler, CounterTypeIs32Bits) {
   EXPECT_EQ(sizeof(CT), 4u);
 }
 
+
+TEST(WideBundler, NoSaturationPastInt16Range) {
+  constexpr std::size_t D = 64;
+  hyperstream::core::HyperVector<D, bool> hv;
+  hv.Clear();
+  hv.SetBit(0, true);
+  BinaryBundler<D> bundler;
+  for (int i = 0; i < 40000; ++i) bundler.Accumulate(hv);
+  BinaryBundler<D>::Stats stats;
+  hyperstream::core::HyperVector<D, bool> out;
+  bundler.Finalize(&out, &stats);
+  EXPECT_EQ(stats.saturated, 0u);
+  EXPECT_EQ(stats.margin_histogram[BinaryBundler<D>::kMarginBuckets - 1], D);
+}